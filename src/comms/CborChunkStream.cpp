@@ -0,0 +1,56 @@
+#include <CborChunkStream.hpp>
+
+#include <cstring>
+
+size_t CborChunkStream::fill(uint8_t* out, size_t maxLen) {
+    if (!out || maxLen == 0) return 0;
+    size_t n = 0;
+
+    // Rest of the piece that did not fit last time.
+    if (_pendingLen > 0) {
+        size_t take = _pendingLen < maxLen ? _pendingLen : maxLen;
+        memcpy(out, _scratch + _pendingOff, take);
+        _pendingOff += take;
+        _pendingLen -= take;
+        n += take;
+        if (_pendingLen > 0) {
+            _written += n;
+            return n;
+        }
+    }
+
+    while (_state == State::Streaming && n < maxLen) {
+        const size_t room = maxLen - n;
+        const bool direct = room >= kScratch;
+        uint8_t* dst = direct ? out + n : _scratch;
+        size_t len = 0;
+        const Step step = _next(dst, kScratch, len);
+        if (step == Step::Done) {
+            _state = State::Finished;
+            break;
+        }
+        if (step == Step::Error || len > kScratch) {
+            _state = State::Failed;
+            break;
+        }
+        if (direct) {
+            n += len;
+            continue;
+        }
+        const size_t take = len < room ? len : room;
+        memcpy(out + n, _scratch, take);
+        n += take;
+        _pendingOff = take;
+        _pendingLen = len - take;
+        if (_pendingLen > 0) break;
+    }
+
+    _written += n;
+    return n;
+}
+
+size_t CborChunkStream::writeBreaks(uint8_t* buf, size_t cap, size_t n) {
+    if (!buf || n > cap) return 0;
+    memset(buf, kBreak, n);
+    return n;
+}
@@ -0,0 +1,63 @@
+#ifndef CBOR_CHUNK_STREAM_HPP
+#define CBOR_CHUNK_STREAM_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+/**
+ * Incremental CBOR body for chunked HTTP responses.
+ *
+ * A large reply such as {"history": [row, row, ...]} is cut into pieces:
+ * the head (map open, leading keys, array open), one piece per row, and
+ * the closing break bytes. Indefinite-length containers are plain byte
+ * concatenations (0xBF/0x9F ... 0xFF), so the pieces join to exactly the
+ * bytes a single buffered encode produces.
+ *
+ * The producer is called for one piece at a time and advances its own
+ * cursor over the source data. fill() writes pieces straight into the
+ * buffer the web server hands it while at least kScratch bytes are free;
+ * only a piece that lands on the end of a chunk goes through the small
+ * scratch buffer and carries over. Working memory is kScratch bytes no
+ * matter how many rows the reply has.
+ */
+
+#ifndef CBOR_CHUNK_SCRATCH
+#define CBOR_CHUNK_SCRATCH  256    // largest single piece (calibration head)
+#endif
+
+class CborChunkStream {
+public:
+    static constexpr size_t kScratch = CBOR_CHUNK_SCRATCH;
+    static constexpr uint8_t kBreak = 0xFF;
+
+    enum class Step : uint8_t { Piece, Done, Error };
+
+    // Writes the next piece into buf (cap >= kScratch) and sets len.
+    using Producer = std::function<Step(uint8_t* buf, size_t cap, size_t& len)>;
+
+    explicit CborChunkStream(Producer next) : _next(next) {}
+
+    // Up to maxLen bytes into out; 0 once the body is complete. A producer
+    // error also ends the body (the client sees truncated CBOR).
+    size_t fill(uint8_t* out, size_t maxLen);
+
+    bool done() const { return _state != State::Streaming && _pendingLen == 0; }
+    bool failed() const { return _state == State::Failed; }
+    size_t written() const { return _written; }
+
+    // n break bytes (closes n indefinite containers).
+    static size_t writeBreaks(uint8_t* buf, size_t cap, size_t n);
+
+private:
+    enum class State : uint8_t { Streaming, Finished, Failed };
+
+    Producer _next;
+    State    _state = State::Streaming;
+    uint8_t  _scratch[kScratch]{};
+    size_t   _pendingOff = 0;
+    size_t   _pendingLen = 0;
+    size_t   _written = 0;
+};
+
+#endif // CBOR_CHUNK_STREAM_HPP
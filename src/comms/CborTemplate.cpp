@@ -0,0 +1,127 @@
+#include <CborTemplate.hpp>
+
+#include <cstring>
+
+void CborTemplate::reset(uint32_t shapeKey) {
+    _len = 0;
+    _slots = 0;
+    _depth = 0;
+    _shapeKey = shapeKey;
+    _ok = true;
+    _ready = false;
+}
+
+bool CborTemplate::put_(uint8_t b) {
+    if (_len >= sizeof(_buf)) {
+        _ok = false;
+        return false;
+    }
+    _buf[_len++] = b;
+    return true;
+}
+
+bool CborTemplate::key_(const char* key) {
+    if (!key) return false;
+    const size_t n = strlen(key);
+    // Text header: keys are short, 1- or 2-byte form is enough.
+    if (n < 24) {
+        if (!put_(static_cast<uint8_t>(0x60 | n))) return false;
+    } else if (n <= 0xFF) {
+        if (!put_(0x78) || !put_(static_cast<uint8_t>(n))) return false;
+    } else {
+        _ok = false;
+        return false;
+    }
+    if (_len + n > sizeof(_buf)) {
+        _ok = false;
+        return false;
+    }
+    memcpy(_buf + _len, key, n);
+    _len += n;
+    return true;
+}
+
+CborTemplate::SlotId CborTemplate::slot_(SlotType type) {
+    const size_t width = (type == SlotType::Bool) ? 1 : 5;
+    if (!_ok || _slots >= CBOR_TEMPLATE_MAX_SLOTS || _len + width > sizeof(_buf)) {
+        return fail_();
+    }
+    const SlotId id = static_cast<SlotId>(_slots++);
+    _offset[id] = static_cast<uint16_t>(_len);
+    _type[id] = type;
+    _buf[_len] = (type == SlotType::Bool) ? 0xF4
+               : (type == SlotType::F32)  ? 0xFA
+                                          : 0x1A;
+    memset(_buf + _len + 1, 0, width - 1);
+    _len += width;
+    return id;
+}
+
+bool CborTemplate::beginArray(const char* key) {
+    if (!key_(key) || !put_(0x9F)) return false;
+    ++_depth;
+    return true;
+}
+
+bool CborTemplate::beginMap(const char* key) {
+    if (!key_(key) || !put_(0xBF)) return false;
+    ++_depth;
+    return true;
+}
+
+bool CborTemplate::end() {
+    if (_depth == 0) {
+        _ok = false;
+        return false;
+    }
+    --_depth;
+    return put_(0xFF);
+}
+
+bool CborTemplate::finish() {
+    _ready = _ok && _depth == 0;
+    return _ready;
+}
+
+uint8_t* CborTemplate::at_(SlotId id, SlotType type) {
+    if (id >= _slots || _type[id] != type) return nullptr;
+    return _buf + _offset[id];
+}
+
+void CborTemplate::be32_(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v >> 24);
+    p[1] = static_cast<uint8_t>(v >> 16);
+    p[2] = static_cast<uint8_t>(v >> 8);
+    p[3] = static_cast<uint8_t>(v);
+}
+
+void CborTemplate::setF32(SlotId id, float v) {
+    uint8_t* p = at_(id, SlotType::F32);
+    if (!p) return;
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    be32_(p + 1, bits);
+}
+
+void CborTemplate::setU32(SlotId id, uint32_t v) {
+    uint8_t* p = at_(id, SlotType::U32);
+    if (p) be32_(p + 1, v);
+}
+
+void CborTemplate::setI32(SlotId id, int32_t v) {
+    uint8_t* p = at_(id, SlotType::I32);
+    if (!p) return;
+    // Negative n is major type 1 with argument -1 - n.
+    if (v >= 0) {
+        p[0] = 0x1A;
+        be32_(p + 1, static_cast<uint32_t>(v));
+    } else {
+        p[0] = 0x3A;
+        be32_(p + 1, static_cast<uint32_t>(-1 - static_cast<int64_t>(v)));
+    }
+}
+
+void CborTemplate::setBool(SlotId id, bool v) {
+    uint8_t* p = at_(id, SlotType::Bool);
+    if (p) p[0] = v ? 0xF5 : 0xF4;
+}
@@ -0,0 +1,100 @@
+#ifndef CBOR_TEMPLATE_HPP
+#define CBOR_TEMPLATE_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Pre-encoded CBOR map pairs with fixed-width value slots.
+ *
+ * The keys and container structure of a payload whose shape does not
+ * change between updates are encoded once. Each value is a slot of fixed
+ * width, so updating a value rewrites only its bytes, in place:
+ *   F32   0xFA + 4 bytes, float32 (holds any float exactly)
+ *   U32   0x1A + 4 bytes
+ *   I32   0x1A/0x3A + 4 bytes (major type follows the sign)
+ *   Bool  0xF4/0xF5
+ * Fixed-width integers are valid CBOR; they are just not the shortest
+ * form, which decoders do not require.
+ *
+ * The bytes are map *pairs* without the enclosing map header, so the
+ * caller can splice them into a map that also carries variable fields
+ * (optional keys, strings) encoded the normal way. Nested containers are
+ * indefinite length, like the rest of the firmware's CBOR.
+ *
+ * A template is built for a shape key (e.g. wire and sensor counts);
+ * callers rebuild it when that key changes.
+ *
+ * Host check: tools/monitor_template_bench.cpp.
+ */
+
+#ifndef CBOR_TEMPLATE_MAX_BYTES
+#define CBOR_TEMPLATE_MAX_BYTES   1024
+#endif
+#ifndef CBOR_TEMPLATE_MAX_SLOTS
+#define CBOR_TEMPLATE_MAX_SLOTS   128
+#endif
+
+class CborTemplate {
+public:
+    using SlotId = uint16_t;
+    static constexpr SlotId kNoSlot = 0xFFFF;
+
+    enum class SlotType : uint8_t { F32, U32, I32, Bool };
+
+    // ---- Building (once per shape) ----
+    void     reset(uint32_t shapeKey);
+    uint32_t shapeKey() const { return _shapeKey; }
+    bool     ready() const { return _ready; }
+
+    // Map pair with a slot value; returns kNoSlot on overflow.
+    SlotId addF32(const char* key) { return key_(key) ? slot_(SlotType::F32) : fail_(); }
+    SlotId addU32(const char* key) { return key_(key) ? slot_(SlotType::U32) : fail_(); }
+    SlotId addI32(const char* key) { return key_(key) ? slot_(SlotType::I32) : fail_(); }
+    SlotId addBool(const char* key) { return key_(key) ? slot_(SlotType::Bool) : fail_(); }
+
+    // Containers: key + indefinite array/map, closed by end().
+    bool beginArray(const char* key);
+    bool beginMap(const char* key);
+    bool end();
+
+    // Array elements (inside beginArray).
+    SlotId f32() { return slot_(SlotType::F32); }
+    SlotId u32() { return slot_(SlotType::U32); }
+    SlotId i32() { return slot_(SlotType::I32); }
+    SlotId boolean() { return slot_(SlotType::Bool); }
+
+    // Marks the template usable; false if anything overflowed or a
+    // container is still open.
+    bool finish();
+
+    // ---- Updating (every period) ----
+    void setF32(SlotId id, float v);
+    void setU32(SlotId id, uint32_t v);
+    void setI32(SlotId id, int32_t v);
+    void setBool(SlotId id, bool v);
+
+    const uint8_t* data() const { return _buf; }
+    size_t size() const { return _len; }
+    size_t slotCount() const { return _slots; }
+
+private:
+    bool   put_(uint8_t b);
+    bool   key_(const char* key);
+    SlotId slot_(SlotType type);
+    SlotId fail_() { _ok = false; return kNoSlot; }
+    uint8_t* at_(SlotId id, SlotType type);
+    void   be32_(uint8_t* p, uint32_t v);
+
+    uint8_t  _buf[CBOR_TEMPLATE_MAX_BYTES]{};
+    size_t   _len = 0;
+    uint16_t _offset[CBOR_TEMPLATE_MAX_SLOTS]{};
+    SlotType _type[CBOR_TEMPLATE_MAX_SLOTS]{};
+    size_t   _slots = 0;
+    uint8_t  _depth = 0;
+    uint32_t _shapeKey = 0;
+    bool     _ok = false;
+    bool     _ready = false;
+};
+
+#endif // CBOR_TEMPLATE_HPP
@@ -0,0 +1,181 @@
+#include <ControlTargets.hpp>
+#include <ConfigNVS.hpp>
+
+#include <cmath>
+#include <cstdlib>
+
+namespace ControlTargets {
+
+namespace {
+
+constexpr Target kTargets[] = {
+    queued("reboot",             Op::Reboot),
+    queued("systemReset",        Op::SysReset),
+    queued("ledFeedback",        Op::LedFeedback, Type::Bool),
+    queued("relay",              Op::Relay, Type::Bool),
+    queued("acFrequency",        Op::AcFreq, Type::Int),
+    queued("chargeResistor",     Op::ChargeRes, Type::Float),
+    queued("systemStart",        Op::SystemStart),
+    queued("systemWake",         Op::SystemWake),
+    queued("systemShutdown",     Op::SystemShutdown),
+    queued("fanSpeed",           Op::FanSpeed, Type::Int, Rule::Clamp, 0, 100),
+    queued("buzzerMute",         Op::BuzzerMute, Type::Bool),
+    queued("wireOhmPerM",        Op::WireOhmPerM, Type::Float),
+    queued("wireGauge",          Op::WireGauge, Type::Int),
+    queued("currLimit",          Op::CurrLimit, Type::Float),
+    queued("confirmWiresCool",   Op::ConfirmWiresCool),
+    queued("calibrate",          Op::Calibrate),
+
+    custom("adminCredentials",   Op::AdminCredentials),
+    custom("userCredentials",    Op::UserCredentials),
+    custom("wifiSSID",           Op::WifiSsid, Type::Text, STA_SSID_KEY),
+    custom("wifiPassword",       Op::WifiPassword, Type::Text, STA_PASS_KEY),
+    custom("uiLanguage",         Op::Language, Type::Text, UI_LANGUAGE_KEY),
+    custom("language",           Op::Language, Type::Text, UI_LANGUAGE_KEY),
+
+    stored("tempWarnC",          Op::Store, Type::Float, TEMP_WARN_KEY,
+           Rule::AtLeast, 0.0, kNoLimit, 0.0f),
+    stored("tempTripC",          Op::Store, Type::Float, TEMP_THRESHOLD_KEY,
+           Rule::AtLeast, 0.0, kNoLimit, DEFAULT_TEMP_THRESHOLD),
+    stored("floorThicknessMm",   Op::Store, Type::Float, FLOOR_THICKNESS_MM_KEY,
+           Rule::ZeroOrRange, FLOOR_THICKNESS_MIN_MM, FLOOR_THICKNESS_MAX_MM,
+           DEFAULT_FLOOR_THICKNESS_MM),
+    custom("floorMaterial",      Op::FloorMaterial, Type::Custom, FLOOR_MATERIAL_KEY),
+    stored("floorMaxC",          Op::Store, Type::Float, FLOOR_MAX_C_KEY,
+           Rule::AtLeast, 0.0, DEFAULT_FLOOR_MAX_C, DEFAULT_FLOOR_MAX_C),
+    stored("floorSwitchMarginC", Op::Store, Type::Float, FLOOR_SWITCH_MARGIN_C_KEY,
+           Rule::Above, 0.0, kNoLimit, DEFAULT_FLOOR_SWITCH_MARGIN_C),
+    stored("floorTau",           Op::Store, Type::Double, FLOOR_MODEL_TAU_KEY,
+           Rule::Above, 0.0, kNoLimit, DEFAULT_FLOOR_MODEL_TAU),
+    stored("floorK",             Op::Store, Type::Double, FLOOR_MODEL_K_KEY,
+           Rule::Above, 0.0, kNoLimit, DEFAULT_FLOOR_MODEL_K),
+    stored("floorC",             Op::Store, Type::Double, FLOOR_MODEL_C_KEY,
+           Rule::Above, 0.0, kNoLimit, DEFAULT_FLOOR_MODEL_C),
+    stored("nichromeFinalTempC", Op::Store, Type::Float, NICHROME_FINAL_TEMP_C_KEY,
+           Rule::AtLeast, 0.0, kNoLimit, DEFAULT_NICHROME_FINAL_TEMP_C),
+    custom("currentSource",      Op::CurrentSource, Type::Custom, CURRENT_SOURCE_KEY),
+    stored("presenceCalibrated", Op::Store, Type::Bool, CALIB_PRESENCE_DONE_KEY),
+    custom("presenceMinRatio",   Op::PresenceMinRatio, Type::Float,
+           PRESENCE_MIN_RATIO_KEY, 0),
+    custom("presenceMinRatioPct", Op::PresenceMinRatio, Type::Float,
+           PRESENCE_MIN_RATIO_KEY, 1),
+    stored("floorCalibrated",    Op::Store, Type::Bool, CALIB_FLOOR_DONE_KEY),
+
+    custom("ntcModel",           Op::NtcModel, Type::Custom, NTC_MODEL_KEY),
+    stored("ntcBeta",            Op::NtcBeta, Type::Float, NTC_BETA_KEY,
+           Rule::Above, 0.0, kNoLimit, DEFAULT_NTC_BETA),
+    stored("ntcT0C",             Op::NtcT0C, Type::Float, NTC_T0_C_KEY,
+           Rule::Finite, 0.0, kNoLimit, DEFAULT_NTC_T0_C),
+    stored("ntcR0",              Op::NtcR0, Type::Float, NTC_R0_KEY,
+           Rule::Above, 0.0, kNoLimit, DEFAULT_NTC_R0_OHMS),
+    custom("ntcShA",             Op::NtcSteinhart, Type::Float, nullptr, 0),
+    custom("ntcShB",             Op::NtcSteinhart, Type::Float, nullptr, 1),
+    custom("ntcShC",             Op::NtcSteinhart, Type::Float, nullptr, 2),
+    stored("ntcFixedRes",        Op::NtcFixedRes, Type::Float, NTC_FIXED_RES_KEY,
+           Rule::Above, 0.0, kNoLimit, DEFAULT_NTC_FIXED_RES_OHMS),
+    custom("ntcMinC",            Op::NtcLimits, Type::Float, nullptr, 0),
+    custom("ntcMaxC",            Op::NtcLimits, Type::Float, nullptr, 1),
+    stored("ntcSamples",         Op::NtcSamples, Type::Int, NTC_SAMPLES_KEY,
+           Rule::Clamp, 1, 64),
+    custom("ntcPressMv",         Op::NtcButton, Type::Float, nullptr, 0),
+    custom("ntcReleaseMv",       Op::NtcButton, Type::Float, nullptr, 1),
+    custom("ntcDebounceMs",      Op::NtcButton, Type::Int, nullptr, 2),
+    stored("ntcCalTargetC",      Op::Store, Type::Float, NTC_CAL_TARGET_C_KEY,
+           Rule::Above, 0.0, kNoLimit, DEFAULT_NTC_CAL_TARGET_C),
+    stored("ntcCalSampleMs",     Op::Store, Type::Int, NTC_CAL_SAMPLE_MS_KEY,
+           Rule::Clamp, 50, 5000),
+    stored("ntcCalTimeoutMs",    Op::Store, Type::Int, NTC_CAL_TIMEOUT_MS_KEY,
+           Rule::Clamp, 1000, 3600000),
+    stored("ntcCalibrated",      Op::Store, Type::Bool, CALIB_NTC_DONE_KEY),
+    stored("ntcGateIndex",       Op::Store, Type::Int, NTC_GATE_INDEX_KEY,
+           Rule::Clamp, 1, kWires),
+};
+
+constexpr size_t kTargetCount = sizeof(kTargets) / sizeof(kTargets[0]);
+static_assert(kTargetCount < kEmpty, "control table outgrew the 8-bit index");
+
+// Found with tools/control_dispatch_check.cpp --seed.
+#ifndef CONTROL_TARGETS_SEED
+#define CONTROL_TARGETS_SEED 1590916851u
+#endif
+
+constexpr Index kIndex = makeIndex(kTargets, kTargetCount, CONTROL_TARGETS_SEED);
+#ifndef CONTROL_TARGETS_SEED_SEARCH
+static_assert(perfect(kIndex, kTargets, kTargetCount),
+              "control target names collide; pick a new CONTROL_TARGETS_SEED");
+#endif
+
+// The per-wire families are checked before the plain targets used to be,
+// so an out-of-range index falls through to the next family (and then to
+// "unknown target"). output / Access / wireRes take any number.
+constexpr Target kFamilies[] = {
+    family("wireTau",        Op::WireTau, Type::Double, kWires,
+           Rule::Above, DEFAULT_WIRE_MODEL_TAU),
+    family("wireK",          Op::WireK, Type::Double, kWires,
+           Rule::Above, DEFAULT_WIRE_MODEL_K),
+    family("wireC",          Op::WireC, Type::Double, kWires,
+           Rule::Above, DEFAULT_WIRE_MODEL_C),
+    family("wireCalibrated", Op::WireCalibrated, Type::Bool, kWires),
+    family("output",         Op::Output, Type::Bool, 0),
+    family("Access",         Op::Access, Type::Bool, 0),
+    family("wireRes",        Op::WireRes, Type::Float, 0),
+};
+
+constexpr size_t kFamilyCount = sizeof(kFamilies) / sizeof(kFamilies[0]);
+
+} // namespace
+
+const Target* resolve(const char* name, int32_t& index) {
+    index = 0;
+    const Target* t = find(kIndex, kTargets, name);
+    if (t || !name) return t;
+
+    for (size_t i = 0; i < kFamilyCount; ++i) {
+        const Target& f = kFamilies[i];
+        const size_t n = std::strlen(f.name);
+        if (std::strncmp(name, f.name, n) != 0) continue;
+        const long v = std::atol(name + n);
+        if (f.arg && (v < 1 || v > f.arg)) continue;
+        index = static_cast<int32_t>(v);
+        return &f;
+    }
+    return nullptr;
+}
+
+const Target* targets(size_t& count) {
+    count = kTargetCount;
+    return kTargets;
+}
+
+const Target* families(size_t& count) {
+    count = kFamilyCount;
+    return kFamilies;
+}
+
+const Index& index() { return kIndex; }
+
+double normalize(const Target& t, double v) {
+    switch (t.rule) {
+        case Rule::Keep:
+            return v;
+        case Rule::Finite:
+            return std::isfinite(v) ? v : t.fallback;
+        case Rule::AtLeast:
+            if (!std::isfinite(v) || v < t.lo) return t.fallback;
+            return (v > t.hi) ? t.hi : v;
+        case Rule::Above:
+            if (!std::isfinite(v) || v <= t.lo) return t.fallback;
+            return (v > t.hi) ? t.hi : v;
+        case Rule::Clamp:
+            if (v < t.lo) return t.lo;
+            return (v > t.hi) ? t.hi : v;
+        case Rule::ZeroOrRange:
+            if (!std::isfinite(v) || v < 0.0) return t.fallback;
+            if (v == 0.0) return v;
+            if (v < t.lo) return t.lo;
+            return (v > t.hi) ? t.hi : v;
+    }
+    return v;
+}
+
+} // namespace ControlTargets
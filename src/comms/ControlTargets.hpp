@@ -0,0 +1,214 @@
+#ifndef CONTROL_TARGETS_HPP
+#define CONTROL_TARGETS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * Target table for EP_CONTROL "set".
+ *
+ * Every exact target name maps to one descriptor: how the CBOR `value`
+ * is read (type), how it is range checked (rule, lo, hi, fallback), the
+ * NVS key it lands under and the handler (op) that applies it. The
+ * route reads the value, runs normalize() and switches on op once, so
+ * adding a plain stored setting is one table line.
+ *
+ * Exact names are found through a perfect hash built at compile time:
+ * FNV-1a of the name with a fixed seed picks one of kSlots slots, the
+ * slot holds the table index, and a single strcmp confirms the match.
+ * A static_assert in ControlTargets.cpp fails the build if a new name
+ * collides; tools/control_dispatch_check.cpp --seed prints a seed that
+ * fits the table again.
+ *
+ * Indexed families ("output3", "wireTau2", ...) keep their prefix
+ * semantics and are tried, in table order, only when the exact lookup
+ * misses; no exact name starts with a family prefix.
+ *
+ * ControlTargets.cpp only needs the key and default macros from
+ * ConfigNVS.hpp.
+ */
+
+namespace ControlTargets {
+
+// How the request `value` is read; a missing value reads as 0 / false / "".
+enum class Type : uint8_t {
+    None,     // value ignored
+    Bool,     // bool, or integer != 0
+    Int,      // integer, or float rounded to nearest
+    Float,    // any number, narrowed to float
+    Double,   // any number
+    Text,     // text string
+    Custom,   // the handler reads the raw value itself
+};
+
+// Range check applied by normalize(). Comparisons against lo / hi are
+// made in the value's own type, fallbacks replace rejected values.
+enum class Rule : uint8_t {
+    Keep,         // stored as read
+    Finite,       // non-finite -> fallback
+    AtLeast,      // non-finite or < lo -> fallback, > hi -> hi
+    Above,        // non-finite or <= lo -> fallback, > hi -> hi
+    Clamp,        // clamped to [lo, hi]
+    ZeroOrRange,  // non-finite or < 0 -> fallback, 0 kept, else clamped to [lo, hi]
+};
+
+// Handler for a target. The queued ops come first and follow
+// WiFiManager::CtrlType one to one (checked in WiFiRoutes_Control.cpp).
+enum class Op : uint8_t {
+    Reboot,
+    SysReset,
+    LedFeedback,
+    Relay,
+    Output,
+    AcFreq,
+    ChargeRes,
+    Access,
+    SystemStart,
+    SystemWake,
+    SystemShutdown,
+    FanSpeed,
+    BuzzerMute,
+    WireRes,
+    WireOhmPerM,
+    WireGauge,
+    CurrLimit,
+    ConfirmWiresCool,
+    Calibrate,
+
+    Store,            // CONF->Put<type>(key, value)
+    NtcBeta,          // NTC setter when the sensor exists, else Store
+    NtcT0C,
+    NtcR0,
+    NtcFixedRes,
+    NtcSamples,
+    WireTau,          // per-wire model families (index from the name)
+    WireK,
+    WireC,
+    WireCalibrated,
+
+    AdminCredentials, // custom handlers; arg selects the field where
+    UserCredentials,  // several targets share one
+    WifiSsid,
+    WifiPassword,
+    Language,
+    FloorMaterial,
+    CurrentSource,
+    PresenceMinRatio,
+    NtcModel,
+    NtcSteinhart,
+    NtcLimits,
+    NtcButton,
+};
+
+constexpr bool isQueued(Op op) { return op <= Op::Calibrate; }
+
+// HeaterManager::kWireCount (checked in WiFiRoutes_Control.cpp).
+constexpr uint8_t kWires = 10;
+
+struct Target {
+    const char* name;   // exact name, or prefix for a family
+    Op          op;
+    Type        type;
+    Rule        rule;
+    uint8_t     arg;    // custom: field selector; family: max index (0 = any)
+    const char* key;    // NVS key written by the handler, else nullptr
+    double      lo;
+    double      hi;
+    double      fallback;
+};
+
+constexpr double kNoLimit = 1e300;
+
+constexpr Target queued(const char* name, Op op, Type type = Type::None,
+                        Rule rule = Rule::Keep, double lo = 0.0,
+                        double hi = kNoLimit) {
+    return Target{name, op, type, rule, 0, nullptr, lo, hi, 0.0};
+}
+
+constexpr Target stored(const char* name, Op op, Type type, const char* key,
+                        Rule rule = Rule::Keep, double lo = 0.0,
+                        double hi = kNoLimit, double fallback = 0.0) {
+    return Target{name, op, type, rule, 0, key, lo, hi, fallback};
+}
+
+constexpr Target custom(const char* name, Op op, Type type = Type::Custom,
+                        const char* key = nullptr, uint8_t arg = 0) {
+    return Target{name, op, type, Rule::Keep, arg, key, 0.0, kNoLimit, 0.0};
+}
+
+constexpr Target family(const char* prefix, Op op, Type type, uint8_t maxIndex,
+                        Rule rule = Rule::Keep, double fallback = 0.0) {
+    return Target{prefix, op, type, rule, maxIndex, nullptr, 0.0, kNoLimit, fallback};
+}
+
+// ---- compile-time perfect hash ----
+
+constexpr size_t  kSlots = 256;
+constexpr uint8_t kEmpty = 0xFF;
+
+constexpr uint32_t hash(const char* s, uint32_t h) {
+    return *s ? hash(s + 1, (h ^ static_cast<uint8_t>(*s)) * 16777619u) : h;
+}
+
+constexpr size_t fold(uint32_t h) { return (h ^ (h >> 16)) & (kSlots - 1); }
+
+constexpr size_t slotOf(const char* name, uint32_t seed) {
+    return fold(hash(name, seed));
+}
+
+struct Index {
+    uint32_t seed;
+    uint8_t  slot[kSlots];
+};
+
+template <size_t... I> struct Seq {};
+template <size_t N, size_t... I> struct MakeSeq : MakeSeq<N - 1, N - 1, I...> {};
+template <size_t... I> struct MakeSeq<0, I...> { typedef Seq<I...> type; };
+
+constexpr uint8_t entryFor(const Target* t, size_t n, uint32_t seed, size_t slot,
+                           size_t i = 0) {
+    return i == n ? kEmpty
+         : slotOf(t[i].name, seed) == slot ? static_cast<uint8_t>(i)
+         : entryFor(t, n, seed, slot, i + 1);
+}
+
+template <size_t... S>
+constexpr Index makeIndex(const Target* t, size_t n, uint32_t seed, Seq<S...>) {
+    return Index{seed, {entryFor(t, n, seed, S)...}};
+}
+
+constexpr Index makeIndex(const Target* t, size_t n, uint32_t seed) {
+    return makeIndex(t, n, seed, MakeSeq<kSlots>::type());
+}
+
+// True when every entry owns its slot, i.e. no two names collide.
+constexpr bool perfect(const Index& idx, const Target* t, size_t n, size_t i = 0) {
+    return i == n || (idx.slot[slotOf(t[i].name, idx.seed)] == i &&
+                      perfect(idx, t, n, i + 1));
+}
+
+inline const Target* find(const Index& idx, const Target* t, const char* name) {
+    if (!name) return nullptr;
+    const uint8_t i = idx.slot[slotOf(name, idx.seed)];
+    if (i == kEmpty || std::strcmp(t[i].name, name) != 0) return nullptr;
+    return &t[i];
+}
+
+// ---- the EP_CONTROL table (ControlTargets.cpp) ----
+
+// Exact lookup, then the families. For a family hit `index` is the number
+// after the prefix (atol semantics, like String::toInt()); a family with a
+// max index is skipped when the number is outside 1..max.
+const Target* resolve(const char* name, int32_t& index);
+
+const Target* targets(size_t& count);
+const Target* families(size_t& count);
+const Index&  index();
+
+// Applies the target's rule to a value read as its type.
+double normalize(const Target& t, double v);
+
+} // namespace ControlTargets
+
+#endif // CONTROL_TARGETS_HPP
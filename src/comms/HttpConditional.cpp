@@ -0,0 +1,140 @@
+#include <HttpConditional.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+namespace HttpConditional {
+
+namespace {
+
+const char* const kDays[7]    = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+const char* const kMonths[12] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                 "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+// Days since 1970-01-01 <-> civil date (proleptic Gregorian).
+int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+void civilFromDays(int64_t z, int64_t& y, unsigned& m, unsigned& d) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+}
+
+bool isSpace(char c) { return c == ' ' || c == '\t'; }
+
+} // namespace
+
+Validator make(const char* scope, uint32_t bootTag, uint32_t generation,
+               uint32_t modifiedEpoch) {
+    Validator v;
+    snprintf(v.etag, sizeof(v.etag), "\"%s-%08lx-%lx\"",
+             scope ? scope : "",
+             static_cast<unsigned long>(bootTag),
+             static_cast<unsigned long>(generation));
+    v.modifiedEpoch = modifiedEpoch;
+    return v;
+}
+
+bool etagListMatches(const char* header, const char* etag) {
+    if (!header || !etag || !etag[0]) return false;
+    // Our tags are quoted; compare the opaque part so unquoted client
+    // values (seen from some tools) still match.
+    const char* ours = etag;
+    size_t oursLen = strlen(etag);
+    if (oursLen >= 2 && ours[0] == '"' && ours[oursLen - 1] == '"') {
+        ++ours;
+        oursLen -= 2;
+    }
+
+    const char* p = header;
+    while (*p) {
+        while (*p == ',' || isSpace(*p)) ++p;
+        if (!*p) break;
+        if (*p == '*') return true;
+        if (p[0] == 'W' && p[1] == '/') p += 2;   // weak comparison
+
+        const char* start;
+        const char* end;
+        if (*p == '"') {
+            start = ++p;
+            while (*p && *p != '"') ++p;
+            end = p;
+            if (*p == '"') ++p;
+        } else {
+            start = p;
+            while (*p && *p != ',' && !isSpace(*p)) ++p;
+            end = p;
+        }
+        if (static_cast<size_t>(end - start) == oursLen &&
+            memcmp(start, ours, oursLen) == 0) {
+            return true;
+        }
+        while (*p && *p != ',') ++p;
+    }
+    return false;
+}
+
+bool formatHttpDate(uint32_t epoch, char* out, size_t cap) {
+    if (!out || cap < 30) return false;
+    const int64_t days = epoch / 86400;
+    const uint32_t secs = epoch % 86400;
+    int64_t y;
+    unsigned m, d;
+    civilFromDays(days, y, m, d);
+    const int n = snprintf(out, cap, "%s, %02u %s %04d %02u:%02u:%02u GMT",
+                           kDays[(days + 4) % 7], d, kMonths[m - 1], static_cast<int>(y),
+                           static_cast<unsigned>(secs / 3600),
+                           static_cast<unsigned>((secs / 60) % 60),
+                           static_cast<unsigned>(secs % 60));
+    return n > 0 && static_cast<size_t>(n) < cap;
+}
+
+bool parseHttpDate(const char* text, uint32_t& epoch) {
+    if (!text) return false;
+    char wday[4] = {0};
+    char mon[4] = {0};
+    unsigned d = 0, hh = 0, mm = 0, ss = 0;
+    int y = 0;
+    if (sscanf(text, "%3s, %u %3s %d %u:%u:%u", wday, &d, mon, &y, &hh, &mm, &ss) != 7) {
+        return false;
+    }
+    unsigned m = 0;
+    for (unsigned k = 0; k < 12; ++k) {
+        if (strcmp(mon, kMonths[k]) == 0) {
+            m = k + 1;
+            break;
+        }
+    }
+    if (m == 0 || d < 1 || d > 31 || y < 1970 || hh > 23 || mm > 59 || ss > 60) return false;
+    const int64_t t = daysFromCivil(y, m, d) * 86400 + hh * 3600 + mm * 60 + ss;
+    if (t < 0 || t > 0xFFFFFFFFLL) return false;
+    epoch = static_cast<uint32_t>(t);
+    return true;
+}
+
+bool notModified(const char* ifNoneMatch, const char* ifModifiedSince,
+                 const Validator& v) {
+    if (ifNoneMatch) {
+        return etagListMatches(ifNoneMatch, v.etag);
+    }
+    if (ifModifiedSince && v.modifiedEpoch) {
+        uint32_t since = 0;
+        return parseHttpDate(ifModifiedSince, since) && v.modifiedEpoch <= since;
+    }
+    return false;
+}
+
+} // namespace HttpConditional
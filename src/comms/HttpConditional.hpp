@@ -0,0 +1,66 @@
+#ifndef HTTP_CONDITIONAL_HPP
+#define HTTP_CONDITIONAL_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Conditional GET for responses derived from an in-RAM generation counter
+ * (PowerTracker history, CalibrationRecorder files).
+ *
+ * Validator:
+ *   ETag           "<scope>-<boot>-<generation>" (hex). The boot tag is
+ *                  random per power-up, so a counter that restarts at 0
+ *                  after a reboot never repeats an old tag.
+ *   Last-Modified  epoch of the last change, when the RTC knew the time.
+ *
+ * notModified() follows RFC 9110 13.1/13.2: If-None-Match (weak
+ * comparison, lists, "*") decides when present; If-Modified-Since is only
+ * looked at without it. A hit means the handler sends 304 with the
+ * validator headers and returns before reading flash or encoding.
+ *
+ * The request-side template works on anything with the AsyncWebServer
+ * header API (hasHeader / getHeader()->value().c_str()).
+ */
+
+namespace HttpConditional {
+
+constexpr size_t kETagMax = 40;
+constexpr size_t kDateMax = 32;   // "Sun, 06 Nov 1994 08:49:37 GMT"
+
+struct Validator {
+    char     etag[kETagMax] = {0};
+    uint32_t modifiedEpoch = 0;   // 0: no Last-Modified
+};
+
+Validator make(const char* scope, uint32_t bootTag, uint32_t generation,
+               uint32_t modifiedEpoch);
+
+// If-None-Match value against one of our (strong) tags.
+bool etagListMatches(const char* header, const char* etag);
+
+// IMF-fixdate, the only form HTTP senders must produce.
+bool formatHttpDate(uint32_t epoch, char* out, size_t cap);
+bool parseHttpDate(const char* text, uint32_t& epoch);
+
+// nullptr for an absent header.
+bool notModified(const char* ifNoneMatch, const char* ifModifiedSince,
+                 const Validator& v);
+
+template <typename Request>
+bool notModified(Request* request, const Validator& v) {
+    if (!request) return false;
+    const char* inm = nullptr;
+    const char* ims = nullptr;
+    if (request->hasHeader("If-None-Match")) {
+        inm = request->getHeader("If-None-Match")->value().c_str();
+    }
+    if (request->hasHeader("If-Modified-Since")) {
+        ims = request->getHeader("If-Modified-Since")->value().c_str();
+    }
+    return notModified(inm, ims, v);
+}
+
+} // namespace HttpConditional
+
+#endif // HTTP_CONDITIONAL_HPP
@@ -0,0 +1,59 @@
+#include <LiveColumnar.hpp>
+
+#include <cmath>
+
+namespace LiveColumnar {
+
+int32_t quantize(double value, int32_t scale) {
+    if (!std::isfinite(value)) return 0;
+    const double q = std::round(value * scale);
+    if (q > 2147483647.0) return 2147483647;
+    if (q < -2147483648.0) return -2147483647 - 1;
+    return static_cast<int32_t>(q);
+}
+
+bool ColumnEncoder::add(int32_t value) {
+    if (!_ok) return false;
+    // Wrapping delta; the decoder wraps back the same way.
+    const int32_t delta = static_cast<int32_t>(
+        static_cast<uint32_t>(value) - static_cast<uint32_t>(_prev));
+    uint32_t u = zigzag(delta);
+    do {
+        if (_len >= _cap) {
+            _ok = false;
+            return false;
+        }
+        uint8_t b = static_cast<uint8_t>(u & 0x7Fu);
+        u >>= 7;
+        if (u) b |= 0x80u;
+        _buf[_len++] = b;
+    } while (u);
+    _prev = value;
+    return true;
+}
+
+int decodeColumn(const uint8_t* data, size_t len, int32_t base,
+                 int32_t* out, size_t maxOut) {
+    if (!data && len > 0) return -1;
+    size_t pos = 0;
+    size_t n = 0;
+    int32_t prev = base;
+    while (pos < len) {
+        uint32_t u = 0;
+        unsigned shift = 0;
+        for (;;) {
+            if (pos >= len || shift >= 7 * kMaxVarint) return -1;
+            const uint8_t b = data[pos++];
+            u |= static_cast<uint32_t>(b & 0x7Fu) << shift;
+            shift += 7;
+            if (!(b & 0x80u)) break;
+        }
+        if (n >= maxOut) return -1;
+        prev = static_cast<int32_t>(static_cast<uint32_t>(prev) +
+                                    static_cast<uint32_t>(unzigzag(u)));
+        out[n++] = prev;
+    }
+    return static_cast<int>(n);
+}
+
+} // namespace LiveColumnar
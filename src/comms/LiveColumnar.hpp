@@ -0,0 +1,84 @@
+#ifndef LIVE_COLUMNAR_HPP
+#define LIVE_COLUMNAR_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Columnar live batch format ("fmt": "col"), opt-in next to the row
+ * format where every sample is its own CBOR map.
+ *
+ * Batch map:
+ *   fmt       "col"
+ *   n         samples in the batch
+ *   seqStart, seqEnd, stride?   as in the row format (seq of sample k is
+ *                               seqStart + k * stride)
+ *   t0        timestamp of the first sample [ms]
+ *   dt        mean sample period [ms]; the "ts" column holds the jitter
+ *             ts[k] - (t0 + k * dt), so its deltas stay within one byte
+ *   cols      field names, e.g. ["ts","capV","i","mask",...,"wt10"]
+ *   scale     per column: value = integer / scale
+ *   data      per column one byte string: n zig-zag varints, each the
+ *             delta from the previous integer (the first from 0)
+ *
+ * Slowly moving values (temperatures, flags, timestamps at a fixed
+ * period) delta to 0 or a constant and pack into one byte per sample.
+ * The encoder and the reference decoder below are all a client needs
+ * beyond a CBOR parser.
+ */
+
+namespace LiveColumnar {
+
+constexpr const char* kFormat = "col";
+constexpr size_t kMaxVarint = 5;   // uint32
+
+inline uint32_t zigzag(int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+inline int32_t unzigzag(uint32_t u) {
+    return static_cast<int32_t>(u >> 1) ^ -static_cast<int32_t>(u & 1u);
+}
+
+// Scaled integer, rounded and clamped to int32.
+int32_t quantize(double value, int32_t scale);
+
+// Mean period of n timestamps from t0 to tLast (0 for n < 2).
+inline uint32_t meanPeriod(uint32_t t0, uint32_t tLast, size_t n) {
+    return n < 2 ? 0 : static_cast<uint32_t>(((tLast - t0) + (n - 1) / 2) / (n - 1));
+}
+
+// "ts" column value of sample k and its inverse.
+inline int32_t tsResidual(uint32_t ts, uint32_t t0, uint32_t dt, size_t k) {
+    return static_cast<int32_t>(ts - t0 - static_cast<uint32_t>(k) * dt);
+}
+inline uint32_t tsFromResidual(int32_t r, uint32_t t0, uint32_t dt, size_t k) {
+    return t0 + static_cast<uint32_t>(k) * dt + static_cast<uint32_t>(r);
+}
+
+// Appends one column of deltas into a caller buffer.
+class ColumnEncoder {
+public:
+    ColumnEncoder(uint8_t* buf, size_t cap, int32_t base = 0)
+        : _buf(buf), _cap(cap), _prev(base) {}
+
+    bool add(int32_t value);
+    size_t size() const { return _len; }
+    bool ok() const { return _ok; }
+
+private:
+    uint8_t* _buf;
+    size_t   _cap;
+    size_t   _len = 0;
+    int32_t  _prev;
+    bool     _ok = true;
+};
+
+// Reference decoder for one data column. Returns the number of values
+// written to out, or -1 if the column is malformed or longer than maxOut.
+int decodeColumn(const uint8_t* data, size_t len, int32_t base,
+                 int32_t* out, size_t maxOut);
+
+} // namespace LiveColumnar
+
+#endif // LIVE_COLUMNAR_HPP
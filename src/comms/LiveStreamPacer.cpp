@@ -0,0 +1,45 @@
+#include <LiveStreamPacer.hpp>
+
+LiveStreamPacer::Plan LiveStreamPacer::plan(const Config& cfg, uint32_t lastSeq,
+                                            uint32_t oldestSeq, uint32_t newestSeq,
+                                            size_t freeBytes, bool queueFull) {
+    Plan p;
+    if (newestSeq == 0 || lastSeq == newestSeq) return p;
+
+    // New client, a sequence from before a reboot, or a gap the ring no
+    // longer covers: start over from a snapshot.
+    if (lastSeq == 0 || lastSeq > newestSeq || lastSeq + 1 < oldestSeq) {
+        p.action = Action::Resync;
+        p.since = newestSeq;
+        return p;
+    }
+
+    if (queueFull || freeBytes <= cfg.overheadBytes || cfg.sampleBytes == 0) {
+        p.action = Action::Wait;
+        return p;
+    }
+    size_t budget = (freeBytes - cfg.overheadBytes) / cfg.sampleBytes;
+    if (budget > cfg.maxBatch) budget = cfg.maxBatch;
+    if (budget == 0) {
+        p.action = Action::Wait;
+        return p;
+    }
+
+    const uint32_t pending = newestSeq - lastSeq;
+    uint32_t stride = 1;
+    if (pending > budget) {
+        stride = static_cast<uint32_t>((pending + budget - 1) / budget);
+        if (stride > 255) stride = 255;
+    }
+    p.action = Action::Send;
+    p.since = lastSeq;
+    p.stride = static_cast<uint8_t>(stride);
+    p.count = static_cast<uint16_t>((pending - 1) / stride + 1);
+    return p;
+}
+
+bool LiveStreamPacer::selects(const Plan& p, uint32_t seq, uint32_t newestSeq) {
+    if (p.action != Action::Send) return false;
+    if (seq <= p.since || seq > newestSeq) return false;
+    return p.stride <= 1 || ((newestSeq - seq) % p.stride) == 0;
+}
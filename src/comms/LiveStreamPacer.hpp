@@ -0,0 +1,59 @@
+#ifndef LIVE_STREAM_PACER_HPP
+#define LIVE_STREAM_PACER_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Per-client pacing of the live monitor ring (WiFiManager::_liveBuf).
+ *
+ * Each push round, every live subscriber gets a plan from its last
+ * delivered sequence, the ring's [oldest, newest] window and the free
+ * space in its TCP send buffer:
+ *   - None:   nothing new.
+ *   - Resync: the client is new (no since) or fell out of the ring; send
+ *             a /monitor snapshot and continue from newest.
+ *   - Wait:   send queue full or no room for one sample; the samples stay
+ *             in the ring and the client catches up later (or resyncs).
+ *   - Send:   the pending samples, as many as fit (up to maxBatch). When
+ *             they do not all fit, every stride-th sample ending at newest
+ *             is sent, so a slow client gets a decimated but current view
+ *             instead of stalling the publisher.
+ */
+
+#ifndef LIVE_STREAM_MAX_BATCH
+#define LIVE_STREAM_MAX_BATCH       16     // samples per frame
+#endif
+#ifndef LIVE_STREAM_SAMPLE_BYTES
+#define LIVE_STREAM_SAMPLE_BYTES    120    // CBOR per sample (10 wires), rounded up
+#endif
+#ifndef LIVE_STREAM_FRAME_OVERHEAD
+#define LIVE_STREAM_FRAME_OVERHEAD  48     // ws + telemetry header + batch map
+#endif
+
+class LiveStreamPacer {
+public:
+    enum class Action : uint8_t { None, Wait, Resync, Send };
+
+    struct Config {
+        uint16_t maxBatch = LIVE_STREAM_MAX_BATCH;
+        uint16_t sampleBytes = LIVE_STREAM_SAMPLE_BYTES;
+        uint16_t overheadBytes = LIVE_STREAM_FRAME_OVERHEAD;
+    };
+
+    struct Plan {
+        Action   action = Action::None;
+        uint32_t since = 0;      // send samples with seq > since ...
+        uint8_t  stride = 1;     // ... where (newest - seq) % stride == 0
+        uint16_t count = 0;      // samples that selects
+    };
+
+    // oldestSeq/newestSeq: ring window (newestSeq == 0 = empty ring).
+    static Plan plan(const Config& cfg, uint32_t lastSeq, uint32_t oldestSeq,
+                     uint32_t newestSeq, size_t freeBytes, bool queueFull);
+
+    // True if seq is part of plan p against a ring ending at newestSeq.
+    static bool selects(const Plan& p, uint32_t seq, uint32_t newestSeq);
+};
+
+#endif // LIVE_STREAM_PACER_HPP
@@ -0,0 +1,96 @@
+#include <PageCursor.hpp>
+
+namespace PageCursor {
+
+namespace {
+
+constexpr size_t kFieldBytes = 17;
+
+void putU32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v >> 24);
+    p[1] = static_cast<uint8_t>(v >> 16);
+    p[2] = static_cast<uint8_t>(v >> 8);
+    p[3] = static_cast<uint8_t>(v);
+}
+
+uint32_t getU32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+// FNV-1a folded to 16 bits.
+uint16_t checksum(const uint8_t* p, size_t n) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return static_cast<uint16_t>((h >> 16) ^ h);
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+} // namespace
+
+bool format(const Token& t, char* out, size_t cap) {
+    if (!out || cap < kTextMax) return false;
+    uint8_t raw[kFieldBytes + 2];
+    raw[0] = static_cast<uint8_t>(t.source);
+    putU32(raw + 1, t.boot);
+    putU32(raw + 5, t.dataset);
+    putU32(raw + 9, t.pos);
+    putU32(raw + 13, t.floor);
+    const uint16_t c = checksum(raw, kFieldBytes);
+    raw[kFieldBytes]     = static_cast<uint8_t>(c >> 8);
+    raw[kFieldBytes + 1] = static_cast<uint8_t>(c);
+
+    static const char kHex[] = "0123456789abcdef";
+    for (size_t i = 0; i < sizeof(raw); ++i) {
+        out[2 * i]     = kHex[raw[i] >> 4];
+        out[2 * i + 1] = kHex[raw[i] & 0x0F];
+    }
+    out[kTextLen] = '\0';
+    return true;
+}
+
+bool parse(const char* text, Token& out) {
+    if (!text) return false;
+    uint8_t raw[kFieldBytes + 2];
+    for (size_t i = 0; i < sizeof(raw); ++i) {
+        const int hi = hexValue(text[2 * i]);
+        if (hi < 0) return false;
+        const int lo = hexValue(text[2 * i + 1]);
+        if (lo < 0) return false;
+        raw[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    if (text[kTextLen] != '\0') return false;
+
+    const uint16_t c = checksum(raw, kFieldBytes);
+    if (raw[kFieldBytes] != static_cast<uint8_t>(c >> 8) ||
+        raw[kFieldBytes + 1] != static_cast<uint8_t>(c)) {
+        return false;
+    }
+    if (raw[0] != static_cast<uint8_t>(Source::History) &&
+        raw[0] != static_cast<uint8_t>(Source::Calib)) {
+        return false;
+    }
+    out.source  = static_cast<Source>(raw[0]);
+    out.boot    = getU32(raw + 1);
+    out.dataset = getU32(raw + 5);
+    out.pos     = getU32(raw + 9);
+    out.floor   = getU32(raw + 13);
+    return true;
+}
+
+Check check(const char* text, Source source, uint32_t boot, uint32_t dataset,
+            Token& out) {
+    if (!parse(text, out) || out.source != source) return Check::Invalid;
+    if (out.boot != boot || out.dataset != dataset) return Check::Expired;
+    return Check::Ok;
+}
+
+} // namespace PageCursor
@@ -0,0 +1,86 @@
+#ifndef PAGE_CURSOR_HPP
+#define PAGE_CURSOR_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Opaque "next" cursor for paged list routes (/session_history,
+ * /calib_data).
+ *
+ * A cursor names a position in an append-only sequence, not an offset
+ * into the current list, so entries appended while a client pages never
+ * shift what the next page returns:
+ *   source    which route issued it (a history cursor is not a calib one)
+ *   boot      WiFiCbor::bootTag() at issue; positions do not survive a reboot
+ *   dataset   history: bumped on clear / load; calib: recorder run id
+ *   pos       history: walk continues below this append sequence
+ *             calib:   sample index of the next (newer) sample
+ *   floor     history: oldest sequence stored when the walk began; the
+ *             walk covers [floor, pos), so entries the ring overwrote in
+ *             that range are reported as a gap instead of vanishing
+ *             calib:   0 (samples are never dropped)
+ *
+ * Text form: 38 lowercase hex digits, the 17 field bytes followed by a
+ * 16-bit check over them. The check catches truncated or hand-edited
+ * cursors; it is not a signature (the routes are authenticated anyway).
+ */
+
+namespace PageCursor {
+
+enum class Source : uint8_t { History = 1, Calib = 2 };
+
+struct Token {
+    Source   source  = Source::History;
+    uint32_t boot    = 0;
+    uint32_t dataset = 0;
+    uint32_t pos     = 0;
+    uint32_t floor   = 0;
+};
+
+constexpr size_t kTextLen = 38;
+constexpr size_t kTextMax = kTextLen + 1;
+
+// Writes the text form (NUL-terminated); false if cap < kTextMax.
+bool format(const Token& t, char* out, size_t cap);
+
+// False for anything format() would not have produced.
+bool parse(const char* text, Token& out);
+
+enum class Check : uint8_t { Ok, Invalid, Expired };
+
+// Invalid: malformed or issued by another route (HTTP 400).
+// Expired: valid, but the device rebooted or the data set was replaced
+// since; the client restarts from the first page (HTTP 410).
+Check check(const char* text, Source source, uint32_t boot, uint32_t dataset,
+            Token& out);
+
+// Newest-first walk over [floor, pos) of a ring whose oldest stored
+// sequence is `oldest`. next() yields pos - 1, pos - 2, ... and stops at
+// the floor; when the ring has dropped part of the range it sets gap and
+// raises the floor to what is still stored.
+struct DescendingWalk {
+    uint32_t pos   = 0;
+    uint32_t floor = 0;
+    bool     gap   = false;
+
+    bool next(uint32_t oldest, uint32_t& seq) {
+        if (pos <= floor) return false;
+        if (oldest > floor) {
+            gap = true;
+            floor = oldest;
+            if (pos <= floor) return false;
+        }
+        seq = --pos;
+        return true;
+    }
+
+    // True while the range holds entries not yet walked.
+    bool more(uint32_t oldest) const {
+        return pos > ((oldest > floor) ? oldest : floor);
+    }
+};
+
+} // namespace PageCursor
+
+#endif // PAGE_CURSOR_HPP
@@ -0,0 +1,134 @@
+#include <TelemetryChannel.hpp>
+
+namespace TelemetryFrame {
+
+void writeHeader(uint8_t* out, TelemetryChannel ch, uint32_t seq) {
+    if (!out) return;
+    out[0] = kVersion;
+    out[1] = static_cast<uint8_t>(ch);
+    out[2] = static_cast<uint8_t>(seq & 0xFFu);
+    out[3] = static_cast<uint8_t>((seq >> 8) & 0xFFu);
+    out[4] = static_cast<uint8_t>((seq >> 16) & 0xFFu);
+    out[5] = static_cast<uint8_t>((seq >> 24) & 0xFFu);
+}
+
+bool parseHeader(const uint8_t* data, size_t len, TelemetryChannel& ch, uint32_t& seq) {
+    if (!data || len < kHeaderLen) return false;
+    if (data[0] != kVersion) return false;
+    if (data[1] >= static_cast<uint8_t>(TelemetryChannel::Count)) return false;
+    ch = static_cast<TelemetryChannel>(data[1]);
+    seq = static_cast<uint32_t>(data[2]) |
+          (static_cast<uint32_t>(data[3]) << 8) |
+          (static_cast<uint32_t>(data[4]) << 16) |
+          (static_cast<uint32_t>(data[5]) << 24);
+    return true;
+}
+
+} // namespace TelemetryFrame
+
+TelemetrySubscribers::Client* TelemetrySubscribers::slot(uint32_t id) {
+    if (id == 0) return nullptr;
+    for (Client& c : _clients) {
+        if (c.id == id) return &c;
+    }
+    return nullptr;
+}
+
+const TelemetrySubscribers::Client* TelemetrySubscribers::find(uint32_t id) const {
+    if (id == 0) return nullptr;
+    for (const Client& c : _clients) {
+        if (c.id == id) return &c;
+    }
+    return nullptr;
+}
+
+bool TelemetrySubscribers::add(uint32_t id, uint8_t mask) {
+    if (id == 0) return false;
+    Client* c = slot(id);
+    if (!c) {
+        for (Client& f : _clients) {
+            if (f.id == 0) {
+                c = &f;
+                break;
+            }
+        }
+    }
+    if (!c) return false;
+    *c = Client{};
+    c->id = id;
+    c->mask = mask;
+    return true;
+}
+
+void TelemetrySubscribers::remove(uint32_t id) {
+    Client* c = slot(id);
+    if (c) *c = Client{};
+}
+
+bool TelemetrySubscribers::setMask(uint32_t id, uint8_t mask) {
+    Client* c = slot(id);
+    if (!c) return false;
+    c->mask = mask;
+    return true;
+}
+
+bool TelemetrySubscribers::setFlags(uint32_t id, uint8_t flags) {
+    Client* c = slot(id);
+    if (!c) return false;
+    c->flags = flags;
+    return true;
+}
+
+uint8_t TelemetrySubscribers::flags(uint32_t id) const {
+    const Client* c = find(id);
+    return c ? c->flags : 0;
+}
+
+size_t TelemetrySubscribers::subscribers(TelemetryChannel ch, uint32_t* out,
+                                         size_t maxOut) const {
+    const uint8_t b = TelemetryFrame::bit(ch);
+    size_t n = 0;
+    for (const Client& c : _clients) {
+        if (c.id == 0 || !(c.mask & b)) continue;
+        if (out && n < maxOut) out[n] = c.id;
+        ++n;
+    }
+    return (out && n > maxOut) ? maxOut : n;
+}
+
+bool TelemetrySubscribers::any(TelemetryChannel ch) const {
+    return subscribers(ch, nullptr, 0) > 0;
+}
+
+void TelemetrySubscribers::delivered(uint32_t id, TelemetryChannel ch, uint32_t seq) {
+    Client* c = slot(id);
+    if (!c) return;
+    const size_t idx = static_cast<size_t>(ch);
+    if (idx < kChannels) c->lastSeq[idx] = seq;
+    c->sent++;
+}
+
+void TelemetrySubscribers::dropped(uint32_t id) {
+    Client* c = slot(id);
+    if (c) c->dropped++;
+}
+
+void TelemetrySubscribers::resume(uint32_t id, TelemetryChannel ch, uint32_t seq) {
+    Client* c = slot(id);
+    const size_t idx = static_cast<size_t>(ch);
+    if (c && idx < kChannels) c->lastSeq[idx] = seq;
+}
+
+uint32_t TelemetrySubscribers::lastSeq(uint32_t id, TelemetryChannel ch) const {
+    const Client* c = find(id);
+    const size_t idx = static_cast<size_t>(ch);
+    return (c && idx < kChannels) ? c->lastSeq[idx] : 0;
+}
+
+size_t TelemetrySubscribers::count() const {
+    size_t n = 0;
+    for (const Client& c : _clients) {
+        if (c.id != 0) ++n;
+    }
+    return n;
+}
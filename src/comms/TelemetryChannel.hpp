@@ -0,0 +1,102 @@
+#ifndef TELEMETRY_CHANNEL_HPP
+#define TELEMETRY_CHANNEL_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Binary telemetry framing for the WebSocket endpoint (EP_TELEMETRY_WS).
+ *
+ * Every WebSocket binary message is one frame:
+ *   [0]    version (kVersion)
+ *   [1]    channel (TelemetryChannel)
+ *   [2..5] sequence, little endian (the channel's own counter: state seq,
+ *          event seq, monitor snapshot seq, last live sample in the batch)
+ *   [6..]  raw CBOR payload, the same map the SSE route base64-encodes
+ *
+ * Client -> device frames use channel Control with a CBOR map
+ * {"sub": mask, "since": seq, "fmt": "col"|"row"} (bit n = channel n;
+ * since resumes the live channel after a reconnect, fmt picks the live
+ * batch format). TelemetrySubscribers keeps per-client
+ * masks and the last sequence delivered on each channel; a frame skipped
+ * for a full send queue only shows up as a sequence gap on that client.
+ */
+
+#ifndef TELEMETRY_WS_MAX_CLIENTS
+#define TELEMETRY_WS_MAX_CLIENTS    4
+#endif
+
+enum class TelemetryChannel : uint8_t {
+    Control = 0,
+    State   = 1,
+    Event   = 2,
+    Monitor = 3,
+    Live    = 4,
+    Count
+};
+
+namespace TelemetryFrame {
+
+constexpr uint8_t kVersion   = 1;
+constexpr size_t  kHeaderLen = 6;
+
+constexpr uint8_t bit(TelemetryChannel ch) {
+    return static_cast<uint8_t>(1u << static_cast<uint8_t>(ch));
+}
+
+// Default subscription of a new client (what the SSE routes carry).
+constexpr uint8_t kDefaultMask =
+    static_cast<uint8_t>(bit(TelemetryChannel::State) | bit(TelemetryChannel::Event));
+
+// Writes the header to out (>= kHeaderLen bytes).
+void writeHeader(uint8_t* out, TelemetryChannel ch, uint32_t seq);
+
+// False if too short, wrong version or unknown channel.
+bool parseHeader(const uint8_t* data, size_t len, TelemetryChannel& ch, uint32_t& seq);
+
+} // namespace TelemetryFrame
+
+class TelemetrySubscribers {
+public:
+    static constexpr size_t kMaxClients = TELEMETRY_WS_MAX_CLIENTS;
+    static constexpr size_t kChannels = static_cast<size_t>(TelemetryChannel::Count);
+
+    // Per-client options set from the control frame.
+    static constexpr uint8_t kFlagColumnar = 0x01;   // live batches as "fmt":"col"
+
+    struct Client {
+        uint32_t id = 0;                 // 0 = free slot
+        uint8_t  mask = 0;
+        uint8_t  flags = 0;
+        uint32_t lastSeq[kChannels] = {0};
+        uint32_t sent = 0;
+        uint32_t dropped = 0;
+    };
+
+    // False when the table is full (the caller closes the connection).
+    bool add(uint32_t id, uint8_t mask = TelemetryFrame::kDefaultMask);
+    void remove(uint32_t id);
+    bool setMask(uint32_t id, uint8_t mask);
+    bool setFlags(uint32_t id, uint8_t flags);
+    uint8_t flags(uint32_t id) const;
+
+    // Ids subscribed to ch, written to out; returns the count.
+    size_t subscribers(TelemetryChannel ch, uint32_t* out, size_t maxOut) const;
+    bool any(TelemetryChannel ch) const;
+
+    void delivered(uint32_t id, TelemetryChannel ch, uint32_t seq);
+    void dropped(uint32_t id);
+    // Position on ch without counting a send (resume, resync).
+    void resume(uint32_t id, TelemetryChannel ch, uint32_t seq);
+    uint32_t lastSeq(uint32_t id, TelemetryChannel ch) const;
+
+    const Client* find(uint32_t id) const;
+    size_t count() const;
+
+private:
+    Client* slot(uint32_t id);
+
+    Client _clients[kMaxClients]{};
+};
+
+#endif // TELEMETRY_CHANNEL_HPP
@@ -6,9 +6,14 @@
 #include <cbor.h>
 #include <math.h>
 #include <vector>
+#include <memory>
+#include <string.h>
 
 #include <WifiEnpoin.hpp>
 #include <WiFiLocalization.hpp>
+#include <CborChunkStream.hpp>
+#include <CborNumber.hpp>
+#include <HttpConditional.hpp>
 
 namespace WiFiCbor {
 
@@ -36,21 +41,38 @@ inline bool encodeKvInt(CborEncoder* map, const char* key, int64_t value) {
     return encodeText(map, key) && cbor_encode_int(map, value) == CborNoError;
 }
 
-inline bool encodeKvFloat(CborEncoder* map, const char* key, double value) {
-    return encodeText(map, key) && cbor_encode_double(map, value) == CborNoError;
+// Shortest form within res (int / float16 / float32 / float64); the
+// default keeps the value exact.
+inline bool encodeNumber(CborEncoder* enc, double value,
+                         CborNumber::Resolution res = CborNumber::kExact) {
+    const CborNumber::Choice c = CborNumber::choose(value, res);
+    switch (c.form) {
+        case CborNumber::Form::Int:    return cbor_encode_int(enc, c.i) == CborNoError;
+        case CborNumber::Form::Half:   return cbor_encode_half_float(enc, &c.half) == CborNoError;
+        case CborNumber::Form::Single: return cbor_encode_float(enc, c.f) == CborNoError;
+        default:                       return cbor_encode_double(enc, value) == CborNoError;
+    }
+}
+
+inline bool encodeKvFloat(CborEncoder* map, const char* key, double value,
+                          CborNumber::Resolution res = CborNumber::kExact) {
+    return encodeText(map, key) && encodeNumber(map, value, res);
 }
 
-inline bool encodeKvFloatIfFinite(CborEncoder* map, const char* key, double value) {
+inline bool encodeKvFloatIfFinite(CborEncoder* map, const char* key, double value,
+                                  CborNumber::Resolution res = CborNumber::kExact) {
     if (!isfinite(value)) return true;
-    return encodeKvFloat(map, key, value);
+    return encodeKvFloat(map, key, value, res);
 }
 
+// Encodes one map into a caller-owned buffer (no allocation).
 template <typename BuildFn>
-bool buildMapPayload(std::vector<uint8_t>& out, size_t capacity, BuildFn&& build) {
-    out.assign(capacity, 0);
+bool buildMapInto(uint8_t* buf, size_t capacity, size_t& size, BuildFn&& build) {
+    size = 0;
+    if (!buf || capacity == 0) return false;
     CborEncoder root;
     CborEncoder map;
-    cbor_encoder_init(&root, out.data(), out.size(), 0);
+    cbor_encoder_init(&root, buf, capacity, 0);
     if (cbor_encoder_create_map(&root, &map, CborIndefiniteLength) != CborNoError) {
         return false;
     }
@@ -60,25 +82,201 @@ bool buildMapPayload(std::vector<uint8_t>& out, size_t capacity, BuildFn&& build
     if (cbor_encoder_close_container(&root, &map) != CborNoError) {
         return false;
     }
-    const size_t size = cbor_encoder_get_buffer_size(&root, out.data());
+    size = cbor_encoder_get_buffer_size(&root, buf);
+    return true;
+}
+
+template <typename BuildFn>
+bool buildMapPayload(std::vector<uint8_t>& out, size_t capacity, BuildFn&& build) {
+    out.assign(capacity, 0);
+    size_t size = 0;
+    if (!buildMapInto(out.data(), out.size(), size, build)) {
+        return false;
+    }
     out.resize(size);
     return true;
 }
 
+// ---- Chunked responses (CborChunkStream) ----
+enum class RowStep : uint8_t { Row, Skip, End, Error };
+
+// Streams {<head keys>, <array key>: [row, ...], <tail keys>}. head(map)
+// writes the leading pairs and the array key; nextRow(map) writes one row
+// map per call from its own cursor, Skip drops the row, End closes the
+// array. tail(map) then adds pairs only known after the rows (e.g. a
+// paging cursor); it runs once, after the last nextRow().
+template <typename HeadFn, typename RowFn, typename TailFn>
+std::shared_ptr<CborChunkStream> makeArrayStream(HeadFn head, RowFn nextRow, TailFn tail) {
+    uint8_t stage = 0;
+    return std::make_shared<CborChunkStream>(
+        [head, nextRow, tail, stage](uint8_t* buf, size_t cap, size_t& len) mutable {
+            using Step = CborChunkStream::Step;
+            len = 0;
+            if (stage == 0) {
+                // Both containers stay open: the head ends at the array
+                // header and the rows follow it byte for byte.
+                CborEncoder root;
+                CborEncoder map;
+                CborEncoder arr;
+                cbor_encoder_init(&root, buf, cap, 0);
+                if (cbor_encoder_create_map(&root, &map, CborIndefiniteLength) != CborNoError ||
+                    !head(&map) ||
+                    cbor_encoder_create_array(&map, &arr, CborIndefiniteLength) != CborNoError) {
+                    return Step::Error;
+                }
+                len = cbor_encoder_get_buffer_size(&arr, buf);
+                stage = 1;
+                return Step::Piece;
+            }
+            while (stage == 1) {
+                RowStep r = RowStep::End;
+                const bool ok = buildMapInto(buf, cap, len, [&](CborEncoder* row) {
+                    r = nextRow(row);
+                    return r != RowStep::Error;
+                });
+                if (!ok || r == RowStep::Error) return Step::Error;
+                if (r == RowStep::Row) return Step::Piece;
+                len = 0;
+                if (r == RowStep::End) stage = 2;
+            }
+            if (stage == 2) {
+                // Array break, the tail pairs as bare items, map break.
+                len = CborChunkStream::writeBreaks(buf, cap, 1);
+                if (len == 0) return Step::Error;
+                CborEncoder pairs;
+                cbor_encoder_init(&pairs, buf + len, cap - len, 0);
+                if (!tail(&pairs)) return Step::Error;
+                len += cbor_encoder_get_buffer_size(&pairs, buf + len);
+                const size_t brk = CborChunkStream::writeBreaks(buf + len, cap - len, 1);
+                if (brk == 0) return Step::Error;
+                len += brk;
+                stage = 3;
+                return Step::Piece;
+            }
+            return Step::Done;
+        });
+}
+
+template <typename HeadFn, typename RowFn>
+std::shared_ptr<CborChunkStream> makeArrayStream(HeadFn head, RowFn nextRow) {
+    return makeArrayStream(head, nextRow, [](CborEncoder*) { return true; });
+}
+
+// ---- Conditional GET (see HttpConditional.hpp) ----
+
+// Random per power-up, so ETags from before a reboot never match.
+inline uint32_t bootTag() {
+    static const uint32_t tag = esp_random();
+    return tag;
+}
+
+inline HttpConditional::Validator makeValidator(const char* scope,
+                                                uint32_t generation,
+                                                uint32_t modifiedEpoch) {
+    return HttpConditional::make(scope, bootTag(), generation, modifiedEpoch);
+}
+
+// ETag / Last-Modified, and "revalidate every time" unless the route set
+// its own Cache-Control.
+inline void addValidatorHeaders(AsyncWebServerResponse* response,
+                                const HttpConditional::Validator* v,
+                                bool hasCacheControl) {
+    if (!response || !v) return;
+    response->addHeader("ETag", v->etag);
+    if (v->modifiedEpoch) {
+        char date[HttpConditional::kDateMax];
+        if (HttpConditional::formatHttpDate(v->modifiedEpoch, date, sizeof(date))) {
+            response->addHeader("Last-Modified", date);
+        }
+    }
+    if (!hasCacheControl) {
+        response->addHeader("Cache-Control", "private, no-cache");
+    }
+}
+
+// Sends 304 and returns true when the client's copy is current. Call
+// before reading flash or encoding anything.
+inline bool sendNotModified(AsyncWebServerRequest* request,
+                            const HttpConditional::Validator& v) {
+    if (!HttpConditional::notModified(request, v)) return false;
+    AsyncWebServerResponse* response = request->beginResponse(304);
+    addValidatorHeaders(response, &v, false);
+    request->send(response);
+    return true;
+}
+
+// Body is produced while AsyncTCP drains it; nothing is buffered up front.
+inline void sendChunked(AsyncWebServerRequest* request,
+                        int status,
+                        std::shared_ptr<CborChunkStream> stream,
+                        const char* cacheControl = nullptr,
+                        const HttpConditional::Validator* validator = nullptr) {
+    if (!request || !stream) return;
+    AsyncWebServerResponse* response = request->beginChunkedResponse(
+        CT_APP_CBOR,
+        [stream](uint8_t* buf, size_t maxLen, size_t /*index*/) -> size_t {
+            return stream->fill(buf, maxLen);
+        });
+    response->setCode(status);
+    if (cacheControl && *cacheControl) {
+        response->addHeader("Cache-Control", cacheControl);
+    }
+    addValidatorHeaders(response, validator, cacheControl && *cacheControl);
+    request->send(response);
+}
+
 inline void sendPayload(AsyncWebServerRequest* request,
                         int status,
                         const std::vector<uint8_t>& payload,
-                        const char* cacheControl = nullptr) {
+                        const char* cacheControl = nullptr,
+                        const HttpConditional::Validator* validator = nullptr) {
     if (!request) return;
     AsyncResponseStream* response = request->beginResponseStream(CT_APP_CBOR);
     response->setCode(status);
     if (cacheControl && *cacheControl) {
         response->addHeader("Cache-Control", cacheControl);
     }
+    addValidatorHeaders(response, validator, cacheControl && *cacheControl);
     response->write(payload.data(), payload.size());
     request->send(response);
 }
 
+// SPIFFS file as CBOR with validator headers.
+inline void sendFile(AsyncWebServerRequest* request,
+                     fs::FS& fs,
+                     const String& path,
+                     const HttpConditional::Validator* validator = nullptr) {
+    if (!request) return;
+    AsyncWebServerResponse* response = request->beginResponse(fs, path, CT_APP_CBOR);
+    addValidatorHeaders(response, validator, false);
+    request->send(response);
+}
+
+// Zero-copy send of an immutable shared buffer: the response filler keeps a
+// reference until the last chunk has been handed to AsyncTCP.
+inline void sendSharedPayload(AsyncWebServerRequest* request,
+                              int status,
+                              std::shared_ptr<const std::vector<uint8_t>> payload,
+                              const char* cacheControl = nullptr) {
+    if (!request || !payload) return;
+    const size_t total = payload->size();
+    AsyncWebServerResponse* response = request->beginResponse(
+        CT_APP_CBOR, total,
+        [payload](uint8_t* buf, size_t maxLen, size_t index) -> size_t {
+            const size_t size = payload->size();
+            if (index >= size) return 0;
+            size_t n = size - index;
+            if (n > maxLen) n = maxLen;
+            memcpy(buf, payload->data() + index, n);
+            return n;
+        });
+    response->setCode(status);
+    if (cacheControl && *cacheControl) {
+        response->addHeader("Cache-Control", cacheControl);
+    }
+    request->send(response);
+}
+
 inline bool buildErrorPayload(std::vector<uint8_t>& out,
                               size_t capacity,
                               const char* message,
@@ -82,6 +82,7 @@ static constexpr ErrorTranslation kErrorTranslations[] = {
     { ERR_CALIBRATION_BUSY,         "Calibration en cours",                    "Calibrazione in corso" },
     { ERR_CALIBRATION_FAILED,       "Echec calibration",                       "Calibrazione fallita" },
     { ERR_CTRL_QUEUE_FULL,          "File de commande pleine",                 "Coda comandi piena" },
+    { ERR_CURSOR_EXPIRED,           "Curseur expire",                          "Cursore scaduto" },
     { ERR_DEVICE_MISSING,           "Appareil manquant",                       "Dispositivo mancante" },
     { ERR_DEVICE_NOT_IDLE,          "Appareil non au repos",                   "Dispositivo non in idle" },
     { ERR_DEVICE_TRANSPORT_MISSING, "Transport appareil manquant",             "Trasporto dispositivo mancante" },
@@ -89,6 +90,7 @@ static constexpr ErrorTranslation kErrorTranslations[] = {
     { ERR_ENERGY_STOPPED,           "Energie arretee",                         "Energia arrestata" },
     { ERR_FIT_FAILED,               "Ajustement echoue",                       "Adattamento fallito" },
     { ERR_INVALID_COEFFS,           "Coefficients invalides",                  "Coefficienti non validi" },
+    { ERR_INVALID_CURSOR,           "Curseur invalide",                        "Cursore non valido" },
     { ERR_INVALID_MODE,             "Mode invalide",                           "Modalita non valida" },
     { ERR_INVALID_NAME,             "Nom invalide",                            "Nome non valido" },
     { ERR_INVALID_REF_TEMP,         "Temperature de reference invalide",       "Temperatura di riferimento non valida" },
@@ -158,6 +160,9 @@ static constexpr ReasonTranslation kReasonTranslations[] = {
     { "floor_cal",                            "calibration sol",                            "calibrazione pavimento" },
     { "run",                                  "marche",                                     "esecuzione" },
     { "confirmed",                            "confirme",                                   "confermato" },
+    { "warm_tracked",                         "reprise a chaud (suivi)",                    "ripresa a caldo (tracciata)" },
+    { "warm_cold",                            "reprise a froid",                            "ripresa a freddo" },
+    { "warm_bounded",                         "reprise a chaud (borne)",                    "ripresa a caldo (limitata)" },
     { "none",                                 "aucun",                                      "nessuno" }
 };
 
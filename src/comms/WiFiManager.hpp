@@ -16,6 +16,7 @@
 #include <freertos/semphr.h>
 #include <freertos/queue.h>
 #include <vector>
+#include <memory>
 
 #include <Device.hpp>
 #include <Config.hpp>
@@ -23,6 +24,7 @@
 #include <HeaterManager.hpp>
 #include <StatusSnapshot.hpp>
 #include <WifiEnpoin.hpp>
+#include <TelemetryChannel.hpp>
 
 struct CborEncoder;
 
@@ -132,10 +134,22 @@ private:
     void clearSession_();
 
     // ===== Snapshot task + storage =====
+    // The snapshot task publishes an immutable frame (status + prebuilt
+    // /monitor CBOR) by swapping a shared pointer. Handlers take their own
+    // reference: no copy, no wait on the task, no 503 once published.
+    struct SnapshotFrame {
+        StatusSnapshot       snap;
+        std::vector<uint8_t> monitorCbor;
+    };
+    using FramePtr = std::shared_ptr<const SnapshotFrame>;
+
     TaskHandle_t      snapshotTaskHandle = nullptr;
-    SemaphoreHandle_t _snapMtx           = nullptr;
-    StatusSnapshot    _snap; // guarded by _snapMtx
-    std::vector<uint8_t> _monitorCbor;
+    SemaphoreHandle_t _snapMtx           = nullptr; // guards live ring only
+    std::shared_ptr<SnapshotFrame> _frame;          // swapped under _frameMux
+    mutable portMUX_TYPE _frameMux = portMUX_INITIALIZER_UNLOCKED;
+
+    FramePtr acquireFrame_() const;
+    void     publishFrame_(std::shared_ptr<SnapshotFrame>& next);
 
     // ===== State streaming (SSE) =====
     AsyncEventSource stateSse{EP_STATE_STREAM};
@@ -144,6 +158,21 @@ private:
     TaskHandle_t     eventStreamTaskHandle = nullptr;
     uint32_t         eventSeq = 0;
 
+    // ===== Binary telemetry (WebSocket) =====
+    // State, event and /monitor frames as raw CBOR behind a small channel
+    // header (TelemetryChannel.hpp); the SSE routes above stay as fallback.
+    AsyncWebSocket       telemetryWs{EP_TELEMETRY_WS};
+    TelemetrySubscribers _wsSubs;                      // guarded by _wsMux
+    mutable portMUX_TYPE _wsMux = portMUX_INITIALIZER_UNLOCKED;
+    uint32_t             _wsEventSeq = 0;
+
+    // frame: kHeaderLen reserved bytes followed by len bytes of CBOR.
+    void wsPublish_(TelemetryChannel ch, uint32_t seq, uint8_t* frame, size_t len);
+    bool wsSendTo_(uint32_t id, TelemetryChannel ch, uint32_t seq,
+                   const uint8_t* frame, size_t frameLen);
+    void onTelemetryWsEvent_(AsyncWebSocketClient* client, AwsEventType type,
+                             void* arg, uint8_t* data, size_t len);
+
     // ===== Live monitor streaming (batched) =====
     struct LiveSample {
         uint32_t seq      = 0;
@@ -161,18 +190,32 @@ private:
     size_t       _liveCount   = 0;
     size_t       _liveHead    = 0; // next write
     uint32_t     _liveSeqCtr  = 0;
-    uint32_t     _liveSentSeq = 0;
+    uint32_t     _liveSentSeq = 0; // last seq broadcast on liveSse
+    uint32_t     _liveRetryMs = 150;
     AsyncEventSource liveSse{EP_MONITOR_STREAM};
     TaskHandle_t     liveStreamTaskHandle = nullptr;
     void pushLiveSample(const StatusSnapshot& s);
     void startLiveStreamTask(uint32_t emitPeriodMs = 150);
     static void liveStreamTask(void* pv);
-    bool buildLiveBatch(CborEncoder* items, uint32_t sinceSeq, uint32_t& seqStart, uint32_t& seqEnd);
+    // Caller holds _snapMtx. Samples after sinceSeq, every stride-th one
+    // ending at the newest, at most maxItems (the newest kept).
+    bool buildLiveBatch(CborEncoder* items, uint32_t sinceSeq, uint32_t& seqStart,
+                        uint32_t& seqEnd, uint8_t stride = 1,
+                        size_t maxItems = kLiveBufSize);
+    // Same selection in the columnar format (LiveColumnar.hpp), map pairs.
+    bool buildLiveColumns_(CborEncoder* map, uint32_t sinceSeq, uint8_t stride,
+                           size_t maxItems, uint32_t& seqStart, uint32_t& seqEnd);
+    size_t selectLive_(uint32_t sinceSeq, uint8_t stride, size_t maxItems,
+                       const LiveSample** out) const;
+    bool liveWindow_(uint32_t& oldest, uint32_t& newest);
+    bool encodeLiveBatch_(uint8_t* buf, size_t capacity, size_t& len,
+                          uint32_t sinceSeq, uint8_t stride, size_t maxItems,
+                          uint32_t& seqEnd, bool columnar = false);
+    void serviceLiveStream_(std::vector<uint8_t>& frame);
 
     static void snapshotTask(void* param);
     void startSnapshotTask(uint32_t periodMs = 250);
     bool getSnapshot(StatusSnapshot& out);
-    bool getMonitorCbor(std::vector<uint8_t>& out);
 
     // ================= Control command queue =================
     enum CtrlType : uint8_t {
@@ -10,7 +10,11 @@ void WiFiManager::registerRoutes_() {
         );
         DefaultHeaders::Instance().addHeader(
             "Access-Control-Allow-Headers",
-            "Content-Type, X-Session-Token"
+            "Content-Type, X-Session-Token, If-None-Match, If-Modified-Since"
+        );
+        DefaultHeaders::Instance().addHeader(
+            "Access-Control-Expose-Headers",
+            "ETag, Last-Modified"
         );
         DefaultHeaders::Instance().addHeader("Access-Control-Max-Age", "600");
         DefaultHeaders::Instance().addHeader(
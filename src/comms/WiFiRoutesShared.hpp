@@ -8,6 +8,8 @@
 #include <BusSampler.hpp>
 #include <NtcSensor.hpp>
 #include <RTCManager.hpp>
+#include <PageCursor.hpp>
+#include <Decimator.hpp>
 #include <SPIFFS.h>
 #include <esp_system.h>
 #include <string.h>
@@ -184,6 +186,12 @@ bool readCborDouble_(CborValue* it, double& value) {
         value = tmp;
         return cbor_value_advance(it) == CborNoError;
     }
+    if (cbor_value_is_half_float(it)) {
+        uint16_t half = 0;
+        if (cbor_value_get_half_float(it, &half) != CborNoError) return false;
+        value = CborNumber::halfToFloat(half);
+        return cbor_value_advance(it) == CborNoError;
+    }
     if (cbor_value_is_integer(it)) {
         int64_t iv = 0;
         if (cbor_value_get_int64(it, &iv) != CborNoError) return false;
@@ -388,6 +396,85 @@ void sendHistoryEmpty_(AsyncWebServerRequest* request, int status = 200) {
     }
     WiFiCbor::sendPayload(request, status, payload);
 }
+
+// ---- Paged list queries (/session_history, /calib_data) ----
+// ?cursor=<next from the previous page>&limit=N&from=MS&to=MS&width=PX
+struct PageQuery_ {
+    String   cursor;              // empty: first page
+    uint16_t limit  = 0;          // 0: not given
+    uint32_t fromMs = 0;
+    uint32_t toMs   = UINT32_MAX;
+    uint16_t width  = 0;          // > 0: min/max/mean buckets instead of rows
+    bool     paged  = false;      // cursor, limit, from or to given
+};
+
+uint32_t paramU32_(AsyncWebServerRequest* request, const char* name, uint32_t fallback) {
+    if (!request->hasParam(name)) return fallback;
+    const char* text = request->getParam(name)->value().c_str();
+    char* end = nullptr;
+    const unsigned long v = strtoul(text, &end, 10);
+    return (end && end != text) ? static_cast<uint32_t>(v) : fallback;
+}
+
+PageQuery_ readPageQuery_(AsyncWebServerRequest* request) {
+    PageQuery_ q;
+    if (request->hasParam("cursor")) q.cursor = request->getParam("cursor")->value();
+    const uint32_t limit = paramU32_(request, "limit", 0);
+    q.limit  = static_cast<uint16_t>(limit > UINT16_MAX ? UINT16_MAX : limit);
+    q.fromMs = paramU32_(request, "from", 0);
+    q.toMs   = paramU32_(request, "to", UINT32_MAX);
+    const uint32_t width = paramU32_(request, "width", 0);
+    q.width  = static_cast<uint16_t>(width > Decimator::kMaxWidth ? Decimator::kMaxWidth : width);
+    q.paged  = q.cursor.length() > 0 || request->hasParam("limit") ||
+               request->hasParam("from") || request->hasParam("to");
+    return q;
+}
+
+// Sends 400 (malformed / other route) or 410 (reboot, data replaced) and
+// returns false when the cursor cannot be resumed.
+bool resumeCursor_(AsyncWebServerRequest* request, const PageQuery_& q,
+                   PageCursor::Source source, uint32_t dataset, PageCursor::Token& out) {
+    switch (PageCursor::check(q.cursor.c_str(), source, WiFiCbor::bootTag(), dataset, out)) {
+        case PageCursor::Check::Ok:
+            return true;
+        case PageCursor::Check::Expired:
+            WiFiCbor::sendError(request, 410, ERR_CURSOR_EXPIRED);
+            return false;
+        default:
+            WiFiCbor::sendError(request, 400, ERR_INVALID_CURSOR);
+            return false;
+    }
+}
+
+bool encodeKvCursor_(CborEncoder* map, const PageCursor::Token& t) {
+    char text[PageCursor::kTextMax];
+    return PageCursor::format(t, text, sizeof(text)) &&
+           WiFiCbor::encodeKvText(map, "next", text);
+}
+
+// One decimation bucket: {"x0", "x1", "n", <field>: [min, max, mean], ...};
+// fields with no finite value in the bucket are left out.
+bool encodeBucket_(CborEncoder* row, const Decimator::Bucket& b, uint8_t fields,
+                   const char* const* names, const CborNumber::Resolution* res) {
+    if (!WiFiCbor::encodeKvUInt(row, "x0", b.xFirst) ||
+        !WiFiCbor::encodeKvUInt(row, "x1", b.xLast) ||
+        !WiFiCbor::encodeKvUInt(row, "n", b.n)) {
+        return false;
+    }
+    for (uint8_t f = 0; f < fields; ++f) {
+        if (b.count[f] == 0) continue;
+        CborEncoder arr;
+        if (!WiFiCbor::encodeText(row, names[f]) ||
+            cbor_encoder_create_array(row, &arr, 3) != CborNoError ||
+            !WiFiCbor::encodeNumber(&arr, b.min[f], res[f]) ||
+            !WiFiCbor::encodeNumber(&arr, b.max[f], res[f]) ||
+            !WiFiCbor::encodeNumber(&arr, b.mean(f), res[f]) ||
+            cbor_encoder_close_container(row, &arr) != CborNoError) {
+            return false;
+        }
+    }
+    return true;
+}
 } // namespace
 
 static void appendMissing(std::vector<const char*>* arr, const char* key) {
@@ -471,7 +558,8 @@ static bool checkSetupConfig(std::vector<const char*>* missing) {
         ok = false;
     }
     int currentSource = CONF->GetInt(CURRENT_SOURCE_KEY, DEFAULT_CURRENT_SOURCE);
-    if (currentSource != CURRENT_SRC_ACS && currentSource != CURRENT_SRC_ESTIMATE) {
+    if (currentSource != CURRENT_SRC_ACS && currentSource != CURRENT_SRC_ESTIMATE &&
+        currentSource != CURRENT_SRC_FUSED) {
         appendMissing(missing, CURRENT_SOURCE_KEY);
         ok = false;
     }
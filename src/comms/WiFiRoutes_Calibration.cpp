@@ -1166,6 +1166,195 @@ static bool normalizeHistoryPath(const String& rawName,
 
     return true;
 }
+
+// ---- /calib_data pages ----
+constexpr uint16_t kCalibPageMax = 200;
+// Samples copied per recorder lock while a page streams.
+constexpr size_t kCalibCopyBatch = 16;
+
+constexpr uint8_t kCalibFields = 5;
+const char* const kCalibFieldNames[kCalibFields] = {
+    "v", "i", "temp_c", "room_c", "ntc_ohm"
+};
+const CborNumber::Resolution kCalibFieldRes[kCalibFields] = {
+    CborNumber::kVoltage, CborNumber::kCurrent, CborNumber::kTemperature,
+    CborNumber::kTemperature, CborNumber::kResistance
+};
+
+// Forward reader over one recorder run. Refills kCalibCopyBatch samples
+// per lock and stops (runChanged) if the run is cleared or restarted
+// under it, so a page never mixes two runs.
+struct CalibSampleReader {
+    uint32_t runId = 0;
+    uint32_t pos   = 0;   // index of the next sample handed out
+    bool     runChanged = false;
+    CalibrationRecorder::Sample batch[kCalibCopyBatch];
+    size_t   n  = 0;
+    size_t   at = 0;
+
+    bool next(CalibrationRecorder::Sample& out) {
+        if (at >= n) {
+            at = 0;
+            n = (pos <= UINT16_MAX)
+                    ? CALREC->copySamples(runId, static_cast<uint16_t>(pos), batch, kCalibCopyBatch)
+                    : 0;
+            if (n == 0) {
+                runChanged = (CALREC->getMeta().runId != runId);
+                return false;
+            }
+        }
+        out = batch[at++];
+        ++pos;
+        return true;
+    }
+};
+
+bool encodeCalibMeta(CborEncoder* map, const CalibrationRecorder::Meta& meta,
+                     uint32_t offset, uint32_t limit) {
+    if (!WiFiCbor::encodeText(map, "meta")) return false;
+    CborEncoder metaMap;
+    if (cbor_encoder_create_map(map, &metaMap, CborIndefiniteLength) != CborNoError) {
+        return false;
+    }
+    const char* modeStr =
+        (meta.mode == CalibrationRecorder::Mode::Ntc)   ? MODE_NTC :
+        (meta.mode == CalibrationRecorder::Mode::Model) ? MODE_MODEL :
+        (meta.mode == CalibrationRecorder::Mode::Floor) ? MODE_FLOOR :
+        MODE_NONE;
+    if (!WiFiCbor::encodeKvText(&metaMap, "mode", modeStr)) return false;
+    if (!WiFiCbor::encodeKvBool(&metaMap, "running", meta.running)) return false;
+    if (!WiFiCbor::encodeKvUInt(&metaMap, "count", meta.count)) return false;
+    if (!WiFiCbor::encodeKvUInt(&metaMap, "capacity", meta.capacity)) return false;
+    if (!WiFiCbor::encodeKvUInt(&metaMap, "interval_ms", meta.intervalMs)) return false;
+    if (!WiFiCbor::encodeKvUInt(&metaMap, "start_ms", meta.startMs)) return false;
+    if (meta.startEpoch > 0) {
+        if (!WiFiCbor::encodeKvUInt(&metaMap, "start_epoch", meta.startEpoch)) {
+            return false;
+        }
+    }
+    if (!WiFiCbor::encodeKvBool(&metaMap, "saved", meta.saved)) return false;
+    if (!WiFiCbor::encodeKvUInt(&metaMap, "saved_ms", meta.savedMs)) return false;
+    if (meta.savedEpoch > 0) {
+        if (!WiFiCbor::encodeKvUInt(&metaMap, "saved_epoch", meta.savedEpoch)) {
+            return false;
+        }
+    }
+    if (isfinite(meta.targetTempC)) {
+        if (!WiFiCbor::encodeKvFloat(&metaMap, "target_c", meta.targetTempC)) {
+            return false;
+        }
+    }
+    if (meta.wireIndex > 0) {
+        if (!WiFiCbor::encodeKvUInt(&metaMap, "wire_index", meta.wireIndex)) {
+            return false;
+        }
+    }
+    if (!WiFiCbor::encodeKvUInt(&metaMap, "offset", offset)) return false;
+    if (!WiFiCbor::encodeKvUInt(&metaMap, "limit", limit)) return false;
+    return cbor_encoder_close_container(map, &metaMap) == CborNoError;
+}
+
+// {"meta": {...}, "samples": [...], "next"?, "stale"?} oldest first.
+// "next" resumes after the last sample; while the run records it is
+// always there, so polling it returns only the samples added since.
+static std::shared_ptr<CborChunkStream> makeCalibPageStream(const CalibrationRecorder::Meta& meta,
+                                                            uint32_t offset,
+                                                            uint16_t limit,
+                                                            uint32_t toMs) {
+    struct Page {
+        CalibSampleReader reader;
+        bool pastTo = false;
+    };
+    auto page = std::make_shared<Page>();
+    page->reader.runId = meta.runId;
+    page->reader.pos = offset;
+    uint16_t rows = 0;
+    return WiFiCbor::makeArrayStream(
+        [meta, offset, limit](CborEncoder* map) {
+            return encodeCalibMeta(map, meta, offset, limit) &&
+                   WiFiCbor::encodeText(map, "samples");
+        },
+        [page, limit, toMs, rows](CborEncoder* row) mutable {
+            if (rows >= limit) return WiFiCbor::RowStep::End;
+            CalibrationRecorder::Sample sm;
+            if (!page->reader.next(sm)) return WiFiCbor::RowStep::End;
+            if (sm.tMs > toMs) {
+                page->pastTo = true;
+                return WiFiCbor::RowStep::End;
+            }
+            ++rows;
+            if (!WiFiCbor::encodeKvUInt(row, "t_ms", sm.tMs) ||
+                !WiFiCbor::encodeKvFloat(row, "v", sm.voltageV, CborNumber::kVoltage) ||
+                !WiFiCbor::encodeKvFloat(row, "i", sm.currentA, CborNumber::kCurrent) ||
+                !WiFiCbor::encodeKvFloat(row, "temp_c", sm.tempC, CborNumber::kTemperature) ||
+                !WiFiCbor::encodeKvFloat(row, "room_c", sm.roomTempC, CborNumber::kTemperature) ||
+                !WiFiCbor::encodeKvFloat(row, "ntc_v", sm.ntcVolts, CborNumber::kSenseVoltage) ||
+                !WiFiCbor::encodeKvFloat(row, "ntc_ohm", sm.ntcOhm, CborNumber::kResistance) ||
+                !WiFiCbor::encodeKvInt(row, "ntc_adc", sm.ntcAdc) ||
+                !WiFiCbor::encodeKvBool(row, "ntc_ok", sm.ntcValid) ||
+                !WiFiCbor::encodeKvBool(row, "pressed", sm.pressed)) {
+                return WiFiCbor::RowStep::Error;
+            }
+            return WiFiCbor::RowStep::Row;
+        },
+        [page](CborEncoder* map) {
+            const CalibSampleReader& r = page->reader;
+            const CalibrationRecorder::Meta now = CALREC->getMeta();
+            if (r.runChanged || now.runId != r.runId) {
+                return WiFiCbor::encodeKvBool(map, "stale", true);
+            }
+            if (page->pastTo || (!now.running && r.pos >= now.count)) return true;
+            PageCursor::Token next;
+            next.source  = PageCursor::Source::Calib;
+            next.boot    = WiFiCbor::bootTag();
+            next.dataset = r.runId;
+            next.pos     = r.pos;
+            return encodeKvCursor_(map, next);
+        });
+}
+
+// {"meta": {...}, "x": "t_ms", "width", "buckets": [...]} over [x0, x1].
+static std::shared_ptr<CborChunkStream> makeCalibBucketStream(const CalibrationRecorder::Meta& meta,
+                                                              uint32_t offset,
+                                                              uint32_t x0,
+                                                              uint32_t x1,
+                                                              uint16_t width) {
+    auto reader = std::make_shared<CalibSampleReader>();
+    reader->runId = meta.runId;
+    reader->pos = offset;
+    auto dec = std::make_shared<Decimator>(x0, x1, width, kCalibFields);
+    bool drained = false;
+    bool flushed = false;
+    return WiFiCbor::makeArrayStream(
+        [meta, offset, dec](CborEncoder* map) {
+            return encodeCalibMeta(map, meta, offset, 0) &&
+                   WiFiCbor::encodeKvText(map, "x", "t_ms") &&
+                   WiFiCbor::encodeKvUInt(map, "width", dec->width()) &&
+                   WiFiCbor::encodeText(map, "buckets");
+        },
+        [reader, dec, x1, drained, flushed](CborEncoder* row) mutable {
+            bool ready = false;
+            while (!ready && !drained) {
+                CalibrationRecorder::Sample sm;
+                if (!reader->next(sm) || sm.tMs > x1) {
+                    drained = true;
+                    break;
+                }
+                const float v[kCalibFields] = {
+                    sm.voltageV, sm.currentA, sm.tempC, sm.roomTempC, sm.ntcOhm
+                };
+                ready = dec->add(sm.tMs, v);
+            }
+            if (!ready) {
+                if (flushed || !dec->finish()) return WiFiCbor::RowStep::End;
+                flushed = true;
+            }
+            return encodeBucket_(row, dec->ready(), kCalibFields, kCalibFieldNames,
+                                 kCalibFieldRes)
+                       ? WiFiCbor::RowStep::Row
+                       : WiFiCbor::RowStep::Error;
+        });
+}
 }
 
 bool modelCalIsRunning_() {
@@ -1215,7 +1404,7 @@ void WiFiManager::registerCalibrationRoutes_() {
                     float progressPct = NAN;
                     uint8_t progressWire = 0;
                     if (getModelCalProgress(progressPct, progressWire)) {
-                        if (!WiFiCbor::encodeKvFloat(map, "progress_pct", progressPct)) return false;
+                        if (!WiFiCbor::encodeKvFloat(map, "progress_pct", progressPct, CborNumber::kPercent)) return false;
                         if (progressWire > 0) {
                             if (!WiFiCbor::encodeKvUInt(map, "progress_wire", progressWire)) {
                                 return false;
@@ -1777,6 +1966,7 @@ void WiFiManager::registerCalibrationRoutes_() {
                     removeFromDir(root);
                 }
             }
+            CALREC->markFilesChanged();
 
             sendStatusClearedFile_(request, removed, removedCount);
         }
@@ -1788,107 +1978,36 @@ void WiFiManager::registerCalibrationRoutes_() {
             if (!isAuthenticated(request)) return;
             if (lock()) { lastActivityMillis = millis(); unlock(); }
 
-            uint16_t offset = 0;
-            uint16_t count = 0;
-            if (request->hasParam("offset")) {
-                offset = request->getParam("offset")->value().toInt();
-            }
-            if (request->hasParam("count")) {
-                count = request->getParam("count")->value().toInt();
-            }
-            if (count == 0) count = 200;
-            if (count > 200) count = 200;
+            const PageQuery_ q = readPageQuery_(request);
+            uint32_t offset = paramU32_(request, "offset", 0);
+            uint32_t count = paramU32_(request, "count", 0);
+            if (q.limit > 0) count = q.limit;
+            if (count == 0 || count > kCalibPageMax) count = kCalibPageMax;
 
             const CalibrationRecorder::Meta meta = CALREC->getMeta();
-            const uint16_t total = meta.count;
-
-            const size_t capacity = 4096 + (size_t)count * 160;
-            std::vector<uint8_t> payload;
-            if (!WiFiCbor::buildMapPayload(payload, capacity, [&](CborEncoder* map) {
-                    if (!WiFiCbor::encodeText(map, "meta")) return false;
-                    CborEncoder metaMap;
-                    if (cbor_encoder_create_map(map, &metaMap, CborIndefiniteLength) != CborNoError) {
-                        return false;
-                    }
-                    const char* modeStr =
-                        (meta.mode == CalibrationRecorder::Mode::Ntc)   ? MODE_NTC :
-                        (meta.mode == CalibrationRecorder::Mode::Model) ? MODE_MODEL :
-                        (meta.mode == CalibrationRecorder::Mode::Floor) ? MODE_FLOOR :
-                        MODE_NONE;
-                    if (!WiFiCbor::encodeKvText(&metaMap, "mode", modeStr)) return false;
-                    if (!WiFiCbor::encodeKvBool(&metaMap, "running", meta.running)) return false;
-                    if (!WiFiCbor::encodeKvUInt(&metaMap, "count", total)) return false;
-                    if (!WiFiCbor::encodeKvUInt(&metaMap, "capacity", meta.capacity)) return false;
-                    if (!WiFiCbor::encodeKvUInt(&metaMap, "interval_ms", meta.intervalMs)) return false;
-                    if (!WiFiCbor::encodeKvUInt(&metaMap, "start_ms", meta.startMs)) return false;
-                    if (meta.startEpoch > 0) {
-                        if (!WiFiCbor::encodeKvUInt(&metaMap, "start_epoch", meta.startEpoch)) {
-                            return false;
-                        }
-                    }
-                    if (!WiFiCbor::encodeKvBool(&metaMap, "saved", meta.saved)) return false;
-                    if (!WiFiCbor::encodeKvUInt(&metaMap, "saved_ms", meta.savedMs)) return false;
-                    if (meta.savedEpoch > 0) {
-                        if (!WiFiCbor::encodeKvUInt(&metaMap, "saved_epoch", meta.savedEpoch)) {
-                            return false;
-                        }
-                    }
-                    if (isfinite(meta.targetTempC)) {
-                        if (!WiFiCbor::encodeKvFloat(&metaMap, "target_c", meta.targetTempC)) {
-                            return false;
-                        }
-                    }
-                    if (meta.wireIndex > 0) {
-                        if (!WiFiCbor::encodeKvUInt(&metaMap, "wire_index", meta.wireIndex)) {
-                            return false;
-                        }
-                    }
-                    if (!WiFiCbor::encodeKvUInt(&metaMap, "offset", offset)) return false;
-                    if (!WiFiCbor::encodeKvUInt(&metaMap, "limit", count)) return false;
-                    if (cbor_encoder_close_container(map, &metaMap) != CborNoError) {
-                        return false;
-                    }
-
-                    if (!WiFiCbor::encodeText(map, "samples")) return false;
-                    CborEncoder samples;
-                    if (cbor_encoder_create_array(map, &samples, CborIndefiniteLength) != CborNoError) {
-                        return false;
-                    }
-
-                    CalibrationRecorder::Sample buf[32];
-                    uint16_t copied = 0;
-                    while (copied < count) {
-                        const size_t chunk = (count - copied) < 32 ? (count - copied) : 32;
-                        const size_t got = CALREC->copySamples(offset + copied, buf, chunk);
-                        if (got == 0) break;
-                        for (size_t i = 0; i < got; ++i) {
-                            CborEncoder row;
-                            if (cbor_encoder_create_map(&samples, &row, CborIndefiniteLength) != CborNoError) {
-                                return false;
-                            }
-                            if (!WiFiCbor::encodeKvUInt(&row, "t_ms", buf[i].tMs)) return false;
-                            if (!WiFiCbor::encodeKvFloat(&row, "v", buf[i].voltageV)) return false;
-                            if (!WiFiCbor::encodeKvFloat(&row, "i", buf[i].currentA)) return false;
-                            if (!WiFiCbor::encodeKvFloat(&row, "temp_c", buf[i].tempC)) return false;
-                            if (!WiFiCbor::encodeKvFloat(&row, "room_c", buf[i].roomTempC)) return false;
-                            if (!WiFiCbor::encodeKvFloat(&row, "ntc_v", buf[i].ntcVolts)) return false;
-                            if (!WiFiCbor::encodeKvFloat(&row, "ntc_ohm", buf[i].ntcOhm)) return false;
-                            if (!WiFiCbor::encodeKvInt(&row, "ntc_adc", buf[i].ntcAdc)) return false;
-                            if (!WiFiCbor::encodeKvBool(&row, "ntc_ok", buf[i].ntcValid)) return false;
-                            if (!WiFiCbor::encodeKvBool(&row, "pressed", buf[i].pressed)) return false;
-                            if (cbor_encoder_close_container(&samples, &row) != CborNoError) {
-                                return false;
-                            }
-                        }
-                        copied += got;
-                    }
-
-                    return cbor_encoder_close_container(map, &samples) == CborNoError;
-                })) {
-                request->send(500, CT_TEXT_PLAIN, WiFiLang::getPlainError());
+            if (q.cursor.length() > 0) {
+                PageCursor::Token t;
+                if (!resumeCursor_(request, q, PageCursor::Source::Calib, meta.runId, t)) return;
+                offset = t.pos;
+            } else if (request->hasParam("from")) {
+                offset = CALREC->findSample(q.fromMs);
+            }
+
+            if (q.width > 0) {
+                uint32_t x1 = q.toMs;
+                if (!request->hasParam("to")) {
+                    CalibrationRecorder::Sample last;
+                    x1 = (meta.count > 0 &&
+                          CALREC->copySamples(meta.runId, meta.count - 1, &last, 1) == 1)
+                             ? last.tMs
+                             : q.fromMs;
+                }
+                WiFiCbor::sendChunked(request, 200,
+                    makeCalibBucketStream(meta, offset, q.fromMs, x1, q.width));
                 return;
             }
-            WiFiCbor::sendPayload(request, 200, payload);
+            WiFiCbor::sendChunked(request, 200,
+                makeCalibPageStream(meta, offset, static_cast<uint16_t>(count), q.toMs));
         }
     );
 
@@ -1898,11 +2017,14 @@ void WiFiManager::registerCalibrationRoutes_() {
             if (!isAuthenticated(request)) return;
             if (lock()) { lastActivityMillis = millis(); unlock(); }
 
+            const HttpConditional::Validator v = WiFiCbor::makeValidator(
+                "cm", CALREC->getFilesGeneration(), CALREC->getFilesModifiedEpoch());
+            if (WiFiCbor::sendNotModified(request, v)) return;
             if (!SPIFFS.begin(false) || !SPIFFS.exists(CALIB_MODEL_CBOR_FILE)) {
                 WiFiCbor::sendError(request, 404, ERR_NOT_FOUND);
                 return;
             }
-            request->send(SPIFFS, CALIB_MODEL_CBOR_FILE, CT_APP_CBOR);
+            WiFiCbor::sendFile(request, SPIFFS, CALIB_MODEL_CBOR_FILE, &v);
         }
     );
 
@@ -1912,6 +2034,10 @@ void WiFiManager::registerCalibrationRoutes_() {
             if (!isAuthenticated(request)) return;
             if (lock()) { lastActivityMillis = millis(); unlock(); }
 
+            const HttpConditional::Validator v = WiFiCbor::makeValidator(
+                "cl", CALREC->getFilesGeneration(), CALREC->getFilesModifiedEpoch());
+            if (WiFiCbor::sendNotModified(request, v)) return;
+
             std::vector<String> names;
             std::vector<uint32_t> epochs;
 
@@ -1979,7 +2105,7 @@ void WiFiManager::registerCalibrationRoutes_() {
                 request->send(500, CT_TEXT_PLAIN, WiFiLang::getPlainError());
                 return;
             }
-            WiFiCbor::sendPayload(request, 200, payload);
+            WiFiCbor::sendPayload(request, 200, payload, nullptr, &v);
         }
     );
 
@@ -2000,14 +2126,19 @@ void WiFiManager::registerCalibrationRoutes_() {
                 WiFiCbor::sendError(request, 400, ERR_INVALID_NAME);
                 return;
             }
+            // Per-URL cache entry; the shared generation only costs a
+            // refetch when some other calibration file changed.
+            const HttpConditional::Validator v = WiFiCbor::makeValidator(
+                "cf", CALREC->getFilesGeneration(), CALREC->getFilesModifiedEpoch());
+            if (WiFiCbor::sendNotModified(request, v)) return;
             if (SPIFFS.begin(false)) {
                 if (SPIFFS.exists(fullName)) {
-                    request->send(SPIFFS, fullName, CT_APP_CBOR);
+                    WiFiCbor::sendFile(request, SPIFFS, fullName, &v);
                     return;
                 }
                 String legacyPath = "/" + baseName;
                 if (legacyPath != fullName && SPIFFS.exists(legacyPath)) {
-                    request->send(SPIFFS, legacyPath, CT_APP_CBOR);
+                    WiFiCbor::sendFile(request, SPIFFS, legacyPath, &v);
                     return;
                 }
             }
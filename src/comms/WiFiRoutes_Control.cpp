@@ -1,7 +1,32 @@
 #include <WiFiRoutesShared.hpp>
 #include <WiFiLocalization.hpp>
+#include <ControlTargets.hpp>
 
 void WiFiManager::registerControlRoutes_() {
+    // Queued ops are cast straight to CtrlType.
+    static_assert(static_cast<uint8_t>(ControlTargets::Op::Reboot) == CTRL_REBOOT &&
+                  static_cast<uint8_t>(ControlTargets::Op::SysReset) == CTRL_SYS_RESET &&
+                  static_cast<uint8_t>(ControlTargets::Op::LedFeedback) == CTRL_LED_FEEDBACK_BOOL &&
+                  static_cast<uint8_t>(ControlTargets::Op::Relay) == CTRL_RELAY_BOOL &&
+                  static_cast<uint8_t>(ControlTargets::Op::Output) == CTRL_OUTPUT_BOOL &&
+                  static_cast<uint8_t>(ControlTargets::Op::AcFreq) == CTRL_AC_FREQ &&
+                  static_cast<uint8_t>(ControlTargets::Op::ChargeRes) == CTRL_CHARGE_RES &&
+                  static_cast<uint8_t>(ControlTargets::Op::Access) == CTRL_ACCESS_BOOL &&
+                  static_cast<uint8_t>(ControlTargets::Op::SystemStart) == CTRL_SYSTEM_START &&
+                  static_cast<uint8_t>(ControlTargets::Op::SystemWake) == CTRL_SYSTEM_WAKE &&
+                  static_cast<uint8_t>(ControlTargets::Op::SystemShutdown) == CTRL_SYSTEM_SHUTDOWN &&
+                  static_cast<uint8_t>(ControlTargets::Op::FanSpeed) == CTRL_FAN_SPEED &&
+                  static_cast<uint8_t>(ControlTargets::Op::BuzzerMute) == CTRL_BUZZER_MUTE &&
+                  static_cast<uint8_t>(ControlTargets::Op::WireRes) == CTRL_WIRE_RES &&
+                  static_cast<uint8_t>(ControlTargets::Op::WireOhmPerM) == CTRL_WIRE_OHM_PER_M &&
+                  static_cast<uint8_t>(ControlTargets::Op::WireGauge) == CTRL_WIRE_GAUGE &&
+                  static_cast<uint8_t>(ControlTargets::Op::CurrLimit) == CTRL_CURR_LIMIT &&
+                  static_cast<uint8_t>(ControlTargets::Op::ConfirmWiresCool) == CTRL_CONFIRM_WIRES_COOL &&
+                  static_cast<uint8_t>(ControlTargets::Op::Calibrate) == CTRL_CALIBRATE,
+                  "ControlTargets::Op out of step with CtrlType");
+    static_assert(ControlTargets::kWires == HeaterManager::kWireCount,
+                  "ControlTargets::kWires out of step with HeaterManager");
+
     // ---- CONTROL (queued) ----
     server.on(EP_CONTROL, HTTP_POST,
         [this](AsyncWebServerRequest* request) {},
@@ -12,879 +37,539 @@ void WiFiManager::registerControlRoutes_() {
                size_t index,
                size_t total)
         {
-            static std::vector<uint8_t> body;
-            if (index == 0) body.clear();
-            body.insert(body.end(), data, data + len);
-            if (index + len != total) return;
-            if (!isAuthenticated(request)) {
-                body.clear();
-                return;
-            }
-
-            String action;
-            String target;
-            CborValue valueIt;
-            bool hasValue = false;
-            uint32_t epoch = 0;
-            const bool parsed = parseCborMap_(body, [&](const char* key, CborValue* it) {
-                if (strcmp(key, "action") == 0) {
-                    return readCborText_(it, action);
-                }
-                if (strcmp(key, "target") == 0) {
-                    return readCborText_(it, target);
-                }
-                if (strcmp(key, "value") == 0) {
-                    valueIt = *it;
-                    hasValue = true;
-                    return skipCborValue_(it);
-                }
-                if (strcmp(key, "epoch") == 0) {
-                    uint64_t v = 0;
-                    if (!readCborUInt64_(it, v)) return false;
-                    epoch = static_cast<uint32_t>(v);
-                    return true;
-                }
-                return skipCborValue_(it);
-            });
-            body.clear();
-            if (!parsed) {
-                WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                return;
-            }
-
-            ControlCmd c{};
-            if (epoch > 0 && RTC) {
-                RTC->setUnixTime(epoch);
-            }
+            collectCborBody_(request, data, len, index, total,
+                [this](AsyncWebServerRequest* request, const std::vector<uint8_t>& body) {
+                    if (!isAuthenticated(request)) {
+                        return;
+                    }
 
-            if (action == "set") {
-                String valStr = "null";
-                if (hasValue) {
-                    CborValue tmp = valueIt;
-                    if (cbor_value_is_text_string(&tmp)) {
-                        readCborText_(&tmp, valStr);
-                    } else if (cbor_value_is_boolean(&tmp)) {
-                        bool b = false;
-                        if (cbor_value_get_boolean(&tmp, &b) == CborNoError) {
-                            valStr = b ? "true" : "false";
+                    String action;
+                    String target;
+                    CborValue valueIt = {};
+                    bool hasValue = false;
+                    uint32_t epoch = 0;
+                    const bool parsed = parseCborMap_(body, [&](const char* key, CborValue* it) {
+                        if (strcmp(key, "action") == 0) {
+                            return readCborText_(it, action);
                         }
-                    } else if (cbor_value_is_integer(&tmp)) {
-                        int64_t v = 0;
-                        if (cbor_value_get_int64(&tmp, &v) == CborNoError) {
-                            valStr = String(static_cast<long long>(v));
+                        if (strcmp(key, "target") == 0) {
+                            return readCborText_(it, target);
                         }
-                    } else if (cbor_value_is_float(&tmp) || cbor_value_is_double(&tmp)) {
-                        double v = 0.0;
-                        if (cbor_value_get_double(&tmp, &v) == CborNoError) {
-                            valStr = String(v, 3);
+                        if (strcmp(key, "value") == 0) {
+                            valueIt = *it;
+                            hasValue = true;
+                            return skipCborValue_(it);
                         }
-                    } else if (cbor_value_is_map(&tmp) || cbor_value_is_array(&tmp)) {
-                        valStr = "[complex]";
-                    }
-                }
-                DEBUG_PRINTF("[WiFi] /control set target=%s value=%s\n",
-                             target.c_str(),
-                             valStr.c_str());
-
-                auto readValueBool = [&](bool& out) -> bool {
-                    if (!hasValue) {
-                        out = false;
-                        return true;
-                    }
-                    CborValue tmp = valueIt;
-                    if (cbor_value_is_boolean(&tmp)) {
-                        return readCborBool_(&tmp, out);
-                    }
-                    if (cbor_value_is_integer(&tmp)) {
-                        int64_t v = 0;
-                        if (!readCborInt64_(&tmp, v)) return false;
-                        out = (v != 0);
-                        return true;
-                    }
-                    return false;
-                };
-
-                auto readValueInt = [&](int& out) -> bool {
-                    if (!hasValue) {
-                        out = 0;
-                        return true;
-                    }
-                    CborValue tmp = valueIt;
-                    if (cbor_value_is_integer(&tmp)) {
-                        int64_t v = 0;
-                        if (!readCborInt64_(&tmp, v)) return false;
-                        out = static_cast<int>(v);
-                        return true;
-                    }
-                    if (cbor_value_is_float(&tmp) || cbor_value_is_double(&tmp)) {
-                        double v = 0.0;
-                        if (!readCborDouble_(&tmp, v)) return false;
-                        out = static_cast<int>(lround(v));
-                        return true;
-                    }
-                    return false;
-                };
-
-                auto readValueFloat = [&](float& out) -> bool {
-                    if (!hasValue) {
-                        out = 0.0f;
-                        return true;
-                    }
-                    CborValue tmp = valueIt;
-                    double v = 0.0;
-                    if (!readCborDouble_(&tmp, v)) return false;
-                    out = static_cast<float>(v);
-                    return true;
-                };
-
-                auto readValueDouble = [&](double& out) -> bool {
-                    if (!hasValue) {
-                        out = 0.0;
-                        return true;
-                    }
-                    CborValue tmp = valueIt;
-                    return readCborDouble_(&tmp, out);
-                };
-
-                auto readValueString = [&](String& out) -> bool {
-                    if (!hasValue) {
-                        out = "";
-                        return true;
-                    }
-                    CborValue tmp = valueIt;
-                    return readCborText_(&tmp, out);
-                };
-
-                auto parseWireIndex = [&](const String& name,
-                                          const char* prefix) -> int {
-                    if (!name.startsWith(prefix)) return 0;
-                    const int idx = name.substring(strlen(prefix)).toInt();
-                    if (idx < 1 || idx > HeaterManager::kWireCount) return 0;
-                    return idx;
-                };
-
-                int wireIdx = parseWireIndex(target, "wireTau");
-                if (wireIdx > 0) {
-                    double v = 0.0;
-                    if (!readValueDouble(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v <= 0.0) v = DEFAULT_WIRE_MODEL_TAU;
-                    CONF->PutDouble(kWireModelTauKeys[wireIdx - 1], v);
-                    if (DEVICE) {
-                        const double k = CONF->GetDouble(kWireModelKKeys[wireIdx - 1],
-                                                         DEFAULT_WIRE_MODEL_K);
-                        const double c = CONF->GetDouble(kWireModelCKeys[wireIdx - 1],
-                                                         DEFAULT_WIRE_MODEL_C);
-                        DEVICE->getWireThermalModel()
-                            .setWireThermalParams(wireIdx, v, k, c);
-                    }
-                    sendStatusApplied_(request);
-                    return;
-                }
-                wireIdx = parseWireIndex(target, "wireK");
-                if (wireIdx > 0) {
-                    double v = 0.0;
-                    if (!readValueDouble(v)) {
+                        if (strcmp(key, "epoch") == 0) {
+                            uint64_t v = 0;
+                            if (!readCborUInt64_(it, v)) return false;
+                            epoch = static_cast<uint32_t>(v);
+                            return true;
+                        }
+                        return skipCborValue_(it);
+                    });
+                    if (!parsed) {
                         WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
                         return;
                     }
-                    if (!isfinite(v) || v <= 0.0) v = DEFAULT_WIRE_MODEL_K;
-                    CONF->PutDouble(kWireModelKKeys[wireIdx - 1], v);
-                    if (DEVICE) {
-                        const double tau = CONF->GetDouble(kWireModelTauKeys[wireIdx - 1],
-                                                           DEFAULT_WIRE_MODEL_TAU);
-                        const double c = CONF->GetDouble(kWireModelCKeys[wireIdx - 1],
-                                                         DEFAULT_WIRE_MODEL_C);
-                        DEVICE->getWireThermalModel()
-                            .setWireThermalParams(wireIdx, tau, v, c);
+
+                    if (epoch > 0 && RTC) {
+                        RTC->setUnixTime(epoch);
                     }
-                    sendStatusApplied_(request);
-                    return;
-                }
-                wireIdx = parseWireIndex(target, "wireC");
-                if (wireIdx > 0) {
-                    double v = 0.0;
-                    if (!readValueDouble(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
+
+                    if (action == "get" && target == "status") {
+                        const Device::StateSnapshot snap = DEVTRAN->getStateSnapshot();
+                        sendState_(request, stateName(snap.state));
                         return;
                     }
-                    if (!isfinite(v) || v <= 0.0) v = DEFAULT_WIRE_MODEL_C;
-                    CONF->PutDouble(kWireModelCKeys[wireIdx - 1], v);
-                    if (DEVICE) {
-                        const double tau = CONF->GetDouble(kWireModelTauKeys[wireIdx - 1],
-                                                           DEFAULT_WIRE_MODEL_TAU);
-                        const double k = CONF->GetDouble(kWireModelKKeys[wireIdx - 1],
-                                                         DEFAULT_WIRE_MODEL_K);
-                        DEVICE->getWireThermalModel()
-                            .setWireThermalParams(wireIdx, tau, k, v);
-                    }
-                    sendStatusApplied_(request);
-                    return;
-                }
-                wireIdx = parseWireIndex(target, "wireCalibrated");
-                if (wireIdx > 0) {
-                    bool v = false;
-                    if (!readValueBool(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
+                    if (action != "set") {
+                        WiFiCbor::sendError(request, 400, ERR_INVALID_ACTION_TARGET);
                         return;
                     }
-                    CONF->PutBool(kWireCalibDoneKeys[wireIdx - 1], v);
-                    sendStatusApplied_(request);
-                    return;
-                }
 
-                if (target == "reboot")                       c.type = CTRL_REBOOT;
-                else if (target == "systemReset")             c.type = CTRL_SYS_RESET;
-                else if (target == "ledFeedback")             { c.type = CTRL_LED_FEEDBACK_BOOL; if (!readValueBool(c.b1)) { WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR); return; } }
-                else if (target == "relay")                   { c.type = CTRL_RELAY_BOOL;        if (!readValueBool(c.b1)) { WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR); return; } }
-                else if (target.startsWith("output"))         { c.type = CTRL_OUTPUT_BOOL;       c.i1 = target.substring(6).toInt(); if (!readValueBool(c.b1)) { WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR); return; } }
-                else if (target == "acFrequency")             { c.type = CTRL_AC_FREQ;           if (!readValueInt(c.i1)) { WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR); return; } }
-                else if (target == "chargeResistor")          { c.type = CTRL_CHARGE_RES;        if (!readValueFloat(c.f1)) { WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR); return; } }
-                else if (target.startsWith("Access"))         { c.type = CTRL_ACCESS_BOOL;       c.i1 = target.substring(6).toInt(); if (!readValueBool(c.b1)) { WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR); return; } }
-                else if (target == "systemStart")             c.type = CTRL_SYSTEM_START;
-                else if (target == "systemWake")              c.type = CTRL_SYSTEM_WAKE;
-                else if (target == "systemShutdown")          c.type = CTRL_SYSTEM_SHUTDOWN;
-                else if (target == "fanSpeed")                { c.type = CTRL_FAN_SPEED;         if (!readValueInt(c.i1)) { WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR); return; } c.i1 = constrain(c.i1, 0, 100); }
-                else if (target == "buzzerMute")              { c.type = CTRL_BUZZER_MUTE;       if (!readValueBool(c.b1)) { WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR); return; } }
-                else if (target.startsWith("wireRes"))        { c.type = CTRL_WIRE_RES;          c.i1 = target.substring(7).toInt(); if (!readValueFloat(c.f1)) { WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR); return; } }
-                else if (target == "wireOhmPerM")             { c.type = CTRL_WIRE_OHM_PER_M;    if (!readValueFloat(c.f1)) { WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR); return; } }
-                else if (target == "wireGauge")               { c.type = CTRL_WIRE_GAUGE;        if (!readValueInt(c.i1)) { WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR); return; } }
-                else if (target == "currLimit")               { c.type = CTRL_CURR_LIMIT;        if (!readValueFloat(c.f1)) { WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR); return; } }
-                else if (target == "confirmWiresCool")        { c.type = CTRL_CONFIRM_WIRES_COOL; }
-                else if (target == "adminCredentials") {
-                    String current;
-                    String newUser;
-                    String newPass;
-                    String newSsid;
-                    String newWifiPass;
-                    if (hasValue && cbor_value_is_map(&valueIt)) {
+                    String valStr = "null";
+                    if (hasValue) {
                         CborValue tmp = valueIt;
-                        const bool parsedMap = parseCborValueMap_(&tmp, [&](const char* key, CborValue* it) {
-                            if (strcmp(key, "current") == 0) {
-                                return readCborText_(it, current);
-                            }
-                            if (strcmp(key, "username") == 0) {
-                                return readCborText_(it, newUser);
-                            }
-                            if (strcmp(key, "password") == 0) {
-                                return readCborText_(it, newPass);
+                        if (cbor_value_is_text_string(&tmp)) {
+                            readCborText_(&tmp, valStr);
+                        } else if (cbor_value_is_boolean(&tmp)) {
+                            bool b = false;
+                            if (cbor_value_get_boolean(&tmp, &b) == CborNoError) {
+                                valStr = b ? "true" : "false";
                             }
-                            if (strcmp(key, "wifiSSID") == 0) {
-                                return readCborText_(it, newSsid);
+                        } else if (cbor_value_is_integer(&tmp)) {
+                            int64_t v = 0;
+                            if (cbor_value_get_int64(&tmp, &v) == CborNoError) {
+                                valStr = String(static_cast<long long>(v));
                             }
-                            if (strcmp(key, "wifiPassword") == 0) {
-                                return readCborText_(it, newWifiPass);
+                        } else if (cbor_value_is_float(&tmp) || cbor_value_is_double(&tmp)) {
+                            double v = 0.0;
+                            if (cbor_value_get_double(&tmp, &v) == CborNoError) {
+                                valStr = String(v, 3);
                             }
-                            return skipCborValue_(it);
-                        });
-                        if (!parsedMap) {
-                            WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                            return;
+                        } else if (cbor_value_is_map(&tmp) || cbor_value_is_array(&tmp)) {
+                            valStr = "[complex]";
                         }
                     }
+                    DEBUG_PRINTF("[WiFi] /control set target=%s value=%s\n",
+                                 target.c_str(),
+                                 valStr.c_str());
 
-                    const String storedUser = CONF->GetString(ADMIN_ID_KEY, DEFAULT_ADMIN_ID);
-                    const String storedPass = CONF->GetString(ADMIN_PASS_KEY, DEFAULT_ADMIN_PASS);
-                    const String storedSsid = CONF->GetString(STA_SSID_KEY, DEFAULT_STA_SSID);
-                    const String storedWifiPass = CONF->GetString(STA_PASS_KEY, DEFAULT_STA_PASS);
-                    if (current.length() && current != storedPass) {
-                        WiFiCbor::sendError(request, 403, ERR_BAD_PASSWORD);
-                        return;
-                    }
-
-                    bool sessionChanged = false;
-                    bool wifiChanged = false;
+                    using ControlTargets::Op;
+                    using ControlTargets::Type;
 
-                    if (newUser.length() && newUser != storedUser) {
-                        CONF->PutString(ADMIN_ID_KEY, newUser);
-                        sessionChanged = true;
-                    }
-                    if (newPass.length() && newPass != storedPass) {
-                        CONF->PutString(ADMIN_PASS_KEY, newPass);
-                        sessionChanged = true;
-                    }
-                    if (newSsid.length() && newSsid != storedSsid) {
-                        CONF->PutString(STA_SSID_KEY, newSsid);
-                        wifiChanged = true;
-                    }
-                    if (newWifiPass.length() && newWifiPass != storedWifiPass) {
-                        CONF->PutString(STA_PASS_KEY, newWifiPass);
-                        wifiChanged = true;
+                    int32_t wireIdx = 0;
+                    const ControlTargets::Target* t =
+                        ControlTargets::resolve(target.c_str(), wireIdx);
+                    if (!t) {
+                        WiFiCbor::sendError(request, 400, ERR_UNKNOWN_TARGET);
+                        return;
                     }
 
-                    sendStatusApplied_(request);
-                    if (sessionChanged) {
-                        onDisconnected();
-                    }
-                    if (wifiChanged) {
-                        CONF->RestartSysDelayDown(3000);
-                    }
-                    return;
-                }
-                else if (target == "userCredentials") {
-                    String current;
-                    String newPass;
-                    String newId;
-                    if (hasValue && cbor_value_is_map(&valueIt)) {
-                        CborValue tmp = valueIt;
-                        const bool parsedMap = parseCborValueMap_(&tmp, [&](const char* key, CborValue* it) {
-                            if (strcmp(key, "current") == 0) {
-                                return readCborText_(it, current);
+                    // Read the value as the table says; a missing value reads
+                    // as false / 0 / "". Numbers go through the range rule.
+                    bool vBool = false;
+                    int vInt = 0;
+                    float vFloat = 0.0f;
+                    double vDouble = 0.0;
+                    String vText;
+                    bool valueOk = true;
+                    CborValue tmp = valueIt;
+                    switch (t->type) {
+                        case Type::Bool:
+                            if (!hasValue) break;
+                            if (cbor_value_is_boolean(&tmp)) {
+                                valueOk = readCborBool_(&tmp, vBool);
+                            } else if (cbor_value_is_integer(&tmp)) {
+                                int64_t v = 0;
+                                valueOk = readCborInt64_(&tmp, v);
+                                vBool = (v != 0);
+                            } else {
+                                valueOk = false;
                             }
-                            if (strcmp(key, "newPass") == 0) {
-                                return readCborText_(it, newPass);
+                            break;
+                        case Type::Int:
+                            if (hasValue) {
+                                if (cbor_value_is_integer(&tmp)) {
+                                    int64_t v = 0;
+                                    valueOk = readCborInt64_(&tmp, v);
+                                    vInt = static_cast<int>(v);
+                                } else if (cbor_value_is_float(&tmp) ||
+                                           cbor_value_is_double(&tmp)) {
+                                    double v = 0.0;
+                                    valueOk = readCborDouble_(&tmp, v);
+                                    vInt = static_cast<int>(lround(v));
+                                } else {
+                                    valueOk = false;
+                                }
                             }
-                            if (strcmp(key, "newId") == 0) {
-                                return readCborText_(it, newId);
+                            vInt = static_cast<int>(ControlTargets::normalize(*t, vInt));
+                            break;
+                        case Type::Float:
+                            if (hasValue) {
+                                double v = 0.0;
+                                valueOk = readCborDouble_(&tmp, v);
+                                vFloat = static_cast<float>(v);
                             }
-                            return skipCborValue_(it);
-                        });
-                        if (!parsedMap) {
-                            WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                            return;
-                        }
-                    }
-                    const String storedPass = CONF->GetString(USER_PASS_KEY, DEFAULT_USER_PASS);
-                    if (current.length() && current != storedPass) {
-                        WiFiCbor::sendError(request, 403, ERR_BAD_PASSWORD);
-                        return;
-                    }
-                    bool sessionChanged = false;
-                    const String storedId = CONF->GetString(USER_ID_KEY, DEFAULT_USER_ID);
-                    if (newId.length() && newId != storedId) {
-                        CONF->PutString(USER_ID_KEY, newId);
-                        sessionChanged = true;
-                    }
-                    if (newPass.length() && newPass != storedPass) {
-                        CONF->PutString(USER_PASS_KEY, newPass);
-                        sessionChanged = true;
-                    }
-                    sendStatusApplied_(request);
-                    if (sessionChanged) {
-                        onDisconnected();
-                    }
-                    return;
-                }
-                else if (target == "wifiSSID") {
-                    String ssid;
-                    if (!readValueString(ssid)) {
+                            vFloat = static_cast<float>(ControlTargets::normalize(*t, vFloat));
+                            break;
+                        case Type::Double:
+                            if (hasValue) valueOk = readCborDouble_(&tmp, vDouble);
+                            vDouble = ControlTargets::normalize(*t, vDouble);
+                            break;
+                        case Type::Text:
+                            if (hasValue) valueOk = readCborText_(&tmp, vText);
+                            break;
+                        case Type::None:
+                        case Type::Custom:
+                            break;
+                    }
+                    if (!valueOk) {
                         WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
                         return;
                     }
-                    bool changed = false;
-                    if (ssid.length()) {
-                        const String stored = CONF->GetString(STA_SSID_KEY, DEFAULT_STA_SSID);
-                        if (ssid != stored) {
-                            CONF->PutString(STA_SSID_KEY, ssid);
-                            changed = true;
+
+                    if (ControlTargets::isQueued(t->op)) {
+                        ControlCmd c{};
+                        c.type = static_cast<CtrlType>(t->op);
+                        c.i1 = (t->type == Type::Int) ? vInt : wireIdx;
+                        c.f1 = vFloat;
+                        c.b1 = vBool;
+                        if (sendCmd(c)) {
+                            sendStatusQueued_(request);
+                        } else {
+                            WiFiCbor::sendError(request, 503, ERR_CTRL_QUEUE_FULL);
                         }
-                    }
-                    sendStatusApplied_(request);
-                    if (changed) {
-                        CONF->RestartSysDelayDown(3000);
-                    }
-                    return;
-                }
-                else if (target == "wifiPassword") {
-                    String pw;
-                    if (!readValueString(pw)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
                         return;
                     }
-                    bool changed = false;
-                    if (pw.length()) {
-                        const String stored = CONF->GetString(STA_PASS_KEY, DEFAULT_STA_PASS);
-                        if (pw != stored) {
-                            CONF->PutString(STA_PASS_KEY, pw);
-                            changed = true;
+
+                    switch (t->op) {
+                        case Op::Store:
+                            switch (t->type) {
+                                case Type::Bool:   CONF->PutBool(t->key, vBool); break;
+                                case Type::Int:    CONF->PutInt(t->key, vInt); break;
+                                case Type::Float:  CONF->PutFloat(t->key, vFloat); break;
+                                case Type::Double: CONF->PutDouble(t->key, vDouble); break;
+                                default: break;
+                            }
+                            break;
+
+                        case Op::NtcBeta:
+                            if (NTC) NTC->setBeta(vFloat, true);
+                            else CONF->PutFloat(t->key, vFloat);
+                            break;
+                        case Op::NtcT0C:
+                            if (NTC) NTC->setT0C(vFloat, true);
+                            else CONF->PutFloat(t->key, vFloat);
+                            break;
+                        case Op::NtcR0:
+                            if (NTC) NTC->setR0(vFloat, true);
+                            else CONF->PutFloat(t->key, vFloat);
+                            break;
+                        case Op::NtcFixedRes:
+                            if (NTC) NTC->setFixedRes(vFloat, true);
+                            else CONF->PutFloat(t->key, vFloat);
+                            break;
+                        case Op::NtcSamples:
+                            if (NTC) NTC->setSampleCount(static_cast<uint8_t>(vInt), true);
+                            else CONF->PutInt(t->key, vInt);
+                            break;
+
+                        case Op::WireTau:   // consecutive: tau, k, c
+                        case Op::WireK:
+                        case Op::WireC: {
+                            const int w = wireIdx - 1;
+                            const char* const keys[3] = {
+                                kWireModelTauKeys[w], kWireModelKKeys[w], kWireModelCKeys[w]
+                            };
+                            const double defaults[3] = {
+                                DEFAULT_WIRE_MODEL_TAU, DEFAULT_WIRE_MODEL_K, DEFAULT_WIRE_MODEL_C
+                            };
+                            const int field = static_cast<int>(t->op) -
+                                              static_cast<int>(Op::WireTau);
+                            CONF->PutDouble(keys[field], vDouble);
+                            if (DEVICE) {
+                                double p[3];
+                                for (int i = 0; i < 3; ++i) {
+                                    p[i] = (i == field) ? vDouble
+                                                        : CONF->GetDouble(keys[i], defaults[i]);
+                                }
+                                DEVICE->getWireThermalModel()
+                                    .setWireThermalParams(wireIdx, p[0], p[1], p[2]);
+                            }
+                            break;
                         }
-                    }
-                    sendStatusApplied_(request);
-                    if (changed) {
-                        CONF->RestartSysDelayDown(3000);
-                    }
-                    return;
-                }
-                else if (target == "uiLanguage" || target == "language") {
-                    String langRaw;
-                    if (!readValueString(langRaw)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    const String norm = WiFiLang::normalizeLanguageCode(langRaw);
-                    CONF->PutString(UI_LANGUAGE_KEY, norm);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "tempWarnC") {
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v < 0.0f) v = 0.0f;
-                    CONF->PutFloat(TEMP_WARN_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "tempTripC") {
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v < 0.0f) v = DEFAULT_TEMP_THRESHOLD;
-                    CONF->PutFloat(TEMP_THRESHOLD_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "floorThicknessMm") {
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v < 0.0f) {
-                        v = DEFAULT_FLOOR_THICKNESS_MM;
-                    } else if (v > 0.0f) {
-                        if (v < FLOOR_THICKNESS_MIN_MM) v = FLOOR_THICKNESS_MIN_MM;
-                        if (v > FLOOR_THICKNESS_MAX_MM) v = FLOOR_THICKNESS_MAX_MM;
-                    }
-                    CONF->PutFloat(FLOOR_THICKNESS_MM_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "floorMaterial") {
-                    const int fallback = CONF->GetInt(FLOOR_MATERIAL_KEY, DEFAULT_FLOOR_MATERIAL);
-                    int code = fallback;
-                    if (hasValue) {
-                        CborValue tmp = valueIt;
-                        if (cbor_value_is_text_string(&tmp)) {
-                            String s;
-                            if (!readCborText_(&tmp, s)) {
-                                WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                                return;
+                        case Op::WireCalibrated:
+                            CONF->PutBool(kWireCalibDoneKeys[wireIdx - 1], vBool);
+                            break;
+
+                        case Op::AdminCredentials: {
+                            String current;
+                            String newUser;
+                            String newPass;
+                            String newSsid;
+                            String newWifiPass;
+                            if (hasValue && cbor_value_is_map(&valueIt)) {
+                                CborValue map = valueIt;
+                                const bool parsedMap = parseCborValueMap_(&map, [&](const char* key, CborValue* it) {
+                                    if (strcmp(key, "current") == 0) {
+                                        return readCborText_(it, current);
+                                    }
+                                    if (strcmp(key, "username") == 0) {
+                                        return readCborText_(it, newUser);
+                                    }
+                                    if (strcmp(key, "password") == 0) {
+                                        return readCborText_(it, newPass);
+                                    }
+                                    if (strcmp(key, "wifiSSID") == 0) {
+                                        return readCborText_(it, newSsid);
+                                    }
+                                    if (strcmp(key, "wifiPassword") == 0) {
+                                        return readCborText_(it, newWifiPass);
+                                    }
+                                    return skipCborValue_(it);
+                                });
+                                if (!parsedMap) {
+                                    WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
+                                    return;
+                                }
                             }
-                            code = parseFloorMaterialCode(s, fallback);
-                        } else if (cbor_value_is_integer(&tmp)) {
-                            int64_t v = 0;
-                            if (!readCborInt64_(&tmp, v)) {
-                                WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
+
+                            const String storedUser = CONF->GetString(ADMIN_ID_KEY, DEFAULT_ADMIN_ID);
+                            const String storedPass = CONF->GetString(ADMIN_PASS_KEY, DEFAULT_ADMIN_PASS);
+                            const String storedSsid = CONF->GetString(STA_SSID_KEY, DEFAULT_STA_SSID);
+                            const String storedWifiPass = CONF->GetString(STA_PASS_KEY, DEFAULT_STA_PASS);
+                            if (current.length() && current != storedPass) {
+                                WiFiCbor::sendError(request, 403, ERR_BAD_PASSWORD);
                                 return;
                             }
-                            if (v >= FLOOR_MAT_WOOD && v <= FLOOR_MAT_GRANITE) {
-                                code = static_cast<int>(v);
+
+                            bool sessionChanged = false;
+                            bool wifiChanged = false;
+
+                            if (newUser.length() && newUser != storedUser) {
+                                CONF->PutString(ADMIN_ID_KEY, newUser);
+                                sessionChanged = true;
+                            }
+                            if (newPass.length() && newPass != storedPass) {
+                                CONF->PutString(ADMIN_PASS_KEY, newPass);
+                                sessionChanged = true;
+                            }
+                            if (newSsid.length() && newSsid != storedSsid) {
+                                CONF->PutString(STA_SSID_KEY, newSsid);
+                                wifiChanged = true;
+                            }
+                            if (newWifiPass.length() && newWifiPass != storedWifiPass) {
+                                CONF->PutString(STA_PASS_KEY, newWifiPass);
+                                wifiChanged = true;
+                            }
+
+                            sendStatusApplied_(request);
+                            if (sessionChanged) {
+                                onDisconnected();
                             }
+                            if (wifiChanged) {
+                                CONF->RestartSysDelayDown(3000);
+                            }
+                            return;
                         }
-                    }
-                    CONF->PutInt(FLOOR_MATERIAL_KEY, code);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "floorMaxC") {
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v < 0.0f) v = DEFAULT_FLOOR_MAX_C;
-                    if (v > DEFAULT_FLOOR_MAX_C) v = DEFAULT_FLOOR_MAX_C;
-                    CONF->PutFloat(FLOOR_MAX_C_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "floorSwitchMarginC") {
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v <= 0.0f) v = DEFAULT_FLOOR_SWITCH_MARGIN_C;
-                    CONF->PutFloat(FLOOR_SWITCH_MARGIN_C_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "floorTau") {
-                    double v = 0.0;
-                    if (!readValueDouble(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v <= 0.0) v = DEFAULT_FLOOR_MODEL_TAU;
-                    CONF->PutDouble(FLOOR_MODEL_TAU_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "floorK") {
-                    double v = 0.0;
-                    if (!readValueDouble(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v <= 0.0) v = DEFAULT_FLOOR_MODEL_K;
-                    CONF->PutDouble(FLOOR_MODEL_K_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "floorC") {
-                    double v = 0.0;
-                    if (!readValueDouble(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v <= 0.0) v = DEFAULT_FLOOR_MODEL_C;
-                    CONF->PutDouble(FLOOR_MODEL_C_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "nichromeFinalTempC") {
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v < 0.0f) v = DEFAULT_NICHROME_FINAL_TEMP_C;
-                    CONF->PutFloat(NICHROME_FINAL_TEMP_C_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "currentSource") {
-                    int src = DEFAULT_CURRENT_SOURCE;
-                    if (hasValue) {
-                        CborValue tmp = valueIt;
-                        if (cbor_value_is_text_string(&tmp)) {
-                            String s;
-                            if (!readCborText_(&tmp, s)) {
-                                WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                                return;
+                        case Op::UserCredentials: {
+                            String current;
+                            String newPass;
+                            String newId;
+                            if (hasValue && cbor_value_is_map(&valueIt)) {
+                                CborValue map = valueIt;
+                                const bool parsedMap = parseCborValueMap_(&map, [&](const char* key, CborValue* it) {
+                                    if (strcmp(key, "current") == 0) {
+                                        return readCborText_(it, current);
+                                    }
+                                    if (strcmp(key, "newPass") == 0) {
+                                        return readCborText_(it, newPass);
+                                    }
+                                    if (strcmp(key, "newId") == 0) {
+                                        return readCborText_(it, newId);
+                                    }
+                                    return skipCborValue_(it);
+                                });
+                                if (!parsedMap) {
+                                    WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
+                                    return;
+                                }
                             }
-                            s.toLowerCase();
-                            src = (s.indexOf("acs") >= 0) ? CURRENT_SRC_ACS : CURRENT_SRC_ESTIMATE;
-                        } else if (cbor_value_is_integer(&tmp)) {
-                            int64_t v = 0;
-                            if (!readCborInt64_(&tmp, v)) {
-                                WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
+                            const String storedPass = CONF->GetString(USER_PASS_KEY, DEFAULT_USER_PASS);
+                            if (current.length() && current != storedPass) {
+                                WiFiCbor::sendError(request, 403, ERR_BAD_PASSWORD);
                                 return;
                             }
-                            src = (v == CURRENT_SRC_ACS) ? CURRENT_SRC_ACS : CURRENT_SRC_ESTIMATE;
+                            bool sessionChanged = false;
+                            const String storedId = CONF->GetString(USER_ID_KEY, DEFAULT_USER_ID);
+                            if (newId.length() && newId != storedId) {
+                                CONF->PutString(USER_ID_KEY, newId);
+                                sessionChanged = true;
+                            }
+                            if (newPass.length() && newPass != storedPass) {
+                                CONF->PutString(USER_PASS_KEY, newPass);
+                                sessionChanged = true;
+                            }
+                            sendStatusApplied_(request);
+                            if (sessionChanged) {
+                                onDisconnected();
+                            }
+                            return;
                         }
-                    }
-                    CONF->PutInt(CURRENT_SOURCE_KEY, src);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "presenceCalibrated") {
-                    bool v = false;
-                    if (!readValueBool(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    CONF->PutBool(CALIB_PRESENCE_DONE_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "presenceMinRatio" || target == "presenceMinRatioPct") {
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    float ratio = v;
-                    if (target == "presenceMinRatioPct" || ratio > 1.0f) {
-                        ratio = v / 100.0f;
-                    }
-                    if (!isfinite(ratio) || ratio <= 0.0f) {
-                        ratio = DEFAULT_PRESENCE_MIN_RATIO;
-                    }
-                    if (ratio < 0.10f) ratio = 0.10f;
-                    if (ratio > 1.00f) ratio = 1.00f;
-                    CONF->PutFloat(PRESENCE_MIN_RATIO_KEY, ratio);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "floorCalibrated") {
-                    bool v = false;
-                    if (!readValueBool(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    CONF->PutBool(CALIB_FLOOR_DONE_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcModel") {
-                    int model = DEFAULT_NTC_MODEL;
-                    if (hasValue) {
-                        CborValue tmp = valueIt;
-                        if (cbor_value_is_text_string(&tmp)) {
-                            String s;
-                            if (!readCborText_(&tmp, s)) {
-                                WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                                return;
+                        case Op::WifiSsid:
+                        case Op::WifiPassword: {
+                            bool changed = false;
+                            if (vText.length()) {
+                                const String stored = CONF->GetString(
+                                    t->key,
+                                    t->op == Op::WifiSsid ? DEFAULT_STA_SSID : DEFAULT_STA_PASS);
+                                if (vText != stored) {
+                                    CONF->PutString(t->key, vText);
+                                    changed = true;
+                                }
                             }
-                            s.toLowerCase();
-                            model = (s.indexOf("stein") >= 0 || s.indexOf("sh") >= 0) ? 1 : 0;
-                        } else if (cbor_value_is_integer(&tmp)) {
-                            int64_t v = 0;
-                            if (!readCborInt64_(&tmp, v)) {
-                                WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                                return;
+                            sendStatusApplied_(request);
+                            if (changed) {
+                                CONF->RestartSysDelayDown(3000);
                             }
-                            model = (v == 1) ? 1 : 0;
+                            return;
                         }
-                    }
-                    if (NTC) {
-                        NTC->setModel(model == 1 ? NtcSensor::Model::Steinhart
-                                                 : NtcSensor::Model::Beta, true);
-                    } else {
-                        CONF->PutInt(NTC_MODEL_KEY, model);
-                    }
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcBeta") {
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v <= 0.0f) v = DEFAULT_NTC_BETA;
-                    if (NTC) NTC->setBeta(v, true);
-                    else CONF->PutFloat(NTC_BETA_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcT0C") {
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v)) v = DEFAULT_NTC_T0_C;
-                    if (NTC) NTC->setT0C(v, true);
-                    else CONF->PutFloat(NTC_T0_C_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcR0") {
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v <= 0.0f) v = DEFAULT_NTC_R0_OHMS;
-                    if (NTC) NTC->setR0(v, true);
-                    else CONF->PutFloat(NTC_R0_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcShA" || target == "ntcShB" || target == "ntcShC") {
-                    float a = DEFAULT_NTC_SH_A;
-                    float b = DEFAULT_NTC_SH_B;
-                    float c = DEFAULT_NTC_SH_C;
-                    if (CONF) {
-                        a = CONF->GetFloat(NTC_SH_A_KEY, DEFAULT_NTC_SH_A);
-                        b = CONF->GetFloat(NTC_SH_B_KEY, DEFAULT_NTC_SH_B);
-                        c = CONF->GetFloat(NTC_SH_C_KEY, DEFAULT_NTC_SH_C);
-                    }
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (target == "ntcShA") a = v;
-                    else if (target == "ntcShB") b = v;
-                    else c = v;
+                        case Op::Language:
+                            CONF->PutString(t->key, WiFiLang::normalizeLanguageCode(vText));
+                            break;
 
-                    bool persisted = false;
-                    if (NTC) {
-                        persisted = NTC->setSteinhartCoefficients(a, b, c, true);
-                    }
-                    if (!persisted && CONF) {
-                        CONF->PutFloat(NTC_SH_A_KEY, a);
-                        CONF->PutFloat(NTC_SH_B_KEY, b);
-                        CONF->PutFloat(NTC_SH_C_KEY, c);
-                    }
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcFixedRes") {
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v <= 0.0f) v = DEFAULT_NTC_FIXED_RES_OHMS;
-                    if (NTC) NTC->setFixedRes(v, true);
-                    else CONF->PutFloat(NTC_FIXED_RES_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcMinC" || target == "ntcMaxC") {
-                    float minC = DEFAULT_NTC_MIN_C;
-                    float maxC = DEFAULT_NTC_MAX_C;
-                    if (CONF) {
-                        minC = CONF->GetFloat(NTC_MIN_C_KEY, DEFAULT_NTC_MIN_C);
-                        maxC = CONF->GetFloat(NTC_MAX_C_KEY, DEFAULT_NTC_MAX_C);
-                    }
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (target == "ntcMinC") minC = v;
-                    else maxC = v;
-                    if (!isfinite(minC)) minC = DEFAULT_NTC_MIN_C;
-                    if (!isfinite(maxC)) maxC = DEFAULT_NTC_MAX_C;
-                    if (minC >= maxC) {
-                        minC = DEFAULT_NTC_MIN_C;
-                        maxC = DEFAULT_NTC_MAX_C;
-                    }
-                    if (NTC) {
-                        NTC->setTempLimits(minC, maxC, true);
-                    } else {
-                        CONF->PutFloat(NTC_MIN_C_KEY, minC);
-                        CONF->PutFloat(NTC_MAX_C_KEY, maxC);
-                    }
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcSamples") {
-                    int v = 0;
-                    if (!readValueInt(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (v < 1) v = 1;
-                    if (v > 64) v = 64;
-                    if (NTC) NTC->setSampleCount(static_cast<uint8_t>(v), true);
-                    else CONF->PutInt(NTC_SAMPLES_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcPressMv" || target == "ntcReleaseMv" ||
-                         target == "ntcDebounceMs") {
-                    float pressMv = DEFAULT_NTC_PRESS_MV;
-                    float releaseMv = DEFAULT_NTC_RELEASE_MV;
-                    int debounceMs = DEFAULT_NTC_DEBOUNCE_MS;
-                    if (CONF) {
-                        pressMv = CONF->GetFloat(NTC_PRESS_MV_KEY, DEFAULT_NTC_PRESS_MV);
-                        releaseMv = CONF->GetFloat(NTC_RELEASE_MV_KEY, DEFAULT_NTC_RELEASE_MV);
-                        debounceMs = CONF->GetInt(NTC_DEBOUNCE_MS_KEY, DEFAULT_NTC_DEBOUNCE_MS);
-                    }
-                    if (target == "ntcPressMv") {
-                        float v = 0.0f;
-                        if (!readValueFloat(v)) {
-                            WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                            return;
+                        case Op::FloorMaterial: {
+                            const int fallback = CONF->GetInt(t->key, DEFAULT_FLOOR_MATERIAL);
+                            int code = fallback;
+                            if (hasValue) {
+                                if (cbor_value_is_text_string(&tmp)) {
+                                    String s;
+                                    if (!readCborText_(&tmp, s)) {
+                                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
+                                        return;
+                                    }
+                                    code = parseFloorMaterialCode(s, fallback);
+                                } else if (cbor_value_is_integer(&tmp)) {
+                                    int64_t v = 0;
+                                    if (!readCborInt64_(&tmp, v)) {
+                                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
+                                        return;
+                                    }
+                                    if (v >= FLOOR_MAT_WOOD && v <= FLOOR_MAT_GRANITE) {
+                                        code = static_cast<int>(v);
+                                    }
+                                }
+                            }
+                            CONF->PutInt(t->key, code);
+                            break;
                         }
-                        pressMv = v;
-                    } else if (target == "ntcReleaseMv") {
-                        float v = 0.0f;
-                        if (!readValueFloat(v)) {
-                            WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                            return;
+                        case Op::CurrentSource: {
+                            int src = DEFAULT_CURRENT_SOURCE;
+                            if (hasValue) {
+                                if (cbor_value_is_text_string(&tmp)) {
+                                    String s;
+                                    if (!readCborText_(&tmp, s)) {
+                                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
+                                        return;
+                                    }
+                                    s.toLowerCase();
+                                    if (s.indexOf("fus") >= 0) src = CURRENT_SRC_FUSED;
+                                    else src = (s.indexOf("acs") >= 0) ? CURRENT_SRC_ACS : CURRENT_SRC_ESTIMATE;
+                                } else if (cbor_value_is_integer(&tmp)) {
+                                    int64_t v = 0;
+                                    if (!readCborInt64_(&tmp, v)) {
+                                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
+                                        return;
+                                    }
+                                    if (v == CURRENT_SRC_ACS || v == CURRENT_SRC_FUSED) src = (int)v;
+                                    else src = CURRENT_SRC_ESTIMATE;
+                                }
+                            }
+                            CONF->PutInt(t->key, src);
+                            break;
                         }
-                        releaseMv = v;
-                    } else {
-                        int v = 0;
-                        if (!readValueInt(v)) {
-                            WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                            return;
+                        case Op::PresenceMinRatio: {
+                            // arg 1: presenceMinRatioPct (always percent).
+                            float ratio = vFloat;
+                            if (t->arg == 1 || ratio > 1.0f) {
+                                ratio = vFloat / 100.0f;
+                            }
+                            if (!isfinite(ratio) || ratio <= 0.0f) {
+                                ratio = DEFAULT_PRESENCE_MIN_RATIO;
+                            }
+                            if (ratio < 0.10f) ratio = 0.10f;
+                            if (ratio > 1.00f) ratio = 1.00f;
+                            CONF->PutFloat(t->key, ratio);
+                            break;
                         }
-                        debounceMs = v;
-                    }
-                    if (!isfinite(pressMv) || pressMv < 0.0f) pressMv = DEFAULT_NTC_PRESS_MV;
-                    if (!isfinite(releaseMv) || releaseMv < pressMv) releaseMv = pressMv;
-                    if (debounceMs < 0) debounceMs = 0;
-                    if (NTC) {
-                        NTC->setButtonThresholdsMv(pressMv, releaseMv,
-                                                   static_cast<uint32_t>(debounceMs), true);
-                    } else {
-                        CONF->PutFloat(NTC_PRESS_MV_KEY, pressMv);
-                        CONF->PutFloat(NTC_RELEASE_MV_KEY, releaseMv);
-                        CONF->PutInt(NTC_DEBOUNCE_MS_KEY, debounceMs);
-                    }
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcCalTargetC") {
-                    float v = 0.0f;
-                    if (!readValueFloat(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (!isfinite(v) || v <= 0.0f) v = DEFAULT_NTC_CAL_TARGET_C;
-                    CONF->PutFloat(NTC_CAL_TARGET_C_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcCalSampleMs") {
-                    int v = 0;
-                    if (!readValueInt(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (v < 50) v = 50;
-                    if (v > 5000) v = 5000;
-                    CONF->PutInt(NTC_CAL_SAMPLE_MS_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcCalTimeoutMs") {
-                    int v = 0;
-                    if (!readValueInt(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    if (v < 1000) v = 1000;
-                    if (v > 3600000) v = 3600000;
-                    CONF->PutInt(NTC_CAL_TIMEOUT_MS_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcCalibrated") {
-                    bool v = false;
-                    if (!readValueBool(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
-                    }
-                    CONF->PutBool(CALIB_NTC_DONE_KEY, v);
-                    sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "ntcGateIndex") {
-                    int v = 0;
-                    if (!readValueInt(v)) {
-                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
-                        return;
+
+                        case Op::NtcModel: {
+                            int model = DEFAULT_NTC_MODEL;
+                            if (hasValue) {
+                                if (cbor_value_is_text_string(&tmp)) {
+                                    String s;
+                                    if (!readCborText_(&tmp, s)) {
+                                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
+                                        return;
+                                    }
+                                    s.toLowerCase();
+                                    model = (s.indexOf("stein") >= 0 || s.indexOf("sh") >= 0) ? 1 : 0;
+                                } else if (cbor_value_is_integer(&tmp)) {
+                                    int64_t v = 0;
+                                    if (!readCborInt64_(&tmp, v)) {
+                                        WiFiCbor::sendError(request, 400, ERR_INVALID_CBOR);
+                                        return;
+                                    }
+                                    model = (v == 1) ? 1 : 0;
+                                }
+                            }
+                            if (NTC) {
+                                NTC->setModel(model == 1 ? NtcSensor::Model::Steinhart
+                                                         : NtcSensor::Model::Beta, true);
+                            } else {
+                                CONF->PutInt(t->key, model);
+                            }
+                            break;
+                        }
+                        case Op::NtcSteinhart: {
+                            // arg: 0 = A, 1 = B, 2 = C; the other two are kept.
+                            float sh[3] = { DEFAULT_NTC_SH_A, DEFAULT_NTC_SH_B, DEFAULT_NTC_SH_C };
+                            if (CONF) {
+                                sh[0] = CONF->GetFloat(NTC_SH_A_KEY, DEFAULT_NTC_SH_A);
+                                sh[1] = CONF->GetFloat(NTC_SH_B_KEY, DEFAULT_NTC_SH_B);
+                                sh[2] = CONF->GetFloat(NTC_SH_C_KEY, DEFAULT_NTC_SH_C);
+                            }
+                            sh[t->arg] = vFloat;
+
+                            bool persisted = false;
+                            if (NTC) {
+                                persisted = NTC->setSteinhartCoefficients(sh[0], sh[1], sh[2], true);
+                            }
+                            if (!persisted && CONF) {
+                                CONF->PutFloat(NTC_SH_A_KEY, sh[0]);
+                                CONF->PutFloat(NTC_SH_B_KEY, sh[1]);
+                                CONF->PutFloat(NTC_SH_C_KEY, sh[2]);
+                            }
+                            break;
+                        }
+                        case Op::NtcLimits: {
+                            // arg: 0 = ntcMinC, 1 = ntcMaxC.
+                            float minC = DEFAULT_NTC_MIN_C;
+                            float maxC = DEFAULT_NTC_MAX_C;
+                            if (CONF) {
+                                minC = CONF->GetFloat(NTC_MIN_C_KEY, DEFAULT_NTC_MIN_C);
+                                maxC = CONF->GetFloat(NTC_MAX_C_KEY, DEFAULT_NTC_MAX_C);
+                            }
+                            if (t->arg == 0) minC = vFloat;
+                            else maxC = vFloat;
+                            if (!isfinite(minC)) minC = DEFAULT_NTC_MIN_C;
+                            if (!isfinite(maxC)) maxC = DEFAULT_NTC_MAX_C;
+                            if (minC >= maxC) {
+                                minC = DEFAULT_NTC_MIN_C;
+                                maxC = DEFAULT_NTC_MAX_C;
+                            }
+                            if (NTC) {
+                                NTC->setTempLimits(minC, maxC, true);
+                            } else {
+                                CONF->PutFloat(NTC_MIN_C_KEY, minC);
+                                CONF->PutFloat(NTC_MAX_C_KEY, maxC);
+                            }
+                            break;
+                        }
+                        case Op::NtcButton: {
+                            // arg: 0 = ntcPressMv, 1 = ntcReleaseMv, 2 = ntcDebounceMs.
+                            float pressMv = DEFAULT_NTC_PRESS_MV;
+                            float releaseMv = DEFAULT_NTC_RELEASE_MV;
+                            int debounceMs = DEFAULT_NTC_DEBOUNCE_MS;
+                            if (CONF) {
+                                pressMv = CONF->GetFloat(NTC_PRESS_MV_KEY, DEFAULT_NTC_PRESS_MV);
+                                releaseMv = CONF->GetFloat(NTC_RELEASE_MV_KEY, DEFAULT_NTC_RELEASE_MV);
+                                debounceMs = CONF->GetInt(NTC_DEBOUNCE_MS_KEY, DEFAULT_NTC_DEBOUNCE_MS);
+                            }
+                            if (t->arg == 0) pressMv = vFloat;
+                            else if (t->arg == 1) releaseMv = vFloat;
+                            else debounceMs = vInt;
+                            if (!isfinite(pressMv) || pressMv < 0.0f) pressMv = DEFAULT_NTC_PRESS_MV;
+                            if (!isfinite(releaseMv) || releaseMv < pressMv) releaseMv = pressMv;
+                            if (debounceMs < 0) debounceMs = 0;
+                            if (NTC) {
+                                NTC->setButtonThresholdsMv(pressMv, releaseMv,
+                                                           static_cast<uint32_t>(debounceMs), true);
+                            } else {
+                                CONF->PutFloat(NTC_PRESS_MV_KEY, pressMv);
+                                CONF->PutFloat(NTC_RELEASE_MV_KEY, releaseMv);
+                                CONF->PutInt(NTC_DEBOUNCE_MS_KEY, debounceMs);
+                            }
+                            break;
+                        }
+
+                        default:
+                            WiFiCbor::sendError(request, 400, ERR_UNKNOWN_TARGET);
+                            return;
                     }
-                    if (v < 1) v = 1;
-                    if (v > HeaterManager::kWireCount) v = HeaterManager::kWireCount;
-                    CONF->PutInt(NTC_GATE_INDEX_KEY, v);
                     sendStatusApplied_(request);
-                    return;
-                }
-                else if (target == "calibrate")              { c.type = CTRL_CALIBRATE; }
-                else {
-                    WiFiCbor::sendError(request, 400, ERR_UNKNOWN_TARGET);
-                    return;
-                }
-
-                const bool ok = sendCmd(c);
-                if (ok) {
-                    sendStatusQueued_(request);
-                } else {
-                    WiFiCbor::sendError(request, 503, ERR_CTRL_QUEUE_FULL);
-                }
-            } else if (action == "get" && target == "status") {
-                const Device::StateSnapshot snap = DEVTRAN->getStateSnapshot();
-                sendState_(request, stateName(snap.state));
-            } else {
-                WiFiCbor::sendError(request, 400, ERR_INVALID_ACTION_TARGET);
-            }
+                });
         }
     );
 
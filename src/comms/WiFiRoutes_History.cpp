@@ -1,45 +1,183 @@
 #include <WiFiRoutesShared.hpp>
 
+namespace {
+constexpr uint16_t kHistoryPageDefault = 100;
+constexpr uint16_t kHistoryPageMax     = 200;
+// Entries one page may look at. A narrow time filter then costs a few
+// short (possibly empty) pages with a "next" instead of one long scan.
+constexpr uint16_t kHistoryScanMax     = 400;
+
+constexpr uint8_t kHistoryFields = 4;
+const char* const kHistoryFieldNames[kHistoryFields] = {
+    "energy_Wh", "duration_s", "peakPower_W", "peakCurrent_A"
+};
+const CborNumber::Resolution kHistoryFieldRes[kHistoryFields] = {
+    CborNumber::kEnergy, CborNumber::kExact, CborNumber::kPower, CborNumber::kCurrent
+};
+
+bool encodeHistoryRow(CborEncoder* row, const PowerTracker::HistoryEntry& h) {
+    return WiFiCbor::encodeKvUInt(row, "start_ms", h.startMs) &&
+           WiFiCbor::encodeKvUInt(row, "duration_s", h.stats.duration_s) &&
+           WiFiCbor::encodeKvFloat(row, "energy_Wh", h.stats.energy_Wh, CborNumber::kEnergy) &&
+           WiFiCbor::encodeKvFloat(row, "peakPower_W", h.stats.peakPower_W, CborNumber::kPower) &&
+           WiFiCbor::encodeKvFloat(row, "peakCurrent_A", h.stats.peakCurrent_A,
+                                   CborNumber::kCurrent);
+}
+
+uint32_t historyOldestSeq() {
+    const uint32_t end = POWER_TRACKER->getHistoryEndSeq();
+    const uint16_t count = POWER_TRACKER->getHistoryCount();
+    return (end > count) ? end - count : 0;
+}
+
+// {"history": [...]} newest first, one row per chunk piece. Rows are
+// addressed by append sequence from the end seen at request time, so a
+// session appended while the body is sent does not shift or repeat rows.
+static std::shared_ptr<CborChunkStream> makeHistoryStream(uint16_t count) {
+    const uint32_t dataset = POWER_TRACKER->getHistoryDataset();
+    uint32_t seq = POWER_TRACKER->getHistoryEndSeq();
+    const uint32_t first = (seq > count) ? seq - count : 0;
+    return WiFiCbor::makeArrayStream(
+        [](CborEncoder* map) {
+            return WiFiCbor::encodeText(map, "history");
+        },
+        [dataset, first, seq](CborEncoder* row) mutable {
+            if (seq <= first) return WiFiCbor::RowStep::End;
+            // Clear / load restarts the sequence; the rest is not ours.
+            if (POWER_TRACKER->getHistoryDataset() != dataset) return WiFiCbor::RowStep::End;
+            PowerTracker::HistoryEntry h;
+            // A miss is an entry overwritten since the request.
+            if (!POWER_TRACKER->getHistoryEntryBySeq(--seq, h)) {
+                return WiFiCbor::RowStep::Skip;
+            }
+            return encodeHistoryRow(row, h) ? WiFiCbor::RowStep::Row : WiFiCbor::RowStep::Error;
+        });
+}
+
+// {"history": [...], "next"?, "gap"?} newest first from walk.pos down.
+// Rows are addressed by append sequence, so sessions that end while the
+// client pages only show up on a fresh first page.
+static std::shared_ptr<CborChunkStream> makeHistoryPageStream(PageCursor::DescendingWalk walk,
+                                                              uint32_t dataset,
+                                                              const PageQuery_& q) {
+    const uint16_t limit = q.limit;
+    const uint32_t fromMs = q.fromMs;
+    const uint32_t toMs = q.toMs;
+    auto state = std::make_shared<PageCursor::DescendingWalk>(walk);
+    uint16_t rows = 0;
+    uint16_t scanned = 0;
+    return WiFiCbor::makeArrayStream(
+        [](CborEncoder* map) {
+            return WiFiCbor::encodeText(map, "history");
+        },
+        [state, limit, fromMs, toMs, rows, scanned](CborEncoder* row) mutable {
+            if (rows >= limit || scanned >= kHistoryScanMax) return WiFiCbor::RowStep::End;
+            uint32_t seq = 0;
+            if (!state->next(historyOldestSeq(), seq)) return WiFiCbor::RowStep::End;
+            ++scanned;
+            PowerTracker::HistoryEntry h;
+            // A miss is an entry overwritten since the walk began; the
+            // next call raises the floor past it and flags the gap.
+            if (!POWER_TRACKER->getHistoryEntryBySeq(seq, h)) return WiFiCbor::RowStep::Skip;
+            if (h.startMs < fromMs || h.startMs > toMs) return WiFiCbor::RowStep::Skip;
+            if (!encodeHistoryRow(row, h)) return WiFiCbor::RowStep::Error;
+            ++rows;
+            return WiFiCbor::RowStep::Row;
+        },
+        [state, dataset](CborEncoder* map) {
+            if (state->more(historyOldestSeq())) {
+                PageCursor::Token next;
+                next.source  = PageCursor::Source::History;
+                next.boot    = WiFiCbor::bootTag();
+                next.dataset = dataset;
+                next.pos     = state->pos;
+                next.floor   = state->floor;
+                if (!encodeKvCursor_(map, next)) return false;
+            }
+            return !state->gap || WiFiCbor::encodeKvBool(map, "gap", true);
+        });
+}
+
+// {"x": "seq", "width", "buckets": [...]} oldest first. Sessions are
+// bucketed by append sequence: start_ms restarts with every boot, so it
+// is a filter here, not an axis.
+static std::shared_ptr<CborChunkStream> makeHistoryBucketStream(const PageQuery_& q) {
+    const uint32_t end = POWER_TRACKER->getHistoryEndSeq();
+    const uint32_t first = historyOldestSeq();
+    auto dec = std::make_shared<Decimator>(first, end ? end - 1 : 0, q.width, kHistoryFields);
+    const uint32_t fromMs = q.fromMs;
+    const uint32_t toMs = q.toMs;
+    uint32_t seq = first;
+    bool flushed = false;
+    return WiFiCbor::makeArrayStream(
+        [dec](CborEncoder* map) {
+            return WiFiCbor::encodeKvText(map, "x", "seq") &&
+                   WiFiCbor::encodeKvUInt(map, "width", dec->width()) &&
+                   WiFiCbor::encodeText(map, "buckets");
+        },
+        [dec, end, fromMs, toMs, seq, flushed](CborEncoder* row) mutable {
+            bool ready = false;
+            while (!ready && seq < end) {
+                PowerTracker::HistoryEntry h;
+                const uint32_t s = seq++;
+                if (!POWER_TRACKER->getHistoryEntryBySeq(s, h)) continue;
+                if (h.startMs < fromMs || h.startMs > toMs) continue;
+                const float v[kHistoryFields] = {
+                    h.stats.energy_Wh, static_cast<float>(h.stats.duration_s),
+                    h.stats.peakPower_W, h.stats.peakCurrent_A
+                };
+                ready = dec->add(s, v);
+            }
+            if (!ready) {
+                if (flushed || !dec->finish()) return WiFiCbor::RowStep::End;
+                flushed = true;
+            }
+            return encodeBucket_(row, dec->ready(), kHistoryFields, kHistoryFieldNames,
+                                 kHistoryFieldRes)
+                       ? WiFiCbor::RowStep::Row
+                       : WiFiCbor::RowStep::Error;
+        });
+}
+} // namespace
+
 void WiFiManager::registerHistoryRoutes_() {
     // ---- Session history (CBOR) ----
     server.on(EP_SESSION_HISTORY, HTTP_GET,
         [this](AsyncWebServerRequest* request) {
             if (!isAuthenticated(request)) return;
             if (lock()) { lastActivityMillis = millis(); unlock(); }
-            const uint16_t count = POWER_TRACKER->getHistoryCount();
-            const size_t capacity = 256 + (size_t)count * 80;
-
-            std::vector<uint8_t> payload;
-            if (!WiFiCbor::buildMapPayload(payload, capacity, [&](CborEncoder* map) {
-                    if (!WiFiCbor::encodeText(map, "history")) return false;
-                    CborEncoder arr;
-                    if (cbor_encoder_create_array(map, &arr, CborIndefiniteLength) != CborNoError) {
-                        return false;
-                    }
-
-                    for (uint16_t i = 0; i < count; ++i) {
-                        PowerTracker::HistoryEntry h;
-                        if (!POWER_TRACKER->getHistoryEntry(i, h) || !h.valid) continue;
-                        CborEncoder row;
-                        if (cbor_encoder_create_map(&arr, &row, CborIndefiniteLength) != CborNoError) {
-                            return false;
-                        }
-                        if (!WiFiCbor::encodeKvUInt(&row, "start_ms", h.startMs)) return false;
-                        if (!WiFiCbor::encodeKvUInt(&row, "duration_s", h.stats.duration_s)) return false;
-                        if (!WiFiCbor::encodeKvFloat(&row, "energy_Wh", h.stats.energy_Wh)) return false;
-                        if (!WiFiCbor::encodeKvFloat(&row, "peakPower_W", h.stats.peakPower_W)) return false;
-                        if (!WiFiCbor::encodeKvFloat(&row, "peakCurrent_A", h.stats.peakCurrent_A)) return false;
-                        if (cbor_encoder_close_container(&arr, &row) != CborNoError) {
-                            return false;
-                        }
-                    }
+            const HttpConditional::Validator v = WiFiCbor::makeValidator(
+                "h", POWER_TRACKER->getHistoryGeneration(),
+                POWER_TRACKER->getHistoryModifiedEpoch());
+            if (WiFiCbor::sendNotModified(request, v)) return;
 
-                    return cbor_encoder_close_container(map, &arr) == CborNoError;
-                })) {
-                request->send(500, CT_TEXT_PLAIN, WiFiLang::getPlainError());
+            const PageQuery_ q = readPageQuery_(request);
+            if (q.width > 0) {
+                WiFiCbor::sendChunked(request, 200, makeHistoryBucketStream(q), nullptr, &v);
                 return;
             }
-            WiFiCbor::sendPayload(request, 200, payload);
+            if (!q.paged) {
+                const uint16_t count = POWER_TRACKER->getHistoryCount();
+                WiFiCbor::sendChunked(request, 200, makeHistoryStream(count), nullptr, &v);
+                return;
+            }
+
+            const uint32_t dataset = POWER_TRACKER->getHistoryDataset();
+            PageCursor::DescendingWalk walk;
+            if (q.cursor.length() > 0) {
+                PageCursor::Token t;
+                if (!resumeCursor_(request, q, PageCursor::Source::History, dataset, t)) return;
+                walk.pos = t.pos;
+                walk.floor = t.floor;
+            } else {
+                walk.pos = POWER_TRACKER->getHistoryEndSeq();
+                walk.floor = historyOldestSeq();
+            }
+            PageQuery_ page = q;
+            if (page.limit == 0) page.limit = kHistoryPageDefault;
+            if (page.limit > kHistoryPageMax) page.limit = kHistoryPageMax;
+            WiFiCbor::sendChunked(request, 200, makeHistoryPageStream(walk, dataset, page),
+                                  nullptr, &v);
         }
     );
 
@@ -53,36 +191,11 @@ void WiFiManager::registerHistoryRoutes_() {
                 sendHistoryEmpty_(request);
                 return;
             }
-            const size_t capacity = 256 + (size_t)count * 80;
-            std::vector<uint8_t> payload;
-            if (!WiFiCbor::buildMapPayload(payload, capacity, [&](CborEncoder* map) {
-                    if (!WiFiCbor::encodeText(map, "history")) return false;
-                    CborEncoder arr;
-                    if (cbor_encoder_create_array(map, &arr, CborIndefiniteLength) != CborNoError) {
-                        return false;
-                    }
-                    for (uint16_t i = 0; i < count; ++i) {
-                        PowerTracker::HistoryEntry h;
-                        if (!POWER_TRACKER->getHistoryEntry(i, h) || !h.valid) continue;
-                        CborEncoder row;
-                        if (cbor_encoder_create_map(&arr, &row, CborIndefiniteLength) != CborNoError) {
-                            return false;
-                        }
-                        if (!WiFiCbor::encodeKvUInt(&row, "start_ms", h.startMs)) return false;
-                        if (!WiFiCbor::encodeKvUInt(&row, "duration_s", h.stats.duration_s)) return false;
-                        if (!WiFiCbor::encodeKvFloat(&row, "energy_Wh", h.stats.energy_Wh)) return false;
-                        if (!WiFiCbor::encodeKvFloat(&row, "peakPower_W", h.stats.peakPower_W)) return false;
-                        if (!WiFiCbor::encodeKvFloat(&row, "peakCurrent_A", h.stats.peakCurrent_A)) return false;
-                        if (cbor_encoder_close_container(&arr, &row) != CborNoError) {
-                            return false;
-                        }
-                    }
-                    return cbor_encoder_close_container(map, &arr) == CborNoError;
-                })) {
-                request->send(500, CT_TEXT_PLAIN, WiFiLang::getPlainError());
-                return;
-            }
-            WiFiCbor::sendPayload(request, 200, payload);
+            const HttpConditional::Validator v = WiFiCbor::makeValidator(
+                "hf", POWER_TRACKER->getHistoryGeneration(),
+                POWER_TRACKER->getHistoryModifiedEpoch());
+            if (WiFiCbor::sendNotModified(request, v)) return;
+            WiFiCbor::sendChunked(request, 200, makeHistoryStream(count), nullptr, &v);
         }
     );
 }
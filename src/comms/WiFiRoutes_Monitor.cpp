@@ -1,4 +1,5 @@
 #include <WiFiRoutesShared.hpp>
+#include <LiveColumnar.hpp>
 
 void WiFiManager::registerMonitorRoutes_() {
     // ---- Live monitor stream (SSE) ----
@@ -13,38 +14,22 @@ void WiFiManager::registerMonitorRoutes_() {
             if (request->hasParam("seq")) {
                 since = request->getParam("seq")->value().toInt();
             }
+            // ?fmt=col: columnar batch (LiveColumnar.hpp); default rows.
+            const bool columnar = request->hasParam("fmt") &&
+                request->getParam("fmt")->value() == LiveColumnar::kFormat;
 
-            uint32_t seqStart = 0;
+            std::vector<uint8_t> payload(3072);
+            size_t len = 0;
             uint32_t seqEnd = 0;
-            std::vector<uint8_t> payload;
-            if (!WiFiCbor::buildMapPayload(payload, 3072, [&](CborEncoder* map) {
-                    if (!WiFiCbor::encodeText(map, "items")) return false;
-                    CborEncoder items;
-                    if (cbor_encoder_create_array(map, &items, CborIndefiniteLength) != CborNoError) {
-                        return false;
-                    }
-                    if (_snapMtx &&
-                        xSemaphoreTake(_snapMtx, pdMS_TO_TICKS(20)) == pdTRUE) {
-                        buildLiveBatch(&items, since, seqStart, seqEnd);
-                        xSemaphoreGive(_snapMtx);
-                    }
-                    if (cbor_encoder_close_container(map, &items) != CborNoError) {
-                        return false;
-                    }
-                    if (seqStart != 0) {
-                        if (!WiFiCbor::encodeKvUInt(map, "seqStart", seqStart)) return false;
-                        if (!WiFiCbor::encodeKvUInt(map, "seqEnd", seqEnd)) return false;
-                    }
-                    return true;
-                })) {
+            if (!encodeLiveBatch_(payload.data(), payload.size(), len, since, 1,
+                                  kLiveBufSize, seqEnd, columnar)) {
                 request->send(500, CT_TEXT_PLAIN, WiFiLang::getPlainError());
                 return;
             }
+            payload.resize(len);
             WiFiCbor::sendPayload(request, 200, payload);
         }
     );
-    // ---- Live monitor stream (SSE) ----
-    server.addHandler(&liveSse);
 
     // ---- Monitor (uses snapshot) ----
     server.on(EP_MONITOR, HTTP_GET,
@@ -52,12 +37,15 @@ void WiFiManager::registerMonitorRoutes_() {
             if (!isAuthenticated(request)) return;
             if (lock()) { lastActivityMillis = millis(); keepAlive = true; unlock(); }
 
-            std::vector<uint8_t> payload;
-            if (!getMonitorCbor(payload)) {
+            // Only before the first snapshot is published.
+            const FramePtr frame = acquireFrame_();
+            if (!frame || frame->monitorCbor.empty()) {
                 WiFiCbor::sendError(request, 503, ERR_SNAPSHOT_BUSY);
                 return;
             }
-            WiFiCbor::sendPayload(request, 200, payload);
+            WiFiCbor::sendSharedPayload(
+                request, 200,
+                std::shared_ptr<const std::vector<uint8_t>>(frame, &frame->monitorCbor));
         }
     );
 }
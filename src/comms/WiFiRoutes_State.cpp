@@ -5,4 +5,18 @@ void WiFiManager::registerStateRoutes_() {
     server.addHandler(&stateSse);
     // ---- Event stream (SSE) ----
     server.addHandler(&eventSse);
+    // ---- Binary telemetry (WebSocket) ----
+    // The handshake must carry the session token (?token=).
+    telemetryWs.setFilter([this](AsyncWebServerRequest* request) {
+        return wifiStatus != WiFiStatus::NotConnected && validateSession_(request);
+    });
+    telemetryWs.onEvent([this](AsyncWebSocket* /*server*/,
+                               AsyncWebSocketClient* client,
+                               AwsEventType type,
+                               void* arg,
+                               uint8_t* data,
+                               size_t len) {
+        onTelemetryWsEvent_(client, type, arg, data, len);
+    });
+    server.addHandler(&telemetryWs);
 }
@@ -4,6 +4,11 @@
 #include <Utils.hpp>
 #include <DeviceTransport.hpp>
 #include <NtcSensor.hpp>
+#include <BusSampler.hpp>
+#include <TelemetryChannel.hpp>
+#include <LiveStreamPacer.hpp>
+#include <CborTemplate.hpp>
+#include <LiveColumnar.hpp>
 #include <math.h>
 
 namespace {
@@ -22,7 +27,7 @@ static int getCurrentSourceSetting() {
     if (CONF) {
         src = CONF->GetInt(CURRENT_SOURCE_KEY, DEFAULT_CURRENT_SOURCE);
     }
-    if (src != CURRENT_SRC_ACS) {
+    if (src != CURRENT_SRC_ACS && src != CURRENT_SRC_FUSED) {
         src = CURRENT_SRC_ESTIMATE;
     }
     return src;
@@ -39,7 +44,15 @@ static float readAcsCurrent() {
 }
 
 static float sampleCurrentFromSource(float busVoltage, uint16_t mask) {
-    if (getCurrentSourceSetting() == CURRENT_SRC_ACS) {
+    const int src = getCurrentSourceSetting();
+    if (src == CURRENT_SRC_FUSED && BUS_SAMPLER) {
+        // Passive read: the sampler task owns the filter state.
+        const float i = BUS_SAMPLER->getFusedCurrent().currentA;
+        if (isfinite(i)) {
+            return i;
+        }
+    }
+    if (src == CURRENT_SRC_ACS) {
         const float i = readAcsCurrent();
         if (isfinite(i)) {
             return i;
@@ -87,18 +100,203 @@ static void appendBase64_(String& out, const uint8_t* data, size_t len) {
     }
 }
 
-template <typename BuildFn>
-static bool buildCborBase64_(String& out, size_t capacity, BuildFn build) {
-    std::vector<uint8_t> payload;
-    if (!WiFiCbor::buildMapPayload(payload, capacity, build)) {
+static void toBase64_(String& out, const uint8_t* data, size_t len) {
+    out = "";
+    out.reserve(((len + 2) / 3) * 4);
+    appendBase64_(out, data, len);
+}
+
+// Frame scratch sizes: telemetry header + the CBOR map.
+constexpr size_t kStateCborMax = 96;
+constexpr size_t kEventCborMax = 256;
+constexpr size_t kEventSnapshotCborMax = 512;
+// Live: a full batch, or the /monitor snapshot a resync sends instead.
+constexpr size_t kLiveBatchCborMax =
+    LIVE_STREAM_FRAME_OVERHEAD + LIVE_STREAM_MAX_BATCH * LIVE_STREAM_SAMPLE_BYTES;
+constexpr size_t kLiveFrameMax = TelemetryFrame::kHeaderLen + kMonitorCborMax;
+// SSE live batches wait while clients average this many queued messages.
+constexpr size_t kLiveSseMaxWaiting = 4;
+
+// Fixed-shape part of /monitor: keys encoded once into a CborTemplate,
+// values patched in place every snapshot. Fields that come and go (floor,
+// precharge, session, ...) are still encoded per snapshot around it.
+constexpr uint32_t kMonitorShape =
+    (static_cast<uint32_t>(MAX_TEMP_SENSORS) << 8) | HeaterManager::kWireCount;
+// wireRes is only sent with a DEVICE (estimator) to report, as before.
+constexpr uint32_t kMonitorShapeRes = 1u << 16;
+
+struct MonitorSlots {
+    using Id = CborTemplate::SlotId;
+    Id capVoltage, capAdcRaw, current, currentAcs, capacitanceF;
+    Id temps[MAX_TEMP_SENSORS];
+    Id boardTemp, heatsinkTemp;
+    Id wireTemps[HeaterManager::kWireCount];
+    Id wirePresent[HeaterManager::kWireCount];
+    Id wireHealth[HeaterManager::kWireCount];
+    Id resOhm[HeaterManager::kWireCount];
+    Id resConf[HeaterManager::kWireCount];
+    Id resDrift[HeaterManager::kWireCount];
+    Id outputs[HeaterManager::kWireCount];
+    Id ready, off, ac, relay, fanSpeed, wifiSta, wifiConnected;
+    Id totalEnergyWh, totalSessions, totalSessionsOk;
+};
+
+static CborTemplate s_monitorTpl;   // snapshot task only
+static MonitorSlots s_monitorSlots;
+
+static bool buildMonitorTemplate(CborTemplate& t, MonitorSlots& m, uint32_t shape) {
+    constexpr uint8_t kWires = HeaterManager::kWireCount;
+    t.reset(shape);
+    m.capVoltage = t.addF32("capVoltage");
+    m.capAdcRaw = t.addF32("capAdcRaw");
+    m.current = t.addF32("current");
+    m.currentAcs = t.addF32("currentAcs");
+    m.capacitanceF = t.addF32("capacitanceF");
+
+    t.beginArray("temperatures");
+    for (uint8_t i = 0; i < MAX_TEMP_SENSORS; ++i) m.temps[i] = t.f32();
+    t.end();
+    m.boardTemp = t.addF32("boardTemp");
+    m.heatsinkTemp = t.addF32("heatsinkTemp");
+
+    t.beginArray("wireTemps");
+    for (uint8_t i = 0; i < kWires; ++i) m.wireTemps[i] = t.i32();
+    t.end();
+    t.beginArray("wirePresent");
+    for (uint8_t i = 0; i < kWires; ++i) m.wirePresent[i] = t.boolean();
+    t.end();
+    t.beginArray("wireHealth");
+    for (uint8_t i = 0; i < kWires; ++i) m.wireHealth[i] = t.u32();
+    t.end();
+
+    // Online resistance estimate: ohm, confidence [%], drift vs calibration [%].
+    if (shape & kMonitorShapeRes) {
+        t.beginMap("wireRes");
+        t.beginArray("ohm");
+        for (uint8_t i = 0; i < kWires; ++i) m.resOhm[i] = t.f32();
+        t.end();
+        t.beginArray("conf");
+        for (uint8_t i = 0; i < kWires; ++i) m.resConf[i] = t.f32();
+        t.end();
+        t.beginArray("drift");
+        for (uint8_t i = 0; i < kWires; ++i) m.resDrift[i] = t.f32();
+        t.end();
+        t.end();
+    } else {
+        for (uint8_t i = 0; i < kWires; ++i) {
+            m.resOhm[i] = m.resConf[i] = m.resDrift[i] = CborTemplate::kNoSlot;
+        }
+    }
+
+    t.beginMap("outputs");
+    for (uint8_t i = 0; i < kWires; ++i) {
+        char key[12];
+        snprintf(key, sizeof(key), "output%u", (unsigned)(i + 1));
+        m.outputs[i] = t.addBool(key);
+    }
+    t.end();
+
+    m.ready = t.addBool("ready");
+    m.off = t.addBool("off");
+    m.ac = t.addBool("ac");
+    m.relay = t.addBool("relay");
+    m.fanSpeed = t.addU32("fanSpeed");
+    m.wifiSta = t.addBool("wifiSta");
+    m.wifiConnected = t.addBool("wifiConnected");
+
+    t.beginMap("sessionTotals");
+    m.totalEnergyWh = t.addF32("totalEnergy_Wh");
+    m.totalSessions = t.addU32("totalSessions");
+    m.totalSessionsOk = t.addU32("totalSessionsOk");
+    t.end();
+    return t.finish();
+}
+
+static bool encodeStateMap_(CborEncoder* map, const Device::StateSnapshot& snap,
+                            const char* state) {
+    if (!WiFiCbor::encodeKvText(map, "state", state)) return false;
+    if (!WiFiCbor::encodeKvUInt(map, "seq", snap.seq)) return false;
+    return WiFiCbor::encodeKvUInt(map, "sinceMs", snap.sinceMs);
+}
+
+static bool encodeEventEntry_(CborEncoder* map, const char* key,
+                              const Device::EventEntry& entry,
+                              WiFiLang::UiLanguage lang) {
+    if (!WiFiCbor::encodeText(map, key)) return false;
+    CborEncoder e;
+    if (cbor_encoder_create_map(map, &e, CborIndefiniteLength) != CborNoError) {
+        return false;
+    }
+    const String reason = WiFiLang::translateReason(entry.reason, lang);
+    if (!WiFiCbor::encodeKvText(&e, "reason", reason)) return false;
+    if (entry.ms) {
+        if (!WiFiCbor::encodeKvUInt(&e, "ms", entry.ms)) return false;
+    }
+    if (entry.epoch) {
+        if (!WiFiCbor::encodeKvUInt(&e, "epoch", entry.epoch)) return false;
+    }
+    return cbor_encoder_close_container(map, &e) == CborNoError;
+}
+
+static bool encodeUnread_(CborEncoder* map, uint32_t warn, uint32_t err) {
+    if (!WiFiCbor::encodeText(map, "unread")) return false;
+    CborEncoder unread;
+    if (cbor_encoder_create_map(map, &unread, CborIndefiniteLength) != CborNoError) {
+        return false;
+    }
+    if (!WiFiCbor::encodeKvUInt(&unread, "warn", warn)) return false;
+    if (!WiFiCbor::encodeKvUInt(&unread, "error", err)) return false;
+    return cbor_encoder_close_container(map, &unread) == CborNoError;
+}
+
+// {kind:"snapshot", unread, last_warning?, last_error?} sent on connect.
+static bool encodeEventSnapshotMap_(CborEncoder* map) {
+    uint8_t warnCount = 0;
+    uint8_t errCount = 0;
+    DEVICE->getUnreadEventCounts(warnCount, errCount);
+
+    Device::EventEntry warnEntries[1]{};
+    Device::EventEntry errEntries[1]{};
+    const bool hasWarn = (DEVICE->getWarningHistory(warnEntries, 1) > 0);
+    const bool hasErr = (DEVICE->getErrorHistory(errEntries, 1) > 0);
+    const WiFiLang::UiLanguage lang = WiFiLang::getCurrentLanguage();
+
+    if (!WiFiCbor::encodeKvText(map, "kind", "snapshot")) return false;
+    if (!encodeUnread_(map, warnCount, errCount)) return false;
+    if (hasWarn && !encodeEventEntry_(map, "last_warning", warnEntries[0], lang)) {
+        return false;
+    }
+    if (hasErr && !encodeEventEntry_(map, "last_error", errEntries[0], lang)) {
         return false;
     }
-    out = "";
-    const size_t outLen = ((payload.size() + 2) / 3) * 4;
-    out.reserve(outLen);
-    appendBase64_(out, payload.data(), payload.size());
     return true;
 }
+
+static bool encodeEventNoticeMap_(CborEncoder* map, const Device::EventNotice& note) {
+    const WiFiLang::UiLanguage lang = WiFiLang::getCurrentLanguage();
+    const char* kind =
+        (note.kind == Device::EventKind::Warning) ? "warning" : "error";
+    if (!WiFiCbor::encodeKvText(map, "kind", kind)) return false;
+    const String reason = WiFiLang::translateReason(note.reason, lang);
+    if (!WiFiCbor::encodeKvText(map, "reason", reason)) return false;
+    if (note.ms) {
+        if (!WiFiCbor::encodeKvUInt(map, "ms", note.ms)) return false;
+    }
+    if (note.epoch) {
+        if (!WiFiCbor::encodeKvUInt(map, "epoch", note.epoch)) return false;
+    }
+    return encodeUnread_(map, note.unreadWarn, note.unreadErr);
+}
+
+// Encodes the map after a reserved telemetry header in frame; len is the
+// CBOR length (the frame is kHeaderLen + len bytes).
+template <typename BuildFn>
+static bool encodeFrame_(uint8_t* frame, size_t capacity, size_t& len, BuildFn&& build) {
+    if (capacity <= TelemetryFrame::kHeaderLen) return false;
+    return WiFiCbor::buildMapInto(frame + TelemetryFrame::kHeaderLen,
+                                  capacity - TelemetryFrame::kHeaderLen,
+                                  len, build);
+}
 } // namespace
 
 const char* WiFiManager::stateName(DeviceState s) {
@@ -129,15 +327,16 @@ void WiFiManager::startStateStreamTask() {
         }
 
         Device::StateSnapshot snap = DEVTRAN->getStateSnapshot();
-        String payload;
+        uint8_t frame[TelemetryFrame::kHeaderLen + kStateCborMax];
+        size_t len = 0;
         const char* state = stateName(snap.state);
-        if (!buildCborBase64_(payload, 96, [&](CborEncoder* map) {
-                if (!WiFiCbor::encodeKvText(map, "state", state)) return false;
-                if (!WiFiCbor::encodeKvUInt(map, "seq", snap.seq)) return false;
-                return WiFiCbor::encodeKvUInt(map, "sinceMs", snap.sinceMs);
+        if (!encodeFrame_(frame, sizeof(frame), len, [&](CborEncoder* map) {
+                return encodeStateMap_(map, snap, state);
             })) {
             return;
         }
+        String payload;
+        toBase64_(payload, frame + TelemetryFrame::kHeaderLen, len);
         client->send(payload.c_str(), SSE_EVENT_STATE, snap.seq);
     });
 
@@ -163,16 +362,21 @@ void WiFiManager::stateStreamTask(void* pv) {
         Device::StateSnapshot snap{};
         if (!dt->waitForStateEvent(snap, portMAX_DELAY)) continue;
 
-        String payload;
+        // One encode; SSE gets it base64'd, the WebSocket raw.
+        uint8_t frame[TelemetryFrame::kHeaderLen + kStateCborMax];
+        size_t len = 0;
         const char* state = stateName(snap.state);
-        if (!buildCborBase64_(payload, 96, [&](CborEncoder* map) {
-                if (!WiFiCbor::encodeKvText(map, "state", state)) return false;
-                if (!WiFiCbor::encodeKvUInt(map, "seq", snap.seq)) return false;
-                return WiFiCbor::encodeKvUInt(map, "sinceMs", snap.sinceMs);
+        if (!encodeFrame_(frame, sizeof(frame), len, [&](CborEncoder* map) {
+                return encodeStateMap_(map, snap, state);
             })) {
             continue;
         }
-        self->stateSse.send(payload.c_str(), SSE_EVENT_STATE, snap.seq);
+        if (self->stateSse.count() > 0) {
+            String payload;
+            toBase64_(payload, frame + TelemetryFrame::kHeaderLen, len);
+            self->stateSse.send(payload.c_str(), SSE_EVENT_STATE, snap.seq);
+        }
+        self->wsPublish_(TelemetryChannel::State, snap.seq, frame, len);
     }
 }
 
@@ -194,84 +398,15 @@ void WiFiManager::startEventStreamTask() {
 
         if (!DEVICE) return;
 
-        uint8_t warnCount = 0;
-        uint8_t errCount = 0;
-        DEVICE->getUnreadEventCounts(warnCount, errCount);
-
-        Device::EventEntry warnEntries[1]{};
-        Device::EventEntry errEntries[1]{};
-        const bool hasWarn = (DEVICE->getWarningHistory(warnEntries, 1) > 0);
-        const bool hasErr = (DEVICE->getErrorHistory(errEntries, 1) > 0);
-        const WiFiLang::UiLanguage lang = WiFiLang::getCurrentLanguage();
-
-        String payload;
-        if (!buildCborBase64_(payload, 512, [&](CborEncoder* map) {
-                if (!WiFiCbor::encodeKvText(map, "kind", "snapshot")) return false;
-                if (!WiFiCbor::encodeText(map, "unread")) return false;
-                CborEncoder unread;
-                if (cbor_encoder_create_map(map, &unread, CborIndefiniteLength) != CborNoError) {
-                    return false;
-                }
-                if (!WiFiCbor::encodeKvUInt(&unread, "warn", warnCount)) return false;
-                if (!WiFiCbor::encodeKvUInt(&unread, "error", errCount)) return false;
-                if (cbor_encoder_close_container(map, &unread) != CborNoError) return false;
-
-                if (hasWarn) {
-                    if (!WiFiCbor::encodeText(map, "last_warning")) return false;
-                    CborEncoder lastWarn;
-                    if (cbor_encoder_create_map(map, &lastWarn, CborIndefiniteLength) != CborNoError) {
-                        return false;
-                    }
-                    const String warnReason =
-                        WiFiLang::translateReason(warnEntries[0].reason, lang);
-                    if (!WiFiCbor::encodeKvText(&lastWarn, "reason", warnReason)) {
-                        return false;
-                    }
-                    if (warnEntries[0].ms) {
-                        if (!WiFiCbor::encodeKvUInt(&lastWarn, "ms", warnEntries[0].ms)) {
-                            return false;
-                        }
-                    }
-                    if (warnEntries[0].epoch) {
-                        if (!WiFiCbor::encodeKvUInt(&lastWarn, "epoch", warnEntries[0].epoch)) {
-                            return false;
-                        }
-                    }
-                    if (cbor_encoder_close_container(map, &lastWarn) != CborNoError) {
-                        return false;
-                    }
-                }
-
-                if (hasErr) {
-                    if (!WiFiCbor::encodeText(map, "last_error")) return false;
-                    CborEncoder lastErr;
-                    if (cbor_encoder_create_map(map, &lastErr, CborIndefiniteLength) != CborNoError) {
-                        return false;
-                    }
-                    const String errReason =
-                        WiFiLang::translateReason(errEntries[0].reason, lang);
-                    if (!WiFiCbor::encodeKvText(&lastErr, "reason", errReason)) {
-                        return false;
-                    }
-                    if (errEntries[0].ms) {
-                        if (!WiFiCbor::encodeKvUInt(&lastErr, "ms", errEntries[0].ms)) {
-                            return false;
-                        }
-                    }
-                    if (errEntries[0].epoch) {
-                        if (!WiFiCbor::encodeKvUInt(&lastErr, "epoch", errEntries[0].epoch)) {
-                            return false;
-                        }
-                    }
-                    if (cbor_encoder_close_container(map, &lastErr) != CborNoError) {
-                        return false;
-                    }
-                }
-
-                return true;
+        uint8_t frame[TelemetryFrame::kHeaderLen + kEventSnapshotCborMax];
+        size_t len = 0;
+        if (!encodeFrame_(frame, sizeof(frame), len, [&](CborEncoder* map) {
+                return encodeEventSnapshotMap_(map);
             })) {
             return;
         }
+        String payload;
+        toBase64_(payload, frame + TelemetryFrame::kHeaderLen, len);
         client->send(payload.c_str(), SSE_EVENT_EVENT, ++eventSeq);
     });
 
@@ -301,40 +436,171 @@ void WiFiManager::eventStreamTask(void* pv) {
         Device::EventNotice note{};
         if (!DEVICE->waitForEventNotice(note, portMAX_DELAY)) continue;
 
-        String payload;
-        const WiFiLang::UiLanguage lang = WiFiLang::getCurrentLanguage();
-        const char* kind =
-            (note.kind == Device::EventKind::Warning) ? "warning" : "error";
-        if (!buildCborBase64_(payload, 256, [&](CborEncoder* map) {
-                if (!WiFiCbor::encodeKvText(map, "kind", kind)) return false;
-                const String reason = WiFiLang::translateReason(note.reason, lang);
-                if (!WiFiCbor::encodeKvText(map, "reason", reason)) return false;
-                if (note.ms) {
-                    if (!WiFiCbor::encodeKvUInt(map, "ms", note.ms)) return false;
-                }
-                if (note.epoch) {
-                    if (!WiFiCbor::encodeKvUInt(map, "epoch", note.epoch)) return false;
-                }
-                if (!WiFiCbor::encodeText(map, "unread")) return false;
-                CborEncoder unread;
-                if (cbor_encoder_create_map(map, &unread, CborIndefiniteLength) != CborNoError) {
-                    return false;
-                }
-                if (!WiFiCbor::encodeKvUInt(&unread, "warn", note.unreadWarn)) return false;
-                if (!WiFiCbor::encodeKvUInt(&unread, "error", note.unreadErr)) return false;
-                return cbor_encoder_close_container(map, &unread) == CborNoError;
+        uint8_t frame[TelemetryFrame::kHeaderLen + kEventCborMax];
+        size_t len = 0;
+        if (!encodeFrame_(frame, sizeof(frame), len, [&](CborEncoder* map) {
+                return encodeEventNoticeMap_(map, note);
             })) {
             continue;
         }
-        self->eventSse.send(payload.c_str(), SSE_EVENT_EVENT, ++self->eventSeq);
+        if (self->eventSse.count() > 0) {
+            String payload;
+            toBase64_(payload, frame + TelemetryFrame::kHeaderLen, len);
+            self->eventSse.send(payload.c_str(), SSE_EVENT_EVENT, ++self->eventSeq);
+        }
+        self->wsPublish_(TelemetryChannel::Event, ++self->_wsEventSeq, frame, len);
+    }
+}
+
+// ===== Binary WebSocket telemetry =====
+
+void WiFiManager::wsPublish_(TelemetryChannel ch, uint32_t seq, uint8_t* frame, size_t len) {
+    if (!frame || len == 0) return;
+    uint32_t ids[TelemetrySubscribers::kMaxClients];
+    portENTER_CRITICAL(&_wsMux);
+    const size_t n = _wsSubs.subscribers(ch, ids, TelemetrySubscribers::kMaxClients);
+    portEXIT_CRITICAL(&_wsMux);
+    if (n == 0) return;
+
+    TelemetryFrame::writeHeader(frame, ch, seq);
+    for (size_t i = 0; i < n; ++i) {
+        wsSendTo_(ids[i], ch, seq, frame, TelemetryFrame::kHeaderLen + len);
+    }
+}
+
+bool WiFiManager::wsSendTo_(uint32_t id, TelemetryChannel ch, uint32_t seq,
+                            const uint8_t* frame, size_t frameLen) {
+    // A full send queue skips the frame: the client sees a sequence gap
+    // instead of stalling the publisher.
+    const bool ok = telemetryWs.availableForWrite(id);
+    if (ok) {
+        telemetryWs.binary(id, frame, frameLen);
+    }
+    portENTER_CRITICAL(&_wsMux);
+    if (ok) _wsSubs.delivered(id, ch, seq);
+    else _wsSubs.dropped(id);
+    portEXIT_CRITICAL(&_wsMux);
+    return ok;
+}
+
+void WiFiManager::onTelemetryWsEvent_(AsyncWebSocketClient* client,
+                                      AwsEventType type,
+                                      void* arg,
+                                      uint8_t* data,
+                                      size_t len) {
+    if (!client) return;
+    const uint32_t id = client->id();
+
+    if (type == WS_EVT_DISCONNECT) {
+        portENTER_CRITICAL(&_wsMux);
+        _wsSubs.remove(id);
+        portEXIT_CRITICAL(&_wsMux);
+        return;
+    }
+
+    if (type == WS_EVT_CONNECT) {
+        // The handshake filter checked the token; the socket must also
+        // come from the session IP, as for the SSE routes.
+        if (wifiStatus == WiFiStatus::NotConnected || !sessionIpMatches_(client->remoteIP())) {
+            client->close();
+            return;
+        }
+        portENTER_CRITICAL(&_wsMux);
+        const bool added = _wsSubs.add(id);
+        portEXIT_CRITICAL(&_wsMux);
+        if (!added) {
+            client->close();
+            return;
+        }
+
+        // Current state and event snapshot, as the SSE routes do on connect.
+        Device::StateSnapshot snap = DEVTRAN->getStateSnapshot();
+        uint8_t frame[TelemetryFrame::kHeaderLen + kEventSnapshotCborMax];
+        size_t n = 0;
+        const char* state = stateName(snap.state);
+        if (encodeFrame_(frame, sizeof(frame), n, [&](CborEncoder* map) {
+                return encodeStateMap_(map, snap, state);
+            })) {
+            TelemetryFrame::writeHeader(frame, TelemetryChannel::State, snap.seq);
+            wsSendTo_(id, TelemetryChannel::State, snap.seq,
+                      frame, TelemetryFrame::kHeaderLen + n);
+        }
+        if (DEVICE &&
+            encodeFrame_(frame, sizeof(frame), n, [&](CborEncoder* map) {
+                return encodeEventSnapshotMap_(map);
+            })) {
+            const uint32_t seq = _wsEventSeq;
+            TelemetryFrame::writeHeader(frame, TelemetryChannel::Event, seq);
+            wsSendTo_(id, TelemetryChannel::Event, seq,
+                      frame, TelemetryFrame::kHeaderLen + n);
+        }
+        return;
     }
+
+    if (type != WS_EVT_DATA) return;
+
+    // Control frames are tiny: only whole, unfragmented binary messages.
+    const AwsFrameInfo* info = static_cast<const AwsFrameInfo*>(arg);
+    if (!info || !info->final || info->index != 0 || info->len != len ||
+        info->opcode != WS_BINARY) {
+        return;
+    }
+    TelemetryChannel ch = TelemetryChannel::Control;
+    uint32_t seq = 0;
+    if (!TelemetryFrame::parseHeader(data, len, ch, seq) ||
+        ch != TelemetryChannel::Control) {
+        return;
+    }
+    if (lock()) { lastActivityMillis = millis(); unlock(); }
+
+    CborParser parser;
+    CborValue it;
+    if (cbor_parser_init(data + TelemetryFrame::kHeaderLen,
+                         len - TelemetryFrame::kHeaderLen, 0, &parser, &it) != CborNoError ||
+        !cbor_value_is_map(&it)) {
+        return;
+    }
+    CborValue value;
+    if (cbor_value_map_find_value(&it, "sub", &value) != CborNoError ||
+        !cbor_value_is_unsigned_integer(&value)) {
+        return;
+    }
+    uint64_t mask = 0;
+    if (cbor_value_get_uint64(&value, &mask) != CborNoError) return;
+    mask &= (1u << static_cast<uint8_t>(TelemetryChannel::Count)) - 1u;
+    mask &= ~static_cast<uint64_t>(TelemetryFrame::bit(TelemetryChannel::Control));
+
+    // Optional live resume point: the last seq the client saw before it
+    // reconnected. Out-of-ring values resync on the next round.
+    uint64_t since = 0;
+    const bool hasSince =
+        cbor_value_map_find_value(&it, "since", &value) == CborNoError &&
+        cbor_value_is_unsigned_integer(&value) &&
+        cbor_value_get_uint64(&value, &since) == CborNoError;
+
+    // Optional live batch format; absent keeps the client's current one.
+    bool columnar = false;
+    const bool hasFmt =
+        cbor_value_map_find_value(&it, "fmt", &value) == CborNoError &&
+        cbor_value_is_text_string(&value) &&
+        cbor_value_text_string_equals(&value, LiveColumnar::kFormat, &columnar) == CborNoError;
+
+    portENTER_CRITICAL(&_wsMux);
+    _wsSubs.setMask(id, static_cast<uint8_t>(mask));
+    if (hasSince) _wsSubs.resume(id, TelemetryChannel::Live, static_cast<uint32_t>(since));
+    if (hasFmt) {
+        uint8_t flags = _wsSubs.flags(id) & ~TelemetrySubscribers::kFlagColumnar;
+        if (columnar) flags |= TelemetrySubscribers::kFlagColumnar;
+        _wsSubs.setFlags(id, flags);
+    }
+    portEXIT_CRITICAL(&_wsMux);
+    if (liveStreamTaskHandle) xTaskNotifyGive(liveStreamTaskHandle);
 }
 
 void WiFiManager::startSnapshotTask(uint32_t periodMs) {
     if (_snapMtx == nullptr) {
         _snapMtx = xSemaphoreCreateMutex();
     }
-    _monitorCbor.reserve(kMonitorCborMax);
     if (snapshotTaskHandle == nullptr) {
         xTaskCreate(
             WiFiManager::snapshotTask,
@@ -361,6 +627,9 @@ void WiFiManager::snapshotTask(void* param) {
     StatusSnapshot local{};
     std::vector<uint8_t> monitorCbor;
     monitorCbor.reserve(kMonitorCborMax);
+    std::shared_ptr<SnapshotFrame> spare; // previous frame, reused once unreferenced
+    std::vector<uint8_t> wsFrame;         // telemetry header + /monitor CBOR
+    uint32_t monitorSeq = 0;
     constexpr float kWireTargetMaxC = 150.0f;
 
     for (;;) {
@@ -419,6 +688,8 @@ void WiFiManager::snapshotTask(void* param) {
                 (WIRE ? WIRE->getOutputState(i) : false);
             local.wirePresent[i - 1] =
                 (WIRE ? WIRE->getWireInfo(i).connected : false);
+            local.wireHealth[i - 1] =
+                (DEVICE ? DEVICE->getWireStateModel().wire(i).health : 0);
         }
         if (NTC) {
             const uint8_t ntcIdx = getNtcGateIndexFromConfig();
@@ -466,47 +737,67 @@ void WiFiManager::snapshotTask(void* param) {
             if (targetC < 0.0f) targetC = 0.0f;
         }
 
-        monitorCbor.assign(kMonitorCborMax, 0);
-        CborEncoder root;
-        CborEncoder map;
-        cbor_encoder_init(&root, monitorCbor.data(), monitorCbor.size(), 0);
-        bool cborOk =
-            (cbor_encoder_create_map(&root, &map, CborIndefiniteLength) == CborNoError);
-
-        if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&map, "capVoltage", local.capVoltage);
-        if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&map, "capAdcRaw", local.capAdcScaled);
-        if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&map, "current", local.current);
-        if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&map, "currentAcs", local.currentAcs);
-        if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&map, "capacitanceF",
-                                                     DEVICE ? DEVICE->getCapBankCapF() : 0.0f);
+        const Device::StateSnapshot snap = DEVTRAN->getStateSnapshot();
+        const wifi_mode_t mode = WiFi.getMode();
+        const bool staMode = (mode == WIFI_STA || mode == WIFI_AP_STA);
+        const bool staConnected = (WiFi.status() == WL_CONNECTED);
 
-        if (cborOk) {
-            cborOk = WiFiCbor::encodeText(&map, "temperatures");
+        // Fixed part: patch the template values (no re-encode of keys).
+        CborTemplate& tpl = s_monitorTpl;
+        const MonitorSlots& ms = s_monitorSlots;
+        const uint32_t shape = kMonitorShape | (DEVICE ? kMonitorShapeRes : 0u);
+        if (!tpl.ready() || tpl.shapeKey() != shape) {
+            if (!buildMonitorTemplate(tpl, s_monitorSlots, shape)) {
+                DEBUG_PRINTLN("[WiFi] Monitor template overflow");
+            }
         }
-        CborEncoder temps;
-        if (cborOk &&
-            cbor_encoder_create_array(&map, &temps, CborIndefiniteLength) != CborNoError) {
-            cborOk = false;
+        tpl.setF32(ms.capVoltage, local.capVoltage);
+        tpl.setF32(ms.capAdcRaw, local.capAdcScaled);
+        tpl.setF32(ms.current, local.current);
+        tpl.setF32(ms.currentAcs, local.currentAcs);
+        tpl.setF32(ms.capacitanceF, DEVICE ? DEVICE->getCapBankCapF() : 0.0f);
+        for (uint8_t i = 0; i < MAX_TEMP_SENSORS; ++i) {
+            tpl.setF32(ms.temps[i], local.temps[i]);
         }
-        if (cborOk) {
-            for (uint8_t i = 0; i < MAX_TEMP_SENSORS; ++i) {
-                if (cbor_encode_double(&temps, local.temps[i]) != CborNoError) {
-                    cborOk = false;
-                    break;
-                }
+        tpl.setF32(ms.boardTemp, isfinite(boardTemp) ? boardTemp : -127.0f);
+        tpl.setF32(ms.heatsinkTemp, isfinite(heatsink) ? heatsink : -127.0f);
+        for (uint8_t i = 0; i < HeaterManager::kWireCount; ++i) {
+            const double t = local.wireTemps[i];
+            tpl.setI32(ms.wireTemps[i], isfinite(t) ? (int32_t)lround(t) : -127);
+            tpl.setBool(ms.wirePresent[i], local.wirePresent[i]);
+            tpl.setU32(ms.wireHealth[i], local.wireHealth[i]);
+            tpl.setBool(ms.outputs[i], local.outputs[i]);
+
+            if (DEVICE) {
+                const WireResistanceEstimator::Report rep =
+                    DEVICE->getWireResistanceEstimator().report(i + 1);
+                const float conf = rep.confidence * 100.0f;
+                const float drift = rep.driftFrac * 100.0f;
+                tpl.setF32(ms.resOhm[i], isfinite(rep.estimateOhm) ? rep.estimateOhm : 0.0f);
+                tpl.setF32(ms.resConf[i], isfinite(conf) ? conf : 0.0f);
+                tpl.setF32(ms.resDrift[i], isfinite(drift) ? drift : 0.0f);
             }
         }
-        if (cborOk &&
-            cbor_encoder_close_container(&map, &temps) != CborNoError) {
-            cborOk = false;
-        }
+        tpl.setBool(ms.ready, snap.state == DeviceState::Idle);
+        tpl.setBool(ms.off, snap.state == DeviceState::Shutdown);
+        tpl.setBool(ms.ac, local.acPresent);
+        tpl.setBool(ms.relay, local.relayOn);
+        tpl.setU32(ms.fanSpeed, FAN->getSpeedPercent());
+        tpl.setBool(ms.wifiSta, staMode);
+        tpl.setBool(ms.wifiConnected, staConnected);
+        tpl.setF32(ms.totalEnergyWh, POWER_TRACKER->getTotalEnergy_Wh());
+        tpl.setU32(ms.totalSessions, POWER_TRACKER->getTotalSessions());
+        tpl.setU32(ms.totalSessionsOk, POWER_TRACKER->getTotalSuccessful());
+
+        // Optional part, encoded as before; the template pairs are spliced
+        // in just before the closing break.
+        monitorCbor.resize(kMonitorCborMax);
+        CborEncoder root;
+        CborEncoder map;
+        cbor_encoder_init(&root, monitorCbor.data(), monitorCbor.size(), 0);
+        bool cborOk = tpl.ready() &&
+            (cbor_encoder_create_map(&root, &map, CborIndefiniteLength) == CborNoError);
 
-        if (cborOk) {
-            const float boardOut = isfinite(boardTemp) ? boardTemp : -127.0f;
-            const float heatOut = isfinite(heatsink) ? heatsink : -127.0f;
-            cborOk = WiFiCbor::encodeKvFloat(&map, "boardTemp", boardOut);
-            if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&map, "heatsinkTemp", heatOut);
-        }
         if (cborOk && isfinite(targetC)) {
             cborOk = WiFiCbor::encodeKvFloat(&map, "wireTargetC", targetC);
         }
@@ -529,7 +820,8 @@ void WiFiManager::snapshotTask(void* param) {
             if (cborOk) {
                 const float tempOut = isfinite(floorTempC) ? floorTempC : fc.tempC;
                 if (isfinite(tempOut)) {
-                    cborOk = WiFiCbor::encodeKvFloat(&floorMap, "temp_c", tempOut);
+                    cborOk = WiFiCbor::encodeKvFloat(&floorMap, "temp_c", tempOut,
+                                                     CborNumber::kTemperature);
                 }
             }
             if (cborOk) cborOk = WiFiCbor::encodeKvFloatIfFinite(&floorMap, "wire_target_c",
@@ -543,74 +835,67 @@ void WiFiManager::snapshotTask(void* param) {
             }
         }
 
-        if (cborOk) cborOk = WiFiCbor::encodeText(&map, "wireTemps");
-        CborEncoder wireTemps;
-        if (cborOk &&
-            cbor_encoder_create_array(&map, &wireTemps, CborIndefiniteLength) != CborNoError) {
-            cborOk = false;
-        }
-        if (cborOk) {
-            for (uint8_t i = 0; i < HeaterManager::kWireCount; ++i) {
-                const double t = local.wireTemps[i];
-                const int32_t v = isfinite(t) ? (int32_t)lround(t) : -127;
-                if (cbor_encode_int(&wireTemps, v) != CborNoError) {
-                    cborOk = false;
-                    break;
-                }
+        // Last RUN-prep charge curve vs. capacitor model (bank health).
+        if (cborOk && DEVICE) {
+            const PrechargeMonitor::Result pr = DEVICE->getPrechargeReport();
+            cborOk = WiFiCbor::encodeText(&map, "precharge");
+            CborEncoder pcMap;
+            if (cborOk &&
+                cbor_encoder_create_map(&map, &pcMap, CborIndefiniteLength) != CborNoError) {
+                cborOk = false;
             }
-        }
-        if (cborOk &&
-            cbor_encoder_close_container(&map, &wireTemps) != CborNoError) {
-            cborOk = false;
-        }
-
-        if (cborOk) cborOk = WiFiCbor::encodeText(&map, "wirePresent");
-        CborEncoder wirePresent;
-        if (cborOk &&
-            cbor_encoder_create_array(&map, &wirePresent, CborIndefiniteLength) != CborNoError) {
-            cborOk = false;
-        }
-        if (cborOk) {
-            for (uint8_t i = 0; i < HeaterManager::kWireCount; ++i) {
-                if (cbor_encode_boolean(&wirePresent, local.wirePresent[i]) != CborNoError) {
-                    cborOk = false;
-                    break;
-                }
+            if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&pcMap, "status",
+                                                        static_cast<uint8_t>(pr.status));
+            if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&pcMap, "fault",
+                                                        static_cast<uint8_t>(pr.fault));
+            if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&pcMap, "ms", pr.elapsedMs);
+            if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&pcMap, "model_ms", pr.modelReadyMs);
+            if (cborOk && pr.fitValid) {
+                cborOk = WiFiCbor::encodeKvFloat(&pcMap, "tau_ratio", pr.tauRatio);
+                if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&pcMap, "v_inf", pr.vInf);
+            }
+            if (cborOk &&
+                cbor_encoder_close_container(&map, &pcMap) != CborNoError) {
+                cborOk = false;
             }
-        }
-        if (cborOk &&
-            cbor_encoder_close_container(&map, &wirePresent) != CborNoError) {
-            cborOk = false;
         }
 
-        if (cborOk) cborOk = WiFiCbor::encodeText(&map, "outputs");
-        CborEncoder outputs;
-        if (cborOk &&
-            cbor_encoder_create_map(&map, &outputs, CborIndefiniteLength) != CborNoError) {
-            cborOk = false;
-        }
-        if (cborOk) {
-            for (uint8_t i = 0; i < HeaterManager::kWireCount; ++i) {
-                char key[12];
-                snprintf(key, sizeof(key), "output%u", (unsigned)(i + 1));
-                if (!WiFiCbor::encodeKvBool(&outputs, key, local.outputs[i])) {
+        // Last capacitor bank discharge vs. model, energy per wire.
+        if (cborOk && DEVICE) {
+            const CapDischargeController::Report dr = DEVICE->getDischargeReport();
+            cborOk = WiFiCbor::encodeText(&map, "discharge");
+            CborEncoder dcMap;
+            if (cborOk &&
+                cbor_encoder_create_map(&map, &dcMap, CborIndefiniteLength) != CborNoError) {
+                cborOk = false;
+            }
+            if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&dcMap, "status",
+                                                        static_cast<uint8_t>(dr.status));
+            if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&dcMap, "ms", dr.elapsedMs);
+            if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&dcMap, "model_ms", dr.modelMs);
+            if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&dcMap, "open", dr.openMask);
+            if (cborOk && dr.gRatio > 0.0f) {
+                cborOk = WiFiCbor::encodeKvFloat(&dcMap, "g_ratio", dr.gRatio);
+            }
+            if (cborOk) cborOk = WiFiCbor::encodeText(&dcMap, "j");
+            CborEncoder jArr;
+            if (cborOk &&
+                cbor_encoder_create_array(&dcMap, &jArr, HeaterManager::kWireCount) != CborNoError) {
+                cborOk = false;
+            }
+            for (uint8_t i = 0; cborOk && i < HeaterManager::kWireCount; ++i) {
+                if (cbor_encode_float(&jArr, dr.energyJ[i]) != CborNoError) {
                     cborOk = false;
-                    break;
                 }
             }
+            if (cborOk && cbor_encoder_close_container(&dcMap, &jArr) != CborNoError) {
+                cborOk = false;
+            }
+            if (cborOk &&
+                cbor_encoder_close_container(&map, &dcMap) != CborNoError) {
+                cborOk = false;
+            }
         }
-        if (cborOk &&
-            cbor_encoder_close_container(&map, &outputs) != CborNoError) {
-            cborOk = false;
-        }
-
-        const Device::StateSnapshot snap = DEVTRAN->getStateSnapshot();
-        if (cborOk) cborOk = WiFiCbor::encodeKvBool(&map, "ready",
-                                                    snap.state == DeviceState::Idle);
-        if (cborOk) cborOk = WiFiCbor::encodeKvBool(&map, "off",
-                                                    snap.state == DeviceState::Shutdown);
-        if (cborOk) cborOk = WiFiCbor::encodeKvBool(&map, "ac", local.acPresent);
-        if (cborOk) cborOk = WiFiCbor::encodeKvBool(&map, "relay", local.relayOn);
 
         if (cborOk && DEVICE) {
             uint8_t warnCount = 0;
@@ -656,33 +941,10 @@ void WiFiManager::snapshotTask(void* param) {
             }
         }
 
-        if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&map, "fanSpeed", FAN->getSpeedPercent());
-        const wifi_mode_t mode = WiFi.getMode();
-        const bool staMode = (mode == WIFI_STA || mode == WIFI_AP_STA);
-        const bool staConnected = (WiFi.status() == WL_CONNECTED);
-        if (cborOk) cborOk = WiFiCbor::encodeKvBool(&map, "wifiSta", staMode);
-        if (cborOk) cborOk = WiFiCbor::encodeKvBool(&map, "wifiConnected", staConnected);
         if (cborOk && staMode && staConnected) {
             cborOk = WiFiCbor::encodeKvInt(&map, "wifiRssi", WiFi.RSSI());
         }
 
-        if (cborOk) cborOk = WiFiCbor::encodeText(&map, "sessionTotals");
-        CborEncoder totals;
-        if (cborOk &&
-            cbor_encoder_create_map(&map, &totals, CborIndefiniteLength) != CborNoError) {
-            cborOk = false;
-        }
-        if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&totals, "totalEnergy_Wh",
-                                                     POWER_TRACKER->getTotalEnergy_Wh());
-        if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&totals, "totalSessions",
-                                                    POWER_TRACKER->getTotalSessions());
-        if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&totals, "totalSessionsOk",
-                                                    POWER_TRACKER->getTotalSuccessful());
-        if (cborOk &&
-            cbor_encoder_close_container(&map, &totals) != CborNoError) {
-            cborOk = false;
-        }
-
         if (cborOk) cborOk = WiFiCbor::encodeText(&map, "session");
         CborEncoder sess;
         if (cborOk &&
@@ -697,19 +959,25 @@ void WiFiManager::snapshotTask(void* param) {
             if (cur.valid) {
                 cborOk = WiFiCbor::encodeKvBool(&sess, "valid", true);
                 if (cborOk) cborOk = WiFiCbor::encodeKvBool(&sess, "running", true);
-                if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&sess, "energy_Wh", cur.energy_Wh);
+                if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&sess, "energy_Wh", cur.energy_Wh,
+                                                            CborNumber::kEnergy);
                 if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&sess, "duration_s", cur.duration_s);
-                if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&sess, "peakPower_W", cur.peakPower_W);
+                if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&sess, "peakPower_W", cur.peakPower_W,
+                                                            CborNumber::kPower);
                 if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&sess, "peakCurrent_A",
-                                                            cur.peakCurrent_A);
+                                                            cur.peakCurrent_A,
+                                                            CborNumber::kCurrent);
             } else if (last.valid) {
                 cborOk = WiFiCbor::encodeKvBool(&sess, "valid", true);
                 if (cborOk) cborOk = WiFiCbor::encodeKvBool(&sess, "running", false);
-                if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&sess, "energy_Wh", last.energy_Wh);
+                if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&sess, "energy_Wh", last.energy_Wh,
+                                                            CborNumber::kEnergy);
                 if (cborOk) cborOk = WiFiCbor::encodeKvUInt(&sess, "duration_s", last.duration_s);
-                if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&sess, "peakPower_W", last.peakPower_W);
+                if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&sess, "peakPower_W", last.peakPower_W,
+                                                            CborNumber::kPower);
                 if (cborOk) cborOk = WiFiCbor::encodeKvFloat(&sess, "peakCurrent_A",
-                                                            last.peakCurrent_A);
+                                                            last.peakCurrent_A,
+                                                            CborNumber::kCurrent);
             } else {
                 cborOk = WiFiCbor::encodeKvBool(&sess, "valid", false);
                 if (cborOk) cborOk = WiFiCbor::encodeKvBool(&sess, "running", false);
@@ -720,52 +988,82 @@ void WiFiManager::snapshotTask(void* param) {
             cborOk = false;
         }
 
-        if (cborOk &&
-            cbor_encoder_close_container(&root, &map) != CborNoError) {
-            cborOk = false;
+        size_t size = 0;
+        if (cborOk) {
+            size = cbor_encoder_get_buffer_size(&map, monitorCbor.data());
+            cborOk = (size + tpl.size() + 1 <= monitorCbor.size());
         }
         if (cborOk) {
-            const size_t size = cbor_encoder_get_buffer_size(&root, monitorCbor.data());
+            memcpy(monitorCbor.data() + size, tpl.data(), tpl.size());
+            size += tpl.size();
+            monitorCbor[size++] = 0xFF;   // closes the root map
             monitorCbor.resize(size);
         } else {
             monitorCbor.clear();
         }
 
-        // Commit snapshot under lock
+        // Publish a fresh immutable frame. Recycle the previous one (and its
+        // CBOR buffer) only when no HTTP response still references it.
+        std::shared_ptr<SnapshotFrame> next;
+        if (spare && spare.use_count() == 1) {
+            next.swap(spare);
+        } else {
+            next = std::make_shared<SnapshotFrame>();
+        }
+        next->snap = local;
+        next->monitorCbor.swap(monitorCbor);
+        self->publishFrame_(next);
+        spare.swap(next);
+
+        // Same /monitor CBOR to WebSocket subscribers, no re-encode.
+        portENTER_CRITICAL(&self->_wsMux);
+        const bool wsMonitor = self->_wsSubs.any(TelemetryChannel::Monitor);
+        portEXIT_CRITICAL(&self->_wsMux);
+        ++monitorSeq;
+        if (wsMonitor) {
+            const FramePtr published = self->acquireFrame_();
+            if (published && !published->monitorCbor.empty()) {
+                const size_t len = published->monitorCbor.size();
+                wsFrame.resize(TelemetryFrame::kHeaderLen + len);
+                memcpy(wsFrame.data() + TelemetryFrame::kHeaderLen,
+                       published->monitorCbor.data(), len);
+                self->wsPublish_(TelemetryChannel::Monitor, monitorSeq, wsFrame.data(), len);
+            }
+        }
+        self->telemetryWs.cleanupClients(TelemetrySubscribers::kMaxClients);
+
         if (self->_snapMtx &&
             xSemaphoreTake(self->_snapMtx, portMAX_DELAY) == pdTRUE)
         {
-            self->_snap = local;
-            self->_monitorCbor.swap(monitorCbor);
             self->pushLiveSample(local);
             xSemaphoreGive(self->_snapMtx);
+            if (self->liveStreamTaskHandle) xTaskNotifyGive(self->liveStreamTaskHandle);
         }
 
         vTaskDelay(periodTicks);
     }
 }
 
-bool WiFiManager::getSnapshot(StatusSnapshot& out) {
-    if (_snapMtx == nullptr) return false;
-    if (xSemaphoreTake(_snapMtx, pdMS_TO_TICKS(25)) != pdTRUE) {
-        return false;
-    }
-    out = _snap;
-    xSemaphoreGive(_snapMtx);
-    return true;
+WiFiManager::FramePtr WiFiManager::acquireFrame_() const {
+    // Only the refcount bump sits in the critical section.
+    portENTER_CRITICAL(&_frameMux);
+    FramePtr f = _frame;
+    portEXIT_CRITICAL(&_frameMux);
+    return f;
 }
 
-bool WiFiManager::getMonitorCbor(std::vector<uint8_t>& out) {
-    if (_snapMtx == nullptr) return false;
-    if (xSemaphoreTake(_snapMtx, pdMS_TO_TICKS(25)) != pdTRUE) {
-        return false;
-    }
-    if (_monitorCbor.empty()) {
-        xSemaphoreGive(_snapMtx);
-        return false;
-    }
-    out = _monitorCbor;
-    xSemaphoreGive(_snapMtx);
+void WiFiManager::publishFrame_(std::shared_ptr<SnapshotFrame>& next) {
+    // Swap only; the old frame is released by the caller, outside the
+    // critical section.
+    portENTER_CRITICAL(&_frameMux);
+    _frame.swap(next);
+    portEXIT_CRITICAL(&_frameMux);
+}
+
+bool WiFiManager::getSnapshot(StatusSnapshot& out) {
+    const FramePtr f = acquireFrame_();
+    if (!f) return false;
+    out = f->snap;
     return true;
 }
 
@@ -797,24 +1095,56 @@ void WiFiManager::pushLiveSample(const StatusSnapshot& s) {
     }
 }
 
-bool WiFiManager::buildLiveBatch(CborEncoder* items, uint32_t sinceSeq, uint32_t& seqStart, uint32_t& seqEnd) {
-    if (!items) return false;
+size_t WiFiManager::selectLive_(uint32_t sinceSeq, uint8_t stride, size_t maxItems,
+                                const LiveSample** out) const {
+    const size_t count = _liveCount;
+    if (count == 0 || !out) return 0;
 
-    seqStart = 0;
-    seqEnd = 0;
+    const size_t tail = (_liveHead + kLiveBufSize - count) % kLiveBufSize;
+    const uint32_t newest = _liveBuf[(_liveHead + kLiveBufSize - 1) % kLiveBufSize].seq;
+    if (stride == 0) stride = 1;
+    if (maxItems > kLiveBufSize) maxItems = kLiveBufSize;
 
-    size_t count = _liveCount;
-    if (count == 0) return false;
+    auto selected = [&](const LiveSample& sm) {
+        return sm.seq > sinceSeq && (stride == 1 || ((newest - sm.seq) % stride) == 0);
+    };
 
-    size_t tail = (_liveHead + kLiveBufSize - count) % kLiveBufSize;
+    // Oldest first; over maxItems the oldest are dropped, so the batch
+    // always ends at newest.
+    size_t skip = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (selected(_liveBuf[(tail + i) % kLiveBufSize])) ++skip;
+    }
+    skip = (skip > maxItems) ? skip - maxItems : 0;
 
+    size_t n = 0;
     for (size_t i = 0; i < count; ++i) {
-        const size_t idx = (tail + i) % kLiveBufSize;
-        const LiveSample& sm = _liveBuf[idx];
-        if (sm.seq <= sinceSeq) continue;
+        const LiveSample& sm = _liveBuf[(tail + i) % kLiveBufSize];
+        if (!selected(sm)) continue;
+        if (skip > 0) {
+            --skip;
+            continue;
+        }
+        out[n++] = &sm;
+    }
+    return n;
+}
+
+bool WiFiManager::buildLiveBatch(CborEncoder* items, uint32_t sinceSeq, uint32_t& seqStart,
+                                 uint32_t& seqEnd, uint8_t stride, size_t maxItems) {
+    if (!items) return false;
+
+    seqStart = 0;
+    seqEnd = 0;
+
+    const LiveSample* picked[kLiveBufSize];
+    const size_t n = selectLive_(sinceSeq, stride, maxItems, picked);
+    if (n == 0) return false;
+    seqStart = picked[0]->seq;
+    seqEnd = picked[n - 1]->seq;
 
-        if (seqStart == 0) seqStart = sm.seq;
-        seqEnd = sm.seq;
+    for (size_t k = 0; k < n; ++k) {
+        const LiveSample& sm = *picked[k];
 
         CborEncoder entry;
         if (cbor_encoder_create_map(items, &entry, CborIndefiniteLength) != CborNoError) {
@@ -822,8 +1152,8 @@ bool WiFiManager::buildLiveBatch(CborEncoder* items, uint32_t sinceSeq, uint32_t
         }
         if (!WiFiCbor::encodeKvUInt(&entry, "seq", sm.seq)) return false;
         if (!WiFiCbor::encodeKvUInt(&entry, "ts", sm.tsMs)) return false;
-        if (!WiFiCbor::encodeKvFloat(&entry, "capV", sm.capV)) return false;
-        if (!WiFiCbor::encodeKvFloat(&entry, "i", sm.currentA)) return false;
+        if (!WiFiCbor::encodeKvFloat(&entry, "capV", sm.capV, CborNumber::kVoltage)) return false;
+        if (!WiFiCbor::encodeKvFloat(&entry, "i", sm.currentA, CborNumber::kCurrent)) return false;
         if (!WiFiCbor::encodeKvUInt(&entry, "mask", sm.outputsMask)) return false;
         if (!WiFiCbor::encodeKvBool(&entry, "relay", sm.relay)) return false;
         if (!WiFiCbor::encodeKvBool(&entry, "ac", sm.ac)) return false;
@@ -847,15 +1177,279 @@ bool WiFiManager::buildLiveBatch(CborEncoder* items, uint32_t sinceSeq, uint32_t
         }
     }
 
-    return (seqStart != 0);
+    return true;
+}
+
+bool WiFiManager::buildLiveColumns_(CborEncoder* map, uint32_t sinceSeq, uint8_t stride,
+                                    size_t maxItems, uint32_t& seqStart, uint32_t& seqEnd) {
+    seqStart = 0;
+    seqEnd = 0;
+    const LiveSample* picked[kLiveBufSize];
+    const size_t n = selectLive_(sinceSeq, stride, maxItems, picked);
+
+    // Fixed columns, then one per wire ("wt1".."wtN", whole degrees).
+    static const char* const kNames[] = {"ts", "capV", "i", "mask", "relay", "ac", "fan"};
+    static const int32_t kScales[] = {1, 100, 1000, 1, 1, 1, 1};
+    constexpr size_t kFixed = sizeof(kNames) / sizeof(kNames[0]);
+    constexpr size_t kCols = kFixed + HeaterManager::kWireCount;
+    const uint32_t t0 = n ? picked[0]->tsMs : 0;
+    const uint32_t dt = n ? LiveColumnar::meanPeriod(t0, picked[n - 1]->tsMs, n) : 0;
+
+    auto value = [&](size_t k, size_t c) -> int32_t {
+        const LiveSample& sm = *picked[k];
+        switch (c) {
+            case 0: return LiveColumnar::tsResidual(sm.tsMs, t0, dt, k);
+            case 1: return LiveColumnar::quantize(sm.capV, kScales[1]);
+            case 2: return LiveColumnar::quantize(sm.currentA, kScales[2]);
+            case 3: return sm.outputsMask;
+            case 4: return sm.relay ? 1 : 0;
+            case 5: return sm.ac ? 1 : 0;
+            case 6: return sm.fanPct;
+            default: return sm.wireTemps[c - kFixed];
+        }
+    };
+
+    if (!WiFiCbor::encodeKvText(map, "fmt", LiveColumnar::kFormat)) return false;
+    if (!WiFiCbor::encodeKvUInt(map, "n", n)) return false;
+    if (n > 0) {
+        seqStart = picked[0]->seq;
+        seqEnd = picked[n - 1]->seq;
+        if (!WiFiCbor::encodeKvUInt(map, "t0", t0)) return false;
+        if (!WiFiCbor::encodeKvUInt(map, "dt", dt)) return false;
+    }
+
+    CborEncoder arr;
+    if (!WiFiCbor::encodeText(map, "cols")) return false;
+    if (cbor_encoder_create_array(map, &arr, kCols) != CborNoError) return false;
+    for (size_t c = 0; c < kCols; ++c) {
+        char name[8];
+        const char* text = (c < kFixed) ? kNames[c] : name;
+        if (c >= kFixed) snprintf(name, sizeof(name), "wt%u", (unsigned)(c - kFixed + 1));
+        if (!WiFiCbor::encodeText(&arr, text)) return false;
+    }
+    if (cbor_encoder_close_container(map, &arr) != CborNoError) return false;
+
+    if (!WiFiCbor::encodeText(map, "scale")) return false;
+    if (cbor_encoder_create_array(map, &arr, kCols) != CborNoError) return false;
+    for (size_t c = 0; c < kCols; ++c) {
+        if (cbor_encode_int(&arr, c < kFixed ? kScales[c] : 1) != CborNoError) return false;
+    }
+    if (cbor_encoder_close_container(map, &arr) != CborNoError) return false;
+
+    if (!WiFiCbor::encodeText(map, "data")) return false;
+    if (cbor_encoder_create_array(map, &arr, kCols) != CborNoError) return false;
+    uint8_t column[kLiveBufSize * LiveColumnar::kMaxVarint];
+    for (size_t c = 0; c < kCols; ++c) {
+        LiveColumnar::ColumnEncoder enc(column, sizeof(column));
+        for (size_t k = 0; k < n; ++k) enc.add(value(k, c));
+        if (!enc.ok() ||
+            cbor_encode_byte_string(&arr, column, enc.size()) != CborNoError) {
+            return false;
+        }
+    }
+    return cbor_encoder_close_container(map, &arr) == CborNoError;
 }
 
-void WiFiManager::startLiveStreamTask(uint32_t /*emitPeriodMs*/) {
-    // Live streaming disabled; clients poll snapshots instead.
+bool WiFiManager::liveWindow_(uint32_t& oldest, uint32_t& newest) {
+    oldest = 0;
+    newest = 0;
+    if (!_snapMtx || xSemaphoreTake(_snapMtx, pdMS_TO_TICKS(20)) != pdTRUE) return false;
+    if (_liveCount > 0) {
+        const size_t tail = (_liveHead + kLiveBufSize - _liveCount) % kLiveBufSize;
+        oldest = _liveBuf[tail].seq;
+        newest = _liveBuf[(_liveHead + kLiveBufSize - 1) % kLiveBufSize].seq;
+    }
+    xSemaphoreGive(_snapMtx);
+    return newest != 0;
 }
 
-void WiFiManager::liveStreamTask(void* /*pv*/) {
-    // Live streaming task disabled.
-    vTaskDelete(nullptr);
+bool WiFiManager::encodeLiveBatch_(uint8_t* buf, size_t capacity, size_t& len,
+                                   uint32_t sinceSeq, uint8_t stride, size_t maxItems,
+                                   uint32_t& seqEnd, bool columnar) {
+    uint32_t seqStart = 0;
+    seqEnd = 0;
+    return WiFiCbor::buildMapInto(buf, capacity, len, [&](CborEncoder* map) {
+        bool ok = false;
+        if (columnar) {
+            if (_snapMtx &&
+                xSemaphoreTake(_snapMtx, pdMS_TO_TICKS(20)) == pdTRUE) {
+                ok = buildLiveColumns_(map, sinceSeq, stride, maxItems, seqStart, seqEnd);
+                xSemaphoreGive(_snapMtx);
+            }
+        } else {
+            ok = WiFiCbor::encodeText(map, "items");
+            CborEncoder items;
+            if (ok && cbor_encoder_create_array(map, &items, CborIndefiniteLength) != CborNoError) {
+                ok = false;
+            }
+            if (ok && _snapMtx &&
+                xSemaphoreTake(_snapMtx, pdMS_TO_TICKS(20)) == pdTRUE) {
+                buildLiveBatch(&items, sinceSeq, seqStart, seqEnd, stride, maxItems);
+                xSemaphoreGive(_snapMtx);
+            }
+            if (ok && cbor_encoder_close_container(map, &items) != CborNoError) {
+                ok = false;
+            }
+        }
+        if (!ok) return false;
+        if (seqStart != 0) {
+            if (!WiFiCbor::encodeKvUInt(map, "seqStart", seqStart)) return false;
+            if (!WiFiCbor::encodeKvUInt(map, "seqEnd", seqEnd)) return false;
+        }
+        if (stride > 1) {
+            if (!WiFiCbor::encodeKvUInt(map, "stride", stride)) return false;
+        }
+        return true;
+    });
 }
 
+void WiFiManager::startLiveStreamTask(uint32_t emitPeriodMs) {
+    if (liveStreamTaskHandle) return;
+    _liveRetryMs = emitPeriodMs ? emitPeriodMs : 150;
+
+    // EventSource resends the last id it saw (Last-Event-ID): resume from
+    // it while the ring still covers it, else start at the newest sample.
+    liveSse.onConnect([this](AsyncEventSourceClient* client) {
+        if (wifiStatus == WiFiStatus::NotConnected) {
+            client->close();
+            return;
+        }
+
+        IPAddress ip =
+            client->client() ? client->client()->remoteIP() : IPAddress(0, 0, 0, 0);
+        if (!sessionIpMatches_(ip)) {
+            client->close();
+            return;
+        }
+
+        uint32_t oldest = 0;
+        uint32_t newest = 0;
+        if (!liveWindow_(oldest, newest)) return;
+        LiveStreamPacer::Config cfg;
+        LiveStreamPacer::Plan plan = LiveStreamPacer::plan(
+            cfg, client->lastId(), oldest, newest, kLiveBatchCborMax, false);
+        if (plan.action == LiveStreamPacer::Action::None) return;
+        if (plan.action != LiveStreamPacer::Action::Send) {
+            plan.since = newest - 1;
+            plan.stride = 1;
+        }
+
+        std::vector<uint8_t> buf(kLiveBatchCborMax);
+        size_t len = 0;
+        uint32_t seqEnd = 0;
+        if (!encodeLiveBatch_(buf.data(), buf.size(), len, plan.since, plan.stride,
+                              cfg.maxBatch, seqEnd) || seqEnd == 0) {
+            return;
+        }
+        String payload;
+        toBase64_(payload, buf.data(), len);
+        client->send(payload.c_str(), SSE_EVENT_LIVE, seqEnd);
+    });
+
+    BaseType_t ok = xTaskCreate(
+        WiFiManager::liveStreamTask,
+        "LiveStreamTask",
+        4096,
+        this,
+        1,
+        &liveStreamTaskHandle
+    );
+    if (ok != pdPASS) {
+        liveStreamTaskHandle = nullptr;
+        DEBUG_PRINTLN("[WiFi] Failed to start LiveStreamTask");
+    }
+}
+
+void WiFiManager::liveStreamTask(void* pv) {
+    WiFiManager* self = static_cast<WiFiManager*>(pv);
+    std::vector<uint8_t> frame(kLiveFrameMax);
+
+    for (;;) {
+        // Woken by each new sample; the timeout retries clients that had
+        // to wait for send-queue space.
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(self->_liveRetryMs));
+        self->serviceLiveStream_(frame);
+    }
+}
+
+void WiFiManager::serviceLiveStream_(std::vector<uint8_t>& frame) {
+    uint32_t ids[TelemetrySubscribers::kMaxClients];
+    portENTER_CRITICAL(&_wsMux);
+    const size_t n = _wsSubs.subscribers(TelemetryChannel::Live, ids,
+                                         TelemetrySubscribers::kMaxClients);
+    portEXIT_CRITICAL(&_wsMux);
+    const bool sse = liveSse.count() > 0;
+    if (n == 0 && !sse) return;
+
+    uint32_t oldest = 0;
+    uint32_t newest = 0;
+    if (!liveWindow_(oldest, newest)) return;
+
+    const LiveStreamPacer::Config cfg;
+    uint8_t* cbor = frame.data() + TelemetryFrame::kHeaderLen;
+    const size_t cborCap = frame.size() - TelemetryFrame::kHeaderLen;
+
+    // WebSocket: one plan per client from its own TCP send space.
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t id = ids[i];
+        AsyncWebSocketClient* c = telemetryWs.client(id);
+        if (!c) continue;
+        const bool full = c->queueIsFull();
+        const size_t space = c->client() ? c->client()->space() : 0;
+        portENTER_CRITICAL(&_wsMux);
+        const uint32_t last = _wsSubs.lastSeq(id, TelemetryChannel::Live);
+        const bool columnar = _wsSubs.flags(id) & TelemetrySubscribers::kFlagColumnar;
+        portEXIT_CRITICAL(&_wsMux);
+
+        const LiveStreamPacer::Plan plan =
+            LiveStreamPacer::plan(cfg, last, oldest, newest, space, full);
+        if (plan.action == LiveStreamPacer::Action::Resync) {
+            // New or too far behind: the /monitor snapshot on the live
+            // channel (a map without "items"), then batches after newest.
+            const FramePtr snap = acquireFrame_();
+            if (!snap || snap->monitorCbor.empty()) continue;
+            const size_t len = snap->monitorCbor.size();
+            if (len > cborCap) continue;
+            memcpy(cbor, snap->monitorCbor.data(), len);
+            TelemetryFrame::writeHeader(frame.data(), TelemetryChannel::Live, newest);
+            wsSendTo_(id, TelemetryChannel::Live, newest,
+                      frame.data(), TelemetryFrame::kHeaderLen + len);
+            continue;
+        }
+        if (plan.action != LiveStreamPacer::Action::Send) continue;
+
+        size_t len = 0;
+        uint32_t seqEnd = 0;
+        if (!encodeLiveBatch_(cbor, cborCap, len, plan.since, plan.stride,
+                              plan.count, seqEnd, columnar) || seqEnd == 0) {
+            continue;
+        }
+        TelemetryFrame::writeHeader(frame.data(), TelemetryChannel::Live, seqEnd);
+        wsSendTo_(id, TelemetryChannel::Live, seqEnd,
+                  frame.data(), TelemetryFrame::kHeaderLen + len);
+    }
+
+    // SSE fallback: one shared batch, held back while the clients' queues
+    // are backed up (the next batch is decimated to catch up).
+    if (!sse) return;
+    const bool backedUp = liveSse.avgPacketsWaiting() >= kLiveSseMaxWaiting;
+    LiveStreamPacer::Plan plan = LiveStreamPacer::plan(
+        cfg, _liveSentSeq, oldest, newest, kLiveBatchCborMax, backedUp);
+    if (plan.action == LiveStreamPacer::Action::Resync) {
+        // Each client got its own start on connect: just the newest sample.
+        plan = LiveStreamPacer::plan(cfg, newest - 1, oldest, newest,
+                                     kLiveBatchCborMax, backedUp);
+    }
+    if (plan.action != LiveStreamPacer::Action::Send) return;
+
+    size_t len = 0;
+    uint32_t seqEnd = 0;
+    if (!encodeLiveBatch_(cbor, cborCap, len, plan.since, plan.stride,
+                          plan.count, seqEnd) || seqEnd == 0) {
+        return;
+    }
+    String payload;
+    toBase64_(payload, cbor, len);
+    liveSse.send(payload.c_str(), SSE_EVENT_LIVE, seqEnd);
+    _liveSentSeq = seqEnd;
+}
@@ -20,6 +20,7 @@
 #define EP_DISCONNECT         "/disconnect"          // POST to end session and redirect to login
 #define EP_STATE_STREAM       "/state_stream"        // Server-Sent Events stream of device state
 #define EP_EVENT_STREAM       "/event_stream"        // Server-Sent Events stream of device events
+#define EP_TELEMETRY_WS       "/telemetry_ws"        // Binary WebSocket: state/event/monitor frames (CBOR)
 #define EP_MONITOR_STREAM     "/monitor_stream"      // Server-Sent Events stream of live monitor
 #define EP_MONITOR_SINCE      "/monitor_since"       // Live monitor batch (HTTP)
 #define EP_MONITOR            "/monitor"             // Telemetry snapshot (caps, temps, outputs, session stats)
@@ -77,6 +78,7 @@
 // ===== SSE event names =====
 #define SSE_EVENT_STATE       "state"
 #define SSE_EVENT_EVENT       "event"
+#define SSE_EVENT_LIVE        "live"
 
 // ===== Status/mode strings used in responses =====
 #define STATUS_OK             "ok"
@@ -126,6 +128,7 @@
 #define ERR_CALIBRATION_BUSY        "calibration_busy"
 #define ERR_CALIBRATION_FAILED      "calibration_failed"
 #define ERR_CTRL_QUEUE_FULL         "ctrl_queue_full"
+#define ERR_CURSOR_EXPIRED          "cursor_expired"
 #define ERR_DEVICE_MISSING          "device_missing"
 #define ERR_DEVICE_NOT_IDLE         "device_not_idle"
 #define ERR_DEVICE_TRANSPORT_MISSING "device_transport_missing"
@@ -133,6 +136,7 @@
 #define ERR_ENERGY_STOPPED          "energy_stopped"
 #define ERR_FIT_FAILED              "fit_failed"
 #define ERR_INVALID_COEFFS          "invalid_coeffs"
+#define ERR_INVALID_CURSOR          "invalid_cursor"
 #define ERR_INVALID_MODE            "invalid_mode"
 #define ERR_INVALID_NAME            "invalid_name"
 #define ERR_INVALID_REF_TEMP        "invalid_ref_temp"
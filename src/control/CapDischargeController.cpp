@@ -0,0 +1,344 @@
+#include <CapDischargeController.hpp>
+
+#include <math.h>
+
+namespace {
+constexpr float kProgressFrac = 0.01f;  // drop (of last progress V) that counts as progress
+constexpr float kAbsRatioTol = 0.7f;    // calibrated-C tolerance: median ratio floor
+constexpr float kRidge = 1e-3f;         // pull toward the cached conductance, of the largest diagonal
+constexpr uint8_t kMinDof = 3;          // samples beyond the unknowns before judging
+
+inline uint8_t packed(uint8_t i, uint8_t j) {  // i >= j
+    return static_cast<uint8_t>(i * (i + 1) / 2 + j);
+}
+} // namespace
+
+void CapDischargeController::begin(const Config& cfg, const Wire* wires, uint8_t n,
+                                   float v0, uint32_t nowUs) {
+    _cfg = cfg;
+    if (_cfg.stallSteps == 0) _cfg.stallSteps = 1;
+    _rep = Report{};
+    _n = (n > kMaxWires) ? kMaxWires : n;
+    for (uint8_t i = 0; i < kMaxWires; ++i) {
+        _wires[i] = (wires && i < _n) ? wires[i] : Wire{};
+        if (!isfinite(_wires[i].gS) || _wires[i].gS < 0.0f) _wires[i].gS = 0.0f;
+    }
+    _startUs = nowUs;
+    _lastUs = nowUs;
+    _lastV = isfinite(v0) ? v0 : 0.0f;
+    _progressUs = nowUs;
+    _progressV = _lastV;
+    for (uint8_t i = 0; i < kMaxWires; ++i) {
+        _onTime[i] = 0.0f;
+        _stepsOn[i] = 0;
+    }
+    for (uint8_t k = 0; k < kPacked; ++k) _ata[k] = 0.0f;
+    for (uint8_t k = 0; k < kFit; ++k) _atb[k] = 0.0f;
+    _yy = 0.0f;
+    _rows = 0;
+
+    _rep.v0 = _lastV;
+    _rep.vEnd = _lastV;
+    if (_cfg.capF > 0.0f) addSample(_lastV);
+
+    float gAll = 0.0f;
+    for (uint8_t i = 0; i < _n; ++i) gAll += _wires[i].gS;
+    _rep.modelMs = predictMs(_cfg.capF, gAll, _cfg.maxCurrentA, _lastV, _cfg.vSafe);
+
+    if (_lastV <= _cfg.vSafe) {
+        _rep.status = Status::Done;
+    } else if (!(gAll > 0.0f)) {
+        _rep.status = Status::NoLoad;
+    } else {
+        _rep.status = Status::Running;
+    }
+}
+
+bool CapDischargeController::usable(uint8_t i) const {
+    if (i >= _n) return false;
+    if (!(_wires[i].gS > 0.0f)) return false;
+    return (_rep.openMask & (1u << i)) == 0;
+}
+
+uint16_t CapDischargeController::nextMask(float v) {
+    if (_rep.status != Status::Running) return 0;
+
+    // Candidates: least energy dumped first, then coolest.
+    uint8_t order[kMaxWires];
+    uint8_t count = 0;
+    for (int pass = 0; pass < 2 && count == 0; ++pass) {
+        for (uint8_t i = 0; i < _n; ++i) {
+            if (!usable(i)) continue;
+            // Second pass: all wires too hot; the bank still has to go.
+            const float t = _wires[i].tempC;
+            if (pass == 0 && _cfg.maxWireTempC > 0.0f && isfinite(t) &&
+                t >= _cfg.maxWireTempC) {
+                continue;
+            }
+            uint8_t pos = count++;
+            while (pos > 0) {
+                const uint8_t p = order[pos - 1];
+                const bool before =
+                    (_rep.energyJ[i] < _rep.energyJ[p]) ||
+                    (_rep.energyJ[i] == _rep.energyJ[p] && _wires[i].tempC < _wires[p].tempC);
+                if (!before) break;
+                order[pos] = p;
+                --pos;
+            }
+            order[pos] = i;
+        }
+    }
+    if (count == 0) return 0;
+
+    const float vNow = (isfinite(v) && v > 0.0f) ? v : _lastV;
+    uint16_t mask = 0;
+    float g = 0.0f;
+    for (uint8_t k = 0; k < count; ++k) {
+        const uint8_t i = order[k];
+        const float gNext = g + _wires[i].gS;
+        if (_cfg.maxCurrentA > 0.0f && vNow * gNext > _cfg.maxCurrentA) continue;
+        mask |= static_cast<uint16_t>(1u << i);
+        g = gNext;
+    }
+    if (mask == 0) {
+        // Even one wire exceeds the limit: use the lightest load.
+        uint8_t best = order[0];
+        for (uint8_t k = 1; k < count; ++k) {
+            if (_wires[order[k]].gS < _wires[best].gS) best = order[k];
+        }
+        mask = static_cast<uint16_t>(1u << best);
+    }
+    return mask;
+}
+
+CapDischargeController::Status CapDischargeController::update(uint16_t mask, float v,
+                                                              uint32_t nowUs) {
+    if (_rep.status != Status::Running) return _rep.status;
+    if (!isfinite(v)) return _rep.status;
+    if (v < 0.0f) v = 0.0f;
+
+    const float dtS = (nowUs - _lastUs) * 1e-6f;
+    const float vPrev = _lastV;
+    _rep.elapsedMs = (nowUs - _startUs) / 1000u;
+    _rep.steps++;
+
+    float gMask = 0.0f;
+    for (uint8_t i = 0; i < _n; ++i) {
+        if (mask & (1u << i)) gMask += _wires[i].gS;
+    }
+
+    // Energy dumped this step, split by conductance share.
+    if (gMask > 0.0f && dtS > 0.0f) {
+        float stepJ = 0.0f;
+        if (_cfg.capF > 0.0f) {
+            stepJ = 0.5f * _cfg.capF * (vPrev * vPrev - v * v);
+            if (stepJ < 0.0f) stepJ = 0.0f;
+        } else {
+            stepJ = vPrev * v * gMask * dtS;
+        }
+        for (uint8_t i = 0; i < _n; ++i) {
+            if (!(mask & (1u << i))) continue;
+            const float e = stepJ * (_wires[i].gS / gMask);
+            _rep.energyJ[i] += e;
+            _rep.totalJ += e;
+            if (e > 0.0f) _rep.usedMask |= static_cast<uint16_t>(1u << i);
+        }
+    }
+
+    // Per-wire open detection: on-times so far against the measured decay.
+    if (_cfg.capF > 0.0f && gMask > 0.0f && dtS > 0.0f) {
+        for (uint8_t i = 0; i < _n; ++i) {
+            if (!(mask & (1u << i))) continue;
+            _onTime[i] += _wires[i].gS * dtS / _cfg.capF;
+            if (_stepsOn[i] < 255) _stepsOn[i]++;
+        }
+        addSample(v);
+    }
+
+    _lastUs = nowUs;
+    _lastV = v;
+    _rep.vEnd = v;
+
+    if (v <= _cfg.vSafe) {
+        _rep.status = Status::Done;
+        return _rep.status;
+    }
+
+    if (v <= _progressV * (1.0f - kProgressFrac)) {
+        _progressV = v;
+        _progressUs = nowUs;
+    } else if ((nowUs - _progressUs) / 1000u >= _cfg.stallMs) {
+        _rep.status = Status::Stalled;
+        return _rep.status;
+    }
+
+    bool any = false;
+    for (uint8_t i = 0; i < _n && !any; ++i) any = usable(i);
+    if (!any) {
+        _rep.status = Status::Stalled;
+        return _rep.status;
+    }
+
+    if (_cfg.timeoutMs > 0 && _rep.elapsedMs >= _cfg.timeoutMs) {
+        _rep.status = Status::Timeout;
+    }
+    return _rep.status;
+}
+
+void CapDischargeController::addSample(float v) {
+    if (!(v > _cfg.minEvalV) || !(_rep.v0 > 0.0f)) return;
+
+    // ADC noise sigma gives ln(V) a spread of sigma / V; weighting by V^2
+    // leaves the residuals in volts^2.
+    const float y = logf(_rep.v0 / v);
+    const float w = v * v;
+    float x[kFit];
+    x[0] = 1.0f;
+    for (uint8_t i = 0; i < _n; ++i) x[i + 1] = _onTime[i];
+
+    for (uint8_t a = 0; a <= _n; ++a) {
+        if (x[a] == 0.0f) continue;
+        for (uint8_t b = 0; b <= a; ++b) _ata[packed(a, b)] += w * x[a] * x[b];
+        _atb[a] += w * x[a] * y;
+    }
+    _yy += w * y * y;
+    if (_rows < 0xFFFF) _rows++;
+
+    detectOpen();
+}
+
+void CapDischargeController::detectOpen() {
+    // Unknowns: the offset and every wire that has been on.
+    uint8_t idx[kFit];
+    uint8_t m = 0;
+    idx[m++] = 0;
+    float diagMax = 0.0f;
+    for (uint8_t i = 0; i < _n; ++i) {
+        if (_stepsOn[i] == 0) continue;
+        idx[m++] = static_cast<uint8_t>(i + 1);
+        const float d = _ata[packed(i + 1, i + 1)];
+        if (d > diagMax) diagMax = d;
+    }
+    if (m < 2 || _rows < m + kMinDof || !(diagMax > 0.0f)) return;
+
+    // Cholesky of A + lambda I on the wires (a weak prior of r = 1 keeps
+    // wires that always switch together solvable; they share the deficit).
+    const float lambda = kRidge * diagMax;
+    auto ata = [&](uint8_t k, uint8_t q) {
+        return (idx[k] >= idx[q]) ? _ata[packed(idx[k], idx[q])]
+                                  : _ata[packed(idx[q], idx[k])];
+    };
+    float L[kPacked];
+    for (uint8_t k = 0; k < m; ++k) {
+        for (uint8_t q = 0; q <= k; ++q) {
+            float sum = ata(k, q) + ((k == q && k > 0) ? lambda : 0.0f);
+            for (uint8_t j = 0; j < q; ++j) sum -= L[packed(k, j)] * L[packed(q, j)];
+            if (k == q) {
+                if (!(sum > 0.0f)) return;
+                L[packed(k, k)] = sqrtf(sum);
+            } else {
+                L[packed(k, q)] = sum / L[packed(q, q)];
+            }
+        }
+    }
+
+    float r[kFit];
+    for (uint8_t k = 0; k < m; ++k) {
+        float sum = _atb[idx[k]] + ((k > 0) ? lambda : 0.0f);
+        for (uint8_t j = 0; j < k; ++j) sum -= L[packed(k, j)] * r[j];
+        r[k] = sum / L[packed(k, k)];
+    }
+    for (int k = m - 1; k >= 0; --k) {
+        float sum = r[k];
+        for (uint8_t j = k + 1; j < m; ++j) sum -= L[packed(j, k)] * r[j];
+        r[k] = sum / L[packed(k, k)];
+    }
+
+    // Mean measured / model conductance of the wires used so far.
+    float gSum = 0.0f;
+    float gMeas = 0.0f;
+    for (uint8_t k = 1; k < m; ++k) {
+        gSum += _wires[idx[k] - 1].gS;
+        gMeas += _wires[idx[k] - 1].gS * r[k];
+    }
+    if (gSum > 0.0f) _rep.gRatio = gMeas / gSum;
+
+    // Residual noise: y'y - 2 r'b + r'Ar over the spare samples.
+    float rss = _yy;
+    for (uint8_t k = 0; k < m; ++k) {
+        rss -= 2.0f * r[k] * _atb[idx[k]];
+        for (uint8_t q = 0; q < m; ++q) rss += r[k] * ata(k, q) * r[q];
+    }
+    float s2 = rss / static_cast<float>(_rows - m);
+    const float floor2 = _cfg.noiseFloorV * _cfg.noiseFloorV;
+    if (!(s2 > floor2)) s2 = floor2;
+
+    // Reference: upper median of the wires not yet found open; a C
+    // calibrated up to 30 % low still reads as healthy.
+    float sorted[kMaxWires];
+    uint8_t ns = 0;
+    for (uint8_t k = 1; k < m; ++k) {
+        if (_rep.openMask & (1u << (idx[k] - 1))) continue;
+        uint8_t pos = ns++;
+        while (pos > 0 && sorted[pos - 1] > r[k]) {
+            sorted[pos] = sorted[pos - 1];
+            --pos;
+        }
+        sorted[pos] = r[k];
+    }
+    if (ns == 0) return;
+    float ref = sorted[ns / 2];
+    // Most wires carrying nothing is a bank-level fault; the stall check
+    // reports that, no single wire is to blame.
+    if (ref < _cfg.stallFrac * kAbsRatioTol) return;
+    if (ref < kAbsRatioTol) ref = kAbsRatioTol;
+    const float limit = _cfg.stallFrac * ref;
+
+    for (uint8_t k = 1; k < m; ++k) {
+        const uint8_t i = static_cast<uint8_t>(idx[k] - 1);
+        if ((_rep.openMask & (1u << i)) || _stepsOn[i] < _cfg.stallSteps) continue;
+        if (!(r[k] < limit)) continue;
+        // Var(r_k) = s2 * (A^-1)_kk = s2 * |L^-1 e_k|^2.
+        float z[kFit];
+        float var = 0.0f;
+        for (uint8_t q = k; q < m; ++q) {
+            float sum = (q == k) ? 1.0f : 0.0f;
+            for (uint8_t j = k; j < q; ++j) sum -= L[packed(q, j)] * z[j];
+            z[q] = sum / L[packed(q, q)];
+            var += z[q] * z[q];
+        }
+        if (r[k] + _cfg.openZ * sqrtf(s2 * var) < limit) {
+            _rep.openMask |= static_cast<uint16_t>(1u << i);
+        }
+    }
+}
+
+uint32_t CapDischargeController::predictMs(float capF, float gAllS, float maxCurrentA,
+                                           float v0, float vSafe) {
+    if (!(capF > 0.0f) || !(gAllS > 0.0f) || !isfinite(v0) || !(vSafe > 0.0f)) return 0;
+    if (v0 <= vSafe) return 0;
+
+    double t = 0.0;
+    double v = v0;
+    if (maxCurrentA > 0.0f) {
+        double vKnee = maxCurrentA / gAllS;
+        if (vKnee < vSafe) vKnee = vSafe;
+        if (v > vKnee) {
+            t += capF * (v - vKnee) / maxCurrentA;
+            v = vKnee;
+        }
+    }
+    if (v > vSafe) t += (capF / gAllS) * log(v / vSafe);
+    return static_cast<uint32_t>(ceil(t * 1000.0));
+}
+
+const char* CapDischargeController::statusName(Status s) {
+    switch (s) {
+        case Status::Running: return "running";
+        case Status::Done:    return "done";
+        case Status::Stalled: return "stalled";
+        case Status::NoLoad:  return "no_load";
+        case Status::Timeout: return "timeout";
+        default:              return "idle";
+    }
+}
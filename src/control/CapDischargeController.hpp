@@ -0,0 +1,152 @@
+#ifndef CAP_DISCHARGE_CONTROLLER_HPP
+#define CAP_DISCHARGE_CONTROLLER_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Closed-loop capacitor bank discharge through the heater wires.
+ *
+ * With the relay open the bank decays through the active mask:
+ *   C dV/dt = -G_mask * V.
+ * Each step the controller picks the mask for the present bus voltage:
+ * usable wires (not too hot, not found open) are added in order of least
+ * energy dumped so far, then coolest, while V * G_mask stays under the
+ * current limit. Early steps therefore rotate subsets of wires at the
+ * current limit; once V has dropped, every usable wire is on.
+ *
+ * With a calibrated C, every sample above minEvalV is one equation
+ *   ln(V0 / V) = c + sum_i r_i * (g_i / C) * (time wire i has been on)
+ * in the per-wire ratios r_i of measured to cached conductance (c takes
+ * up the noise of the first reading). The equations are accumulated
+ * (least squares, weighted by V^2 since ADC noise hurts ln(V) most at
+ * low voltage) and solved after every sample. The early rotation
+ * switches wires in different combinations, which is what tells them
+ * apart. A wire is marked open once its ratio, plus openZ standard
+ * errors, is still below stallFrac of the median ratio (which cancels
+ * an error in the calibrated C); the ADC noise behind the standard error
+ * is estimated from the residuals. The discharge then continues on the
+ * rest. Wires that always switch together cannot be told apart and
+ * share the deficit, so they are not flagged; the mean measured/model
+ * conductance ratio still shows the shortfall. Nothing is flagged while
+ * most wires look open: no voltage progress over stallMs means the whole
+ * discharge has stalled.
+ *
+ * The discharge finishes on the first sample at or below vSafe. Energy
+ * dumped per wire (the step's 1/2 C dV^2 split by conductance share) and
+ * the elapsed time are reported alongside the model prediction.
+ */
+
+#ifndef CAP_DISCHARGE_STALL_FRAC
+#define CAP_DISCHARGE_STALL_FRAC     0.5f    // open below this fraction of the median ratio
+#endif
+#ifndef CAP_DISCHARGE_STALL_STEPS
+#define CAP_DISCHARGE_STALL_STEPS    3       // steps a wire was on in before it can be "open"
+#endif
+#ifndef CAP_DISCHARGE_OPEN_Z
+#define CAP_DISCHARGE_OPEN_Z         2.0f    // standard errors of margin for "open"
+#endif
+#ifndef CAP_DISCHARGE_NOISE_FLOOR_V
+#define CAP_DISCHARGE_NOISE_FLOOR_V  0.25f   // lower bound on the estimated ADC noise
+#endif
+#ifndef CAP_DISCHARGE_STALL_MS
+#define CAP_DISCHARGE_STALL_MS       200     // no progress window
+#endif
+#ifndef CAP_DISCHARGE_MIN_EVAL_V
+#define CAP_DISCHARGE_MIN_EVAL_V     40.0f   // below this ADC noise dominates ln(V)
+#endif
+#ifndef CAP_DISCHARGE_TIMEOUT_MS
+#define CAP_DISCHARGE_TIMEOUT_MS     5000
+#endif
+
+class CapDischargeController {
+public:
+    static constexpr uint8_t kMaxWires = 16;
+
+    enum class Status : uint8_t {
+        Idle = 0,
+        Running = 1,
+        Done = 2,
+        Stalled = 3,
+        NoLoad = 4,
+        Timeout = 5
+    };
+
+    struct Config {
+        float    capF = 0.0f;            // calibrated bank [F]; <= 0 = no model
+        float    vSafe = 5.0f;           // done at or below [V]
+        float    maxCurrentA = 0.0f;     // <= 0 = unlimited
+        float    maxWireTempC = 0.0f;    // wires at/above are skipped (<= 0 = off)
+        float    stallFrac = CAP_DISCHARGE_STALL_FRAC;
+        uint8_t  stallSteps = CAP_DISCHARGE_STALL_STEPS;
+        float    openZ = CAP_DISCHARGE_OPEN_Z;
+        float    noiseFloorV = CAP_DISCHARGE_NOISE_FLOOR_V;
+        uint32_t stallMs = CAP_DISCHARGE_STALL_MS;
+        float    minEvalV = CAP_DISCHARGE_MIN_EVAL_V;
+        uint32_t timeoutMs = CAP_DISCHARGE_TIMEOUT_MS;
+    };
+
+    struct Wire {
+        float gS = 0.0f;      // conductance [S] (0 = not usable)
+        float tempC = 0.0f;   // estimated temperature (NAN = unknown)
+    };
+
+    struct Report {
+        Status   status = Status::Idle;
+        uint32_t elapsedMs = 0;
+        uint32_t modelMs = 0;         // predicted time to vSafe (0 = unknown)
+        uint32_t steps = 0;
+        float    v0 = 0.0f;
+        float    vEnd = 0.0f;
+        float    totalJ = 0.0f;
+        float    energyJ[kMaxWires] = {0.0f};
+        uint16_t usedMask = 0;        // wires that carried energy
+        uint16_t openMask = 0;        // wires found open during the discharge
+        float    gRatio = 0.0f;       // mean measured / model conductance (0 = not measured)
+    };
+
+    // wires[i] is bit i of the output mask; n <= kMaxWires.
+    void begin(const Config& cfg, const Wire* wires, uint8_t n, float v0, uint32_t nowUs);
+
+    // Mask to apply for the next step at bus voltage v (0 = nothing usable).
+    uint16_t nextMask(float v);
+
+    // Bus voltage after the step with `mask` applied.
+    Status update(uint16_t mask, float v, uint32_t nowUs);
+
+    const Report& report() const { return _rep; }
+
+    // Model time to vSafe with the current limit: constant-current phase
+    // down to Imax / G, then exponential decay through all wires.
+    static uint32_t predictMs(float capF, float gAllS, float maxCurrentA,
+                              float v0, float vSafe);
+
+    static const char* statusName(Status s);
+
+private:
+    // Open-wire fit: unknown 0 is the offset c, unknown i + 1 is wire i.
+    static constexpr uint8_t kFit = kMaxWires + 1;
+    static constexpr uint8_t kPacked = kFit * (kFit + 1) / 2;
+
+    bool usable(uint8_t i) const;
+    void addSample(float v);
+    void detectOpen();
+
+    Config   _cfg{};
+    Report   _rep{};
+    Wire     _wires[kMaxWires]{};
+    uint8_t  _n = 0;
+    uint32_t _startUs = 0;
+    uint32_t _lastUs = 0;
+    float    _lastV = 0.0f;
+    uint32_t _progressUs = 0;
+    float    _progressV = 0.0f;
+    float    _onTime[kMaxWires]{};   // sum of g_i dt / C while wire i was on
+    uint8_t  _stepsOn[kMaxWires]{};
+    float    _ata[kPacked]{};        // normal equations, packed lower triangle
+    float    _atb[kFit]{};
+    float    _yy = 0.0f;
+    uint16_t _rows = 0;              // samples in the fit
+};
+
+#endif // CAP_DISCHARGE_CONTROLLER_HPP
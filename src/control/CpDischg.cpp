@@ -51,29 +51,59 @@ void CpDischg::begin() {
     ensureMonitorTask();
 }
 
-void CpDischg::discharge() {
-    for (;;) {
-        float v = readCapVoltage();
-        DEBUG_PRINTF("[CpDischg] Capacitor voltage: %.2f V âš¡\n", v);
+bool CpDischg::discharge(uint16_t allowedMask,
+                         const CapDischargeController::Config* cfg,
+                         CapDischargeController::Report* report) {
+    CapDischargeController::Config c{};
+    if (cfg) {
+        c = *cfg;
+    } else {
+        c.vSafe = SAFE_VOLTAGE_THRESHOLD;
+        c.maxCurrentA = DEFAULT_CURR_LIMIT_A;
+    }
 
-        if (v <= SAFE_VOLTAGE_THRESHOLD) {
-            break;
-        }
+    if (!WIRE) {
+        if (report) *report = CapDischargeController::Report{};
+        return false;
+    }
 
-        if (WIRE) {
-            for (int i = 1; i <= 10; ++i) {
-                WIRE->setOutput(i, true);
-                delay(20);
-                WIRE->setOutput(i, false);
-            }
-        }
+    // Bleed only with the source disconnected.
+    WIRE->disableAll();
+    if (relay && relay->isOn()) {
+        relay->turnOff();
+        vTaskDelay(pdMS_TO_TICKS(20));
+    }
 
-        delay(100);
+    // Per-wire conductance from the mask cache, temperature from the model.
+    CapDischargeController::Wire wires[HeaterManager::kWireCount];
+    for (uint8_t i = 0; i < HeaterManager::kWireCount; ++i) {
+        if (!(allowedMask & (1u << i))) continue;
+        wires[i].gS = WIRE->getMaskConductance(static_cast<uint16_t>(1u << i));
+        wires[i].tempC = WIRE->getWireEstimatedTemp(i + 1);
     }
 
-    if (WIRE) {
-        WIRE->disableAll();
+    CapDischargeController ctl;
+    float v = sampleVoltageAvg(CAP_DISCHARGE_ADC_AVG);
+    ctl.begin(c, wires, HeaterManager::kWireCount, v, micros());
+
+    while (ctl.report().status == CapDischargeController::Status::Running) {
+        const uint16_t mask = ctl.nextMask(v);
+        if (mask == 0) break;
+        WIRE->setDischargeMask(mask);
+        vTaskDelay(pdMS_TO_TICKS(CAP_DISCHARGE_STEP_MS));
+        v = sampleVoltageAvg(CAP_DISCHARGE_ADC_AVG);
+        ctl.update(mask, v, micros());
     }
+    WIRE->disableAll();
+
+    const CapDischargeController::Report& r = ctl.report();
+    DEBUG_PRINTF("[CpDischg] Discharge %s: %.1fV -> %.1fV in %lums (model %lums), %.1fJ, open=0x%03X\n",
+                 CapDischargeController::statusName(r.status),
+                 (double)r.v0, (double)r.vEnd,
+                 (unsigned long)r.elapsedMs, (unsigned long)r.modelMs,
+                 (double)r.totalJ, (unsigned)r.openMask);
+    if (report) *report = r;
+    return r.status == CapDischargeController::Status::Done;
 }
 
 float CpDischg::readCapVoltage()
@@ -106,6 +136,15 @@ float CpDischg::sampleVoltageNow() {
     return adcCodeToBusVolts(raw);
 }
 
+float CpDischg::sampleVoltageAvg(uint8_t n) {
+    if (n == 0) n = 1;
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < n; ++i) {
+        sum += adcCodeToBusVolts(analogRead(CAPACITOR_ADC_PIN));
+    }
+    return sum / n;
+}
+
 uint16_t CpDischg::sampleAdcRaw() const {
     return analogRead(CAPACITOR_ADC_PIN);
 }
@@ -14,6 +14,7 @@
 #include <HeaterManager.hpp>
 #include <Relay.hpp>
 #include <Utils.hpp>
+#include <CapDischargeController.hpp>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/semphr.h>
@@ -66,6 +67,14 @@
 #define CAP_EMP_GAIN_MAX        500.0f    // sanity upper bound for runtime gain
 #endif
 
+#ifndef CAP_DISCHARGE_STEP_MS
+#define CAP_DISCHARGE_STEP_MS   5           // closed-loop discharge step
+#endif
+
+#ifndef CAP_DISCHARGE_ADC_AVG
+#define CAP_DISCHARGE_ADC_AVG   32          // ADC reads averaged per discharge step
+#endif
+
 class CpDischg {
 public:
     explicit CpDischg(Relay* relay)
@@ -80,7 +89,12 @@ public:
 
     // Explicit, intentional capacitor discharge using heater outputs.
     // Only this function is allowed to toggle heaters for bleeding.
-    void discharge();
+    // Opens the relay, then runs CapDischargeController over the wires in
+    // allowedMask until cfg.vSafe (nullptr = defaults, no capacitor model).
+    // Returns true when the bank reached the safe voltage.
+    bool discharge(uint16_t allowedMask = 0x03FF,
+                   const CapDischargeController::Config* cfg = nullptr,
+                   CapDischargeController::Report* report = nullptr);
 
     // Non-blocking:
     // Returns last background-computed minimum capacitor/bus voltage.
@@ -102,6 +116,8 @@ public:
 
     // Single-shot voltage sample (immediate ADC read, scaled).
     float sampleVoltageNow();
+    // Mean of n immediate samples (for the discharge open-wire fit).
+    float sampleVoltageAvg(uint8_t n);
     // Raw ADC sample (immediate) without scaling.
     uint16_t sampleAdcRaw() const;
     // Convert raw ADC code to ADC pin voltage (after offset).
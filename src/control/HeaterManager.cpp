@@ -4,6 +4,7 @@
 
 #include <HeaterManager.hpp>
 #include <Device.hpp>
+#include <SampleRateGovernor.hpp>
 #include <math.h>
 // Static singleton pointer
 HeaterManager* HeaterManager::s_instance = nullptr;
@@ -55,6 +56,7 @@ HeaterManager::HeaterManager()
         wires[i].connected          = true;   // default: unknown / not confirmed
         wires[i].lastOnMs           = 0;
     }
+    rebuildConductanceLocked();
 }
 
 // ==========================================================================
@@ -82,6 +84,7 @@ void HeaterManager::begin() {
     _currentMask = 0;
 
     loadWireConfig();
+    rebuildConductanceLocked();
     _initialized = true;
 }
 
@@ -234,6 +237,10 @@ void HeaterManager::setOutput(uint8_t index, bool enable) {
         return;
     }
 
+    if (_emergencyCut) {
+        enable = false;
+    }
+
     uint16_t newMask = _currentMask;
     const uint16_t oldMask = _currentMask;
     if (enable) {
@@ -255,6 +262,7 @@ void HeaterManager::setOutput(uint8_t index, bool enable) {
         _currentMask = newMask;
         logOutputMaskChange(_currentMask);
     }
+    reassertCutLocked();
 
     unlock();
 }
@@ -264,18 +272,52 @@ void HeaterManager::disableAll() {
         return;
     }
 
-    if (_currentMask != 0) {
+    if (_currentMask != 0 || _cutUnlogged) {
         // Only touch pins if anything is on
         for (uint8_t i = 0; i < kWireCount; ++i) {
             digitalWrite(enaPins[i], LOW);
         }
         _currentMask = 0;
+        _cutUnlogged = false;
         logOutputMaskChange(0);
     }
 
     unlock();
 }
 
+void HeaterManager::emergencyCutAll() {
+    // Pins first: no mutex, no logging. The history entry is written by
+    // the next disableAll() from the fault handler.
+    _emergencyCut = true;
+    for (uint8_t i = 0; i < kWireCount; ++i) {
+        digitalWrite(enaPins[i], LOW);
+    }
+    // Zero the mask as well, or a diff-based setOutputMask() after
+    // clearEmergencyCut() would skip pins it still believes are HIGH.
+    if (_currentMask != 0) {
+        _cutUnlogged = true;
+    }
+    _currentMask = 0;
+}
+
+void HeaterManager::reassertCutLocked() {
+    if (!_emergencyCut) {
+        return;
+    }
+    for (uint8_t i = 0; i < kWireCount; ++i) {
+        digitalWrite(enaPins[i], LOW);
+    }
+    if (_currentMask != 0 || _cutUnlogged) {
+        _currentMask = 0;
+        _cutUnlogged = false;
+        logOutputMaskChange(0);
+    }
+}
+
+void HeaterManager::clearEmergencyCut() {
+    _emergencyCut = false;
+}
+
 bool HeaterManager::getOutputState(uint8_t index) const {
     if (index == 0 || index > kWireCount) {
         return false;
@@ -302,12 +344,24 @@ void HeaterManager::setOutputMask(uint16_t mask) {
     if (!DEVICE || DEVICE->getState() != DeviceState::Running) {
         mask = 0;
     }
+    applyMask(mask);
+}
+
+void HeaterManager::setDischargeMask(uint16_t mask) {
+    // No state gate: the bank is bled with the relay open, outside Running.
+    applyMask(mask);
+}
+
+void HeaterManager::applyMask(uint16_t mask) {
     // Only 10 bits are meaningful
     mask &= ((1u << kWireCount) - 1u);
 
     if (!lock()) {
         return;
     }
+    if (_emergencyCut) {
+        mask = 0;
+    }
 
     if (mask == _currentMask) {
         // Nothing to do
@@ -332,6 +386,7 @@ void HeaterManager::setOutputMask(uint16_t mask) {
 
     _currentMask = mask;
     logOutputMaskChange(_currentMask);
+    reassertCutLocked();
 
     unlock();
 }
@@ -352,34 +407,64 @@ float HeaterManager::estimateCurrentFromVoltage(float busVoltage, uint16_t mask)
     if (busVoltage <= 0.0f) {
         return 0.0f;
     }
-    if (!lock()) {
-        return NAN;
+
+    // Hot path (BusSampler / pulse sampling): two cached reads, no lock.
+    const double gTot = static_cast<double>(getMaskConductance(mask)) +
+                        static_cast<double>(_gCharge);
+
+    if (!(gTot > 0.0)) {
+        return 0.0f;
     }
 
-    double gTot = 0.0;
+    return static_cast<float>(busVoltage * gTot);
+}
+
+// ==========================================================================
+// Per-mask conductance cache
+// ==========================================================================
+
+void HeaterManager::rebuildConductanceLocked() {
+    // Caller holds _mutex (or runs before begin()).
+    const uint8_t next = _gActive ^ 1u;
+    float* g = _gTable[next];
+
+    float gWire[kWireCount];
     for (uint8_t i = 0; i < kWireCount; ++i) {
-        if (!(mask & (1u << i))) continue;
         const float r = wires[i].resistanceOhm;
-        if (isfinite(r) && r > 0.01f) {
-            gTot += 1.0 / r;
-        }
+        gWire[i] = (isfinite(r) && r > 0.01f) ? (1.0f / r) : 0.0f;
     }
 
-    unlock();
+    // g[m] = g[m without lowest bit] + g(lowest bit): one add per mask.
+    g[0] = 0.0f;
+    for (uint16_t m = 1; m < kMaskCount; ++m) {
+        const uint16_t rest = m & (m - 1);
+        const uint16_t low  = m ^ rest;
+        g[m] = g[rest] + gWire[__builtin_ctz(low)];
+    }
 
     float rCharge = DEFAULT_CHARGE_RESISTOR_OHMS;
     if (CONF) {
         rCharge = CONF->GetFloat(CHARGE_RESISTOR_KEY, DEFAULT_CHARGE_RESISTOR_OHMS);
     }
-    if (isfinite(rCharge) && rCharge > 0.0f) {
-        gTot += 1.0 / rCharge;
-    }
+    _gCharge = (isfinite(rCharge) && rCharge > 0.0f) ? (1.0f / rCharge) : 0.0f;
 
-    if (!(gTot > 0.0)) {
-        return 0.0f;
-    }
+    _gActive = next;
+    _gGeneration = _gGeneration + 1;
+}
 
-    return static_cast<float>(busVoltage * gTot);
+void HeaterManager::invalidateConductanceCache() {
+    if (!lock()) return;
+    rebuildConductanceLocked();
+    unlock();
+}
+
+float HeaterManager::getMaskConductance(uint16_t mask) const {
+    return _gTable[_gActive][mask & (kMaskCount - 1u)];
+}
+
+float HeaterManager::getMaskEquivalentResistance(uint16_t mask) const {
+    const float g = getMaskConductance(mask);
+    return (g > 0.0f) ? (1.0f / g) : INFINITY;
 }
 
 // ==========================================================================
@@ -388,6 +473,9 @@ float HeaterManager::estimateCurrentFromVoltage(float busVoltage, uint16_t mask)
 
 void HeaterManager::logOutputMaskChange(uint16_t newMask) {
     // Assumes _mutex is already held.
+    // Samplers switch rate on the edge (non-blocking task notify).
+    SAMPLE_GOV->onOutputMask(newMask);
+
     // Do not record duplicate entries with same mask (should be guaranteed
     // by callers, but we guard anyway).
     if (_historySeq > 0) {
@@ -476,6 +564,7 @@ void HeaterManager::setWireResistance(uint8_t index, float ohms) {
 
     wires[i].resistanceOhm = ohms;
     computeWireGeometry(wires[i]);
+    rebuildConductanceLocked();
 
     if (CONF) {
         CONF->PutFloat(WIRE_RES_KEYS[i], ohms);
@@ -484,6 +573,21 @@ void HeaterManager::setWireResistance(uint8_t index, float ohms) {
     unlock();
 }
 
+void HeaterManager::applyResistanceEstimate(uint8_t index, float ohms) {
+    if (index == 0 || index > kWireCount) return;
+    if (!isfinite(ohms) || ohms <= 0.01f) return;
+
+    const uint8_t i = index - 1;
+
+    if (!lock()) return;
+
+    wires[i].resistanceOhm = ohms;
+    computeWireGeometry(wires[i]);
+    rebuildConductanceLocked();
+
+    unlock();
+}
+
 float HeaterManager::getWireResistance(uint8_t index) const {
     if (index == 0 || index > kWireCount) return 0.0f;
     const uint8_t i = index - 1;
@@ -535,7 +639,11 @@ void HeaterManager::setWirePresence(uint8_t index, bool present) {
     }
     const uint8_t i = index - 1;
     if (!lock()) return;
-    wires[i].connected = present;
+    if (wires[i].connected != present) {
+        wires[i].connected = present;
+        // Table is resistance-only; let derived caches notice.
+        _gGeneration = _gGeneration + 1;
+    }
     unlock();
 }
 
@@ -132,6 +132,17 @@ public:
      */
     void disableAll();
 
+    /**
+     * @brief Force every ENA pin LOW without taking the mutex.
+     *
+     * For the over-current trip task, which must not wait behind a mask
+     * update. Further enables are suppressed until clearEmergencyCut();
+     * the mask reads 0 at once, call disableAll() afterwards to log it.
+     */
+    void emergencyCutAll();
+    void clearEmergencyCut();
+    bool isEmergencyCut() const { return _emergencyCut; }
+
     /**
      * @brief Get the current digital state of one ENA pin.
      *
@@ -155,6 +166,14 @@ public:
      */
     void setOutputMask(uint16_t mask);
 
+    /**
+     * @brief Apply a mask for the capacitor bleed, in any device state.
+     *
+     * Same as setOutputMask() without the Running gate; the emergency cut
+     * still wins. Only CpDischg::discharge() uses it, with the relay open.
+     */
+    void setDischargeMask(uint16_t mask);
+
     /**
      * @brief Get the current 10-bit output mask.
      *
@@ -171,6 +190,31 @@ public:
      */
     float estimateCurrentFromVoltage(float busVoltage, uint16_t mask) const;
 
+    // ---------------------------------------------------------------------
+    // Per-mask conductance cache (lock-free reads)
+    // ---------------------------------------------------------------------
+
+    /**
+     * @brief Sum of 1/R (S) over the wires in @p mask, charge path excluded.
+     *
+     * O(1) table read, no mutex. The table covers all 2^10 masks and is
+     * rebuilt when a wire resistance or the charge resistor changes;
+     * presence changes bump the generation.
+     */
+    float getMaskConductance(uint16_t mask) const;
+
+    /** @brief 1 / getMaskConductance(mask); INFINITY for an empty mask. */
+    float getMaskEquivalentResistance(uint16_t mask) const;
+
+    /** @brief 1 / charge resistor (S), cached from CHARGE_RESISTOR_KEY. */
+    float getChargeConductance() const { return _gCharge; }
+
+    /** @brief Incremented on every invalidation (derived caches can compare). */
+    uint32_t getConductanceGeneration() const { return _gGeneration; }
+
+    /** @brief Re-read the charge resistor and rebuild the table. Thread-safe. */
+    void invalidateConductanceCache();
+
     /**
      * @brief Fetch output mask transitions since a given sequence index.
      *
@@ -197,6 +241,9 @@ public:
     /** Cache + persist a single wire resistance (Ω) for channel 1..10. Thread-safe. */
     void setWireResistance(uint8_t index, float ohms);
 
+    /** Cache-only update from the online estimator (not persisted). Thread-safe. */
+    void applyResistanceEstimate(uint8_t index, float ohms);
+
     /** Get cached wire resistance (Ω); returns 0.0f if index is invalid. */
     float getWireResistance(uint8_t index) const;
 
@@ -272,8 +319,22 @@ private:
     bool              _initialized;        ///< begin() completed.
     SemaphoreHandle_t _mutex;              ///< Protects ENA pins + caches.
 
-    // Current effective 10-bit mask (bit i => wire i+1 ON).
-    uint16_t          _currentMask = 0;
+    // Current effective 10-bit mask (bit i => wire i+1 ON). Also zeroed
+    // lock-free by emergencyCutAll().
+    volatile uint16_t _currentMask = 0;
+
+    // Set lock-free by emergencyCutAll(); blocks enables until cleared.
+    volatile bool     _emergencyCut = false;
+    // The cut zeroed a non-zero mask that is not in the history yet.
+    volatile bool     _cutUnlogged  = false;
+
+    // Conductance per output mask, double-buffered: rebuilds (under _mutex)
+    // fill the inactive half, then flip _gActive. Readers never lock.
+    static constexpr uint16_t kMaskCount = (1u << kWireCount);
+    float             _gTable[2][kMaskCount];
+    volatile uint8_t  _gActive     = 0;
+    volatile uint32_t _gGeneration = 0;
+    volatile float    _gCharge     = 0.0f;
 
     // Output history ring buffer.
     OutputEvent       _history[OUTPUT_HISTORY_SIZE];
@@ -288,6 +349,7 @@ private:
 
     void loadWireConfig();                 ///< Load Ω/m, Rxx, targetR, recompute geometry.
     void computeWireGeometry(WireInfo& w); ///< Compute length/area/volume/mass for one wire.
+    void rebuildConductanceLocked();       ///< Refill the inactive mask table and flip.
 
     /**
      * @brief Record a new output mask transition in the history buffer.
@@ -296,6 +358,18 @@ private:
      * Only called when the effective mask actually changes.
      */
     void logOutputMaskChange(uint16_t newMask);
+
+    /**
+     * @brief Undo pin writes that raced a trip.
+     *
+     * emergencyCutAll() does not take the mutex, so a trip can land
+     * between a setter's _emergencyCut check and its digitalWrite(HIGH).
+     * Setters call this after their writes, with _mutex held.
+     */
+    void reassertCutLocked();
+
+    // setOutputMask() / setDischargeMask() after their gate.
+    void applyMask(uint16_t mask);
 };
 
 /**
@@ -0,0 +1,184 @@
+#include <PrechargeMonitor.hpp>
+
+#include <math.h>
+
+namespace {
+constexpr int kGridCenter = 16;          // scale = 2^((g - 16) / 8)
+constexpr uint32_t kMinFitSamples = 5;
+constexpr float kMinFitRiseFrac = 0.05f; // of vSrc; flatter curves carry no tau info
+constexpr float kMaxPlateauFrac = 1.15f; // clamp fitted plateau vs. nominal source
+constexpr uint8_t kReadyHits = 2;
+
+double gridScale(size_t g) {
+    return exp2((static_cast<int>(g) - kGridCenter) / 8.0);
+}
+} // namespace
+
+void PrechargeMonitor::begin(const Config& cfg, float v0, uint32_t nowMs) {
+    _cfg = cfg;
+    if (_cfg.faultSamples == 0) _cfg.faultSamples = 1;
+    _res = Result{};
+    _res.status = Status::Charging;
+    _res.v0 = isfinite(v0) ? v0 : 0.0f;
+    _res.lastV = _res.v0;
+    _startMs = nowMs;
+    _progressMs = nowMs;
+    _progressV = _res.v0;
+    _readyHits = 0;
+    _faultHits = 0;
+    _pending = Fault::None;
+    _samples = 0;
+    _syy = 0.0;
+    for (size_t g = 0; g < kGrid; ++g) {
+        _sxx[g] = 0.0;
+        _sxy[g] = 0.0;
+    }
+
+    const bool srcOk = isfinite(_cfg.vSrc) && _cfg.vSrc > 0.0f;
+    const float tau = _cfg.rChargeOhm * _cfg.capF;
+    _res.modelValid = srcOk && isfinite(tau) && tau > 0.0f;
+    _res.tauModelS = _res.modelValid ? tau : 0.0f;
+    _res.vInf = srcOk ? _cfg.vSrc : 0.0f;
+    _res.readyV = readyThreshold();
+
+    if (_res.modelValid && _res.v0 < _res.readyV && _res.readyV < _cfg.vSrc) {
+        const double t = tau * log((_cfg.vSrc - _res.v0) / (_cfg.vSrc - _res.readyV));
+        if (isfinite(t) && t > 0.0) {
+            _res.modelReadyMs = static_cast<uint32_t>(ceil(t * 1000.0));
+            _res.etaMs = _res.modelReadyMs;
+        }
+    }
+}
+
+float PrechargeMonitor::readyThreshold() const {
+    // No capacitor model: the plain minimum, as before the model existed.
+    if (!_res.modelValid && _cfg.minReadyV > 0.0f) return _cfg.minReadyV;
+
+    const bool srcOk = isfinite(_cfg.vSrc) && _cfg.vSrc > 0.0f;
+    float vRef = srcOk ? _cfg.vSrc : 0.0f;
+    if (_res.fitValid && isfinite(_res.vInf) && _res.vInf > 0.0f) {
+        vRef = _res.vInf;
+        if (srcOk && vRef > _cfg.vSrc * kMaxPlateauFrac) vRef = _cfg.vSrc * kMaxPlateauFrac;
+    }
+    float ready = _cfg.readyFrac * vRef;
+    if (!(ready >= _cfg.minReadyV)) ready = _cfg.minReadyV;
+    return ready;
+}
+
+void PrechargeMonitor::fit() {
+    size_t best = kGrid;
+    double bestSse = INFINITY;
+    for (size_t g = 0; g < kGrid; ++g) {
+        if (!(_sxx[g] > 0.0)) continue;
+        const double sse = _syy - (_sxy[g] * _sxy[g]) / _sxx[g];
+        if (sse < bestSse) {
+            bestSse = sse;
+            best = g;
+        }
+    }
+    if (best == kGrid) return;
+
+    _res.tauRatio = static_cast<float>(gridScale(best));
+    _res.vInf = static_cast<float>(_res.v0 + _sxy[best] / _sxx[best]);
+    const double mse = (bestSse > 0.0 && _samples > 0) ? (bestSse / _samples) : 0.0;
+    _res.residualFrac = static_cast<float>(sqrt(mse) / _cfg.vSrc);
+
+    const float tSeen = _res.elapsedMs * 0.001f;
+    const float tauFit = _res.tauModelS * _res.tauRatio;
+    const float rise = _res.lastV - _res.v0;
+    _res.fitValid = _samples >= kMinFitSamples &&
+                    tSeen >= tauFit &&
+                    rise >= kMinFitRiseFrac * _cfg.vSrc;
+}
+
+PrechargeMonitor::Status PrechargeMonitor::update(float v, uint32_t nowMs) {
+    if (_res.status != Status::Charging) return _res.status;
+    if (!isfinite(v)) return _res.status;
+
+    _res.elapsedMs = nowMs - _startMs;
+    _res.lastV = v;
+
+    const float tSec = _res.elapsedMs * 0.001f;
+
+    if (_res.modelValid && tSec > 0.0f) {
+        const double y = static_cast<double>(v) - _res.v0;
+        _syy += y * y;
+        for (size_t g = 0; g < kGrid; ++g) {
+            const double x = 1.0 - exp(-tSec / (_res.tauModelS * gridScale(g)));
+            _sxx[g] += x * x;
+            _sxy[g] += x * y;
+        }
+        _samples++;
+        fit();
+    }
+
+    // Model departures (only once the fit has seen enough of the curve).
+    if (_res.fitValid) {
+        Fault cand = Fault::None;
+        if (_res.vInf < _cfg.plateauMinFrac * _cfg.vSrc) cand = Fault::LowPlateau;
+        else if (_res.tauRatio < 1.0f / _cfg.tauTol) cand = Fault::FastCharge;
+        else if (_res.tauRatio > _cfg.tauTol) cand = Fault::SlowCharge;
+
+        if (cand == Fault::None) {
+            _faultHits = 0;
+        } else if (cand == _pending) {
+            if (_faultHits < 255) _faultHits++;
+        } else {
+            _faultHits = 1;
+        }
+        _pending = cand;
+        if (cand != Fault::None && _faultHits >= _cfg.faultSamples) {
+            _res.fault = cand;
+            _res.status = Status::Fault;
+            return _res.status;
+        }
+    }
+
+    _res.readyV = readyThreshold();
+
+    // No measurable rise for a while below the threshold. Without a model
+    // the expected curve is unknown; the caller's timeout covers that case.
+    if (_res.modelValid) {
+        const float riseV = _cfg.stallRiseFrac * _cfg.vSrc;
+        if (v >= _progressV + riseV) {
+            _progressV = v;
+            _progressMs = nowMs;
+        }
+        uint32_t stallMs = _cfg.stallMs;
+        // Slowest curve the fit grid can represent is 4x the model.
+        const float tol = (_cfg.tauTol < 4.0f) ? _cfg.tauTol : 4.0f;
+        const float w = 3.0f * _res.tauModelS * tol * 1000.0f;
+        if (w > stallMs) stallMs = static_cast<uint32_t>(w);
+        if (v < _res.readyV && (nowMs - _progressMs) >= stallMs) {
+            _res.fault = Fault::Stalled;
+            _res.status = Status::Fault;
+            return _res.status;
+        }
+    }
+
+    // Remaining time on the fitted (or model) curve.
+    _res.etaMs = 0;
+    const float vRef = _res.fitValid ? _res.vInf : _cfg.vSrc;
+    const float tau = _res.tauModelS * (_res.fitValid ? _res.tauRatio : 1.0f);
+    if (tau > 0.0f && v < _res.readyV && _res.readyV < vRef) {
+        const double t = tau * log((vRef - v) / (vRef - _res.readyV));
+        if (isfinite(t) && t > 0.0) _res.etaMs = static_cast<uint32_t>(ceil(t * 1000.0));
+    }
+
+    if (v >= _res.readyV) {
+        if (++_readyHits >= kReadyHits) _res.status = Status::Ready;
+    } else {
+        _readyHits = 0;
+    }
+    return _res.status;
+}
+
+const char* PrechargeMonitor::faultName(Fault f) {
+    switch (f) {
+        case Fault::FastCharge: return "cap low (charges too fast)";
+        case Fault::SlowCharge: return "charge too slow";
+        case Fault::LowPlateau: return "bus load/leak (low plateau)";
+        case Fault::Stalled:    return "charge stalled";
+        default:                return "none";
+    }
+}
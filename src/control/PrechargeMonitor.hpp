@@ -0,0 +1,124 @@
+#ifndef PRECHARGE_MONITOR_HPP
+#define PRECHARGE_MONITOR_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Model-based capacitor precharge readiness and health check.
+ *
+ * With the relay closed the bank charges through the charge resistor:
+ *   v(t) = vInf + (v0 - vInf) * exp(-t / tau),  tau = Rcharge * C.
+ * Live voltage samples are fitted to that curve: tau is searched on a
+ * log grid around the model value (running sums only, no sample buffer)
+ * and vInf is solved in closed form for each candidate. The fit gives
+ *  - readiness: the bank is ready once it is within readyFrac of the
+ *    fitted plateau (or the source voltage before the fit is usable),
+ *    so start-up no longer waits a fixed soak. Without a model (no
+ *    calibrated C) the ready level is just minReadyV;
+ *  - a predicted time-to-ready from the fitted curve;
+ *  - faults when the measured curve departs from the model:
+ *      FastCharge  tau << model  -> capacitance lost (degraded bank)
+ *      SlowCharge  tau >> model  -> charge path / bank out of spec
+ *      LowPlateau  vInf << vSrc  -> load across the bus (leak / short)
+ *      Stalled     no rise       -> relay / charge path open, dead short
+ *    All of them need the model; without it only the caller's timeout
+ *    applies.
+ */
+
+#ifndef PRECHARGE_READY_FRAC
+#define PRECHARGE_READY_FRAC        0.95f   // of fitted plateau
+#endif
+#ifndef PRECHARGE_TAU_TOL
+#define PRECHARGE_TAU_TOL           1.6f    // fitted/model tau outside [1/tol, tol] = fault
+#endif
+#ifndef PRECHARGE_PLATEAU_MIN_FRAC
+#define PRECHARGE_PLATEAU_MIN_FRAC  0.80f   // fitted vInf below this * vSrc = load on bus
+#endif
+#ifndef PRECHARGE_STALL_MS
+#define PRECHARGE_STALL_MS          1500    // min window without rise before "stalled"
+#endif
+#ifndef PRECHARGE_STALL_RISE_FRAC
+#define PRECHARGE_STALL_RISE_FRAC   0.01f   // rise (of vSrc) that counts as progress
+#endif
+#ifndef PRECHARGE_FAULT_SAMPLES
+#define PRECHARGE_FAULT_SAMPLES     3       // consecutive failing fits before a fault
+#endif
+
+class PrechargeMonitor {
+public:
+    enum class Status : uint8_t {
+        Idle = 0,
+        Charging = 1,
+        Ready = 2,
+        Fault = 3
+    };
+
+    enum class Fault : uint8_t {
+        None = 0,
+        FastCharge = 1,
+        SlowCharge = 2,
+        LowPlateau = 3,
+        Stalled = 4
+    };
+
+    struct Config {
+        float vSrc = 0.0f;          // nominal source voltage [V]
+        float rChargeOhm = 0.0f;    // charge path [ohm]
+        float capF = 0.0f;          // calibrated bank [F]; <= 0 = no model
+        float minReadyV = 0.0f;     // never ready below this [V]
+        float readyFrac = PRECHARGE_READY_FRAC;
+        float tauTol = PRECHARGE_TAU_TOL;      // INFINITY disables the tau checks
+        float plateauMinFrac = PRECHARGE_PLATEAU_MIN_FRAC;
+        uint32_t stallMs = PRECHARGE_STALL_MS;
+        float stallRiseFrac = PRECHARGE_STALL_RISE_FRAC;
+        uint8_t faultSamples = PRECHARGE_FAULT_SAMPLES;
+    };
+
+    struct Result {
+        Status   status = Status::Idle;
+        Fault    fault = Fault::None;
+        bool     modelValid = false;   // capF/rCharge usable
+        bool     fitValid = false;     // enough of the curve seen to trust the fit
+        uint32_t elapsedMs = 0;
+        uint32_t modelReadyMs = 0;     // model prediction from v0 (0 = unknown)
+        uint32_t etaMs = 0;            // predicted remaining time to ready
+        float    v0 = 0.0f;
+        float    lastV = 0.0f;
+        float    readyV = 0.0f;        // current readiness threshold
+        float    tauModelS = 0.0f;
+        float    tauRatio = 1.0f;      // fitted / model tau
+        float    vInf = 0.0f;          // fitted plateau [V]
+        float    residualFrac = 0.0f;  // fit RMS residual / vSrc
+    };
+
+    void begin(const Config& cfg, float v0, uint32_t nowMs);
+
+    // Feed one bus-voltage sample; returns the updated status.
+    Status update(float v, uint32_t nowMs);
+
+    const Result& result() const { return _res; }
+
+    static const char* faultName(Fault f);
+
+private:
+    static constexpr size_t kGrid = 33;  // log2(scale) in [-2, 2], 1/8 steps
+
+    void fit();
+    float readyThreshold() const;
+
+    Config   _cfg{};
+    Result   _res{};
+    uint32_t _startMs = 0;
+    uint32_t _progressMs = 0;
+    float    _progressV = 0.0f;
+    uint8_t  _readyHits = 0;
+    uint8_t  _faultHits = 0;
+    Fault    _pending = Fault::None;
+    uint32_t _samples = 0;
+    double   _syy = 0.0;
+    double   _sxx[kGrid] = {0.0};
+    double   _sxy[kGrid] = {0.0};
+};
+
+#endif // PRECHARGE_MONITOR_HPP
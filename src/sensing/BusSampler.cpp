@@ -1,6 +1,7 @@
 #include <BusSampler.hpp>
 #include <HeaterManager.hpp>
 #include <NtcSensor.hpp>
+#include <SampleRateGovernor.hpp>
 #include <Config.hpp>
 #include <math.h>
 
@@ -39,14 +40,19 @@ static int getCurrentSourceSetting() {
     if (CONF) {
         src = CONF->GetInt(CURRENT_SOURCE_KEY, DEFAULT_CURRENT_SOURCE);
     }
-    if (src != CURRENT_SRC_ACS) {
+    if (src != CURRENT_SRC_ACS && src != CURRENT_SRC_FUSED) {
         src = CURRENT_SRC_ESTIMATE;
     }
     return src;
 }
 
 static float sampleBusCurrent(CurrentSensor* cs, float busVoltage) {
-    if (getCurrentSourceSetting() == CURRENT_SRC_ACS) {
+    const int src = getCurrentSourceSetting();
+    if (src == CURRENT_SRC_FUSED) {
+        const float acs = cs ? cs->readCurrent() : NAN;
+        return BUS_SAMPLER->fuseCurrent(acs, estimateBusCurrent(busVoltage), millis());
+    }
+    if (src == CURRENT_SRC_ACS) {
         if (cs) {
             const float i = cs->readCurrent();
             if (isfinite(i)) {
@@ -127,7 +133,11 @@ void BusSampler::taskThunk(void* param) {
 }
 
 void BusSampler::taskLoop(uint32_t periodMs) {
-    const TickType_t delayTicks = pdMS_TO_TICKS(periodMs);
+    // periodMs is the fast (heating/calibration) period; idle is governed.
+    const uint32_t idleMs = (SAMPLE_GOV_BUS_IDLE_PERIOD_MS > periodMs)
+                          ? SAMPLE_GOV_BUS_IDLE_PERIOD_MS
+                          : periodMs;
+    SAMPLE_GOV->attachTask(xTaskGetCurrentTaskHandle());
     for (;;) {
         const uint32_t ts = millis();
         float v = NAN;
@@ -139,7 +149,7 @@ void BusSampler::taskLoop(uint32_t periodMs) {
         i = sampleBusCurrent(currentSensor, v);
 
         pushSample(ts, v, i);
-        vTaskDelay(delayTicks);
+        SAMPLE_GOV->waitNext(periodMs, idleMs);
     }
 }
 
@@ -200,3 +210,34 @@ size_t BusSampler::getHistorySince(uint32_t lastSeq,
 void BusSampler::recordSample(uint32_t tsMs, float voltageV, float currentA) {
     pushSample(tsMs, voltageV, currentA);
 }
+
+float BusSampler::fuseCurrent(float acsA, float estA, uint32_t tsMs) {
+    if (!_mutex || xSemaphoreTake(_mutex, pdMS_TO_TICKS(5)) != pdTRUE) {
+        // Contended: fall back to the raw inputs, ACS first.
+        return isfinite(acsA) ? acsA : estA;
+    }
+    const float dtS = (_fusionLastMs != 0)
+                          ? static_cast<float>(tsMs - _fusionLastMs) * 0.001f
+                          : 0.0f;
+    _fusionLastMs = tsMs;
+    const CurrentFusion::Output o = _fusion.update(acsA, estA, dtS);
+    xSemaphoreGive(_mutex);
+    return o.currentA;
+}
+
+CurrentFusion::Output BusSampler::getFusedCurrent() const {
+    CurrentFusion::Output o;
+    if (_mutex && xSemaphoreTake(_mutex, pdMS_TO_TICKS(5)) == pdTRUE) {
+        o = _fusion.last();
+        xSemaphoreGive(_mutex);
+    }
+    return o;
+}
+
+void BusSampler::resetFusion() {
+    if (_mutex && xSemaphoreTake(_mutex, portMAX_DELAY) == pdTRUE) {
+        _fusion.reset();
+        _fusionLastMs = 0;
+        xSemaphoreGive(_mutex);
+    }
+}
@@ -10,6 +10,7 @@
 #include <Arduino.h>
 #include <CurrentSensor.hpp>
 #include <CpDischg.hpp>
+#include <CurrentFusion.hpp>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/semphr.h>
@@ -39,7 +40,9 @@ public:
     // Singleton-style accessor
     static BusSampler* Get();
 
-    // Start sampling task. periodMs = sampling interval (default ~200 Hz -> 5ms).
+    // Start sampling task. periodMs = sampling interval while heating or
+    // calibrating (default ~200 Hz -> 5ms); idle rate comes from
+    // SampleRateGovernor. History timestamps are real, dt varies.
     void begin(CurrentSensor* cs, CpDischg* cp, uint32_t periodMs = 5);
     void attachNtc(NtcSensor* ntc);
 
@@ -55,6 +58,16 @@ public:
     // Record a synchronized sample into history (e.g., per-packet pulse).
     void recordSample(uint32_t tsMs, float voltageV, float currentA);
 
+    // Feed one ACS + voltage-estimate pair to the fusion filter
+    // (CURRENT_SRC_FUSED). Returns the fused current (NAN if both missing).
+    float fuseCurrent(float acsA, float estA, uint32_t tsMs);
+
+    // Latest fusion output (current, sigma, confidence, learned offset/gain).
+    CurrentFusion::Output getFusedCurrent() const;
+
+    // Drop learned ACS offset / resistance error (after recalibration).
+    void resetFusion();
+
 private:
     BusSampler() = default;
 
@@ -71,6 +84,9 @@ private:
     uint32_t _historyHead = 0;
     uint32_t _historySeq  = 0;
 
+    CurrentFusion _fusion;
+    uint32_t      _fusionLastMs = 0;
+
     TaskHandle_t      taskHandle   = nullptr;
     SemaphoreHandle_t _mutex       = nullptr;
 };
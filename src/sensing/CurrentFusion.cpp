@@ -0,0 +1,96 @@
+#include <CurrentFusion.hpp>
+
+static constexpr float kOffsetLimitA = 5.0f;
+static constexpr float kGainLimit    = 0.5f;
+static constexpr float kInitOffsetVar = 0.25f;  // 0.5 A initial uncertainty
+static constexpr float kInitGainVar   = 0.01f;  // 10 % initial uncertainty
+
+static inline float clampf(float v, float lo, float hi) {
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+void CurrentFusion::reset() {
+    _offsetA = 0.0f;
+    _gainErr = 0.0f;
+    _pBB = kInitOffsetVar;
+    _pBG = 0.0f;
+    _pGG = kInitGainVar;
+    _out = Output{};
+}
+
+CurrentFusion::Output CurrentFusion::update(float acsA, float estA, float dtS) {
+    const bool haveAcs = isfinite(acsA);
+    const bool haveEst = isfinite(estA);
+
+    // ---- Predict: random-walk states ----
+    if (dtS > 0.0f && isfinite(dtS)) {
+        _pBB += CURRENT_FUSION_OFFSET_Q_A2_PER_S * dtS;
+        _pGG += CURRENT_FUSION_GAIN_Q_PER_S * dtS;
+    }
+
+    Output out;
+
+    // ---- Correct: d = acs - est = offset + gain * est ----
+    if (haveAcs && haveEst) {
+        const float e   = estA;
+        const float ph0 = _pBB + e * _pBG;
+        const float ph1 = _pBG + e * _pGG;
+        const float s   = ph0 + e * ph1 +
+                          CURRENT_FUSION_ACS_VAR_A2 + CURRENT_FUSION_EST_VAR_A2;
+        const float y   = (acsA - e) - (_offsetA + _gainErr * e);
+
+        // Gate out switching edges where the averaged ACS lags the estimate.
+        const float gate = CURRENT_FUSION_GATE_SIGMA;
+        if (s > 0.0f && (y * y) <= (gate * gate * s)) {
+            const float k0 = ph0 / s;
+            const float k1 = ph1 / s;
+            _offsetA += k0 * y;
+            _gainErr += k1 * y;
+            _pBB -= k0 * ph0;
+            _pBG -= k0 * ph1;
+            _pGG -= k1 * ph1;
+            out.updated = true;
+        }
+
+        _offsetA = clampf(_offsetA, -kOffsetLimitA, kOffsetLimitA);
+        _gainErr = clampf(_gainErr, -kGainLimit, kGainLimit);
+        if (_pBB < 1e-6f) _pBB = 1e-6f;
+        if (_pGG < 1e-8f) _pGG = 1e-8f;
+    }
+
+    // ---- Fuse corrected readings (inverse-variance weighting) ----
+    float ia = NAN, va = NAN;
+    float ie = NAN, ve = NAN;
+    if (haveAcs) {
+        ia = acsA - _offsetA;
+        va = CURRENT_FUSION_ACS_VAR_A2 + _pBB;
+    }
+    if (haveEst) {
+        const float g1 = 1.0f + _gainErr;
+        ie = estA * g1;
+        ve = CURRENT_FUSION_EST_VAR_A2 * g1 * g1 + estA * estA * _pGG;
+    }
+
+    float var = NAN;
+    if (haveAcs && haveEst) {
+        const float w = ve / (va + ve);
+        out.currentA = w * ia + (1.0f - w) * ie;
+        var = (va * ve) / (va + ve);
+    } else if (haveAcs) {
+        out.currentA = ia;
+        var = va;
+    } else if (haveEst) {
+        out.currentA = ie;
+        var = ve;
+    }
+
+    if (isfinite(var) && var >= 0.0f) {
+        out.sigmaA = sqrtf(var);
+        out.confidence = 1.0f / (1.0f + out.sigmaA / CURRENT_FUSION_CONF_SCALE_A);
+    }
+    out.offsetA = _offsetA;
+    out.gainErr = _gainErr;
+
+    _out = out;
+    return out;
+}
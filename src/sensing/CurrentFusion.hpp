@@ -0,0 +1,74 @@
+/**************************************************************
+ * CurrentFusion.h
+ *
+ * Two-state Kalman filter that fuses the ACS781 reading with the
+ * voltage-derived current estimate (HeaterManager).
+ *
+ * Measurement model:
+ *   acsA = I + offsetA                 (ACS zero drift)
+ *   estA = I / (1 + gainErr)           (wire-resistance / model error)
+ *   => acsA - estA = offsetA + gainErr * estA
+ *
+ * The difference is linear in [offsetA, gainErr], so a 2x2 filter tracks
+ * both. With all outputs off (estA = 0) only the offset is observable;
+ * while heating both states converge. The fused current is the
+ * variance-weighted blend of the two corrected readings.
+ **************************************************************/
+#ifndef CURRENT_FUSION_H
+#define CURRENT_FUSION_H
+
+#include <stdint.h>
+#include <math.h>
+
+// ---------------------- Noise model (A^2, A^2/s) ----------------------------
+#ifndef CURRENT_FUSION_ACS_VAR_A2
+#define CURRENT_FUSION_ACS_VAR_A2          0.04f   // ACS781 (~0.2 A rms after MA)
+#endif
+#ifndef CURRENT_FUSION_EST_VAR_A2
+#define CURRENT_FUSION_EST_VAR_A2          0.09f   // Vbus/R estimate (~0.3 A rms)
+#endif
+#ifndef CURRENT_FUSION_OFFSET_Q_A2_PER_S
+#define CURRENT_FUSION_OFFSET_Q_A2_PER_S   1e-4f   // ACS zero drift random walk
+#endif
+#ifndef CURRENT_FUSION_GAIN_Q_PER_S
+#define CURRENT_FUSION_GAIN_Q_PER_S        1e-5f   // Resistance error random walk
+#endif
+#ifndef CURRENT_FUSION_GATE_SIGMA
+#define CURRENT_FUSION_GATE_SIGMA          4.0f    // Skip state update on edges
+#endif
+#ifndef CURRENT_FUSION_CONF_SCALE_A
+#define CURRENT_FUSION_CONF_SCALE_A        0.5f    // sigma giving confidence 0.5
+#endif
+
+class CurrentFusion {
+public:
+    struct Output {
+        float    currentA   = NAN;  ///< best-estimate bus current
+        float    sigmaA     = NAN;  ///< 1-sigma uncertainty of currentA
+        float    confidence = 0.0f; ///< 0..1, derived from sigmaA
+        float    offsetA    = 0.0f; ///< tracked ACS zero offset
+        float    gainErr    = 0.0f; ///< tracked estimate gain error
+        bool     updated    = false;///< states were corrected this step
+    };
+
+    CurrentFusion() { reset(); }
+
+    // Forget learned offset/gain (e.g. after ACS recalibration or R change).
+    void reset();
+
+    // One filter step. Either input may be NaN (missing). dtS is the time
+    // since the previous step; non-positive values skip the predict stage.
+    Output update(float acsA, float estA, float dtS);
+
+    const Output& last() const { return _out; }
+
+private:
+    float _offsetA;
+    float _gainErr;
+    float _pBB;   // var(offset)
+    float _pBG;   // cov(offset, gain)
+    float _pGG;   // var(gain)
+    Output _out;
+};
+
+#endif // CURRENT_FUSION_H
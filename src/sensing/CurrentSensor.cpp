@@ -1,4 +1,5 @@
 ﻿#include <CurrentSensor.hpp>
+#include <SampleRateGovernor.hpp>
 #include <Arduino.h>
 #include <math.h>
 
@@ -167,6 +168,13 @@ float CurrentSensor::readCurrent() {
     return current;
 }
 
+float CurrentSensor::readCurrentRaw() {
+    if (!_zeroCalibrated) {
+        return NAN;
+    }
+    return sampleOnceRaw();
+}
+
 // ============================================================================
 // Continuous Sampling: startContinuous()
 // ============================================================================
@@ -249,9 +257,20 @@ void CurrentSensor::_samplingTaskThunk(void* arg) {
 
 void CurrentSensor::_samplingTaskLoop() {
     TickType_t lastWake = xTaskGetTickCount();
+    SAMPLE_GOV->attachTask(xTaskGetCurrentTaskHandle());
 
     for (;;) {
-        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(_samplePeriodMs));
+        if (SAMPLE_GOV->isFast()) {
+            // Fixed cadence while outputs are on.
+            vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(_samplePeriodMs));
+        } else {
+            // Idle: long sleep, woken early by a mask edge.
+            const uint32_t idleMs = (SAMPLE_GOV_CURRENT_IDLE_PERIOD_MS > _samplePeriodMs)
+                                  ? SAMPLE_GOV_CURRENT_IDLE_PERIOD_MS
+                                  : _samplePeriodMs;
+            SAMPLE_GOV->waitNext(_samplePeriodMs, idleMs);
+            lastWake = xTaskGetTickCount();
+        }
 
         if (!lock()) {
             continue;
@@ -284,6 +303,8 @@ void CurrentSensor::_samplingTaskLoop() {
         unlock();
     }
 
+    SAMPLE_GOV->detachTask(xTaskGetCurrentTaskHandle());
+
     if (lock()) {
         _samplingTaskHandle = nullptr;
         unlock();
@@ -550,6 +571,11 @@ void CurrentSensor::configureOverCurrent(float limitA, uint32_t minDurationMs)
     }
 
     unlock();
+
+    const OverCurrentTrip::Config tc = OverCurrentTrip::fromLimit(limitA, minDurationMs);
+    portENTER_CRITICAL(&_tripMux);
+    _trip.configure(tc);
+    portEXIT_CRITICAL(&_tripMux);
 }
 
 bool CurrentSensor::isOverCurrentLatched() const
@@ -568,6 +594,122 @@ void CurrentSensor::clearOverCurrentLatch()
     _ocLatched     = false;
     _ocOverStartMs = 0;
     unlock();
+
+    portENTER_CRITICAL(&_tripMux);
+    _trip.reset();
+    portEXIT_CRITICAL(&_tripMux);
+}
+
+// ============================================================================
+// Fast trip path
+// ============================================================================
+
+void CurrentSensor::setTripCallback(TripCallback cb, void* ctx)
+{
+    portENTER_CRITICAL(&_tripMux);
+    _tripCb  = cb;
+    _tripCtx = ctx;
+    portEXIT_CRITICAL(&_tripMux);
+}
+
+bool CurrentSensor::startFastTrip()
+{
+    if (_tripTaskHandle != nullptr) return true;
+
+    BaseType_t ok = xTaskCreate(
+        _tripTaskThunk,
+        "CurrentTrip",
+        CURRENT_TRIP_TASK_STACK,
+        this,
+        CURRENT_TRIP_TASK_PRIORITY,
+        &_tripTaskHandle
+    );
+    if (ok != pdPASS) {
+        _tripTaskHandle = nullptr;
+        DEBUG_PRINTLN("[CurrentSensor] Failed to start fast trip task");
+        return false;
+    }
+    return true;
+}
+
+CurrentSensor::TripStats CurrentSensor::getTripStats() const
+{
+    portENTER_CRITICAL(&_tripMux);
+    const TripStats s = _tripStats;
+    portEXIT_CRITICAL(&_tripMux);
+    return s;
+}
+
+void CurrentSensor::_tripTaskThunk(void* arg)
+{
+    static_cast<CurrentSensor*>(arg)->_tripTaskLoop();
+}
+
+void CurrentSensor::_tripTaskLoop()
+{
+    TickType_t fastTicks = pdMS_TO_TICKS(CURRENT_TRIP_PERIOD_MS);
+    if (fastTicks == 0) fastTicks = 1;
+    SAMPLE_GOV->attachTask(xTaskGetCurrentTaskHandle());
+
+    for (;;) {
+        // Nothing can over-current with every output off, so follow the
+        // governor; a mask edge wakes this task immediately.
+        if (SAMPLE_GOV->isFast()) {
+            vTaskDelay(fastTicks);
+        } else {
+            SAMPLE_GOV->waitNext(CURRENT_TRIP_PERIOD_MS, SAMPLE_GOV_CURRENT_IDLE_PERIOD_MS);
+        }
+
+        if (!_zeroCalibrated) continue;
+
+        const uint32_t tUs = micros();
+        const float    i   = sampleOnceRaw();
+
+        bool tripped = false;
+        uint32_t overStartUs = 0;
+        float    peakA = 0.0f;
+        uint8_t  cause = 0;
+        portENTER_CRITICAL(&_tripMux);
+        tripped = _trip.feed(i, tUs);
+        if (tripped) {
+            overStartUs = _trip.overStartUs();
+            peakA       = _trip.peakSeenA();
+            cause       = static_cast<uint8_t>(_trip.cause());
+        }
+        TripCallback cb  = _tripCb;
+        void*        ctx = _tripCtx;
+        portEXIT_CRITICAL(&_tripMux);
+
+        if (!tripped) continue;
+
+        // Cut first, account afterwards.
+        if (cb) cb(ctx);
+        const uint32_t cutDoneUs = micros();
+
+        const uint32_t detectUs = tUs - overStartUs;
+        const uint32_t cutUs    = cutDoneUs - tUs;
+        portENTER_CRITICAL(&_tripMux);
+        _tripStats.trips++;
+        _tripStats.lastTripMs   = millis();
+        _tripStats.lastDetectUs = detectUs;
+        _tripStats.lastCutUs    = cutUs;
+        if (detectUs > _tripStats.maxDetectUs) _tripStats.maxDetectUs = detectUs;
+        if (cutUs > _tripStats.maxCutUs)       _tripStats.maxCutUs    = cutUs;
+        _tripStats.lastPeakA    = peakA;
+        _tripStats.lastCause    = cause;
+        portEXIT_CRITICAL(&_tripMux);
+
+        if (lock()) {
+            _ocLatched = true;
+            unlock();
+        }
+
+        DEBUG_PRINTF("[CurrentSensor] FAST TRIP (%s) peak=%.2f A detect=%lu us cut=%lu us\n",
+                     (cause == static_cast<uint8_t>(OverCurrentTrip::Cause::Peak)) ? "peak" : "I2t",
+                     peakA,
+                     (unsigned long)detectUs,
+                     (unsigned long)cutUs);
+    }
 }
 
 // ============================================================================
@@ -694,8 +836,11 @@ float CurrentSensor::getRmsCurrent(uint32_t windowMs) const
                          ? (newestTs - windowMs)
                          : 0;
 
-    double    sumSq = 0.0;
-    uint32_t  n     = 0;
+    // Sample rate is governed (fast while heating, slow when idle), so weight
+    // each sample by the time it represents instead of counting samples.
+    double    sumSq   = 0.0;
+    double    sumW    = 0.0;
+    uint32_t  newerTs = newestTs + _samplePeriodMs;
 
     for (uint32_t i = 0; i < maxCount; ++i) {
         const uint32_t sSeq = seqNow - 1 - i;
@@ -706,18 +851,22 @@ float CurrentSensor::getRmsCurrent(uint32_t windowMs) const
             break;
         }
 
+        uint32_t w = newerTs - s.timestampMs;
+        if (w == 0) w = 1;
+        newerTs = s.timestampMs;
+
         const double ia = (double)s.currentA;
-        sumSq += ia * ia;
-        ++n;
+        sumSq += ia * ia * (double)w;
+        sumW  += (double)w;
     }
 
     const_cast<CurrentSensor*>(this)->unlock();
 
-    if (n == 0) {
+    if (sumW <= 0.0) {
         return fabsf(_lastCurrentA);
     }
 
-    const double rms = sqrt(sumSq / (double)n);
+    const double rms = sqrt(sumSq / sumW);
     return (float)rms;
 }
 
@@ -14,6 +14,7 @@
 #include <freertos/task.h>
 #include <freertos/semphr.h>
 #include <Config.hpp>
+#include <OverCurrentTrip.hpp>
 // ============================================================================
 // ACS781 Current Sensor with Capture + Continuous History + Auto Calibration
 // ============================================================================
@@ -40,7 +41,8 @@
 //
 // Notes:
 //  - Continuous mode and capture mode are mutually exclusive.
-//  - Uses a ring buffer for a 10s window.
+//  - Uses a ring buffer for a 10s window (at full rate; the window spans
+//    longer while SampleRateGovernor holds the idle rate).
 // ============================================================================
 
 // ---------------------- Sensor characteristics ------------------------------
@@ -77,6 +79,15 @@
 #define CURRENT_LIMIT                      36.0f   // Default OC limit [A]
 #define CURRENT_TIME                       10      // Default OC duration [ms]
 
+// ---------------------- Fast trip path --------------------------------------
+//
+// Dedicated task on raw (unfiltered) ADC samples, one per RTOS tick while
+// outputs are on. Independent of the history sampler and its mutex.
+//
+#define CURRENT_TRIP_PERIOD_MS             1
+#define CURRENT_TRIP_TASK_STACK            3072
+#define CURRENT_TRIP_TASK_PRIORITY         (configMAX_PRIORITIES - 2)
+
 
 class CurrentSensor {
 public:
@@ -101,6 +112,12 @@ public:
     //
     float readCurrent();
 
+    // One unfiltered ADC sample (calibrated), for pairing with a voltage
+    // read at the same instant. Leaves the moving average and the
+    // last-current / over-current state alone. NAN before the zero
+    // calibration.
+    float readCurrentRaw();
+
     // ---------------------------------------------------------------------
     // Continuous sampling / 10s history (RTOS-friendly)
     // ---------------------------------------------------------------------
@@ -134,6 +151,25 @@ public:
     bool isOverCurrentLatched() const;
     void clearOverCurrentLatch();
 
+    // Fast trip path: raw samples -> OverCurrentTrip (peak + I2t). On trip
+    // the callback runs directly from the trip task (cut outputs there),
+    // then the regular latch is set for the Device fault handler.
+    struct TripStats {
+        uint32_t trips        = 0;
+        uint32_t lastTripMs   = 0;
+        uint32_t lastDetectUs = 0;  ///< first over-limit sample -> trip decision
+        uint32_t maxDetectUs  = 0;
+        uint32_t lastCutUs    = 0;  ///< trip decision -> callback returned
+        uint32_t maxCutUs     = 0;
+        float    lastPeakA    = 0.0f;
+        uint8_t  lastCause    = 0;  ///< OverCurrentTrip::Cause
+    };
+    using TripCallback = void (*)(void* ctx);
+
+    void      setTripCallback(TripCallback cb, void* ctx);
+    bool      startFastTrip();
+    TripStats getTripStats() const;
+
     // ---------------------------------------------------------------------
     // Calibration & RMS helpers
     // ---------------------------------------------------------------------
@@ -203,6 +239,17 @@ private:
     uint32_t _ocOverStartMs;
 
     void _updateOverCurrentStateLocked(float currentA, uint32_t nowMs);
+
+    // Fast trip state (guarded by _tripMux, never by _mutex)
+    OverCurrentTrip      _trip;
+    TripStats            _tripStats;
+    TripCallback         _tripCb   = nullptr;
+    void*                _tripCtx  = nullptr;
+    TaskHandle_t         _tripTaskHandle = nullptr;
+    mutable portMUX_TYPE _tripMux  = portMUX_INITIALIZER_UNLOCKED;
+
+    static void _tripTaskThunk(void* arg);
+    void        _tripTaskLoop();
 };
 
 #endif // CURRENT_SENSOR_H
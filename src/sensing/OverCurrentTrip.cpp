@@ -0,0 +1,96 @@
+#include <OverCurrentTrip.hpp>
+
+// Largest dt credited to one sample; a stalled sampler must not turn one
+// over-limit reading into a full budget.
+static constexpr float kMaxSampleDtS = 0.005f;
+
+OverCurrentTrip::Config OverCurrentTrip::fromLimit(float limitA, uint32_t minDurationMs) {
+    Config c;
+    limitA = fabsf(limitA);
+    if (!(limitA > 0.0f) || minDurationMs == 0) {
+        return c; // disabled
+    }
+    const float ref = OC_TRIP_I2T_REF_FACTOR;
+    c.limitA      = limitA;
+    c.peakA       = limitA * OC_TRIP_PEAK_FACTOR;
+    c.i2tBudget   = (ref * ref - 1.0f) * limitA * limitA * (minDurationMs * 0.001f);
+    c.peakConfirm = OC_TRIP_PEAK_CONFIRM;
+    return c;
+}
+
+void OverCurrentTrip::configure(const Config& cfg) {
+    _cfg = cfg;
+    if (_cfg.peakConfirm == 0) _cfg.peakConfirm = 1;
+    reset();
+}
+
+void OverCurrentTrip::reset() {
+    _acc         = 0.0f;
+    _peakCount   = 0;
+    _haveLast    = false;
+    _lastUs      = 0;
+    _over        = false;
+    _overStartUs = 0;
+    _tripped     = false;
+    _cause       = Cause::None;
+    _tripUs      = 0;
+    _peakSeenA   = 0.0f;
+}
+
+bool OverCurrentTrip::feed(float currentA, uint32_t tUs) {
+    if (_tripped || !isArmed() || !isfinite(currentA)) {
+        return false;
+    }
+
+    const float a = fabsf(currentA);
+
+    float dtS = 0.0f;
+    if (_haveLast) {
+        dtS = (tUs - _lastUs) * 1e-6f;
+        if (dtS > kMaxSampleDtS) dtS = kMaxSampleDtS;
+    }
+    _lastUs   = tUs;
+    _haveLast = true;
+
+    // Event bookkeeping (latency is measured from the first over-limit sample).
+    if (a >= _cfg.limitA) {
+        if (!_over) {
+            _over        = true;
+            _overStartUs = tUs;
+            _peakSeenA   = a;
+        } else if (a > _peakSeenA) {
+            _peakSeenA = a;
+        }
+    } else if (_acc <= 0.0f) {
+        _over = false;
+    }
+
+    // Peak detector.
+    if (_cfg.peakA > 0.0f && a >= _cfg.peakA) {
+        if (_peakCount < 255) _peakCount++;
+        if (_peakCount >= _cfg.peakConfirm) {
+            _tripped = true;
+            _cause   = Cause::Peak;
+            _tripUs  = tUs;
+            return true;
+        }
+    } else {
+        _peakCount = 0;
+    }
+
+    // I2t detector (leaks below the limit). Samples above the peak level
+    // are credited at the peak level: a sustained short is the peak
+    // detector's job, and one glitched reading must not fill the budget.
+    const float lim2 = _cfg.limitA * _cfg.limitA;
+    const float aI2t = (_cfg.peakA > 0.0f && a > _cfg.peakA) ? _cfg.peakA : a;
+    _acc += (aI2t * aI2t - lim2) * dtS;
+    if (_acc < 0.0f) _acc = 0.0f;
+    if (_cfg.i2tBudget > 0.0f && _acc >= _cfg.i2tBudget) {
+        _tripped = true;
+        _cause   = Cause::I2t;
+        _tripUs  = tUs;
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,76 @@
+/**************************************************************
+ * OverCurrentTrip.h
+ *
+ * Raw-sample over-current detector for the fast trip path.
+ *
+ * Two criteria, evaluated on every unfiltered sample:
+ *  - Peak:  |I| >= peakA for peakConfirm consecutive samples
+ *           (rejects single-sample ADC glitches).
+ *  - I2t:   integral of (I^2 - limit^2) dt above the limit; it leaks
+ *           back down below the limit. Trips when the integral reaches
+ *           the budget, so larger faults trip proportionally faster.
+ *           Samples above peakA count as peakA here.
+ *
+ * Latched once tripped until reset().
+ **************************************************************/
+#ifndef OVER_CURRENT_TRIP_H
+#define OVER_CURRENT_TRIP_H
+
+#include <stdint.h>
+#include <math.h>
+
+#ifndef OC_TRIP_PEAK_FACTOR
+#define OC_TRIP_PEAK_FACTOR        1.5f   // peak trip = limit * factor
+#endif
+#ifndef OC_TRIP_PEAK_CONFIRM
+#define OC_TRIP_PEAK_CONFIRM       2      // consecutive raw samples at peak
+#endif
+#ifndef OC_TRIP_I2T_REF_FACTOR
+#define OC_TRIP_I2T_REF_FACTOR     1.2f   // I2t budget: trips at limit*ref after minDuration
+#endif
+
+class OverCurrentTrip {
+public:
+    enum class Cause : uint8_t { None = 0, Peak = 1, I2t = 2 };
+
+    struct Config {
+        float   limitA      = 0.0f;  ///< continuous limit (0 disables)
+        float   peakA       = 0.0f;  ///< instantaneous trip level
+        float   i2tBudget   = 0.0f;  ///< A^2*s above limit^2
+        uint8_t peakConfirm = OC_TRIP_PEAK_CONFIRM;
+    };
+
+    // Derive peak/I2t settings from the legacy "limit for minDuration" rule.
+    static Config fromLimit(float limitA, uint32_t minDurationMs);
+
+    void configure(const Config& cfg);
+    void reset();
+
+    // Feed one raw sample (tUs: monotonic microseconds). Returns true only
+    // on the sample that trips.
+    bool feed(float currentA, uint32_t tUs);
+
+    bool     isTripped()    const { return _tripped; }
+    bool     isArmed()      const { return _cfg.limitA > 0.0f; }
+    Cause    cause()        const { return _cause; }
+    // First over-limit sample of the event that tripped (for latency stats).
+    uint32_t overStartUs()  const { return _overStartUs; }
+    uint32_t tripUs()       const { return _tripUs; }
+    float    peakSeenA()    const { return _peakSeenA; }
+    float    i2tAccum()     const { return _acc; }
+
+private:
+    Config   _cfg{};
+    float    _acc         = 0.0f;
+    uint8_t  _peakCount   = 0;
+    bool     _haveLast    = false;
+    uint32_t _lastUs      = 0;
+    bool     _over        = false;
+    uint32_t _overStartUs = 0;
+    bool     _tripped     = false;
+    Cause    _cause       = Cause::None;
+    uint32_t _tripUs      = 0;
+    float    _peakSeenA   = 0.0f;
+};
+
+#endif // OVER_CURRENT_TRIP_H
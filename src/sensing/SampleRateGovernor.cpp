@@ -0,0 +1,83 @@
+#include <SampleRateGovernor.hpp>
+
+SampleRateGovernor* SampleRateGovernor::Get() {
+    static SampleRateGovernor instance;
+    return &instance;
+}
+
+void SampleRateGovernor::attachTask(TaskHandle_t task) {
+    if (!task) return;
+    portENTER_CRITICAL(&_mux);
+    bool placed = false;
+    for (uint8_t i = 0; i < SAMPLE_GOV_MAX_TASKS && !placed; ++i) {
+        if (_tasks[i] == task) placed = true;
+    }
+    for (uint8_t i = 0; i < SAMPLE_GOV_MAX_TASKS && !placed; ++i) {
+        if (_tasks[i] == nullptr) {
+            _tasks[i] = task;
+            placed = true;
+        }
+    }
+    portEXIT_CRITICAL(&_mux);
+}
+
+void SampleRateGovernor::detachTask(TaskHandle_t task) {
+    if (!task) return;
+    portENTER_CRITICAL(&_mux);
+    for (uint8_t i = 0; i < SAMPLE_GOV_MAX_TASKS; ++i) {
+        if (_tasks[i] == task) _tasks[i] = nullptr;
+    }
+    portEXIT_CRITICAL(&_mux);
+}
+
+void SampleRateGovernor::onOutputMask(uint16_t mask) {
+    portENTER_CRITICAL(&_mux);
+    const bool wasFast = (_mask != 0) || (_holdCount > 0);
+    _mask = mask;
+    const bool nowFast = (_mask != 0) || (_holdCount > 0);
+    portEXIT_CRITICAL(&_mux);
+
+    // Only idle->fast matters for latency; fast->idle settles on the next
+    // (short) period anyway, but waking keeps both edges symmetric.
+    if (wasFast != nowFast) notifyAll();
+}
+
+void SampleRateGovernor::holdFast() {
+    portENTER_CRITICAL(&_mux);
+    const bool wasFast = (_mask != 0) || (_holdCount > 0);
+    if (_holdCount < 255) _holdCount++;
+    portEXIT_CRITICAL(&_mux);
+    if (!wasFast) notifyAll();
+}
+
+void SampleRateGovernor::releaseFast() {
+    portENTER_CRITICAL(&_mux);
+    if (_holdCount > 0) _holdCount--;
+    portEXIT_CRITICAL(&_mux);
+}
+
+bool SampleRateGovernor::isFast() const {
+    portENTER_CRITICAL(&_mux);
+    const bool fast = (_mask != 0) || (_holdCount > 0);
+    portEXIT_CRITICAL(&_mux);
+    return fast;
+}
+
+void SampleRateGovernor::waitNext(uint32_t fastPeriodMs, uint32_t idlePeriodMs) {
+    uint32_t periodMs = isFast() ? fastPeriodMs : idlePeriodMs;
+    if (periodMs == 0) periodMs = 1;
+    TickType_t ticks = pdMS_TO_TICKS(periodMs);
+    if (ticks == 0) ticks = 1;
+    ulTaskNotifyTake(pdTRUE, ticks);
+}
+
+void SampleRateGovernor::notifyAll() {
+    TaskHandle_t tasks[SAMPLE_GOV_MAX_TASKS];
+    portENTER_CRITICAL(&_mux);
+    for (uint8_t i = 0; i < SAMPLE_GOV_MAX_TASKS; ++i) tasks[i] = _tasks[i];
+    portEXIT_CRITICAL(&_mux);
+
+    for (uint8_t i = 0; i < SAMPLE_GOV_MAX_TASKS; ++i) {
+        if (tasks[i]) xTaskNotifyGive(tasks[i]);
+    }
+}
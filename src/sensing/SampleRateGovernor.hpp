@@ -0,0 +1,63 @@
+/**************************************************************
+ * SampleRateGovernor.h
+ *
+ * Shared fast/idle decision for the sampling tasks (BusSampler,
+ * CurrentSensor continuous mode).
+ *
+ * Fast while any output bit is set or a calibration holds it; idle
+ * otherwise. Mask edges notify the attached tasks so a sampler sleeping
+ * on the long idle period wakes within one sample of the edge.
+ *
+ * History consumers must use sample timestamps, not a fixed dt.
+ **************************************************************/
+#ifndef SAMPLE_RATE_GOVERNOR_H
+#define SAMPLE_RATE_GOVERNOR_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#ifndef SAMPLE_GOV_BUS_IDLE_PERIOD_MS
+#define SAMPLE_GOV_BUS_IDLE_PERIOD_MS      50   // BusSampler idle (20 Hz)
+#endif
+#ifndef SAMPLE_GOV_CURRENT_IDLE_PERIOD_MS
+#define SAMPLE_GOV_CURRENT_IDLE_PERIOD_MS  20   // ACS continuous idle (50 Hz)
+#endif
+#ifndef SAMPLE_GOV_MAX_TASKS
+#define SAMPLE_GOV_MAX_TASKS               4
+#endif
+
+class SampleRateGovernor {
+public:
+    static SampleRateGovernor* Get();
+
+    // Register a sampling task to be woken on fast/idle transitions.
+    void attachTask(TaskHandle_t task);
+    void detachTask(TaskHandle_t task);
+
+    // Called by HeaterManager on every effective output-mask change.
+    void onOutputMask(uint16_t mask);
+
+    // Calibration / capture paths hold fast sampling regardless of mask.
+    void holdFast();
+    void releaseFast();
+
+    bool isFast() const;
+
+    // Sleep for the period matching the current mode. Returns early when
+    // an edge notification arrives. Call from an attached task only.
+    void waitNext(uint32_t fastPeriodMs, uint32_t idlePeriodMs);
+
+private:
+    SampleRateGovernor() = default;
+    void notifyAll();
+
+    mutable portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+    uint16_t     _mask      = 0;
+    uint8_t      _holdCount = 0;
+    TaskHandle_t _tasks[SAMPLE_GOV_MAX_TASKS] = {};
+};
+
+#define SAMPLE_GOV SampleRateGovernor::Get()
+
+#endif // SAMPLE_RATE_GOVERNOR_H
@@ -35,18 +35,14 @@ void TempSensor::begin() {
     DEBUG_PRINTF("[TempSensor] %u sensor(s) found\n", sensorCount);
 
     // Initialize cache as invalid
-    if (lock()) {
-        for (uint8_t i = 0; i < sensorCount; ++i) {
-            lastTempsC[i] = NAN;
-            lastValid[i]  = false;
-            badReadStreak[i] = 0;
-        }
-        unlock();
-    }
+    invalidateSnapshot();
 
     // Identify roles and persist/update IDs as needed
     identifyAndPersistSensors();
 
+    // Per-role resolution (heatsink fast, boards full precision)
+    applyResolutions();
+
     // Start periodic background sampling (5s default)
     startTemperatureTask(TEMP_SENSOR_UPDATE_INTERVAL_MS);
 }
@@ -65,23 +61,22 @@ void TempSensor::requestTemperatures() {
 }
 
 float TempSensor::getTemperature(uint8_t index) {
-    if (index >= sensorCount) return NAN;
+    if (index >= sensorCount || index >= MAX_TEMP_SENSORS) return NAN;
 
-    float temp = NAN;
-    bool  valid = false;
+    portENTER_CRITICAL(&_snapMux);
+    const float temp  = _snap.tempC[index];
+    const bool  valid = _snap.valid[index];
+    portEXIT_CRITICAL(&_snapMux);
 
-    if (lock(pdMS_TO_TICKS(10))) {
-        temp  = lastTempsC[index];
-        valid = lastValid[index];
-        unlock();
-    } else {
-        // Best-effort read if briefly contended
-        temp  = lastTempsC[index];
-        valid = lastValid[index];
-    }
     return valid ? temp : NAN;
 }
 
+void TempSensor::getSnapshot(Snapshot& out) const {
+    portENTER_CRITICAL(&_snapMux);
+    out = _snap;
+    portEXIT_CRITICAL(&_snapMux);
+}
+
 uint8_t TempSensor::getSensorCount() {
     if (sensorCount > 0) return sensorCount;
     if (CONF) return (uint8_t)CONF->GetInt(TEMP_SENSOR_COUNT_KEY, 0);
@@ -165,31 +160,198 @@ void TempSensor::discoverSensors() {
     unlock();
 }
 
-// Read all sensors once AFTER a Convert T has completed (task context).
-void TempSensor::updateAllTemperaturesBlocking() {
+// ========================= 1-Wire bus engine ========================
+
+uint32_t TempSensor::conversionTimeMs(uint8_t bits) {
+    switch (bits) {
+        case 9:  return 94;
+        case 10: return 188;
+        case 11: return 375;
+        default: return 750;
+    }
+}
+
+uint8_t TempSensor::resolutionForIndex(uint8_t index) const {
+    if ((int)index == map_.heatsink) return TEMP_SENSOR_HEATSINK_RESOLUTION_BITS;
+    return TEMP_SENSOR_AMBIENT_RESOLUTION_BITS;
+}
+
+// Write per-role resolution into each sensor's scratchpad (RAM only, no
+// EEPROM wear). Sensors revert to EEPROM defaults after a power cycle, so
+// this runs again after every bus restart.
+void TempSensor::applyResolutions() {
     if (!ow || sensorCount == 0) return;
 
     if (!lock()) {
-        DEBUG_PRINTLN("[TempSensor] updateAllTemperaturesBlocking(): lock failed");
+        DEBUG_PRINTLN("[TempSensor] applyResolutions(): lock failed");
         return;
     }
 
-    bool restartNeeded = false;
+    // READ POWER SUPPLY: parasite-powered parts pull the slot low and
+    // cannot report conversion completion, so fall back to fixed waits.
+    ow->reset();
+    ow->write(0xCC); // SKIP ROM
+    ow->write(0xB4); // READ POWER SUPPLY
+    parasitePower = (ow->read_bit() == 0);
+
     for (uint8_t i = 0; i < sensorCount; ++i) {
+        const uint8_t bits = resolutionForIndex(i);
+        uint8_t th = 0x4B;
+        uint8_t tl = 0x46;
+        if (readScratchpadChecked(i, scratchpad)) {
+            th = scratchpad[2];
+            tl = scratchpad[3];
+        }
+        const uint8_t cfg = (uint8_t)(((bits - 9) << 5) | 0x1F);
+
         ow->reset();
         ow->select(sensorAddresses[i]);
+        ow->write(0x4E); // WRITE SCRATCHPAD
+        ow->write(th);
+        ow->write(tl);
+        ow->write(cfg);
+
+        resolutionBits[i] = bits;
+    }
+
+    unlock();
+
+    DEBUG_PRINTF("[TempSensor] Resolution HS=%u bit, ambient=%u bit%s\n",
+                 (unsigned)TEMP_SENSOR_HEATSINK_RESOLUTION_BITS,
+                 (unsigned)TEMP_SENSOR_AMBIENT_RESOLUTION_BITS,
+                 parasitePower ? " (parasite power)" : "");
+}
+
+// Issue CONVERT T for whatever is due. Returns the bitmask of sensor indices
+// converting (0 if nothing is due yet) and the worst-case conversion time.
+uint16_t TempSensor::startConversion(uint32_t nowMs, uint32_t& maxWaitMs) {
+    maxWaitMs = 0;
+    if (!ow || sensorCount == 0) return 0;
+
+    uint32_t intervalMs = TEMP_SENSOR_UPDATE_INTERVAL_MS;
+    if (lock(pdMS_TO_TICKS(10))) {
+        intervalMs = updateIntervalMs;
+        unlock();
+    }
+    if (intervalMs < TEMP_SENSOR_FAST_INTERVAL_MS) intervalMs = TEMP_SENSOR_FAST_INTERVAL_MS;
+
+    const bool fullDue = (lastFullCycleMs == 0) || ((nowMs - lastFullCycleMs) >= intervalMs);
+    const int  hs      = map_.heatsink;
+    const bool fastDue = (hs >= 0 && hs < (int)sensorCount) &&
+                         ((nowMs - lastFastCycleMs) >= TEMP_SENSOR_FAST_INTERVAL_MS);
+
+    if (!fullDue && !fastDue) return 0;
+
+    if (!lock(pdMS_TO_TICKS(50))) {
+        DEBUG_PRINTLN("[TempSensor] startConversion(): lock timeout");
+        return 0;
+    }
+
+    uint16_t targets = 0;
+    ow->reset();
+    if (fullDue) {
+        ow->write(0xCC); // SKIP ROM: all sensors convert in parallel
+        for (uint8_t i = 0; i < sensorCount; ++i) {
+            targets |= (uint16_t)(1u << i);
+            const uint32_t t = conversionTimeMs(resolutionBits[i]);
+            if (t > maxWaitMs) maxWaitMs = t;
+        }
+        lastFullCycleMs = nowMs;
+    } else {
+        ow->select(sensorAddresses[hs]); // MATCH ROM: heatsink only
+        targets = (uint16_t)(1u << hs);
+        maxWaitMs = conversionTimeMs(resolutionBits[hs]);
+    }
+    ow->write(0x44); // CONVERT T
+    lastFastCycleMs = nowMs;
+
+    unlock();
+    return targets;
+}
+
+// Externally powered sensors hold read slots low until conversion finishes.
+bool TempSensor::conversionDone() {
+    if (!ow || parasitePower) return false;
+    if (!lock(pdMS_TO_TICKS(10))) return false;
+    const bool done = (ow->read_bit() != 0);
+    unlock();
+    return done;
+}
+
+// Read one scratchpad, re-reading on CRC mismatch. Caller holds _mutex.
+bool TempSensor::readScratchpadChecked(uint8_t index, uint8_t out[9]) {
+    for (uint8_t attempt = 0; attempt <= TEMP_SENSOR_CRC_RETRIES; ++attempt) {
+        ow->reset();
+        ow->select(sensorAddresses[index]);
         ow->write(0xBE); // READ SCRATCHPAD
-        ow->read_bytes(scratchpad, 9);
+        ow->read_bytes(out, 9);
+
+        // An all-zero pad passes CRC (shorted bus), so also require the
+        // fixed config-register bits (bit7=0, bits4..0=1).
+        const bool cfgOk = ((out[4] & 0x9F) == 0x1F);
+        if (cfgOk && OneWire::crc8(out, 8) == out[8]) {
+            return true;
+        }
+
+        portENTER_CRITICAL(&_snapMux);
+        _snap.crcErrors++;
+        portEXIT_CRITICAL(&_snapMux);
+    }
+    return false;
+}
+
+void TempSensor::publishReading(uint8_t index, float tempC, bool valid, uint32_t nowMs) {
+    // Bad reads keep the last good value (same as the old blocking reader).
+    if (!valid) return;
+    portENTER_CRITICAL(&_snapMux);
+    _snap.tempC[index]     = tempC;
+    _snap.valid[index]     = true;
+    _snap.updatedMs[index] = nowMs;
+    portEXIT_CRITICAL(&_snapMux);
+}
+
+void TempSensor::invalidateSnapshot() {
+    portENTER_CRITICAL(&_snapMux);
+    for (uint8_t i = 0; i < MAX_TEMP_SENSORS; ++i) {
+        _snap.tempC[i]     = NAN;
+        _snap.valid[i]     = false;
+        _snap.updatedMs[i] = 0;
+    }
+    _snap.count = sensorCount;
+    _snap.seq++;
+    portEXIT_CRITICAL(&_snapMux);
+
+    for (uint8_t i = 0; i < MAX_TEMP_SENSORS; ++i) {
+        badReadStreak[i] = 0;
+    }
+}
+
+// Read the sensors in targetMask AFTER their conversion completed (task context).
+void TempSensor::readSensors(uint16_t targetMask) {
+    if (!ow || sensorCount == 0 || targetMask == 0) return;
 
-        // Optional CRC check (disabled to keep it lean)
-        // if (OneWire::crc8(scratchpad, 8) != scratchpad[8]) { lastValid[i] = false; continue; }
+    if (!lock()) {
+        DEBUG_PRINTLN("[TempSensor] readSensors(): lock failed");
+        return;
+    }
 
-        int16_t raw = (int16_t)((scratchpad[1] << 8) | scratchpad[0]);
-        float tempC = (float)raw / 16.0f;
+    bool restartNeeded = false;
+    for (uint8_t i = 0; i < sensorCount; ++i) {
+        if (!(targetMask & (1u << i))) continue;
+
+        bool ok = readScratchpadChecked(i, scratchpad);
+        float tempC = NAN;
+        if (ok) {
+            int16_t raw = (int16_t)((scratchpad[1] << 8) | scratchpad[0]);
+            // Low bits are undefined below 12-bit resolution.
+            const uint8_t bits = resolutionBits[i] ? resolutionBits[i] : 12;
+            raw &= (int16_t)~((1 << (12 - bits)) - 1);
+            tempC = (float)raw / 16.0f;
+            ok = isTempValid(tempC);
+        }
 
-        if (isTempValid(tempC)) {
-            lastTempsC[i] = tempC;
-            lastValid[i]  = true;
+        if (ok) {
+            publishReading(i, tempC, true, millis());
             badReadStreak[i] = 0;
         } else {
             if (badReadStreak[i] < 255) badReadStreak[i]++;
@@ -201,33 +363,73 @@ void TempSensor::updateAllTemperaturesBlocking() {
 
     unlock();
 
+    portENTER_CRITICAL(&_snapMux);
+    _snap.count = sensorCount;
+    _snap.seq++;
+    portEXIT_CRITICAL(&_snapMux);
+
     if (restartNeeded) {
         restartBus();
     }
 }
 
 // ======================= Background RTOS Task =======================
+//
+// Non-blocking bus engine:
+//   Idle       -> issue CONVERT T for what is due (all sensors, or the
+//                 heatsink alone on the fast cadence)
+//   Converting -> poll read slots until the sensors release the bus
+//                 (bounded by the datasheet time for their resolution)
+//   Reading    -> CRC-checked scratchpad reads, publish snapshot
+// ====================================================================
 
 void TempSensor::temperatureTask(void* param) {
     auto* self = static_cast<TempSensor*>(param);
-    const TickType_t convertWaitTicks = pdMS_TO_TICKS(750); // 12-bit
+    const TickType_t pollTicks = pdMS_TO_TICKS(TEMP_SENSOR_CONVERT_POLL_MS);
+
+    BusPhase phase      = BusPhase::Idle;
+    uint16_t targets    = 0;
+    uint32_t convStart  = 0;
+    uint32_t maxWaitMs  = 0;
+
+    self->lastFullCycleMs = 0;
+    self->lastFastCycleMs = 0;
 
     for (;;) {
         if (self->_stopRequested) break;
-        self->requestTemperatures();
-        vTaskDelay(convertWaitTicks);
-        if (self->_stopRequested) break;
-        self->updateAllTemperaturesBlocking();
+        const uint32_t now = millis();
+
+        switch (phase) {
+            case BusPhase::Idle:
+                targets = self->startConversion(now, maxWaitMs);
+                if (targets == 0) {
+                    vTaskDelay(pollTicks);
+                    break;
+                }
+                convStart = now;
+                phase = BusPhase::Converting;
+                vTaskDelay(pollTicks);
+                break;
 
-        uint32_t intervalMs = TEMP_SENSOR_UPDATE_INTERVAL_MS;
-        if (self->lock(pdMS_TO_TICKS(10))) {
-            intervalMs = self->updateIntervalMs;
-            if (intervalMs < 1000) intervalMs = 1000;
-            self->unlock();
+            case BusPhase::Converting: {
+                const uint32_t elapsed = now - convStart;
+                if (self->parasitePower) {
+                    // No completion signalling: wait the full datasheet time.
+                    if (elapsed >= maxWaitMs) phase = BusPhase::Reading;
+                } else if (self->conversionDone() ||
+                           elapsed >= maxWaitMs + TEMP_SENSOR_CONVERT_MARGIN_MS) {
+                    phase = BusPhase::Reading;
+                }
+                if (phase != BusPhase::Reading) vTaskDelay(pollTicks);
+                break;
+            }
+
+            case BusPhase::Reading:
+                self->readSensors(targets);
+                targets = 0;
+                phase = BusPhase::Idle;
+                break;
         }
-        int32_t remainMs = (int32_t)intervalMs - 750;
-        if (remainMs < 100) remainMs = 100;
-        vTaskDelay(pdMS_TO_TICKS((uint32_t)remainMs));
     }
 
     if (self->lock(pdMS_TO_TICKS(50))) {
@@ -437,14 +639,8 @@ void TempSensor::restartBus() {
 
     if (sensorCount > 0) {
         identifyAndPersistSensors();
+        applyResolutions();
     }
 
-    if (lock(pdMS_TO_TICKS(50))) {
-        for (uint8_t i = 0; i < sensorCount; ++i) {
-            lastTempsC[i] = NAN;
-            lastValid[i]  = false;
-            badReadStreak[i] = 0;
-        }
-        unlock();
-    }
+    invalidateSnapshot();
 }
@@ -54,6 +54,36 @@
 #define TEMP_SENSOR_BAD_READ_RESTART_THRESHOLD 2
 #endif
 
+// Per-role conversion resolution (9..12 bits).
+// Heatsink is a safety input: short conversions, refreshed on its own cadence.
+// Board sensors feed the ambient estimate: full 12-bit resolution.
+#ifndef TEMP_SENSOR_HEATSINK_RESOLUTION_BITS
+#define TEMP_SENSOR_HEATSINK_RESOLUTION_BITS 10
+#endif
+
+#ifndef TEMP_SENSOR_AMBIENT_RESOLUTION_BITS
+#define TEMP_SENSOR_AMBIENT_RESOLUTION_BITS 12
+#endif
+
+// Heatsink-only conversion cadence between full-bus cycles.
+#ifndef TEMP_SENSOR_FAST_INTERVAL_MS
+#define TEMP_SENSOR_FAST_INTERVAL_MS 250UL
+#endif
+
+// Conversion-complete polling granularity and extra slack over datasheet time.
+#ifndef TEMP_SENSOR_CONVERT_POLL_MS
+#define TEMP_SENSOR_CONVERT_POLL_MS 10UL
+#endif
+
+#ifndef TEMP_SENSOR_CONVERT_MARGIN_MS
+#define TEMP_SENSOR_CONVERT_MARGIN_MS 50UL
+#endif
+
+// Scratchpad re-reads on CRC mismatch before counting a bad read.
+#ifndef TEMP_SENSOR_CRC_RETRIES
+#define TEMP_SENSOR_CRC_RETRIES 2
+#endif
+
 enum class TempRole : uint8_t { Unknown=0, Board0, Board1, Heatsink };
 
 class TempSensor {
@@ -68,9 +98,25 @@ public:
     void stopTemperatureTask();
     void startTemperatureTask(uint32_t intervalMs = TEMP_SENSOR_UPDATE_INTERVAL_MS);
 
+    /**
+     * @brief Published readings of all sensors.
+     *
+     * Written only by the bus task; readers copy it under a short critical
+     * section and never wait on the OneWire mutex.
+     */
+    struct Snapshot {
+        float    tempC[MAX_TEMP_SENSORS];
+        bool     valid[MAX_TEMP_SENSORS];
+        uint32_t updatedMs[MAX_TEMP_SENSORS];
+        uint8_t  count      = 0;
+        uint32_t seq        = 0;   ///< Incremented on every publish.
+        uint32_t crcErrors  = 0;   ///< Scratchpad reads rejected by CRC.
+    };
+
     // Cached read (C), NON-BLOCKING
     float   getTemperature(uint8_t index);
     uint8_t getSensorCount();
+    void    getSnapshot(Snapshot& out) const;
 
     // Roles & labels
     float  getHeatsinkTemp();
@@ -91,13 +137,22 @@ public:
     static void temperatureTask(void* param);
 
 private:
+    // Bus engine phases (driven by temperatureTask).
+    enum class BusPhase : uint8_t { Idle, Converting, Reading };
+
     OneWire* ow = nullptr;
 
-    // Cached readings
-    float lastTempsC[MAX_TEMP_SENSORS] = {0};
-    bool  lastValid[MAX_TEMP_SENSORS]  = {false};
+    // Published readings (guarded by _snapMux, not _mutex)
+    Snapshot _snap{};
+    mutable portMUX_TYPE _snapMux = portMUX_INITIALIZER_UNLOCKED;
     uint8_t badReadStreak[MAX_TEMP_SENSORS] = {0};
 
+    // Bus engine state (task context only)
+    uint8_t  resolutionBits[MAX_TEMP_SENSORS] = {0};
+    bool     parasitePower  = false;
+    uint32_t lastFullCycleMs = 0;
+    uint32_t lastFastCycleMs = 0;
+
     float lastBoard0C = NAN;
     float lastBoard1C = NAN;
     float lastHeatsinkC = NAN;
@@ -129,9 +184,19 @@ private:
     int           findIndexByAddr(const uint8_t addr[8]) const;
 
     void discoverSensors();
-    void updateAllTemperaturesBlocking();
     void restartBus();
     bool isTempValid(float tempC) const;
+
+    // Bus engine helpers
+    uint8_t  resolutionForIndex(uint8_t index) const;
+    void     applyResolutions();
+    uint16_t startConversion(uint32_t nowMs, uint32_t& maxWaitMs);
+    bool     conversionDone();
+    bool     readScratchpadChecked(uint8_t index, uint8_t out[9]);
+    void     readSensors(uint16_t targetMask);
+    void     publishReading(uint8_t index, float tempC, bool valid, uint32_t nowMs);
+    void     invalidateSnapshot();
+    static uint32_t conversionTimeMs(uint8_t bits);
 };
 
 #endif
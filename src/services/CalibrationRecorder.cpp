@@ -1,5 +1,6 @@
 #include <CalibrationRecorder.hpp>
 #include <BusSampler.hpp>
+#include <SampleRateGovernor.hpp>
 #include <NtcSensor.hpp>
 #include <Device.hpp>
 #include <HeaterManager.hpp>
@@ -85,6 +86,7 @@ bool CalibrationRecorder::start(Mode mode,
 
     _capacity    = maxSamples;
     _count       = 0;
+    ++_runId;
     _mode        = mode;
     _running     = true;
     _saveOnStop  = false;
@@ -169,6 +171,7 @@ void CalibrationRecorder::clear() {
         return;
     }
     freeBufferLocked();
+    ++_runId;
     _mode = Mode::None;
     _targetTempC = NAN;
     _wireIndex = 0;
@@ -215,6 +218,7 @@ CalibrationRecorder::Meta CalibrationRecorder::getMeta() const {
         m.saved       = _lastSaveOk;
         m.savedMs     = _lastSaveMs;
         m.savedEpoch  = _lastSaveEpoch;
+        m.runId       = _runId;
         const_cast<CalibrationRecorder*>(this)->unlock();
     }
     return m;
@@ -239,6 +243,40 @@ size_t CalibrationRecorder::copySamples(uint16_t offset, Sample* out, size_t max
     return n;
 }
 
+size_t CalibrationRecorder::copySamples(uint32_t runId, uint16_t offset,
+                                        Sample* out, size_t maxOut) const {
+    if (!out || maxOut == 0) return 0;
+    if (!const_cast<CalibrationRecorder*>(this)->lock()) return 0;
+
+    size_t n = 0;
+    if (runId == _runId && offset < _count && _buf != nullptr) {
+        const uint16_t available = _count - offset;
+        n = (available < maxOut) ? available : maxOut;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = _buf[offset + i];
+        }
+    }
+
+    const_cast<CalibrationRecorder*>(this)->unlock();
+    return n;
+}
+
+uint16_t CalibrationRecorder::findSample(uint32_t tMs) const {
+    if (!const_cast<CalibrationRecorder*>(this)->lock()) return 0;
+
+    // tMs grows with the index (time since start), so bisect.
+    uint16_t lo = 0;
+    uint16_t hi = (_buf != nullptr) ? _count : 0;
+    while (lo < hi) {
+        const uint16_t mid = lo + (hi - lo) / 2;
+        if (_buf[mid].tMs < tMs) lo = mid + 1;
+        else hi = mid;
+    }
+
+    const_cast<CalibrationRecorder*>(this)->unlock();
+    return lo;
+}
+
 bool CalibrationRecorder::saveToFile(const char* path) {
     if (!path || !path[0]) return false;
     if (!SPIFFS.begin(false)) return false;
@@ -269,72 +307,78 @@ bool CalibrationRecorder::saveToFile(const char* path) {
     if (_wireIndex > 0) metaCount++;
     if (_lastSaveEpoch > 0) metaCount++;
 
+    uint8_t block[CBOR_STREAM_BLOCK];
+    CborStream::BufferedPrint out(f, block, sizeof(block));
+
     bool ok = true;
-    ok = ok && CborStream::writeMapHeader(f, 2);
-    ok = ok && CborStream::writeText(f, "meta");
-    ok = ok && CborStream::writeMapHeader(f, metaCount);
-    ok = ok && CborStream::writeText(f, "mode");
-    ok = ok && CborStream::writeText(f, modeStr);
-    ok = ok && CborStream::writeText(f, "running");
-    ok = ok && CborStream::writeBool(f, _running);
-    ok = ok && CborStream::writeText(f, "count");
-    ok = ok && CborStream::writeUInt(f, _count);
-    ok = ok && CborStream::writeText(f, "capacity");
-    ok = ok && CborStream::writeUInt(f, _capacity);
-    ok = ok && CborStream::writeText(f, "interval_ms");
-    ok = ok && CborStream::writeUInt(f, _intervalMs);
-    ok = ok && CborStream::writeText(f, "start_ms");
-    ok = ok && CborStream::writeUInt(f, _startMs);
+    ok = ok && CborStream::writeMapHeader(out, 2);
+    ok = ok && CborStream::writeText(out, "meta");
+    ok = ok && CborStream::writeMapHeader(out, metaCount);
+    ok = ok && CborStream::writeText(out, "mode");
+    ok = ok && CborStream::writeText(out, modeStr);
+    ok = ok && CborStream::writeText(out, "running");
+    ok = ok && CborStream::writeBool(out, _running);
+    ok = ok && CborStream::writeText(out, "count");
+    ok = ok && CborStream::writeUInt(out, _count);
+    ok = ok && CborStream::writeText(out, "capacity");
+    ok = ok && CborStream::writeUInt(out, _capacity);
+    ok = ok && CborStream::writeText(out, "interval_ms");
+    ok = ok && CborStream::writeUInt(out, _intervalMs);
+    ok = ok && CborStream::writeText(out, "start_ms");
+    ok = ok && CborStream::writeUInt(out, _startMs);
     if (_startEpoch > 0) {
-        ok = ok && CborStream::writeText(f, "start_epoch");
-        ok = ok && CborStream::writeUInt(f, _startEpoch);
+        ok = ok && CborStream::writeText(out, "start_epoch");
+        ok = ok && CborStream::writeUInt(out, _startEpoch);
     }
     if (isfinite(_targetTempC)) {
-        ok = ok && CborStream::writeText(f, "target_c");
-        ok = ok && CborStream::writeDouble(f, _targetTempC);
+        ok = ok && CborStream::writeText(out, "target_c");
+        ok = ok && CborStream::writeNumber(out, _targetTempC);
     }
     if (_wireIndex > 0) {
-        ok = ok && CborStream::writeText(f, "wire_index");
-        ok = ok && CborStream::writeUInt(f, _wireIndex);
+        ok = ok && CborStream::writeText(out, "wire_index");
+        ok = ok && CborStream::writeUInt(out, _wireIndex);
     }
-    ok = ok && CborStream::writeText(f, "saved");
-    ok = ok && CborStream::writeBool(f, saveOk);
-    ok = ok && CborStream::writeText(f, "saved_ms");
-    ok = ok && CborStream::writeUInt(f, _lastSaveMs);
+    ok = ok && CborStream::writeText(out, "saved");
+    ok = ok && CborStream::writeBool(out, saveOk);
+    ok = ok && CborStream::writeText(out, "saved_ms");
+    ok = ok && CborStream::writeUInt(out, _lastSaveMs);
     if (_lastSaveEpoch > 0) {
-        ok = ok && CborStream::writeText(f, "saved_epoch");
-        ok = ok && CborStream::writeUInt(f, _lastSaveEpoch);
+        ok = ok && CborStream::writeText(out, "saved_epoch");
+        ok = ok && CborStream::writeUInt(out, _lastSaveEpoch);
     }
 
-    ok = ok && CborStream::writeText(f, "samples");
-    ok = ok && CborStream::writeArrayHeader(f, _count);
+    ok = ok && CborStream::writeText(out, "samples");
+    ok = ok && CborStream::writeArrayHeader(out, _count);
 
     for (uint16_t i = 0; i < _count && ok; ++i) {
         const Sample& s = _buf[i];
-        ok = ok && CborStream::writeMapHeader(f, 10);
-        ok = ok && CborStream::writeText(f, "t_ms");
-        ok = ok && CborStream::writeUInt(f, s.tMs);
-        ok = ok && CborStream::writeText(f, "v");
-        ok = ok && CborStream::writeFloatOrNull(f, s.voltageV);
-        ok = ok && CborStream::writeText(f, "i");
-        ok = ok && CborStream::writeFloatOrNull(f, s.currentA);
-        ok = ok && CborStream::writeText(f, "temp_c");
-        ok = ok && CborStream::writeFloatOrNull(f, s.tempC);
-        ok = ok && CborStream::writeText(f, "room_c");
-        ok = ok && CborStream::writeFloatOrNull(f, s.roomTempC);
-        ok = ok && CborStream::writeText(f, "ntc_v");
-        ok = ok && CborStream::writeFloatOrNull(f, s.ntcVolts);
-        ok = ok && CborStream::writeText(f, "ntc_ohm");
-        ok = ok && CborStream::writeFloatOrNull(f, s.ntcOhm);
-        ok = ok && CborStream::writeText(f, "ntc_adc");
-        ok = ok && CborStream::writeUInt(f, s.ntcAdc);
-        ok = ok && CborStream::writeText(f, "ntc_ok");
-        ok = ok && CborStream::writeBool(f, s.ntcValid);
-        ok = ok && CborStream::writeText(f, "pressed");
-        ok = ok && CborStream::writeBool(f, s.pressed);
-    }
+        ok = ok && CborStream::writeMapHeader(out, 10);
+        ok = ok && CborStream::writeText(out, "t_ms");
+        ok = ok && CborStream::writeUInt(out, s.tMs);
+        ok = ok && CborStream::writeText(out, "v");
+        ok = ok && CborStream::writeFloatOrNull(out, s.voltageV, CborNumber::kVoltage);
+        ok = ok && CborStream::writeText(out, "i");
+        ok = ok && CborStream::writeFloatOrNull(out, s.currentA, CborNumber::kCurrent);
+        ok = ok && CborStream::writeText(out, "temp_c");
+        ok = ok && CborStream::writeFloatOrNull(out, s.tempC, CborNumber::kTemperature);
+        ok = ok && CborStream::writeText(out, "room_c");
+        ok = ok && CborStream::writeFloatOrNull(out, s.roomTempC, CborNumber::kTemperature);
+        ok = ok && CborStream::writeText(out, "ntc_v");
+        ok = ok && CborStream::writeFloatOrNull(out, s.ntcVolts, CborNumber::kSenseVoltage);
+        ok = ok && CborStream::writeText(out, "ntc_ohm");
+        ok = ok && CborStream::writeFloatOrNull(out, s.ntcOhm, CborNumber::kResistance);
+        ok = ok && CborStream::writeText(out, "ntc_adc");
+        ok = ok && CborStream::writeUInt(out, s.ntcAdc);
+        ok = ok && CborStream::writeText(out, "ntc_ok");
+        ok = ok && CborStream::writeBool(out, s.ntcValid);
+        ok = ok && CborStream::writeText(out, "pressed");
+        ok = ok && CborStream::writeBool(out, s.pressed);
+    }
+
+    ok = out.finish() && ok;
 
     f.close();
+    markFilesChanged();
     if (!ok) {
         SPIFFS.remove(path);
         unlock();
@@ -356,6 +400,10 @@ void CalibrationRecorder::taskThunk(void* param) {
 void CalibrationRecorder::taskLoop() {
     TickType_t lastWake = xTaskGetTickCount();
 
+    // Keep bus/current sampling at full rate while recording, even if the
+    // outputs are off between pulses.
+    SAMPLE_GOV->holdFast();
+
     for (;;) {
         bool running = false;
         bool saveOnStop = false;
@@ -419,6 +467,8 @@ void CalibrationRecorder::taskLoop() {
         vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(_intervalMs));
     }
 
+    SAMPLE_GOV->releaseFast();
+
     if (lock()) {
         _taskHandle = nullptr;
         unlock();
@@ -470,6 +520,16 @@ bool CalibrationRecorder::saveToHistoryFiles() {
     return okAll;
 }
 
+void CalibrationRecorder::markFilesChanged() {
+    ++_filesGen;
+    uint32_t epoch = 0;
+    if (RTC) {
+        epoch = static_cast<uint32_t>(RTC->getUnixTime());
+    }
+    // Before 2020 the RTC has not been set; no Last-Modified then.
+    _filesModifiedEpoch = (epoch >= 1577836800UL) ? epoch : 0;
+}
+
 void CalibrationRecorder::freeBufferLocked() {
     if (_buf) {
 #ifdef ESP32
@@ -46,6 +46,7 @@ public:
         bool     saved       = false;
         uint32_t savedMs     = 0;
         uint32_t savedEpoch  = 0;
+        uint32_t runId       = 0;   // changes on start() / clear()
     };
 
     static void Init();
@@ -65,6 +66,16 @@ public:
     uint16_t getSampleCount() const;
     Meta getMeta() const;
     size_t copySamples(uint16_t offset, Sample* out, size_t maxOut) const;
+    // Same, but copies nothing once the run runId is no longer loaded.
+    size_t copySamples(uint32_t runId, uint16_t offset, Sample* out, size_t maxOut) const;
+    // Index of the first sample with tMs >= tMs (count if none).
+    uint16_t findSample(uint32_t tMs) const;
+
+    // Bumped whenever a calibration file is written or removed (ETag
+    // source for the file and list routes); epoch 0 = RTC unset.
+    uint32_t getFilesGeneration() const { return _filesGen; }
+    uint32_t getFilesModifiedEpoch() const { return _filesModifiedEpoch; }
+    void markFilesChanged();
 
     static constexpr uint32_t kDefaultIntervalMs = 500;
     static constexpr uint16_t kDefaultMaxSamples = 1200;
@@ -105,6 +116,9 @@ private:
     bool     _lastSaveOk  = false;
     uint32_t _lastSaveMs  = 0;
     uint32_t _lastSaveEpoch = 0;
+    uint32_t _runId         = 0;
+    uint32_t _filesGen      = 0;
+    uint32_t _filesModifiedEpoch = 0;
 
     static CalibrationRecorder* s_instance;
 };
@@ -289,6 +289,10 @@ void NVS::initializeVariables() {
   PutInt(CURRENT_SOURCE_KEY, DEFAULT_CURRENT_SOURCE);
   PutFloat(CP_EMP_GAIN_KEY, DEFAULT_CAP_EMP_GAIN);
   PutFloat(CAP_BANK_CAP_F_KEY, DEFAULT_CAP_BANK_CAP_F);
+  PutFloat(BUS_FLOOR_V_KEY, DEFAULT_BUS_FLOOR_V);
+  PutInt(INTERLEAVE_SUB_KEY, DEFAULT_INTERLEAVE_SUB);
+  PutInt(SOFTSTART_MS_KEY, DEFAULT_SOFTSTART_MS);
+  PutFloat(SOFTSTART_PEAK_KEY, DEFAULT_SOFTSTART_PEAK_A);
   PutFloat(CURR_LIMIT_KEY, DEFAULT_CURR_LIMIT_A);
 
   // Output access (admin-controlled)
@@ -375,6 +379,16 @@ void NVS::initializeVariables() {
   PutFloat(R08OHM_KEY, DEFAULT_WIRE_RES_OHMS);
   PutFloat(R09OHM_KEY, DEFAULT_WIRE_RES_OHMS);
   PutFloat(R10OHM_KEY, DEFAULT_WIRE_RES_OHMS);
+  PutFloat(R01TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  PutFloat(R02TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  PutFloat(R03TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  PutFloat(R04TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  PutFloat(R05TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  PutFloat(R06TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  PutFloat(R07TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  PutFloat(R08TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  PutFloat(R09TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  PutFloat(R10TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
 
   // --- Wire ohm/m ---
   PutFloat(WIRE_OHM_PER_M_KEY, DEFAULT_WIRE_OHM_PER_M);
@@ -453,6 +467,10 @@ void NVS::ensureMissingDefaults() {
   ensureInt(CURRENT_SOURCE_KEY, DEFAULT_CURRENT_SOURCE);
   ensureFloat(CP_EMP_GAIN_KEY, DEFAULT_CAP_EMP_GAIN);
   ensureFloat(CAP_BANK_CAP_F_KEY, DEFAULT_CAP_BANK_CAP_F);
+  ensureFloat(BUS_FLOOR_V_KEY, DEFAULT_BUS_FLOOR_V);
+  ensureInt(INTERLEAVE_SUB_KEY, DEFAULT_INTERLEAVE_SUB);
+  ensureInt(SOFTSTART_MS_KEY, DEFAULT_SOFTSTART_MS);
+  ensureFloat(SOFTSTART_PEAK_KEY, DEFAULT_SOFTSTART_PEAK_A);
   ensureFloat(CURR_LIMIT_KEY, DEFAULT_CURR_LIMIT_A);
 
   ensureBool(OUT01_ACCESS_KEY, DEFAULT_OUT01_ACCESS);
@@ -534,6 +552,16 @@ void NVS::ensureMissingDefaults() {
   ensureFloat(R08OHM_KEY, DEFAULT_WIRE_RES_OHMS);
   ensureFloat(R09OHM_KEY, DEFAULT_WIRE_RES_OHMS);
   ensureFloat(R10OHM_KEY, DEFAULT_WIRE_RES_OHMS);
+  ensureFloat(R01TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  ensureFloat(R02TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  ensureFloat(R03TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  ensureFloat(R04TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  ensureFloat(R05TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  ensureFloat(R06TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  ensureFloat(R07TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  ensureFloat(R08TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  ensureFloat(R09TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
+  ensureFloat(R10TRD_KEY, DEFAULT_WIRE_TREND_OHMS);
 
   ensureFloat(WIRE_OHM_PER_M_KEY, DEFAULT_WIRE_OHM_PER_M);
   ensureInt(WIRE_GAUGE_KEY, DEFAULT_WIRE_GAUGE);
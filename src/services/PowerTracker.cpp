@@ -7,6 +7,7 @@
 #include <CborStream.hpp>
 #include <vector>
 #include <BusSampler.hpp>
+#include <RTCManager.hpp>
 
 namespace {
 constexpr size_t kHistoryCborKeyMax = 32;
@@ -29,6 +30,12 @@ bool readCborDouble_(CborValue* it, double& value) {
         value = tmp;
         return cbor_value_advance(it) == CborNoError;
     }
+    if (cbor_value_is_half_float(it)) {
+        uint16_t half = 0;
+        if (cbor_value_get_half_float(it, &half) != CborNoError) return false;
+        value = CborNumber::halfToFloat(half);
+        return cbor_value_advance(it) == CborNoError;
+    }
     if (cbor_value_is_integer(it)) {
         int64_t iv = 0;
         if (cbor_value_get_int64(it, &iv) != CborNoError) return false;
@@ -95,11 +102,23 @@ void PowerTracker::appendHistoryEntry(const HistoryEntry& e) {
     _history[_historyHead].valid = true;
 
     _historyHead = (_historyHead + 1) % POWERTRACKER_HISTORY_MAX;
+    ++_historyEndSeq;
 
     if (_historyCount < POWERTRACKER_HISTORY_MAX) {
         _historyCount++;
     }
     // If full, ring overwrite: oldest entry is implicitly dropped.
+    markHistoryChanged();
+}
+
+void PowerTracker::markHistoryChanged() {
+    ++_historyGen;
+    uint32_t epoch = 0;
+    if (RTC) {
+        epoch = static_cast<uint32_t>(RTC->getUnixTime());
+    }
+    // Before 2020 the RTC has not been set; no Last-Modified then.
+    _historyModifiedEpoch = (epoch >= 1577836800UL) ? epoch : 0;
 }
 
 bool PowerTracker::saveHistoryToFile() const {
@@ -126,32 +145,37 @@ bool PowerTracker::saveHistoryToFile() const {
         }
     }
 
+    uint8_t block[CBOR_STREAM_BLOCK];
+    CborStream::BufferedPrint out(f, block, sizeof(block));
+
     bool ok = true;
-    ok = ok && CborStream::writeMapHeader(f, 1);
-    ok = ok && CborStream::writeText(f, "history");
-    ok = ok && CborStream::writeArrayHeader(f, validCount);
+    ok = ok && CborStream::writeMapHeader(out, 1);
+    ok = ok && CborStream::writeText(out, "history");
+    ok = ok && CborStream::writeArrayHeader(out, validCount);
 
     if (count > 0) {
         uint16_t idx = (_historyHead + POWERTRACKER_HISTORY_MAX - count) % POWERTRACKER_HISTORY_MAX;
         for (uint16_t i = 0; i < count && ok; ++i) {
             const HistoryEntry& h = _history[idx];
             if (h.valid) {
-                ok = ok && CborStream::writeMapHeader(f, 5);
-                ok = ok && CborStream::writeText(f, "start_ms");
-                ok = ok && CborStream::writeUInt(f, h.startMs);
-                ok = ok && CborStream::writeText(f, "duration_s");
-                ok = ok && CborStream::writeUInt(f, h.stats.duration_s);
-                ok = ok && CborStream::writeText(f, "energy_Wh");
-                ok = ok && CborStream::writeFloatOrNull(f, h.stats.energy_Wh);
-                ok = ok && CborStream::writeText(f, "peakPower_W");
-                ok = ok && CborStream::writeFloatOrNull(f, h.stats.peakPower_W);
-                ok = ok && CborStream::writeText(f, "peakCurrent_A");
-                ok = ok && CborStream::writeFloatOrNull(f, h.stats.peakCurrent_A);
+                ok = ok && CborStream::writeMapHeader(out, 5);
+                ok = ok && CborStream::writeText(out, "start_ms");
+                ok = ok && CborStream::writeUInt(out, h.startMs);
+                ok = ok && CborStream::writeText(out, "duration_s");
+                ok = ok && CborStream::writeUInt(out, h.stats.duration_s);
+                ok = ok && CborStream::writeText(out, "energy_Wh");
+                ok = ok && CborStream::writeFloatOrNull(out, h.stats.energy_Wh, CborNumber::kEnergy);
+                ok = ok && CborStream::writeText(out, "peakPower_W");
+                ok = ok && CborStream::writeFloatOrNull(out, h.stats.peakPower_W, CborNumber::kPower);
+                ok = ok && CborStream::writeText(out, "peakCurrent_A");
+                ok = ok && CborStream::writeFloatOrNull(out, h.stats.peakCurrent_A, CborNumber::kCurrent);
             }
             idx = (idx + 1) % POWERTRACKER_HISTORY_MAX;
         }
     }
 
+    ok = out.finish() && ok;
+
     f.close();
     if (!ok) {
         DEBUG_PRINTLN("[PowerTracker] Failed to serialize history CBOR.");
@@ -172,6 +196,8 @@ bool PowerTracker::saveHistoryToFile() const {
 void PowerTracker::loadHistoryFromFile() {
     _historyHead = 0;
     _historyCount = 0;
+    _historyEndSeq = 0;
+    ++_historyDataset;
 
     if (!SPIFFS.begin(false)) {
         DEBUG_PRINTLN("[PowerTracker] SPIFFS not mounted; no history loaded.");
@@ -364,12 +390,30 @@ bool PowerTracker::getHistoryEntry(uint16_t indexFromNewest, HistoryEntry& out)
     return true;
 }
 
+bool PowerTracker::getHistoryEntryBySeq(uint32_t seq, HistoryEntry& out) const {
+    const uint32_t end = _historyEndSeq;
+    const uint16_t count = _historyCount;
+    if (seq >= end || end - seq > count) return false;
+
+    // Head and sequence both restart at 0 (clear / load) and advance
+    // together, so the slot follows from seq alone.
+    out = _history[seq % POWERTRACKER_HISTORY_MAX];
+    // An append that overwrote the slot during the copy moved the window
+    // past seq; report it as gone rather than return the newer entry.
+    const uint32_t endAfter = *static_cast<const volatile uint32_t*>(&_historyEndSeq);
+    if (endAfter - seq > POWERTRACKER_HISTORY_MAX) return false;
+    return out.valid;
+}
+
 void PowerTracker::clearHistory() {
     for (uint16_t i = 0; i < POWERTRACKER_HISTORY_MAX; ++i) {
         _history[i].valid = false;
     }
     _historyHead  = 0;
     _historyCount = 0;
+    _historyEndSeq = 0;
+    ++_historyDataset;
+    markHistoryChanged();
 
     if (SPIFFS.begin(false)) {
         SPIFFS.remove(POWERTRACKER_HISTORY_FILE);
@@ -94,6 +94,17 @@ public:
     // Optional: clear all history + delete file
     void clearHistory();
 
+    // Bumped on every history change (ETag source); epoch 0 = RTC unset.
+    uint32_t getHistoryGeneration() const { return _historyGen; }
+    uint32_t getHistoryModifiedEpoch() const { return _historyModifiedEpoch; }
+
+    // Paging view (/session_history cursors). Every appended entry gets
+    // the next sequence number; the ring holds [end - count, end). The
+    // dataset id changes when the sequence restarts (clear / load).
+    uint32_t getHistoryDataset() const { return _historyDataset; }
+    uint32_t getHistoryEndSeq() const { return _historyEndSeq; }
+    bool getHistoryEntryBySeq(uint32_t seq, HistoryEntry& out) const;
+
 private:
     PowerTracker() = default;
 
@@ -106,6 +117,7 @@ private:
     void loadHistoryFromFile();
     bool saveHistoryToFile() const;
     void appendHistoryEntry(const HistoryEntry& e);
+    void markHistoryChanged();
 
     // Session state
     bool      _active            = false;
@@ -130,6 +142,10 @@ private:
     HistoryEntry _history[POWERTRACKER_HISTORY_MAX];
     uint16_t     _historyHead  = 0;   // next write index
     uint16_t     _historyCount = 0;   // number of valid entries
+    uint32_t     _historyGen   = 0;
+    uint32_t     _historyModifiedEpoch = 0;
+    uint32_t     _historyDataset = 0;
+    uint32_t     _historyEndSeq  = 0;   // sequence of the next append
 
     // Last session snapshot (for quick access)
     SessionStats _lastSession;
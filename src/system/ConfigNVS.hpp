@@ -42,9 +42,13 @@
 #define CHARGE_RESISTOR_KEY            "CHRES"     // Charge resistor value key
 #define AC_FREQUENCY_KEY               "ACFRQ"     // Sampling rate key (Hz)
 #define AC_VOLTAGE_KEY                 "ACVLT"     // AC line voltage key
-#define CURRENT_SOURCE_KEY             "CSRC"     // int: 0=estimate from Vdrop, 1=ACS sensor
+#define CURRENT_SOURCE_KEY             "CSRC"     // int: 0=estimate from Vdrop, 1=ACS sensor, 2=fused
 #define CP_EMP_GAIN_KEY                "CPEMGN"    // Empirical capacitor ADC gain key
 #define CAP_BANK_CAP_F_KEY             "CPCAPF"    // Capacitor bank capacitance [F] key
+#define BUS_FLOOR_V_KEY                "BUSFLV"    // float: min planned bus voltage under pulses [V]
+#define INTERLEAVE_SUB_KEY             "ILVSUB"    // int: max sub-pulses per wire per frame (1 = sequential)
+#define SOFTSTART_MS_KEY               "SSRAMP"    // int: soft-start ramp at RUN start [ms] (0 = off)
+#define SOFTSTART_PEAK_KEY             "SSPKA"     // float: charge-path peak current at full ramp [A]
 #define CURR_LIMIT_KEY                 "CURRLT"   // float: over-current trip threshold [A]
 #define TEMP_SENSOR_COUNT_KEY          "TMNT"    // Number of temperature sensors detected
 #define RTC_CURRENT_EPOCH_KEY          "RCUR"    // Last known epoch persisted
@@ -183,6 +187,10 @@ ASSERT_NVS_KEY_LEN(DEV_HW_KEY);
 ASSERT_NVS_KEY_LEN(UI_LANGUAGE_KEY);
 ASSERT_NVS_KEY_LEN(CURRENT_SOURCE_KEY);
 ASSERT_NVS_KEY_LEN(CURR_LIMIT_KEY);
+ASSERT_NVS_KEY_LEN(BUS_FLOOR_V_KEY);
+ASSERT_NVS_KEY_LEN(INTERLEAVE_SUB_KEY);
+ASSERT_NVS_KEY_LEN(SOFTSTART_MS_KEY);
+ASSERT_NVS_KEY_LEN(SOFTSTART_PEAK_KEY);
 ASSERT_NVS_KEY_LEN(TEMP_WARN_KEY);
 ASSERT_NVS_KEY_LEN(FLOOR_THICKNESS_MM_KEY);
 ASSERT_NVS_KEY_LEN(FLOOR_MATERIAL_KEY);
@@ -331,6 +339,7 @@ ASSERT_NVS_KEY_LEN(W10CAP_KEY);
 #define FORCE_ALL_WIRES_PRESENT        1
 // ---------- Nichrome Wire Resistance (Ohms) ----------
 #define DEFAULT_WIRE_RES_OHMS  44.0f   // default for all 10 wires
+#define DEFAULT_WIRE_TREND_OHMS 0.0f   // no long-term trend recorded yet
 
 // 6-char NVS keys per wire
 #define R01OHM_KEY  "R01OHM"
@@ -344,6 +353,18 @@ ASSERT_NVS_KEY_LEN(W10CAP_KEY);
 #define R09OHM_KEY  "R09OHM"
 #define R10OHM_KEY  "R10OHM"
 
+// Long-term measured resistance trend per wire (predictive maintenance)
+#define R01TRD_KEY  "R01TRD"
+#define R02TRD_KEY  "R02TRD"
+#define R03TRD_KEY  "R03TRD"
+#define R04TRD_KEY  "R04TRD"
+#define R05TRD_KEY  "R05TRD"
+#define R06TRD_KEY  "R06TRD"
+#define R07TRD_KEY  "R07TRD"
+#define R08TRD_KEY  "R08TRD"
+#define R09TRD_KEY  "R09TRD"
+#define R10TRD_KEY  "R10TRD"
+
 // Idle current calibration removed (no key)
 #define WIRE_OHM_PER_M_KEY               "WOPERM"    // float: Ω per meter for installed nichrome
 #define DEFAULT_WIRE_OHM_PER_M           2.0f        // 2 Ω/m nichrome (your current wire)
@@ -396,9 +417,14 @@ ASSERT_NVS_KEY_LEN(W10CAP_KEY);
 #define DEFAULT_DC_VOLTAGE             325.0f           // Volts (fixed target)
 #define CURRENT_SRC_ESTIMATE           0                // estimate current from voltage drop
 #define CURRENT_SRC_ACS                1                // ACS hall-effect current sensor
+#define CURRENT_SRC_FUSED              2                // Kalman fusion of ACS + voltage estimate
 #define DEFAULT_CURRENT_SOURCE         CURRENT_SRC_ESTIMATE
 #define DEFAULT_CAP_EMP_GAIN           (321.0f / 1.90f) // Default empirical ADC->bus gain
 #define DEFAULT_CAP_BANK_CAP_F         0.0f             // Farads (0 => unknown until calibrated)
+#define DEFAULT_BUS_FLOOR_V            (DEFAULT_DC_VOLTAGE * 0.70f) // droop planning floor [V]
+#define DEFAULT_INTERLEAVE_SUB         4                // phase-staggered sub-pulses per wire
+#define DEFAULT_SOFTSTART_MS           2000             // soft-start ramp [ms]
+#define DEFAULT_SOFTSTART_PEAK_A       3.0f             // charge-path peak at full ramp [A]
 #define DEFAULT_TEMP_SENSOR_COUNT      12               // Default to 12 sensors unless discovered otherwise
 #define DEFAULT_CURR_LIMIT_A           36.0f            // Default over-current trip [A]
 #define DEFAULT_WIRE_GAUGE             20               // AWG number for installed nichrome
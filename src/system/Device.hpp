@@ -75,6 +75,8 @@
 #include <PowerTracker.hpp>
 #include <WireSubsystem.hpp>
 #include <WirePresenceManager.hpp>
+#include <WireResistanceEstimator.hpp>
+#include <PrechargeMonitor.hpp>
 #include <BusSampler.hpp>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -402,6 +404,8 @@ public:
     FloorControlStatus getFloorControlStatus() const;
     LoopTargetStatus getLoopTargetStatus() const;
     AmbientWaitStatus getAmbientWaitStatus() const;
+    PrechargeMonitor::Result getPrechargeReport() const;  ///< Last RUN-prep charge curve.
+    CapDischargeController::Report getDischargeReport() const;  ///< Last bank discharge.
     bool confirmWiresCool();
     bool consumeWiresCoolConfirmation();
     bool isWiresCoolConfirmed() const;
@@ -432,6 +436,7 @@ public:
     WireStateModel&       getWireStateModel()       { return wireStateModel; }
     WireThermalModel&     getWireThermalModel()     { return wireThermalModel; }
     WireTelemetryAdapter& getWireTelemetryAdapter() { return wireTelemetryAdapter; }
+    const WireResistanceEstimator& getWireResistanceEstimator() const { return wireResEstimator; }
     float                 getCapBankCapF() const    { return capBankCapF; }
 
 private:
@@ -483,6 +488,7 @@ private:
 
     float    ambientC            = 25.0f;
     bool     thermalInitDone     = false;
+    bool     wireHeatTracked     = false;   // model seeded at a RUN start this boot (warm start)
     uint32_t lastAmbientUpdateMs = 0;
 
     // Capacitor bank capacitance (Farads), set by calibrateCapacitance().
@@ -541,6 +547,7 @@ private:
     WireThermalModel     wireThermalModel;
     WireTelemetryAdapter wireTelemetryAdapter;
     WirePresenceManager  wirePresenceManager;
+    WireResistanceEstimator wireResEstimator;
     BusSampler*          busSampler = nullptr;
 
     SemaphoreHandle_t    controlMtx = nullptr;
@@ -548,6 +555,8 @@ private:
     FloorControlStatus   floorControlStatus{};
     LoopTargetStatus     loopTargetStatus{};
     AmbientWaitStatus    ambientWaitStatus{};
+    PrechargeMonitor::Result prechargeReport{};
+    CapDischargeController::Report dischargeReport{};
     bool                 wiresCoolConfirmed = false;
     uint32_t             wiresCoolConfirmMs = 0;
     void updateWireTestStatus(uint8_t wireIndex,
@@ -556,9 +565,12 @@ private:
     // Internal helpers
     void syncWireRuntimeFromHeater();
     void updateAmbientFromSensors(bool force = false);
+    void updateWireResistanceEstimate(uint16_t mask, float vBus, float iBusAcs);
     void waitForWiresNearAmbient(float tolC, uint32_t maxWaitMs = 0,
                                  const char* reason = nullptr);
     void setAmbientWaitStatus(bool active, float tolC, const char* reason);
+    bool waitForPrecharge(bool freshCapCal, uint32_t timeoutMs,
+                          uint8_t& abortCode);
     void loadRuntimeSettings();
     void applyWireModelParamsFromNvs();
     bool pushEventNotice(const EventNotice& note);
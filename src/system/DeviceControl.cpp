@@ -475,6 +475,32 @@ Device::WireTargetStatus Device::getWireTargetStatus() const {
     return out;
 }
 
+PrechargeMonitor::Result Device::getPrechargeReport() const {
+    PrechargeMonitor::Result out{};
+    if (const_cast<Device*>(this)->controlMtx &&
+        xSemaphoreTake(const_cast<Device*>(this)->controlMtx, pdMS_TO_TICKS(25)) == pdTRUE)
+    {
+        out = prechargeReport;
+        xSemaphoreGive(const_cast<Device*>(this)->controlMtx);
+    } else {
+        out = prechargeReport;
+    }
+    return out;
+}
+
+CapDischargeController::Report Device::getDischargeReport() const {
+    CapDischargeController::Report out{};
+    if (const_cast<Device*>(this)->controlMtx &&
+        xSemaphoreTake(const_cast<Device*>(this)->controlMtx, pdMS_TO_TICKS(25)) == pdTRUE)
+    {
+        out = dischargeReport;
+        xSemaphoreGive(const_cast<Device*>(this)->controlMtx);
+    } else {
+        out = dischargeReport;
+    }
+    return out;
+}
+
 Device::AmbientWaitStatus Device::getAmbientWaitStatus() const {
     AmbientWaitStatus out{};
     if (const_cast<Device*>(this)->controlMtx &&
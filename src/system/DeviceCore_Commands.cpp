@@ -115,6 +115,7 @@ void Device::handleCommand(const DevCommand& cmd) {
       if (!floatEq(CONF->GetFloat(CHARGE_RESISTOR_KEY, 0.0f), cmd.f1)) {
         CONF->PutFloat(CHARGE_RESISTOR_KEY, cmd.f1);
       }
+      if (WIRE) WIRE->invalidateConductanceCache();
       break;
 
     case DevCmdType::SET_ACCESS_FLAG: {
@@ -145,6 +146,7 @@ void Device::handleCommand(const DevCommand& cmd) {
           CONF->PutFloat(rkeys[cmd.i1 - 1], cmd.f1);
         }
         wireConfigStore.setWireResistance(cmd.i1, cmd.f1);
+        wireResEstimator.seed(cmd.i1, cmd.f1);
         if (WIRE) {
           WIRE->setWireResistance(cmd.i1, cmd.f1);
         }
@@ -12,6 +12,12 @@
 // ===== Singleton storage & accessors =====
 Device* Device::instance = nullptr;
 
+// Runs in the CurrentSensor trip task: cut outputs only, the control loop
+// picks up the latch and runs handleOverCurrentFault().
+static void fastTripCut_(void*) {
+  if (WIRE) WIRE->emergencyCutAll();
+}
+
 void Device::Init(TempSensor* temp,CurrentSensor* current,Relay* relay,CpDischg* discharger,Indicator* ledIndicator) {
   if (!instance) {
     instance = new Device(temp, current, relay, discharger, ledIndicator);
@@ -73,6 +79,10 @@ void Device::begin() {
   RGB->postOverlay(OverlayEvent::WAKE_FLASH);
 
   wireConfigStore.loadFromNvs();
+  wirePresenceManager.loadTrends(wireConfigStore);
+  for (uint8_t i = 1; i <= HeaterManager::kWireCount; ++i) {
+    wireResEstimator.seed(i, wireConfigStore.getWireResistance(i));
+  }
   checkAllowedOutputs();
   loadRuntimeSettings();
 
@@ -108,6 +118,8 @@ void Device::begin() {
     float limitA = CONF->GetFloat(CURR_LIMIT_KEY, DEFAULT_CURR_LIMIT_A);
     if (limitA < 0.0f) limitA = 0.0f;
     currentSensor->configureOverCurrent(limitA, CURRENT_TIME);
+    currentSensor->setTripCallback(&fastTripCut_, nullptr);
+    currentSensor->startFastTrip();
   }
 
   startThermalTask();
@@ -26,7 +26,7 @@ void Device::handle12VDrop() {
       if (CONF) {
         src = CONF->GetInt(CURRENT_SOURCE_KEY, DEFAULT_CURRENT_SOURCE);
       }
-      if (src == CURRENT_SRC_ACS && currentSensor) {
+      if ((src == CURRENT_SRC_ACS || src == CURRENT_SRC_FUSED) && currentSensor) {
         const float i = currentSensor->readCurrent();
         if (isfinite(i)) {
           curA = i;
@@ -101,12 +101,12 @@ bool Device::delayWithPowerWatch(uint32_t ms) {
       }
     }
 
-    // 3) NEW: Check over-current latch
-    /*if (currentSensor && currentSensor->isOverCurrentLatched()) {
-      DEBUG_PRINTLN("[Device] Over-current latch set during wait ???????? abort");
+    // 3) Over-current latch (outputs already cut by the fast trip task)
+    if (currentSensor && currentSensor->isOverCurrentLatched()) {
+      DEBUG_PRINTLN("[Device] Over-current latch set during wait abort");
       handleOverCurrentFault();
       return false;
-    }*/
+    }
   }
 
   return true;
@@ -118,31 +118,57 @@ bool Device::dischargeCapBank(float thresholdV, uint8_t maxRounds) {
   relayControl->turnOff();
   vTaskDelay(pdMS_TO_TICKS(20));
 
-  for (uint8_t round = 0; round < maxRounds; ++round) {
-    float v = discharger->readCapVoltage();
-    if (isfinite(v) && v <= thresholdV) break;
+  uint16_t allowedMask = 0;
+  for (uint8_t idx = 1; idx <= HeaterManager::kWireCount; ++idx) {
+    if (wireConfigStore.getAccessFlag(idx)) {
+      allowedMask |= static_cast<uint16_t>(1u << (idx - 1));
+    }
+  }
 
-    for (uint8_t idx = 1; idx <= HeaterManager::kWireCount; ++idx) {
-      if (!wireConfigStore.getAccessFlag(idx)) continue;
-      WIRE->setOutput(idx, true);
-      delayWithPowerWatch(1000);
-      WIRE->setOutput(idx, false);
+  // Closed loop on the capacitor model: masks sized to stay under the
+  // over-current trip, hot wires skipped, done as soon as V <= threshold.
+  CapDischargeController::Config cfg;
+  cfg.capF = (isfinite(capBankCapF) && capBankCapF > 0.0f) ? capBankCapF : 0.0f;
+  cfg.vSafe = thresholdV;
+  cfg.maxCurrentA = DEFAULT_CURR_LIMIT_A;
+  if (CONF) cfg.maxCurrentA = CONF->GetFloat(CURR_LIMIT_KEY, DEFAULT_CURR_LIMIT_A);
+  if (!isfinite(cfg.maxCurrentA) || cfg.maxCurrentA <= 0.0f) {
+    cfg.maxCurrentA = DEFAULT_CURR_LIMIT_A;
+  }
+  cfg.maxCurrentA *= 0.9f;
+  cfg.maxWireTempC = WIRE_T_MAX_C - 10.0f;
 
-      v = discharger->readCapVoltage();
-      if (isfinite(v) && v <= thresholdV) break;
+  bool ok = false;
+  CapDischargeController::Report rep{};
+  for (uint8_t round = 0; round < maxRounds && allowedMask != 0; ++round) {
+    ok = discharger->discharge(allowedMask, &cfg, &rep);
+
+    if (controlMtx && xSemaphoreTake(controlMtx, pdMS_TO_TICKS(25)) == pdTRUE) {
+      dischargeReport = rep;
+      xSemaphoreGive(controlMtx);
+    } else {
+      dischargeReport = rep;
     }
+
+    if (rep.openMask != 0) {
+      char reason[96] = {0};
+      snprintf(reason, sizeof(reason),
+               "Discharge: no current through wire mask 0x%03X",
+               (unsigned)rep.openMask);
+      addWarningReason(reason);
+      allowedMask &= static_cast<uint16_t>(~rep.openMask);
+    }
+    if (ok || rep.status == CapDischargeController::Status::NoLoad) break;
   }
 
   WIRE->disableAll();
-  const float vfinal = discharger->readCapVoltage();
-  return isfinite(vfinal) && vfinal <= thresholdV;
+  return ok;
 }
 
 bool Device::calibrateCapacitance() {
   if (!discharger || !relayControl || !WIRE) return false;
 
   uint16_t dischargeMask = 0;
-  double gTot = 0.0;
   for (uint8_t i = 1; i <= HeaterManager::kWireCount; ++i) {
     if (!wireConfigStore.getAccessFlag(i)) continue;
     WireInfo wi = WIRE->getWireInfo(i);
@@ -150,9 +176,9 @@ bool Device::calibrateCapacitance() {
     if (!isfinite(wi.resistanceOhm) || wi.resistanceOhm <= 0.01f) {
       continue;
     }
-    gTot += 1.0 / static_cast<double>(wi.resistanceOhm);
     dischargeMask |= static_cast<uint16_t>(1u << (i - 1));
   }
+  const double gTot = WIRE->getMaskConductance(dischargeMask);
   if (!(gTot > 0.0) || dischargeMask == 0) {
     DEBUG_PRINTLN("[Device] Cap calibration skipped (no connected discharge wire)");
     return false;
@@ -324,6 +350,7 @@ bool Device::runCalibrationsStandalone(uint32_t timeoutMs) {
       return failSafe("[Device] Calibration aborted (power/watch stop)");
     }
     currentSensor->calibrateZeroCurrent();
+    if (BUS_SAMPLER) BUS_SAMPLER->resetFusion();  // new zero -> relearn offset
     if (timedOut()) return failSafe("[Device] Calibration timeout (current sensor)");
     if (relayControl) relayControl->turnOn();
   }
@@ -379,7 +406,7 @@ void Device::handleOverCurrentFault() {
         if (CONF) {
           src = CONF->GetInt(CURRENT_SOURCE_KEY, DEFAULT_CURRENT_SOURCE);
         }
-        if (src == CURRENT_SRC_ACS && currentSensor) {
+        if ((src == CURRENT_SRC_ACS || src == CURRENT_SRC_FUSED) && currentSensor) {
           const float i = currentSensor->readCurrent();
           if (isfinite(i)) {
             curA = i;
@@ -393,8 +420,19 @@ void Device::handleOverCurrentFault() {
     if (CONF) limitA = CONF->GetFloat(CURR_LIMIT_KEY, DEFAULT_CURR_LIMIT_A);
     if (!isfinite(limitA) || limitA <= 0.0f) limitA = DEFAULT_CURR_LIMIT_A;
 
+    // Prefer the fast-trip peak: by now the outputs are off and a fresh
+    // read would show ~0 A.
+    CurrentSensor::TripStats ts{};
+    if (currentSensor) ts = currentSensor->getTripStats();
+    const bool fastTrip = ts.trips > 0 && (millis() - ts.lastTripMs) < 1000;
+
     char reason[96] = {0};
-    if (isfinite(curA)) {
+    if (fastTrip) {
+      snprintf(reason, sizeof(reason), "Over-current trip (peak=%.2fA lim=%.1fA %luus)",
+               static_cast<double>(ts.lastPeakA), static_cast<double>(limitA),
+               static_cast<unsigned long>(ts.lastDetectUs));
+      setLastErrorReason(reason);
+    } else if (isfinite(curA)) {
       snprintf(reason, sizeof(reason), "Over-current trip (I=%.2fA lim=%.1fA)",
                static_cast<double>(curA), static_cast<double>(limitA));
       setLastErrorReason(reason);
@@ -411,6 +449,10 @@ void Device::handleOverCurrentFault() {
   if (indicator)    indicator->clearAll();
   if (relayControl) relayControl->turnOff();
 
+  // Error state now gates the outputs; re-arm the trip path.
+  if (WIRE)          WIRE->clearEmergencyCut();
+  if (currentSensor) currentSensor->clearOverCurrentLatch();
+
   // 3) Feedback: critical current trip
   if (RGB) {
     RGB->setDeviceState(DevState::FAULT);      // red strobe background
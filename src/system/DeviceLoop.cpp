@@ -7,6 +7,9 @@
 #include <WireSafetyPolicy.hpp>
 #include <WireActuator.hpp>
 #include <WireScheduler.hpp>
+#include <OutputInterleaver.hpp>
+#include <WireWarmStart.hpp>
+#include <SoftStartRamp.hpp>
 #include <math.h>
 #include <stdio.h>
 
@@ -24,7 +27,9 @@ static inline uint16_t _allowedMaskFrom(const bool allowed[10]) {
 
 static constexpr uint32_t PREP_CAL_TIMEOUT_MS = 10000;    // per-step timeout for calibrations
 static constexpr uint32_t PREP_CHARGE_TIMEOUT_MS = 15000; // per-step timeout for cap charging
-static constexpr uint32_t PREP_CHARGE_SOAK_MS = 4000;     // fixed cap soak before RUN
+static constexpr uint32_t PREP_CHARGE_SOAK_MS = 4000;     // cap soak before RUN when C is unknown
+static constexpr uint32_t PREP_CHARGE_SAMPLE_MS = 20;     // precharge curve sample period
+static constexpr uint8_t  PREP_ABORT_PRECHARGE = 4;       // abort code: charge curve off-model
 static constexpr uint32_t WAIT_12V_TIMEOUT_MS = 10000;
 
 // ============================================================================
@@ -44,6 +49,8 @@ struct PulseStats {
     float    busVoltage = NAN;
     float    currentA   = NAN;
     float    currentAcs = NAN;
+    float    pairVoltage = NAN;     // mean V over samples with a valid ACS reading
+    float    pairCurrentAcs = NAN;  // mean ACS current over the same samples
     uint16_t appliedMask = 0;
 };
 
@@ -65,6 +72,8 @@ static bool _runMaskedPulse(Device* self,
         stats->busVoltage = NAN;
         stats->currentA = NAN;
         stats->currentAcs = NAN;
+        stats->pairVoltage = NAN;
+        stats->pairCurrentAcs = NAN;
         stats->appliedMask = 0;
     }
 
@@ -149,17 +158,26 @@ static bool _runMaskedPulse(Device* self,
 
     float pulseVSum = 0.0f;
     uint8_t pulseVSamples = 0;
+    float pairVSum = 0.0f;
+    float pairISum = 0.0f;
+    uint8_t pairSamples = 0;
     BusSampler* sampler = BUS_SAMPLER;
 
     int currentSource = DEFAULT_CURRENT_SOURCE;
     if (CONF) {
         currentSource = CONF->GetInt(CURRENT_SOURCE_KEY, DEFAULT_CURRENT_SOURCE);
     }
-    if (currentSource != CURRENT_SRC_ACS) {
+    if (currentSource != CURRENT_SRC_ACS && currentSource != CURRENT_SRC_FUSED) {
         currentSource = CURRENT_SRC_ESTIMATE;
     }
 
     auto samplePulseCurrent = [&](float v) -> float {
+        if (currentSource == CURRENT_SRC_FUSED && sampler) {
+            const float acs = self->currentSensor ? self->currentSensor->readCurrent() : NAN;
+            return sampler->fuseCurrent(acs,
+                                        WIRE->estimateCurrentFromVoltage(v, appliedMask),
+                                        millis());
+        }
         if (currentSource == CURRENT_SRC_ACS && self->currentSensor) {
             const float i = self->currentSensor->readCurrent();
             if (isfinite(i)) {
@@ -173,6 +191,16 @@ static bool _runMaskedPulse(Device* self,
         if (!isfinite(v)) return;
         pulseVSum += v;
         pulseVSamples++;
+        if (stats && self->currentSensor) {
+            // Same-instant V/I pairs for the resistance estimator: one raw
+            // sample, the moving average would lag the pulse edge.
+            const float ia = self->currentSensor->readCurrentRaw();
+            if (isfinite(ia)) {
+                pairVSum += v;
+                pairISum += ia;
+                pairSamples++;
+            }
+        }
         if (sampler) {
             const float i = samplePulseCurrent(v);
             sampler->recordSample(millis(), v, i);
@@ -229,6 +257,10 @@ static bool _runMaskedPulse(Device* self,
             stats->busVoltage = V_bus;
             stats->currentA = Itot;
             stats->currentAcs = ItotAcs;
+            if (pairSamples > 0) {
+                stats->pairVoltage = pairVSum / static_cast<float>(pairSamples);
+                stats->pairCurrentAcs = pairISum / static_cast<float>(pairSamples);
+            }
         }
         DEBUG_PRINTF("[Pulse] end: mask=0x%03X Vbus=%.2fV Iest=%.3fA\n",
                      (unsigned)appliedMask,
@@ -260,6 +292,131 @@ static bool _runMaskedPulse(Device* self,
     return ok;
 }
 
+// ============================================================================
+// RUN prep: model-based capacitor precharge
+// ============================================================================
+//
+// Samples the bus while the relay charges the bank and fits the RC charge
+// curve (PrechargeMonitor). With a calibrated capacitance the bank is
+// ready as soon as it is near the fitted plateau, and a curve that departs
+// from the model (lost capacitance, load on the bus, stalled charge)
+// aborts the start. Without a calibration the old behaviour is kept: wait
+// for GO_THRESHOLD_RATIO (plus the fixed soak after the recharge).
+//
+// freshCapCal=false (first charge, C from NVS): a tau mismatch is only a
+// warning, since the capacitance calibration that follows re-measures C.
+// Plateau and stall faults abort in both phases.
+//
+// Returns false on abort with abortCode set (0 = STOP cancel).
+// ============================================================================
+
+bool Device::waitForPrecharge(bool freshCapCal, uint32_t timeoutMs,
+                              uint8_t& abortCode) {
+    if (!discharger) return true;
+
+    float chargeResOhm = DEFAULT_CHARGE_RESISTOR_OHMS;
+    if (CONF) {
+        chargeResOhm = CONF->GetFloat(CHARGE_RESISTOR_KEY, DEFAULT_CHARGE_RESISTOR_OHMS);
+    }
+    if (!isfinite(chargeResOhm) || chargeResOhm <= 0.0f) {
+        chargeResOhm = DEFAULT_CHARGE_RESISTOR_OHMS;
+    }
+
+    PrechargeMonitor::Config cfg;
+    cfg.vSrc = DEFAULT_DC_VOLTAGE;
+    cfg.rChargeOhm = chargeResOhm;
+    cfg.capF = getCapBankCapF();
+    cfg.minReadyV = static_cast<float>(GO_THRESHOLD_RATIO);
+    const float tauTol = cfg.tauTol;
+    if (!freshCapCal) cfg.tauTol = INFINITY;
+
+    PrechargeMonitor monitor;
+    const TickType_t start = xTaskGetTickCount();
+    monitor.begin(cfg, discharger->sampleVoltageNow(), millis());
+    const bool modelValid = monitor.result().modelValid;
+    if (modelValid) {
+        DEBUG_PRINTF("[Device] Precharge: V0=%.1fV tau=%.3fs ready(pred)=%lums\n",
+                     (double)monitor.result().v0,
+                     (double)monitor.result().tauModelS,
+                     (unsigned long)monitor.result().modelReadyMs);
+    }
+
+    auto publish = [&]() {
+        const PrechargeMonitor::Result& r = monitor.result();
+        if (controlMtx && xSemaphoreTake(controlMtx, pdMS_TO_TICKS(25)) == pdTRUE) {
+            prechargeReport = r;
+            xSemaphoreGive(controlMtx);
+        } else {
+            prechargeReport = r;
+        }
+    };
+
+    TickType_t lastPost = 0;
+    PrechargeMonitor::Status st = PrechargeMonitor::Status::Charging;
+    while (st == PrechargeMonitor::Status::Charging) {
+        if ((xTaskGetTickCount() - start) * portTICK_PERIOD_MS >= timeoutMs) {
+            DEBUG_PRINTF("[Device] Precharge timeout at %.1fV (ready at %.1fV)\n",
+                         (double)monitor.result().lastV,
+                         (double)monitor.result().readyV);
+            publish();
+            abortCode = 2;
+            return false;
+        }
+        const TickType_t now = xTaskGetTickCount();
+        if ((now - lastPost) * portTICK_PERIOD_MS >= 1000) {
+            RGB->postOverlay(OverlayEvent::PWR_CHARGING);
+            DEBUG_PRINTF("[Device] Charging... Cap=%.1fV ready=%.1fV eta=%lums\n",
+                         (double)monitor.result().lastV,
+                         (double)monitor.result().readyV,
+                         (unsigned long)monitor.result().etaMs);
+            lastPost = now;
+        }
+        if (!delayWithPowerWatch(PREP_CHARGE_SAMPLE_MS)) {
+            publish();
+            abortCode = (getState() == DeviceState::Shutdown) ? 0 : 2;
+            return false;
+        }
+        st = monitor.update(discharger->sampleVoltageNow(), millis());
+    }
+    publish();
+
+    const PrechargeMonitor::Result& r = monitor.result();
+    if (st == PrechargeMonitor::Status::Fault) {
+        DEBUG_PRINTF("[Device] Precharge fault: %s (V=%.1fV tau x%.2f Vinf=%.1fV t=%lums)\n",
+                     PrechargeMonitor::faultName(r.fault),
+                     (double)r.lastV,
+                     (double)r.tauRatio,
+                     (double)r.vInf,
+                     (unsigned long)r.elapsedMs);
+        abortCode = PREP_ABORT_PRECHARGE;
+        return false;
+    }
+
+    DEBUG_PRINTF("[Device] Precharge ready: %.1fV in %lums (model %lums, tau x%.2f)\n",
+                 (double)r.lastV,
+                 (unsigned long)r.elapsedMs,
+                 (unsigned long)r.modelReadyMs,
+                 (double)r.tauRatio);
+
+    if (!freshCapCal && r.fitValid &&
+        (r.tauRatio < 1.0f / tauTol || r.tauRatio > tauTol)) {
+        char reason[96] = {0};
+        snprintf(reason, sizeof(reason),
+                 "Precharge tau x%.2f vs stored capacitance; recalibrating",
+                 (double)r.tauRatio);
+        addWarningReason(reason);
+    }
+
+    if (!modelValid && freshCapCal) {
+        DEBUG_PRINTLN("[Device] RUN prep: cap soak 4s (capacitance not calibrated)");
+        if (!delayWithPowerWatch(PREP_CHARGE_SOAK_MS)) {
+            abortCode = (getState() == DeviceState::Shutdown) ? 0 : 2;
+            return false;
+        }
+    }
+    return true;
+}
+
 // ============================================================================
 // Loop Task Management & State Machine
 // ============================================================================
@@ -438,40 +595,14 @@ void Device::loopTask() {
         // 1) Enable relay and charge capacitors to GO threshold.
         if (!abortRun) {
             DEBUG_PRINTLN("[Device] RUN prep: enabling relay");
-            TickType_t chargeStart = xTaskGetTickCount();
             relayControl->turnOn();
             RGB->postOverlay(OverlayEvent::RELAY_ON);
-            vTaskDelay(pdMS_TO_TICKS(150));
-
-            TickType_t lastChargePost = 0;
-            while (discharger && discharger->readCapVoltage() < GO_THRESHOLD_RATIO) {
-                if (stepTimedOut(chargeStart, PREP_CHARGE_TIMEOUT_MS)) {
-                    DEBUG_PRINTLN("[Device] Timeout while charging caps to GO threshold; aborting start");
-                    abortRun = true;
-                    abortCat = ErrorCategory::POWER;
-                    abortCode = 2;
-                    break;
-                }
-                TickType_t now = xTaskGetTickCount();
-                if ((now - lastChargePost) * portTICK_PERIOD_MS >= 1000) {
-                    RGB->postOverlay(OverlayEvent::PWR_CHARGING);
-                    lastChargePost = now;
-                }
-                DEBUG_PRINTF("[Device] Charging... Cap=%.2fV Target=%.2fV\n",
-                             discharger ? discharger->readCapVoltage() : -1.0f,
-                             (double)GO_THRESHOLD_RATIO);
-                if (!delayWithPowerWatch(200)) {
-                    // STOP or 12V loss handled inside delayWithPowerWatch()
-                    abortRun = true;
-                    if (getState() == DeviceState::Shutdown) {
-                        // Treat STOP as a clean cancel (no error code).
-                        abortCode = 0;
-                    } else {
-                        abortCat = ErrorCategory::POWER;
-                        abortCode = 2;
-                    }
-                    break;
-                }
+
+            // STOP or 12V loss handled inside; STOP is a clean cancel (code 0).
+            if (!waitForPrecharge(false, PREP_CHARGE_TIMEOUT_MS, abortCode)) {
+                DEBUG_PRINTLN("[Device] Cap charge failed; aborting start");
+                abortRun = true;
+                abortCat = ErrorCategory::POWER;
             }
         }
 
@@ -491,47 +622,14 @@ void Device::loopTask() {
             }
         }
 
-        // 3) Recharge after discharge-based calibration so RUN starts with sane voltage.
+        // 3) Recharge after discharge-based calibration so RUN starts with sane
+        //    voltage. Ready on the fitted charge curve with the freshly
+        //    calibrated C (the fixed soak only remains as the no-model fallback).
         if (!abortRun) {
-            TickType_t chargeStart = xTaskGetTickCount();
-            TickType_t lastChargePost = 0;
-            while (discharger && discharger->readCapVoltage() < GO_THRESHOLD_RATIO) {
-                if (stepTimedOut(chargeStart, PREP_CHARGE_TIMEOUT_MS)) {
-                    DEBUG_PRINTLN("[Device] Timeout while re-charging caps after calibration; aborting start");
-                    abortRun = true;
-                    abortCat = ErrorCategory::POWER;
-                    abortCode = 2;
-                    break;
-                }
-                TickType_t now = xTaskGetTickCount();
-                if ((now - lastChargePost) * portTICK_PERIOD_MS >= 1000) {
-                    RGB->postOverlay(OverlayEvent::PWR_CHARGING);
-                    lastChargePost = now;
-                }
-                if (!delayWithPowerWatch(200)) {
-                    abortRun = true;
-                    if (getState() == DeviceState::Shutdown) {
-                        abortCode = 0; // STOP cancel
-                    } else {
-                        abortCat = ErrorCategory::POWER;
-                        abortCode = 2;
-                    }
-                    break;
-                }
-            }
-        }
-
-        // 4) Final cap soak before RUN (fixed pre-charge dwell).
-        if (!abortRun) {
-            DEBUG_PRINTLN("[Device] RUN prep: cap soak 4s");
-            if (!delayWithPowerWatch(PREP_CHARGE_SOAK_MS)) {
+            if (!waitForPrecharge(true, PREP_CHARGE_TIMEOUT_MS, abortCode)) {
+                DEBUG_PRINTLN("[Device] Cap re-charge after calibration failed; aborting start");
                 abortRun = true;
-                if (getState() == DeviceState::Shutdown) {
-                    abortCode = 0; // STOP cancel
-                } else {
-                    abortCat = ErrorCategory::POWER;
-                    abortCode = 2;
-                }
+                abortCat = ErrorCategory::POWER;
             }
         }
 
@@ -556,7 +654,13 @@ void Device::loopTask() {
                 if (indicator) indicator->clearAll();
                 RGB->setOff();
                 char reason[96] = {0};
-                if (abortCode) {
+                if (abortCode == PREP_ABORT_PRECHARGE) {
+                    const PrechargeMonitor::Result pr = getPrechargeReport();
+                    snprintf(reason, sizeof(reason),
+                             "Precharge fault: %s",
+                             PrechargeMonitor::faultName(pr.fault));
+                    setLastErrorReason(reason);
+                } else if (abortCode) {
                     snprintf(reason, sizeof(reason),
                              "Run prep aborted (cat=%u code=%u)",
                              static_cast<unsigned>(abortCat),
@@ -581,6 +685,7 @@ void Device::loopTask() {
         RGB->setRun();
 
         StartLoop(); // will block until STOP/FAULT/NO-WIRE
+        wirePresenceManager.saveTrends(wireConfigStore);
 
         // =================== CLEAN SHUTDOWN -> OFF ===================
         DEBUG_PRINTLN("[Device] StartLoop finished -> clean shutdown");
@@ -670,7 +775,60 @@ void Device::StartLoop() {
         (waitPurpose == EnergyRunPurpose::NtcCal) ||
         (waitPurpose == EnergyRunPurpose::FloorCal);
     const bool coolConfirmed = shouldWait ? consumeWiresCoolConfirmation() : false;
-    if (shouldWait && !coolConfirmed) {
+
+    // Normal RUN resumes from the thermal model instead of waiting for the
+    // wires to cool: residual heat is charged against the frame budget
+    // below. Calibration runs keep the cold-start wait.
+    bool warmStart = false;
+    if (shouldWait && !coolConfirmed &&
+        waitPurpose == EnergyRunPurpose::None && WIRE) {
+        const uint32_t nowMs = millis();
+        WireWarmStart::Evidence ev;
+        ev.modelReady = thermalInitDone && wireThermalModel.isInitialized() &&
+                        thermalTaskHandle != nullptr;
+        ev.ranThisBoot = wireHeatTracked;
+        ev.uptimeMs = nowMs;
+        for (uint8_t i = 0; i < HeaterManager::kWireCount; ++i) {
+            const uint32_t ts = wireThermalModel.getWireUpdateMs(i + 1);
+            const int32_t dt = static_cast<int32_t>(nowMs - ts);
+            const uint32_t age = (ts == 0) ? UINT32_MAX
+                                           : static_cast<uint32_t>(dt > 0 ? dt : 0);
+            if (age > ev.maxModelAgeMs) ev.maxModelAgeMs = age;
+            if (!isfinite(wireThermalModel.getWireTemp(i + 1))) ev.modelReady = false;
+            double tau = 0.0, k = 0.0, c = 0.0;
+            if (wireThermalModel.getWireThermalParams(i + 1, tau, k, c) &&
+                isfinite(tau) && static_cast<float>(tau) > ev.maxTauS) {
+                ev.maxTauS = static_cast<float>(tau);
+            }
+        }
+
+        const WarmStartMode mode = WireWarmStart::assess(ev, WireWarmStart::Config{});
+        if (mode == WarmStartMode::Bounded) {
+            // Heat from before this boot is unknown: assume the wires were
+            // at the limit at boot and have only been cooling since.
+            for (uint8_t i = 0; i < HeaterManager::kWireCount; ++i) {
+                double tau = 0.0, k = 0.0, c = 0.0;
+                wireThermalModel.getWireThermalParams(i + 1, tau, k, c);
+                const float seedC = WireWarmStart::boundedSeedC(
+                    ambientC, WIRE_T_MAX_C, static_cast<float>(tau), nowMs);
+                const double curC = wireThermalModel.getWireTemp(i + 1);
+                if (seedC > curC) {
+                    wireThermalModel.applyExternalWireTemp(
+                        static_cast<uint8_t>(i + 1), seedC, nowMs, wireStateModel, *WIRE);
+                }
+            }
+        }
+        if (mode != WarmStartMode::Unknown) {
+            warmStart = true;
+            char reason[16] = {0};
+            snprintf(reason, sizeof(reason), "warm_%s", WireWarmStart::modeName(mode));
+            setAmbientWaitStatus(false, 0.0f, reason);
+            DEBUG_PRINTF("[Device] Warm start (%s), skipping cool-down wait\n",
+                         WireWarmStart::modeName(mode));
+        }
+    }
+
+    if (!warmStart && shouldWait && !coolConfirmed) {
         const char* waitReason =
             (waitPurpose == EnergyRunPurpose::ModelCal) ? "model_cal" :
             (waitPurpose == EnergyRunPurpose::NtcCal)   ? "ntc_cal"   :
@@ -688,9 +846,11 @@ void Device::StartLoop() {
             }
         }
         waitForWiresNearAmbient(5.0f, 0, waitReason);
-    } else {
+    } else if (!warmStart) {
         setAmbientWaitStatus(false, 0.0f, coolConfirmed ? "confirmed" : "none");
     }
+    // From here on the model carries every joule this boot delivered.
+    if (shouldWait) wireHeatTracked = true;
 
     // 2) Presence runtime checks (reset counters at run start).
     wirePresenceManager.resetFailures();
@@ -761,6 +921,49 @@ void Device::StartLoop() {
     if (wireMaxC > WIRE_T_MAX_C) wireMaxC = WIRE_T_MAX_C;
     if (wireMaxC < 0.0f) wireMaxC = 0.0f;
 
+    // Droop planning: keep the bank above busFloorV across each frame.
+    float busFloorV = DEFAULT_BUS_FLOOR_V;
+    float chargeResOhm = DEFAULT_CHARGE_RESISTOR_OHMS;
+    if (CONF) {
+        busFloorV = CONF->GetFloat(BUS_FLOOR_V_KEY, DEFAULT_BUS_FLOOR_V);
+        chargeResOhm = CONF->GetFloat(CHARGE_RESISTOR_KEY, DEFAULT_CHARGE_RESISTOR_OHMS);
+    }
+    if (!isfinite(busFloorV) || busFloorV < 0.0f) busFloorV = DEFAULT_BUS_FLOOR_V;
+    if (!isfinite(chargeResOhm) || chargeResOhm <= 0.0f) {
+        chargeResOhm = DEFAULT_CHARGE_RESISTOR_OHMS;
+    }
+
+    // Phase-staggered interleaving: split each wire's on-time into
+    // sub-pulses spread across the frame (1 = plain sequential blocks).
+    int interleaveSub = DEFAULT_INTERLEAVE_SUB;
+    if (CONF) {
+        interleaveSub = CONF->GetInt(INTERLEAVE_SUB_KEY, DEFAULT_INTERLEAVE_SUB);
+    }
+    if (interleaveSub < 1) interleaveSub = 1;
+    if (interleaveSub > 8) interleaveSub = 8;
+
+    // Soft start: ramp frame energy and the charge-path peak over the
+    // first frames while the wires are cold.
+    SoftStartRamp::Config softCfg;
+    if (CONF) {
+        const int rampMs = CONF->GetInt(SOFTSTART_MS_KEY, DEFAULT_SOFTSTART_MS);
+        softCfg.rampMs = (rampMs > 0) ? static_cast<uint32_t>(rampMs) : 0u;
+        softCfg.peakLimitA = CONF->GetFloat(SOFTSTART_PEAK_KEY, DEFAULT_SOFTSTART_PEAK_A);
+    } else {
+        softCfg.rampMs = DEFAULT_SOFTSTART_MS;
+        softCfg.peakLimitA = DEFAULT_SOFTSTART_PEAK_A;
+    }
+    if (softCfg.rampMs > 60000u) softCfg.rampMs = 60000u;
+    if (!isfinite(softCfg.peakLimitA) || softCfg.peakLimitA < 0.0f) {
+        softCfg.peakLimitA = DEFAULT_SOFTSTART_PEAK_A;
+    }
+    // Scaled packets stay as long as the scheduler's minimum and a
+    // measurable sub-pulse.
+    softCfg.minPulseMs = static_cast<uint16_t>(
+        (minOnI > OUTPUT_INTERLEAVE_MIN_SUB_MS) ? minOnI : OUTPUT_INTERLEAVE_MIN_SUB_MS);
+    SoftStartRamp softStart;
+    bool softStartBegun = false;
+
     float floorSwitchMarginC = DEFAULT_FLOOR_SWITCH_MARGIN_C;
     if (CONF) {
         float v = CONF->GetFloat(FLOOR_SWITCH_MARGIN_C_KEY,
@@ -795,18 +998,15 @@ void Device::StartLoop() {
 
     WireScheduler scheduler;
     WirePacket packets[HeaterManager::kWireCount]{};
+    WirePacket plan[WireScheduler::kMaxPlanPackets]{};
     auto sumOnOverR = [&](const WirePacket* list, size_t count) -> double {
         if (!list || count == 0) return 0.0;
         double sum = 0.0;
         for (size_t i = 0; i < count; ++i) {
             const WirePacket& pkt = list[i];
             if (pkt.onMs == 0 || pkt.mask == 0) continue;
-            for (uint8_t b = 0; b < HeaterManager::kWireCount; ++b) {
-                if (!(pkt.mask & (1u << b))) continue;
-                float r = wireConfigStore.getWireResistance(b + 1);
-                if (!isfinite(r) || r <= 0.01f) r = DEFAULT_WIRE_RES_OHMS;
-                sum += static_cast<double>(pkt.onMs) / static_cast<double>(r);
-            }
+            sum += static_cast<double>(pkt.onMs) *
+                   static_cast<double>(WIRE->getMaskConductance(pkt.mask));
         }
         return sum;
     };
@@ -1063,7 +1263,112 @@ void Device::StartLoop() {
             }
         }
 
-        if (packetCount == 0) {
+        // Wire energy budget: cap each packet to the on-time that keeps the
+        // wire model at or below wireMaxC by the end of this frame, so
+        // residual heat (warm start) cannot push a wire past the limit.
+        if (!fixedDuty && packetCount > 0) {
+            for (size_t i = 0; i < packetCount; ++i) {
+                WirePacket& pkt = packets[i];
+                for (uint8_t w = 0; w < HeaterManager::kWireCount; ++w) {
+                    if (!(pkt.mask & (1u << w))) continue;
+                    double tau = 0.0, k = 0.0, c = 0.0;
+                    if (!wireThermalModel.getWireThermalParams(w + 1, tau, k, c)) continue;
+                    const float rOhm = wireConfigStore.getWireResistance(w + 1);
+                    if (!isfinite(rOhm) || rOhm <= 0.01f) continue;
+                    const float pW = (DEFAULT_DC_VOLTAGE * DEFAULT_DC_VOLTAGE) / rOhm;
+                    const uint16_t capMs = WireWarmStart::headroomOnMs(
+                        static_cast<float>(wireThermalModel.getWireTemp(w + 1)),
+                        ambientC,
+                        wireMaxC,
+                        pW,
+                        static_cast<float>(c),
+                        static_cast<float>(k),
+                        static_cast<uint16_t>(frameI));
+                    if (pkt.onMs > capMs) pkt.onMs = capMs;
+                }
+            }
+        }
+
+        // Soft start: the ramp clock starts with the first heating frame;
+        // scaled on-times go out as sub-pulse bursts and the allowed
+        // charge-path peak becomes a droop floor below.
+        SoftStartRamp::Step soft{};
+        if (!fixedDuty && !targetedMode && packetCount > 0) {
+            if (!softStartBegun) {
+                softStart.begin(softCfg, millis());
+                softStartBegun = true;
+            }
+            if (softStart.active()) {
+                float coldestRiseC = NAN;
+                for (size_t i = 0; i < packetCount; ++i) {
+                    for (uint8_t w = 0; w < HeaterManager::kWireCount; ++w) {
+                        if (!(packets[i].mask & (1u << w))) continue;
+                        const float rise =
+                            static_cast<float>(wireThermalModel.getWireTemp(w + 1)) - ambientC;
+                        if (!isfinite(rise)) continue;
+                        if (!isfinite(coldestRiseC) || rise < coldestRiseC) coldestRiseC = rise;
+                    }
+                }
+                soft = softStart.step(millis(), coldestRiseC);
+                if (soft.active) {
+                    softStart.scale(packets, packetCount, soft.frac);
+                }
+            }
+        }
+
+        // Frame plan: the scheduler packets, optionally interleaved. Test
+        // mode keeps whole packets so per-wire test status stays per frame.
+        size_t planCount = 0;
+        bool interleaved = false;
+        if (packetCount > 0) {
+            OutputInterleaver::Limits lim;
+            lim.frameMs = static_cast<uint16_t>(frameI);
+            lim.maxSubPulses = targetedMode ? 1 : static_cast<uint8_t>(interleaveSub);
+            if (soft.active && lim.maxSubPulses < OUTPUT_INTERLEAVE_MAX_SUBPULSES) {
+                lim.maxSubPulses = OUTPUT_INTERLEAVE_MAX_SUBPULSES;
+            }
+            planCount = OutputInterleaver::interleave(packets,
+                                                      packetCount,
+                                                      lim,
+                                                      plan,
+                                                      WireScheduler::kMaxPlanPackets);
+            interleaved = planCount > packetCount;
+        }
+
+        if (planCount > 0 && discharger) {
+            BusDroopModel bus;
+            bus.capF = getCapBankCapF();
+            bus.vSrc = DEFAULT_DC_VOLTAGE;
+            bus.rChargeOhm = (relayControl && relayControl->isOn()) ? chargeResOhm : INFINITY;
+            bus.vStart = discharger->sampleVoltageNow();
+            bus.vNominal = DEFAULT_DC_VOLTAGE;
+            bus.vFloor = busFloorV;
+            if (soft.active && isfinite(bus.rChargeOhm)) {
+                const float softFloorV = SoftStartRamp::floorForPeakV(
+                    bus.vSrc, bus.rChargeOhm, soft.peakAllowA);
+                if (softFloorV > bus.vFloor) bus.vFloor = softFloorV;
+            }
+            bus.maxOnMs = static_cast<uint16_t>(maxOnI);
+            bus.minOnMs = OUTPUT_INTERLEAVE_MIN_SUB_MS;
+            bus.compensate = !fixedDuty;
+            bus.reorder = !interleaved;
+            const float vMinPred =
+                scheduler.planForDroop(wireConfigStore, bus, plan, planCount);
+            if (isfinite(vMinPred)) {
+                DEBUG_PRINTF("[Device] Droop plan: %u pkts V0=%.1fV Vmin(pred)=%.1fV floor=%.1fV\n",
+                             (unsigned)planCount, (double)bus.vStart,
+                             (double)vMinPred, (double)bus.vFloor);
+                if (soft.active) {
+                    DEBUG_PRINTF("[Device] Soft start: x%.2f peak(pred)=%.2fA allow=%.2fA\n",
+                                 (double)soft.frac,
+                                 (double)SoftStartRamp::peakCurrentA(bus.vSrc, vMinPred,
+                                                                     bus.rChargeOhm),
+                                 (double)soft.peakAllowA);
+                }
+            }
+        }
+
+        if (planCount == 0) {
             if (!delayWithPowerWatch(static_cast<uint32_t>(frameMs))) {
                 if (!is12VPresent()) handle12VDrop();
                 else {
@@ -1080,8 +1385,8 @@ void Device::StartLoop() {
         bool abortMixed = false;
         bool reevalAllowed = false;
 
-        for (size_t oi = 0; oi < packetCount; ++oi) {
-            const WirePacket& pkt = packets[oi];
+        for (size_t oi = 0; oi < planCount; ++oi) {
+            const WirePacket& pkt = plan[oi];
             if (pkt.onMs == 0 || pkt.mask == 0) continue;
 
             if (targetedMode) {
@@ -1099,6 +1404,13 @@ void Device::StartLoop() {
                 }
             }
 
+            if (pkt.gapMs > 0 && !delayWithPowerWatch(pkt.gapMs)) {
+                if (!is12VPresent()) handle12VDrop();
+                else setState(DeviceState::Shutdown);
+                abortMixed = true;
+                break;
+            }
+
             PulseStats pulseStats{};
             if (!_runMaskedPulse(this, pkt.mask, pkt.onMs, ledFeedback, &pulseStats)) {
                 if (!is12VPresent()) handle12VDrop();
@@ -1113,9 +1425,13 @@ void Device::StartLoop() {
                     wirePresenceManager.updatePresenceFromMask(
                         *WIRE,
                         wireStateModel,
+                        wireConfigStore,
                         pulseStats.appliedMask,
                         pulseStats.busVoltage,
                         presenceCurrent);
+                updateWireResistanceEstimate(pulseStats.appliedMask,
+                                             pulseStats.pairVoltage,
+                                             pulseStats.pairCurrentAcs);
                 if (changed) {
                     checkAllowedOutputs();
                     if (!wirePresenceManager.hasAnyConnected(wireStateModel)) {
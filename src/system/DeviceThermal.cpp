@@ -135,6 +135,52 @@ float Device::wireResistanceAtTemp(uint8_t idx, float T) const {
     return ws.R0 * scale;
 }
 
+// ============================================================================
+// 3) Online cold-resistance refinement
+// ============================================================================
+//
+// Single-wire pulses with a measured (ACS) current are referred back to
+// ambient through the same tempco and filtered per wire. The bounded,
+// rate-limited result goes to HeaterManager (cache only, not NVS) and to
+// the scheduler's config copy; the thermal model picks it up on next init.
+// ============================================================================
+
+void Device::updateWireResistanceEstimate(uint16_t mask, float vBus, float iBusAcs) {
+    if (!WIRE) return;
+    if (mask == 0 || (mask & (mask - 1)) != 0) return; // single-wire pulses only
+    if (!isfinite(vBus) || !isfinite(iBusAcs)) return;
+
+    uint8_t index = 1;
+    while (!(mask & (1u << (index - 1)))) ++index;
+
+    const WireRuntimeState& rt = wireStateModel.wire(index);
+    if (!rt.present || rt.health >= static_cast<uint8_t>(WireHealth::Open)) return;
+
+    // Divider + charge path draws current alongside the wire.
+    const float gCharge = WIRE->getChargeConductance();
+    const float rLeak = DIVIDER_TOP_OHMS + DIVIDER_BOTTOM_OHMS +
+                        ((gCharge > 0.0f) ? (1.0f / gCharge) : 0.0f);
+    const float iWire = fabsf(iBusAcs) - vBus / rLeak;
+
+    const uint32_t now = millis();
+    wireResEstimator.update(index, vBus, iWire,
+                            WIRE->getWireEstimatedTemp(index), ambientC, now);
+
+    float ohms = NAN;
+    if (wireResEstimator.takePublish(index, now, ohms)) {
+        WIRE->applyResistanceEstimate(index, ohms);
+        wireConfigStore.applyResistanceEstimate(index, ohms);
+        const WireResistanceEstimator::Report rep = wireResEstimator.report(index);
+        DEBUG_PRINTF("[Thermal] R%u -> %.2f ohm (est %.2f +/- %.2f, conf %.2f, drift %.1f%%)\n",
+                     (unsigned)index,
+                     (double)ohms,
+                     (double)rep.estimateOhm,
+                     (double)rep.sigmaOhm,
+                     (double)rep.confidence,
+                     (double)(rep.driftFrac * 100.0f));
+    }
+}
+
 // ============================================================================
 // 4) Utility: derive active mask from HeaterManager, ignoring locked wires
 // ============================================================================
@@ -24,6 +24,7 @@ struct StatusSnapshot {
     double wireTemps[HeaterManager::kWireCount] = {0};      // virtual wire temps
     bool  outputs[HeaterManager::kWireCount]   = {false};   // output states
     bool  wirePresent[HeaterManager::kWireCount] = {false}; // presence flags
+    uint8_t wireHealth[HeaterManager::kWireCount] = {0};    // WireHealth codes
 
     bool  relayOn   = false;
     bool  acPresent = false;
@@ -50,7 +50,8 @@ static bool setupConfigOk() {
   }
 
   const int currentSource = CONF->GetInt(CURRENT_SOURCE_KEY, DEFAULT_CURRENT_SOURCE);
-  if (currentSource != CURRENT_SRC_ACS && currentSource != CURRENT_SRC_ESTIMATE) {
+  if (currentSource != CURRENT_SRC_ACS && currentSource != CURRENT_SRC_ESTIMATE &&
+      currentSource != CURRENT_SRC_FUSED) {
     return false;
   }
 
@@ -304,7 +305,7 @@ bool DeviceTransport::startCalibrationTask(uint32_t timeoutMs) {
         vTaskDelete(nullptr);
       },
       "CalibTask",
-      4096,
+      6144,  // dischargeCapBank(): the open-wire fit keeps ~1.5 KB on the stack
       reinterpret_cast<void*>(static_cast<uintptr_t>(timeoutMs)),
       1,
       &s_calTaskHandle);
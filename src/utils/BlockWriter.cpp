@@ -0,0 +1,61 @@
+#include <BlockWriter.hpp>
+
+#include <cstring>
+
+bool BlockWriter::drain_(const uint8_t* data, size_t len) {
+    if (len == 0) return true;
+    ++_sinkCalls;
+    const size_t n = _sink(_ctx, data, len);
+    _delivered += (n < len) ? n : len;
+    if (n < len) {
+        _error = Error::ShortWrite;
+        return false;
+    }
+    return true;
+}
+
+size_t BlockWriter::write(const uint8_t* data, size_t len) {
+    if (_error != Error::None || len == 0) return 0;
+    if (!data || !_block || _size == 0) {
+        _error = Error::Overflow;
+        return 0;
+    }
+
+    if (!_sink) {
+        // Memory sink: copy what fits, then latch.
+        const size_t room = _size - _used;
+        const size_t n = (len <= room) ? len : room;
+        memcpy(_block + _used, data, n);
+        _used += n;
+        if (n < len) _error = Error::Overflow;
+        return n;
+    }
+
+    size_t done = 0;
+    while (done < len) {
+        if (_used == 0 && len - done >= _size) {
+            // Whole blocks skip the staging copy.
+            const size_t n = len - done;
+            if (!drain_(data + done, n)) return done;
+            return len;
+        }
+        const size_t room = _size - _used;
+        const size_t n = (len - done <= room) ? len - done : room;
+        memcpy(_block + _used, data + done, n);
+        _used += n;
+        done += n;
+        if (_used == _size) {
+            _used = 0;
+            if (!drain_(_block, _size)) return done;
+        }
+    }
+    return len;
+}
+
+bool BlockWriter::flush() {
+    if (_error != Error::None) return false;
+    if (!_sink || _used == 0) return true;
+    const size_t n = _used;
+    _used = 0;
+    return drain_(_block, n);
+}
@@ -0,0 +1,68 @@
+#ifndef BLOCK_WRITER_HPP
+#define BLOCK_WRITER_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Collects small writes into a caller-owned block and hands the sink one
+ * block at a time.
+ *
+ * Two sink kinds:
+ *   stream   a callback (file, Print, socket); the block is a staging
+ *            buffer drained on full / flush(). A write at least one block
+ *            long with nothing staged goes straight to the sink.
+ *   memory   the block is the destination; nothing is drained and running
+ *            past its end is an overflow.
+ *
+ * Errors latch: a sink that takes fewer bytes than offered (partial write,
+ * full disk) or a memory overflow stops the writer, later writes return 0,
+ * and flush() returns false. delivered() counts the bytes the sink accepted,
+ * so a caller can tell how much of a file is valid.
+ */
+
+class BlockWriter {
+public:
+    // Returns the number of bytes taken (< len is an error).
+    using SinkFn = size_t (*)(void* ctx, const uint8_t* data, size_t len);
+
+    enum class Error : uint8_t { None, ShortWrite, Overflow };
+
+    BlockWriter(uint8_t* block, size_t blockSize, SinkFn sink, void* ctx)
+        : _block(block), _size(blockSize), _sink(sink), _ctx(ctx) {}
+
+    BlockWriter(uint8_t* mem, size_t cap)
+        : _block(mem), _size(cap) {}
+
+    // Buffers or forwards data; returns len, or fewer once an error latched.
+    size_t write(const uint8_t* data, size_t len);
+    size_t write(uint8_t b) { return write(&b, 1); }
+
+    // Drains the staged bytes (stream sink); true while no error latched.
+    bool flush();
+
+    bool ok() const { return _error == Error::None; }
+    Error error() const { return _error; }
+
+    size_t pending() const { return _used; }
+    size_t delivered() const { return _delivered; }
+    uint32_t sinkCalls() const { return _sinkCalls; }
+
+    // Memory sink: the encoded bytes so far.
+    const uint8_t* data() const { return _block; }
+    size_t size() const { return _used; }
+
+private:
+    bool drain_(const uint8_t* data, size_t len);
+
+    uint8_t* _block;
+    size_t   _size;
+    SinkFn   _sink = nullptr;
+    void*    _ctx = nullptr;
+    size_t   _used = 0;
+    size_t   _delivered = 0;
+    uint32_t _sinkCalls = 0;
+    Error    _error = Error::None;
+};
+
+#endif // BLOCK_WRITER_HPP
@@ -0,0 +1,210 @@
+#include <CborNumber.hpp>
+
+#include <cmath>
+#include <cstring>
+
+namespace CborNumber {
+
+namespace {
+
+size_t intLen(int64_t v) {
+    const uint64_t n = (v >= 0) ? static_cast<uint64_t>(v) : static_cast<uint64_t>(-1 - v);
+    if (n < 24) return 1;
+    if (n <= 0xFFu) return 2;
+    if (n <= 0xFFFFu) return 3;
+    if (n <= 0xFFFFFFFFu) return 5;
+    return 9;
+}
+
+size_t formLen(const Choice& c) {
+    switch (c.form) {
+        case Form::Int:    return intLen(c.i);
+        case Form::Half:   return 3;
+        case Form::Single: return 5;
+        default:           return 9;
+    }
+}
+
+void putBE(uint8_t* p, uint64_t v, size_t bytes) {
+    for (size_t k = 0; k < bytes; ++k) {
+        p[k] = static_cast<uint8_t>(v >> (8 * (bytes - 1 - k)));
+    }
+}
+
+uint64_t getBE(const uint8_t* p, size_t bytes) {
+    uint64_t v = 0;
+    for (size_t k = 0; k < bytes; ++k) v = (v << 8) | p[k];
+    return v;
+}
+
+} // namespace
+
+uint16_t floatToHalf(float v) {
+    uint32_t x;
+    memcpy(&x, &v, sizeof(x));
+    const uint16_t sign = static_cast<uint16_t>((x >> 16) & 0x8000u);
+    const uint32_t a = x & 0x7FFFFFFFu;
+
+    if (a >= 0x7F800000u) {                       // Inf / NaN (quiet)
+        return static_cast<uint16_t>(sign | 0x7C00u | (a > 0x7F800000u ? 0x0200u : 0u));
+    }
+    if (a >= 0x477FF000u) return static_cast<uint16_t>(sign | 0x7C00u);  // >= 65520 -> Inf
+    if (a <= 0x33000000u) return sign;            // <= 2^-25 -> 0 (tie goes to even)
+
+    const uint32_t exp = a >> 23;
+    if (exp < 113) {
+        // Half subnormal: m * 2^-24.
+        const uint32_t mant  = (a & 0x7FFFFFu) | 0x800000u;
+        const uint32_t shift = 126u - exp;        // 14..24
+        uint32_t m = mant >> shift;
+        const uint32_t rem  = mant & ((1u << shift) - 1u);
+        const uint32_t half = 1u << (shift - 1u);
+        if (rem > half || (rem == half && (m & 1u))) ++m;
+        return static_cast<uint16_t>(sign | m);
+    }
+
+    // Normal; a mantissa carry rolls into the exponent, as it should.
+    uint32_t h = ((exp - 112u) << 10) | ((a >> 13) & 0x3FFu);
+    const uint32_t rem = a & 0x1FFFu;
+    if (rem > 0x1000u || (rem == 0x1000u && (h & 1u))) ++h;
+    return static_cast<uint16_t>(sign | h);
+}
+
+float halfToFloat(uint16_t h) {
+    const uint32_t exp = (h >> 10) & 0x1Fu;
+    const uint32_t m   = h & 0x3FFu;
+    float v;
+    if (exp == 0) {
+        v = std::ldexp(static_cast<float>(m), -24);
+    } else if (exp == 31) {
+        v = m ? NAN : INFINITY;
+    } else {
+        v = std::ldexp(static_cast<float>(m | 0x400u), static_cast<int>(exp) - 25);
+    }
+    return (h & 0x8000u) ? -v : v;
+}
+
+Choice choose(double value, Resolution res) {
+    Choice best{Form::Double, 0, 0, 0.0f};
+    if (!std::isfinite(value)) {
+        best.form = Form::Half;
+        best.half = floatToHalf(static_cast<float>(value));
+        return best;
+    }
+
+    const double tol = std::fmax(static_cast<double>(res.abs),
+                                 static_cast<double>(res.rel) * std::fabs(value));
+    size_t bestLen = 9;
+
+    // Candidates in preference order; a later one must be strictly shorter.
+    if (std::fabs(value) <= 9007199254740992.0) {      // 2^53: exact in double
+        const double r = std::round(value);
+        if (std::fabs(r - value) <= tol) {
+            Choice c{Form::Int, static_cast<int64_t>(r), 0, 0.0f};
+            const size_t len = formLen(c);
+            if (len < bestLen) {
+                best = c;
+                bestLen = len;
+            }
+        }
+    }
+
+    const uint16_t h = floatToHalf(static_cast<float>(value));
+    if (bestLen > 3 && std::fabs(static_cast<double>(halfToFloat(h)) - value) <= tol) {
+        best = Choice{Form::Half, 0, h, 0.0f};
+        bestLen = 3;
+    }
+
+    const float f = static_cast<float>(value);
+    if (bestLen > 5 && std::isfinite(f) && std::fabs(static_cast<double>(f) - value) <= tol) {
+        best = Choice{Form::Single, 0, 0, f};
+    }
+    return best;
+}
+
+size_t encode(double value, Resolution res, uint8_t* out) {
+    const Choice c = choose(value, res);
+    switch (c.form) {
+        case Form::Int: {
+            const uint8_t major = (c.i >= 0) ? 0x00 : 0x20;
+            const uint64_t n = (c.i >= 0) ? static_cast<uint64_t>(c.i)
+                                          : static_cast<uint64_t>(-1 - c.i);
+            const size_t len = intLen(c.i);
+            if (len == 1) {
+                out[0] = static_cast<uint8_t>(major | n);
+                return 1;
+            }
+            out[0] = static_cast<uint8_t>(major | (len == 2 ? 24 : len == 3 ? 25 : len == 5 ? 26 : 27));
+            putBE(out + 1, n, len - 1);
+            return len;
+        }
+        case Form::Half:
+            out[0] = 0xF9;
+            putBE(out + 1, c.half, 2);
+            return 3;
+        case Form::Single: {
+            uint32_t bits;
+            memcpy(&bits, &c.f, sizeof(bits));
+            out[0] = 0xFA;
+            putBE(out + 1, bits, 4);
+            return 5;
+        }
+        default: {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            out[0] = 0xFB;
+            putBE(out + 1, bits, 8);
+            return 9;
+        }
+    }
+}
+
+size_t decode(const uint8_t* data, size_t len, double& value) {
+    if (!data || len == 0) return 0;
+    const uint8_t ib = data[0];
+    const uint8_t major = ib >> 5;
+    const uint8_t ai = ib & 0x1F;
+
+    if (major == 0 || major == 1) {
+        uint64_t n;
+        size_t used;
+        if (ai < 24) {
+            n = ai;
+            used = 1;
+        } else if (ai <= 27) {
+            const size_t bytes = static_cast<size_t>(1) << (ai - 24);
+            if (len < 1 + bytes) return 0;
+            n = getBE(data + 1, bytes);
+            used = 1 + bytes;
+        } else {
+            return 0;
+        }
+        value = (major == 0) ? static_cast<double>(n) : -1.0 - static_cast<double>(n);
+        return used;
+    }
+
+    switch (ib) {
+        case 0xF9:
+            if (len < 3) return 0;
+            value = halfToFloat(static_cast<uint16_t>(getBE(data + 1, 2)));
+            return 3;
+        case 0xFA: {
+            if (len < 5) return 0;
+            const uint32_t bits = static_cast<uint32_t>(getBE(data + 1, 4));
+            float f;
+            memcpy(&f, &bits, sizeof(f));
+            value = f;
+            return 5;
+        }
+        case 0xFB: {
+            if (len < 9) return 0;
+            const uint64_t bits = getBE(data + 1, 8);
+            memcpy(&value, &bits, sizeof(value));
+            return 9;
+        }
+        default:
+            return 0;
+    }
+}
+
+} // namespace CborNumber
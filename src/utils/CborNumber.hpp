@@ -0,0 +1,71 @@
+#ifndef CBOR_NUMBER_HPP
+#define CBOR_NUMBER_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Shortest CBOR form for a measured value.
+ *
+ * Each field declares the error it can tolerate (Resolution). The encoder
+ * tries integer, float16, float32 and float64 and emits the shortest
+ * form whose decoded value stays within that error:
+ *   integer   1..9 bytes (whole values, counts, 0.0 when idle)
+ *   float16   3 bytes, 11-bit mantissa (temperatures, small currents)
+ *   float32   5 bytes (bus voltages, energies)
+ *   float64   9 bytes (only when nothing shorter is close enough)
+ * kExact keeps every value bit-exact, so any float-typed source lands in
+ * float32 or shorter without loss.
+ *
+ * Non-finite values are the caller's decision (null or omitted); encode()
+ * writes them as float16 NaN/Inf, which every form represents exactly.
+ *
+ * Shared by CborStream (file writers) and WiFiCbor (tinycbor payloads).
+ */
+
+namespace CborNumber {
+
+// Allowed |decoded - value|: max(abs, rel * |value|).
+struct Resolution {
+    float abs;
+    float rel;
+};
+
+constexpr Resolution kExact       {0.0f,    0.0f};
+constexpr Resolution kVoltage     {0.005f,  0.0f};   // bus / cap [V], 10 mV steps
+constexpr Resolution kSenseVoltage{0.0005f, 0.0f};   // ADC node [V], 1 mV steps
+constexpr Resolution kCurrent     {0.0005f, 0.0f};   // [A], 1 mA steps
+constexpr Resolution kTemperature {0.05f,   0.0f};   // [C], 0.1 C steps
+constexpr Resolution kPower       {0.05f,   0.0f};   // [W], 0.1 W steps
+constexpr Resolution kEnergy      {0.0005f, 0.0f};   // [Wh], 1 mWh steps
+constexpr Resolution kResistance  {0.0f,    5e-4f};  // [ohm], 0.1 % relative
+constexpr Resolution kPercent     {0.05f,   0.0f};   // [%], 0.1 % steps
+
+enum class Form : uint8_t { Int, Half, Single, Double };
+
+struct Choice {
+    Form     form;
+    int64_t  i;     // Form::Int
+    uint16_t half;  // Form::Half
+    float    f;     // Form::Single
+};
+
+constexpr size_t kMaxBytes = 9;
+
+// IEEE 754 binary16 <-> binary32, round to nearest even.
+uint16_t floatToHalf(float v);
+float halfToFloat(uint16_t h);
+
+// Shortest acceptable form for value under res.
+Choice choose(double value, Resolution res);
+
+// Encodes the chosen form into out (kMaxBytes); returns the length.
+size_t encode(double value, Resolution res, uint8_t* out);
+
+// Reference decoder for one numeric item (int, float16/32/64).
+// Returns the bytes consumed, or 0 if data does not start with a number.
+size_t decode(const uint8_t* data, size_t len, double& value);
+
+} // namespace CborNumber
+
+#endif // CBOR_NUMBER_HPP
@@ -6,8 +6,47 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <CborNumber.hpp>
+#include <BlockWriter.hpp>
+
+#ifndef CBOR_STREAM_BLOCK
+#define CBOR_STREAM_BLOCK 512
+#endif
+
 namespace CborStream {
 
+// Print adapter over BlockWriter: the writers below stay byte-oriented,
+// the target (SPIFFS File, response) sees one write per block.
+//   uint8_t block[CBOR_STREAM_BLOCK];
+//   CborStream::BufferedPrint out(file, block, sizeof(block));
+//   ok = ok && CborStream::writeMapHeader(out, 1) ...;
+//   ok = out.finish() && ok;
+// finish() must run before the target is closed.
+class BufferedPrint : public Print {
+public:
+    BufferedPrint(Print& target, uint8_t* block, size_t blockSize)
+        : _w(block, blockSize, &BufferedPrint::sink_, &target) {}
+
+    // Memory sink: encode straight into mem (no target).
+    BufferedPrint(uint8_t* mem, size_t cap) : _w(mem, cap) {}
+
+    size_t write(uint8_t b) override { return _w.write(b); }
+    size_t write(const uint8_t* data, size_t len) override { return _w.write(data, len); }
+    void flush() override { _w.flush(); }
+
+    // Drains the last partial block; false if any write fell short.
+    bool finish() { return _w.flush(); }
+
+    const BlockWriter& writer() const { return _w; }
+
+private:
+    static size_t sink_(void* ctx, const uint8_t* data, size_t len) {
+        return static_cast<Print*>(ctx)->write(data, len);
+    }
+
+    BlockWriter _w;
+};
+
 inline bool writeByte(Print& out, uint8_t value) {
     return out.write(&value, 1) == 1;
 }
@@ -72,11 +111,20 @@ inline bool writeDouble(Print& out, double value) {
     return writeUintBE(out, conv.u, 8);
 }
 
-inline bool writeFloatOrNull(Print& out, double value) {
+// Shortest form within res (int / float16 / float32 / float64).
+inline bool writeNumber(Print& out, double value,
+                        CborNumber::Resolution res = CborNumber::kExact) {
+    uint8_t buf[CborNumber::kMaxBytes];
+    const size_t len = CborNumber::encode(value, res, buf);
+    return out.write(buf, len) == len;
+}
+
+inline bool writeFloatOrNull(Print& out, double value,
+                             CborNumber::Resolution res = CborNumber::kExact) {
     if (!isfinite(value)) {
         return writeNull(out);
     }
-    return writeDouble(out, value);
+    return writeNumber(out, value, res);
 }
 
 inline bool writeText(Print& out, const char* text) {
@@ -0,0 +1,67 @@
+#include <Decimator.hpp>
+
+#include <cmath>
+
+float Decimator::Bucket::mean(uint8_t field) const {
+    if (field >= kMaxFields || count[field] == 0) return NAN;
+    return static_cast<float>(sum[field] / count[field]);
+}
+
+Decimator::Decimator(uint32_t x0, uint32_t x1, uint16_t width, uint8_t fields)
+    : _x0(x0),
+      _span((x1 >= x0) ? (x1 - x0 + 1u) : 1u),
+      _width(width == 0 ? 1 : (width > kMaxWidth ? kMaxWidth : width)),
+      _fields(fields > kMaxFields ? kMaxFields : fields) {}
+
+uint16_t Decimator::bucketOf(uint32_t x) const {
+    const uint64_t span = _span ? _span : (1ULL << 32);
+    const uint64_t k = static_cast<uint64_t>(x - _x0) * _width / span;
+    return static_cast<uint16_t>(k < _width ? k : _width - 1);
+}
+
+void Decimator::open_(uint16_t index, uint32_t x) {
+    _cur.index  = index;
+    _cur.xFirst = x;
+    _cur.xLast  = x;
+    _cur.n      = 0;
+    for (uint8_t f = 0; f < _fields; ++f) {
+        _cur.min[f]   = INFINITY;
+        _cur.max[f]   = -INFINITY;
+        _cur.sum[f]   = 0.0;
+        _cur.count[f] = 0;
+    }
+    _open = true;
+}
+
+bool Decimator::add(uint32_t x, const float* values) {
+    if (!values || x < _x0 || (_span && x - _x0 >= _span)) return false;
+    const uint16_t k = bucketOf(x);
+
+    bool closed = false;
+    if (_open && k != _cur.index) {
+        if (k < _cur.index) return false;
+        _ready = _cur;
+        closed = true;
+        _open = false;
+    }
+    if (!_open) open_(k, x);
+
+    _cur.xLast = x;
+    ++_cur.n;
+    for (uint8_t f = 0; f < _fields; ++f) {
+        const float v = values[f];
+        if (!std::isfinite(v)) continue;
+        if (v < _cur.min[f]) _cur.min[f] = v;
+        if (v > _cur.max[f]) _cur.max[f] = v;
+        _cur.sum[f] += v;
+        ++_cur.count[f];
+    }
+    return closed;
+}
+
+bool Decimator::finish() {
+    if (!_open) return false;
+    _ready = _cur;
+    _open = false;
+    return true;
+}
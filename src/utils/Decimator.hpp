@@ -0,0 +1,73 @@
+#ifndef DECIMATOR_HPP
+#define DECIMATOR_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#ifndef DECIMATOR_MAX_FIELDS
+#define DECIMATOR_MAX_FIELDS 6
+#endif
+
+/**
+ * Streaming min / max / mean decimation for plots.
+ *
+ * The x range [x0, x1] is split into `width` equal buckets (one per plot
+ * pixel column). Samples arrive in non-decreasing x; each one is folded
+ * into the open bucket, and the bucket is handed out as soon as a sample
+ * lands past it, so memory stays at two buckets however many samples
+ * pass through. Buckets nobody landed in are never emitted.
+ *
+ * Per field the bucket keeps min and max (spikes survive any width) and
+ * the mean. Non-finite values are skipped per field; a field with no
+ * finite value in a bucket reports count 0.
+ *
+ * Host check: tools/page_cursor_check.cpp.
+ */
+
+class Decimator {
+public:
+    static constexpr uint8_t  kMaxFields = DECIMATOR_MAX_FIELDS;
+    static constexpr uint16_t kMaxWidth  = 1024;
+
+    struct Bucket {
+        uint16_t index  = 0;
+        uint32_t xFirst = 0;   // x of the first / last sample in it
+        uint32_t xLast  = 0;
+        uint32_t n      = 0;   // samples, finite or not
+        float    min[kMaxFields];
+        float    max[kMaxFields];
+        double   sum[kMaxFields];
+        uint32_t count[kMaxFields];
+
+        float mean(uint8_t field) const;
+    };
+
+    // width is clamped to 1..kMaxWidth and fields to kMaxFields.
+    Decimator(uint32_t x0, uint32_t x1, uint16_t width, uint8_t fields);
+
+    // values holds fields() floats. Samples outside [x0, x1] or behind
+    // the open bucket are ignored. True when the sample closed a bucket;
+    // read it from ready() before the next add().
+    bool add(uint32_t x, const float* values);
+
+    // Closes the last open bucket; true if there was one.
+    bool finish();
+
+    const Bucket& ready() const { return _ready; }
+    uint8_t fields() const { return _fields; }
+    uint16_t width() const { return _width; }
+    uint16_t bucketOf(uint32_t x) const;
+
+private:
+    void open_(uint16_t index, uint32_t x);
+
+    uint32_t _x0;
+    uint32_t _span;   // x1 - x0 + 1 (0 = the full 2^32 range)
+    uint16_t _width;
+    uint8_t  _fields;
+    bool     _open = false;
+    Bucket   _cur;
+    Bucket   _ready;
+};
+
+#endif // DECIMATOR_HPP
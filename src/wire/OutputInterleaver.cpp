@@ -0,0 +1,85 @@
+#include <OutputInterleaver.hpp>
+
+namespace {
+// Share s (0-based) of `total` split into k integer parts, remainder first.
+uint16_t share(uint32_t total, uint8_t k, uint8_t s) {
+  const uint32_t base = total / k;
+  const uint32_t rem = total % k;
+  return static_cast<uint16_t>(base + ((s < rem) ? 1u : 0u));
+}
+} // namespace
+
+uint8_t OutputInterleaver::chooseSubPulses(const WirePacket* in, size_t count,
+                                           const Limits& lim, size_t maxOut) {
+  if (!in || count == 0 || lim.frameMs == 0) return 1;
+
+  size_t active = 0;
+  uint32_t sumOn = 0;
+  uint16_t minOn = UINT16_MAX;
+  uint16_t maxOn = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (in[i].mask == 0 || in[i].onMs == 0) continue;
+    active++;
+    sumOn += in[i].onMs;
+    if (in[i].onMs < minOn) minOn = in[i].onMs;
+    if (in[i].onMs > maxOn) maxOn = in[i].onMs;
+  }
+  if (active == 0 || sumOn > lim.frameMs) return 1;
+
+  const uint16_t minSub = (lim.minSubOnMs > 0) ? lim.minSubOnMs : 1;
+  uint8_t k = (lim.maxSubPulses > 0) ? lim.maxSubPulses : 1;
+  for (; k > 1; --k) {
+    if (active * k > maxOut) continue;
+    if (minOn / k < minSub) continue;
+    // Each pin's off-time between its own sub-pulses.
+    const uint32_t offMs = lim.frameMs - maxOn;
+    if (offMs / k < lim.minEdgeSpacingMs) continue;
+    break;
+  }
+  return k;
+}
+
+size_t OutputInterleaver::interleave(const WirePacket* in, size_t count, const Limits& lim,
+                                     WirePacket* out, size_t maxOut) {
+  if (!in || !out || count == 0 || maxOut == 0) return 0;
+
+  // Compact the active packets (order = scheduler order).
+  WirePacket act[16];
+  size_t n = 0;
+  uint32_t sumOn = 0;
+  for (size_t i = 0; i < count && n < 16; ++i) {
+    if (in[i].mask == 0 || in[i].onMs == 0) continue;
+    act[n] = in[i];
+    act[n].gapMs = 0;
+    sumOn += in[i].onMs;
+    n++;
+  }
+  if (n == 0) return 0;
+
+  const uint8_t k = chooseSubPulses(act, n, lim, maxOut);
+  if (k <= 1) {
+    const size_t m = (n < maxOut) ? n : maxOut;
+    for (size_t i = 0; i < m; ++i) out[i] = act[i];
+    return m;
+  }
+
+  // Idle spread over the k-1 boundaries between sub-periods; the last
+  // share stays at the frame tail (the loop's end-of-frame wait).
+  const uint32_t idle = (lim.frameMs > sumOn) ? (lim.frameMs - sumOn) : 0;
+
+  size_t o = 0;
+  for (uint8_t s = 0; s < k; ++s) {
+    // Rotate the starting wire; with two wires a rotation would put the
+    // same wire at both ends of a boundary and merge its sub-pulses.
+    const size_t shift = (n > 2) ? s : 0;
+    for (size_t j = 0; j < n; ++j) {
+      const size_t w = (j + shift) % n;
+      WirePacket p;
+      p.mask = act[w].mask;
+      p.onMs = share(act[w].onMs, k, s);
+      p.gapMs = (j == 0 && s > 0) ? share(idle, k, static_cast<uint8_t>(s - 1)) : 0;
+      out[o++] = p;
+    }
+  }
+  return o;
+}
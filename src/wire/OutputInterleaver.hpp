@@ -0,0 +1,54 @@
+#ifndef OUTPUT_INTERLEAVER_HPP
+#define OUTPUT_INTERLEAVER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <WireScheduler.hpp>
+
+/**
+ * Phase-staggered interleaving of one frame's packets.
+ *
+ * The scheduler emits one block per wire, fired back-to-back, followed by
+ * one long idle stretch. The interleaver splits every wire's on-time into
+ * k equal sub-pulses and tiles the frame with k sub-periods: each
+ * sub-period runs one sub-pulse per wire (still one output at a time), the
+ * starting wire rotates by one per sub-period (phase shift), and the idle
+ * time is spread as gaps between sub-periods. Per-wire on-time is
+ * preserved exactly; the load step repeats k times faster, so the bank
+ * and the charge path see ~k times less low-frequency ripple.
+ *
+ * k is the largest value that keeps every sub-pulse >= minSubOnMs, every
+ * pin's off-time between its own sub-pulses >= minEdgeSpacingMs (GPIO
+ * switching limit), and the packet count within maxOut.
+ */
+
+#ifndef OUTPUT_INTERLEAVE_MAX_SUBPULSES
+#define OUTPUT_INTERLEAVE_MAX_SUBPULSES   4
+#endif
+#ifndef OUTPUT_INTERLEAVE_MIN_SUB_MS
+#define OUTPUT_INTERLEAVE_MIN_SUB_MS      20   // keeps pulse current measurable
+#endif
+#ifndef OUTPUT_INTERLEAVE_MIN_EDGE_MS
+#define OUTPUT_INTERLEAVE_MIN_EDGE_MS     5    // min time between edges on one pin
+#endif
+
+class OutputInterleaver {
+public:
+  struct Limits {
+    uint16_t frameMs = 0;
+    uint16_t minSubOnMs = OUTPUT_INTERLEAVE_MIN_SUB_MS;
+    uint16_t minEdgeSpacingMs = OUTPUT_INTERLEAVE_MIN_EDGE_MS;
+    uint8_t maxSubPulses = OUTPUT_INTERLEAVE_MAX_SUBPULSES;
+  };
+
+  // Sub-pulse count the limits allow for this frame (1 = keep sequential).
+  static uint8_t chooseSubPulses(const WirePacket* in, size_t count, const Limits& lim,
+                                 size_t maxOut);
+
+  // Writes the interleaved plan to out (gapMs carries the spread idle).
+  // Falls back to a plain copy when k == 1. Returns the packet count.
+  static size_t interleave(const WirePacket* in, size_t count, const Limits& lim,
+                           WirePacket* out, size_t maxOut);
+};
+
+#endif // OUTPUT_INTERLEAVER_HPP
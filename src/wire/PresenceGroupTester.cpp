@@ -0,0 +1,184 @@
+#include <PresenceGroupTester.hpp>
+
+#include <math.h>
+
+struct PresenceGroupTester::Ctx {
+  const float* g;
+  float vNominal;
+  Config cfg;
+  ProbeFn probe;
+  void* probeCtx;
+  Result res;
+};
+
+namespace {
+uint8_t popcount10(uint16_t m) {
+  uint8_t n = 0;
+  for (; m; m &= static_cast<uint16_t>(m - 1)) ++n;
+  return n;
+}
+
+// Lower half (by member count) of the set bits in `mask`.
+uint16_t lowerHalf(uint16_t mask) {
+  const uint8_t want = popcount10(mask) / 2;
+  uint16_t out = 0;
+  uint8_t taken = 0;
+  for (uint8_t i = 0; i < PresenceGroupTester::kWireCount && taken < want; ++i) {
+    const uint16_t bit = static_cast<uint16_t>(1u << i);
+    if (mask & bit) {
+      out |= bit;
+      ++taken;
+    }
+  }
+  return out;
+}
+
+bool validSample(float v, float i, float minBusV) {
+  return isfinite(v) && v > minBusV && isfinite(i);
+}
+} // namespace
+
+PresenceGroupTester::Result PresenceGroupTester::run(uint16_t eligibleMask,
+                                                     const float g[kWireCount],
+                                                     const float* gCal,
+                                                     float vNominal,
+                                                     const Config& cfg,
+                                                     ProbeFn probe,
+                                                     void* ctx) const {
+  Ctx c{g, vNominal, cfg, probe, ctx, Result{}};
+  eligibleMask &= static_cast<uint16_t>((1u << kWireCount) - 1u);
+  if (!probe || !g || eligibleMask == 0) {
+    return c.res;
+  }
+
+  if (!validSample(vNominal, 0.0f, cfg.minBusV)) {
+    // No usable bus estimate to size groups: plain sequential probe.
+    for (uint8_t i = 0; i < kWireCount; ++i) {
+      if (eligibleMask & (1u << i)) testSingle_(c, i);
+    }
+    return c.res;
+  }
+
+  // Drifted wires are outside the headroom the group band assumes.
+  if (gCal) {
+    for (uint8_t i = 0; i < kWireCount; ++i) {
+      const uint16_t bit = static_cast<uint16_t>(1u << i);
+      if (!(eligibleMask & bit)) continue;
+      if (!isfinite(gCal[i]) || gCal[i] <= 0.0f) continue;
+      if (fabsf(g[i] / gCal[i] - 1.0f) > cfg.driftFrac) {
+        testSingle_(c, i);
+        eligibleMask &= static_cast<uint16_t>(~bit);
+      }
+    }
+  }
+
+  testGroup_(c, eligibleMask);
+  return c.res;
+}
+
+float PresenceGroupTester::groupConductance_(const Ctx& c, uint16_t mask, float* gMin) {
+  float sum = 0.0f;
+  float lo = INFINITY;
+  for (uint8_t i = 0; i < kWireCount; ++i) {
+    if (!(mask & (1u << i))) continue;
+    const float gi = c.g[i];
+    if (!isfinite(gi) || gi <= 0.0f) {
+      if (gMin) *gMin = 0.0f;
+      return 0.0f;
+    }
+    sum += gi;
+    if (gi < lo) lo = gi;
+  }
+  if (gMin) *gMin = lo;
+  return sum;
+}
+
+void PresenceGroupTester::testSingle_(Ctx& c, uint8_t bit) {
+  const uint16_t m = static_cast<uint16_t>(1u << bit);
+  float vBus = NAN;
+  float iBus = NAN;
+  const bool ok = c.probe(c.probeCtx, m, vBus, iBus);
+  if (c.res.probes < 255) c.res.probes++;
+  c.res.decidedMask |= m;
+
+  if (!ok || !validSample(vBus, iBus, c.cfg.minBusV)) return;
+
+  const float iExpected = vBus * c.g[bit];
+  if (!isfinite(iExpected) || iExpected <= 0.0f) return;
+
+  float iWire = fabsf(iBus) - vBus * c.cfg.leakConductanceS;
+  if (iWire < 0.0f) iWire = 0.0f;
+  const float ratio = iWire / iExpected;
+  if (isfinite(ratio) && ratio >= c.cfg.minRatio) {
+    c.res.presentMask |= m;
+  }
+}
+
+void PresenceGroupTester::testGroup_(Ctx& c, uint16_t mask) {
+  const uint8_t n = popcount10(mask);
+  if (n == 0) return;
+  if (n == 1) {
+    for (uint8_t i = 0; i < kWireCount; ++i) {
+      if (mask & (1u << i)) testSingle_(c, i);
+    }
+    return;
+  }
+
+  const uint16_t lo = lowerHalf(mask);
+  const uint16_t hi = static_cast<uint16_t>(mask & ~lo);
+
+  float gMin = 0.0f;
+  const float gSum = groupConductance_(c, mask, &gMin);
+
+  // Acceptance band: a single member at minRatio must land below it even
+  // with every other member at its headroom, so the band scales with what
+  // the weakest member's drop leaves after that compensation.
+  const float swing = 1.0f - c.cfg.minRatio;
+  const float head = (c.cfg.headroomFrac > 0.0f) ? c.cfg.headroomFrac : 0.0f;
+  const float hidden = (swing + head) * gMin - head * gSum;
+  const float marginRel = (gSum > 0.0f && hidden > 0.0f) ? (c.cfg.marginFrac * hidden / gSum)
+                                                         : 0.0f;
+  const float expectA = c.vNominal * gSum;
+  const bool resolvable = (marginRel > 0.0f) && (marginRel * expectA >= c.cfg.noiseA);
+  const bool withinCap = (c.cfg.maxGroupCurrentA <= 0.0f) || (expectA <= c.cfg.maxGroupCurrentA);
+  if (!resolvable || !withinCap) {
+    testGroup_(c, lo);
+    testGroup_(c, hi);
+    return;
+  }
+
+  float vBus = NAN;
+  float iBus = NAN;
+  const bool ok = c.probe(c.probeCtx, mask, vBus, iBus);
+  if (c.res.probes < 255) c.res.probes++;
+  if (c.res.groupProbes < 255) c.res.groupProbes++;
+
+  if (!ok || !validSample(vBus, iBus, c.cfg.minBusV)) {
+    // Bus not usable under load: bisecting would only repeat the failure,
+    // decide each member on its own like the sequential probe.
+    for (uint8_t i = 0; i < kWireCount; ++i) {
+      if (mask & (1u << i)) testSingle_(c, i);
+    }
+    return;
+  }
+
+  float iWire = fabsf(iBus) - vBus * c.cfg.leakConductanceS;
+  if (iWire < 0.0f) iWire = 0.0f;
+  const float ratio = iWire / (vBus * gSum);
+  // Above the band is bisected too: excess current from one member could
+  // be covering for another.
+  if (isfinite(ratio) && fabsf(ratio - 1.0f) <= marginRel) {
+    c.res.presentMask |= mask;
+    c.res.decidedMask |= mask;
+    return;
+  }
+  // Currents only add: if the whole group draws less than the weakest member
+  // needs on its own, no member can pass (noise kept on the safe side).
+  if (isfinite(iWire) && (iWire + c.cfg.noiseA) < c.cfg.minRatio * vBus * gMin) {
+    c.res.decidedMask |= mask;
+    return;
+  }
+
+  testGroup_(c, lo);
+  testGroup_(c, hi);
+}
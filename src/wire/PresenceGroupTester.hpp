@@ -0,0 +1,81 @@
+#ifndef PRESENCE_GROUP_TESTER_HPP
+#define PRESENCE_GROUP_TESTER_HPP
+
+#include <cstdint>
+
+/**
+ * Adaptive group-testing planner for the wire presence probe.
+ *
+ * Instead of energizing each wire on its own, combined masks are probed and
+ * the measured wire current (net of the divider/charge leak) is compared to
+ * V * sum(G). A group is accepted only when its ratio lies inside a margin
+ * that is too narrow to hide a single member below minRatio, even when
+ * every other member draws up to headroomFrac above its stored
+ * conductance (a low-R wire cannot mask an open one); a ratio outside the
+ * band on either side is bisected, and a group drawing less than its
+ * weakest member needs alone is rejected whole. A wire whose stored
+ * conductance has drifted more than driftFrac from its calibrated value
+ * is not trusted to stay inside that headroom and is probed on its own.
+ * Single wires are decided with exactly the sequential rule
+ * (finite V above minBusV, ratio >= minRatio), so the reported presence
+ * matches the per-wire probe whenever each healthy wire is within the group
+ * margin of its nominal conductance.
+ */
+
+#ifndef PRESENCE_GROUP_MARGIN_FRAC
+#define PRESENCE_GROUP_MARGIN_FRAC   0.5f   // share of the smallest member's (1-minRatio) swing
+#endif
+#ifndef PRESENCE_GROUP_NOISE_A
+#define PRESENCE_GROUP_NOISE_A       0.15f  // group margin below this is not resolvable [A]
+#endif
+#ifndef PRESENCE_GROUP_HEADROOM_FRAC
+#define PRESENCE_GROUP_HEADROOM_FRAC 0.10f  // a healthy member draws at most this over its G
+#endif
+#ifndef PRESENCE_GROUP_DRIFT_FRAC
+#define PRESENCE_GROUP_DRIFT_FRAC    0.10f  // |G/Gcal - 1| above this: probe alone
+#endif
+#ifndef PRESENCE_GROUP_LIMIT_FRAC
+#define PRESENCE_GROUP_LIMIT_FRAC    0.70f  // max expected group current vs current limit
+#endif
+
+class PresenceGroupTester {
+public:
+  static constexpr uint8_t kWireCount = 10;
+
+  // Energize `mask`, settle, average, de-energize. Returns false when the
+  // probe could not run at all (treated like a non-finite sample).
+  using ProbeFn = bool (*)(void* ctx, uint16_t mask, float& vBus, float& iBus);
+
+  struct Config {
+    float minRatio = 0.5f;                 ///< Imeas/Iexp presence threshold
+    float minBusV = 5.0f;                  ///< below this a probe is invalid
+    float leakConductanceS = 0.0f;         ///< divider + charge path [S]
+    float maxGroupCurrentA = 0.0f;         ///< 0 = no cap
+    float noiseA = PRESENCE_GROUP_NOISE_A;
+    float marginFrac = PRESENCE_GROUP_MARGIN_FRAC;
+    float headroomFrac = PRESENCE_GROUP_HEADROOM_FRAC;
+    float driftFrac = PRESENCE_GROUP_DRIFT_FRAC;
+  };
+
+  struct Result {
+    uint16_t presentMask = 0;
+    uint16_t decidedMask = 0;
+    uint8_t probes = 0;
+    uint8_t groupProbes = 0;   ///< probes of more than one wire
+  };
+
+  // g[i]: nominal conductance of wire i+1 (<= 0 => cannot be present).
+  // gCal[i]: its calibrated conductance (nullptr = no drift check).
+  // vNominal: idle bus voltage used to size groups before the first probe;
+  // non-finite or too low falls back to one probe per wire.
+  Result run(uint16_t eligibleMask, const float g[kWireCount], const float* gCal,
+             float vNominal, const Config& cfg, ProbeFn probe, void* ctx) const;
+
+private:
+  struct Ctx;
+  static void testGroup_(Ctx& c, uint16_t mask);
+  static void testSingle_(Ctx& c, uint8_t bit);
+  static float groupConductance_(const Ctx& c, uint16_t mask, float* gMin);
+};
+
+#endif // PRESENCE_GROUP_TESTER_HPP
@@ -0,0 +1,82 @@
+#include <SoftStartRamp.hpp>
+
+#include <math.h>
+
+void SoftStartRamp::begin(const Config& cfg, uint32_t nowMs) {
+  _cfg = cfg;
+  if (!isfinite(_cfg.startFrac) || _cfg.startFrac < 0.0f) _cfg.startFrac = 0.0f;
+  if (_cfg.startFrac > 1.0f) _cfg.startFrac = 1.0f;
+  if (!isfinite(_cfg.peakLimitA) || _cfg.peakLimitA < 0.0f) _cfg.peakLimitA = 0.0f;
+  _startMs = nowMs;
+  for (size_t i = 0; i < kCreditSlots; ++i) _creditMs[i] = 0.0f;
+  _active = (_cfg.rampMs > 0) && (_cfg.startFrac < 1.0f);
+}
+
+SoftStartRamp::Step SoftStartRamp::step(uint32_t nowMs, float coldestRiseC) {
+  Step s;
+  if (!_active) return s;
+
+  float p = static_cast<float>(nowMs - _startMs) / static_cast<float>(_cfg.rampMs);
+  if (isfinite(coldestRiseC) && _cfg.warmRiseC > 0.0f) {
+    const float warm = coldestRiseC / _cfg.warmRiseC;
+    if (warm > p) p = warm;
+  }
+  if (!(p < 1.0f)) {
+    _active = false;
+    return s;
+  }
+  if (p < 0.0f) p = 0.0f;
+
+  s.active = true;
+  s.frac = _cfg.startFrac + (1.0f - _cfg.startFrac) * p;
+  s.peakAllowA = _cfg.peakLimitA * s.frac;
+  return s;
+}
+
+uint32_t SoftStartRamp::scale(WirePacket* packets, size_t count, float frac) {
+  if (!packets) return 0;
+  if (!isfinite(frac) || frac < 0.0f) frac = 0.0f;
+  uint32_t total = 0;
+  for (size_t i = 0; i < count; ++i) {
+    WirePacket& p = packets[i];
+    if (p.onMs > 0 && p.mask != 0 && frac < 1.0f) {
+      // Scheduler packets carry one wire; key the credit by the lowest bit.
+      size_t slot = 0;
+      while (!(p.mask & (1u << slot))) ++slot;
+      float& credit = _creditMs[slot];
+
+      const float full = static_cast<float>(p.onMs);
+      uint16_t minMs = (_cfg.minPulseMs > 0) ? _cfg.minPulseMs : 1;
+      if (minMs > p.onMs) minMs = p.onMs;   // never below what the scheduler sent
+
+      const float want = full * frac + credit;
+      if (want < static_cast<float>(minMs)) {
+        p.onMs = 0;
+        credit = want;
+      } else {
+        float ms = floorf(want);
+        if (ms > full) ms = full;
+        p.onMs = static_cast<uint16_t>(ms);
+        credit = want - ms;
+        if (credit > full) credit = full;
+      }
+    }
+    total += p.onMs;
+  }
+  return total;
+}
+
+float SoftStartRamp::floorForPeakV(float vSrc, float rChargeOhm, float peakA) {
+  if (!isfinite(vSrc) || vSrc <= 0.0f) return 0.0f;
+  if (!isfinite(rChargeOhm) || rChargeOhm <= 0.0f) return 0.0f;
+  if (!isfinite(peakA) || peakA <= 0.0f) return 0.0f;
+  const float v = vSrc - peakA * rChargeOhm;
+  return (v > 0.0f) ? v : 0.0f;
+}
+
+float SoftStartRamp::peakCurrentA(float vSrc, float vMin, float rChargeOhm) {
+  if (!isfinite(vSrc) || !isfinite(vMin)) return NAN;
+  if (!isfinite(rChargeOhm) || rChargeOhm <= 0.0f) return NAN;
+  const float i = (vSrc - vMin) / rChargeOhm;
+  return (i > 0.0f) ? i : 0.0f;
+}
@@ -0,0 +1,82 @@
+#ifndef SOFT_START_RAMP_HPP
+#define SOFT_START_RAMP_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <WireScheduler.hpp>
+
+/**
+ * Soft start for the first frames of a RUN.
+ *
+ * Right after precharge the bank sits at the source voltage and the wires
+ * are at their coldest (lowest resistance), so the first full-demand frame
+ * pulls the deepest sag out of the bank and the largest recharge current
+ * through the charge path, I = (Vsrc - Vbus) / Rcharge.
+ *
+ * The ramp progress p goes from 0 to 1 with whichever is further along:
+ * elapsed / rampMs, or the coldest scheduled wire's rise over ambient /
+ * warmRiseC (a warm wire needs no ramp). Each frame then gets
+ *   - on-time scaled by  startFrac + (1 - startFrac) * p, delivered as
+ *     interleaved sub-pulse bursts. No packet goes out shorter than
+ *     minPulseMs: a wire whose scaled share is below it banks the on-time
+ *     and skips frames until the bank covers one minimum pulse, so the
+ *     pulse-current users (health CUSUMs, resistance estimator, trip)
+ *     keep measurable pulses and the average still follows the ramp, and
+ *   - an allowed charge-path peak  peakLimitA * (same fraction), turned
+ *     into a droop-planning floor Vsrc - I * Rcharge so the planner adds
+ *     recharge gaps / shortens pulses until the predicted peak fits.
+ * Once p reaches 1 the ramp latches off for the rest of the RUN.
+ */
+
+#ifndef SOFTSTART_START_FRAC
+#define SOFTSTART_START_FRAC      0.25f   // first-frame share of demand / peak
+#endif
+#ifndef SOFTSTART_WARM_RISE_C
+#define SOFTSTART_WARM_RISE_C     40.0f   // rise over ambient that ends the ramp
+#endif
+
+class SoftStartRamp {
+public:
+  struct Config {
+    uint32_t rampMs = 0;              // 0 = off
+    float startFrac = SOFTSTART_START_FRAC;
+    float warmRiseC = SOFTSTART_WARM_RISE_C;
+    float peakLimitA = 0.0f;          // charge-path peak at full ramp (<= 0 = energy only)
+    uint16_t minPulseMs = 0;          // shortest packet scale() emits (0 = 1 ms)
+  };
+
+  struct Step {
+    bool active = false;
+    float frac = 1.0f;                // on-time scale this frame
+    float peakAllowA = 0.0f;          // allowed charge-path peak (0 = no limit)
+  };
+
+  void begin(const Config& cfg, uint32_t nowMs);
+  bool active() const { return _active; }
+
+  // Ramp state for a frame; coldestRiseC is the coldest scheduled wire's
+  // model temperature over ambient (NAN = unknown, time only).
+  Step step(uint32_t nowMs, float coldestRiseC);
+
+  // Scale every packet's on-time. A packet is either dropped for this
+  // frame or kept at >= min(minPulseMs, its unscaled onMs) and <= its
+  // unscaled onMs; the difference is carried per wire to later frames.
+  // Returns the new total on-time.
+  uint32_t scale(WirePacket* packets, size_t count, float frac);
+
+  // Droop floor that holds the charge-path current at peakA (0 = none).
+  static float floorForPeakV(float vSrc, float rChargeOhm, float peakA);
+
+  // Charge-path current at the predicted bus minimum.
+  static float peakCurrentA(float vSrc, float vMin, float rChargeOhm);
+
+private:
+  static constexpr size_t kCreditSlots = 16;   // one per mask bit
+
+  Config _cfg{};
+  float _creditMs[kCreditSlots] = {0.0f};      // on-time owed per wire
+  uint32_t _startMs = 0;
+  bool _active = false;
+};
+
+#endif // SOFT_START_RAMP_HPP
@@ -0,0 +1,127 @@
+#include <WireHealthMonitor.hpp>
+
+#include <math.h>
+
+namespace {
+float clampf(float v, float lo, float hi) {
+  return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+// One CUSUM step for a mean shift of `d` (in residual units), evidence `x`
+// already signed toward the hypothesis.
+float cusumStep(float s, float x, float d, float var, float cap) {
+  if (!(d > 0.0f) || !(var > 0.0f)) return s;
+  const float llr = clampf((d / var) * (x - 0.5f * d), -cap, cap);
+  s += llr;
+  return (s > 0.0f) ? s : 0.0f;
+}
+} // namespace
+
+void WireHealthMonitor::configure(const Config& cfg) {
+  _cfg = cfg;
+  if (_cfg.minPulses == 0) _cfg.minPulses = 1;
+  if (!(_cfg.hFault > 0.0f)) _cfg.hFault = WIRE_CUSUM_H_FAULT;
+  if (!(_cfg.hDrift > 0.0f)) _cfg.hDrift = WIRE_CUSUM_H_DRIFT;
+}
+
+void WireHealthMonitor::reset() {
+  for (uint8_t i = 1; i <= kWireCount; ++i) {
+    resetWire(i);
+  }
+}
+
+void WireHealthMonitor::resetWire(uint8_t index) {
+  if (index == 0 || index > kWireCount) return;
+  Wire& w = _w[index - 1];
+  w.s = Stats{};
+  w.health = WireHealth::Ok;
+}
+
+uint16_t WireHealthMonitor::update(uint16_t mask, const float g[kWireCount],
+                                   float vBus, float iWireA) {
+  if (!g || mask == 0) return 0;
+  if (!isfinite(vBus) || vBus <= 0.0f || !isfinite(iWireA)) return 0;
+
+  float gSum = 0.0f;
+  for (uint8_t i = 0; i < kWireCount; ++i) {
+    if (!(mask & (1u << i))) continue;
+    if (!isfinite(g[i]) || g[i] <= 0.0f) return 0;
+    gSum += g[i];
+  }
+  if (!(gSum > 0.0f)) return 0;
+
+  const float iExp = vBus * gSum;
+  const float ratio = fabsf(iWireA) / iExp;
+  const float e = ratio - 1.0f;
+  const float sA = _cfg.sigmaA / iExp;
+  const float var = _cfg.sigmaRel * _cfg.sigmaRel + sA * sA;
+  const float capFault = _cfg.hFault / _cfg.minPulses;
+  const float capDrift = _cfg.hDrift / _cfg.minPulses;
+
+  uint16_t changed = 0;
+  for (uint8_t i = 0; i < kWireCount; ++i) {
+    if (!(mask & (1u << i))) continue;
+    Wire& w = _w[i];
+    const float share = g[i] / gSum;
+
+    // Boundaries sit at d/2: open at ratio_i = minRatio, short at
+    // shortRatio, drift at 1 +/- driftFrac.
+    const float dOpen = 2.0f * share * (1.0f - _cfg.minRatio);
+    const float dShort = 2.0f * share * (_cfg.shortRatio - 1.0f);
+    const float dDrift = 2.0f * share * _cfg.driftFrac;
+    w.s.open = cusumStep(w.s.open, -e, dOpen, var, capFault);
+    w.s.shorted = cusumStep(w.s.shorted, e, dShort, var, capFault);
+    w.s.driftUp = cusumStep(w.s.driftUp, e, dDrift, var, capDrift);
+    w.s.driftDown = cusumStep(w.s.driftDown, -e, dDrift, var, capDrift);
+
+    // Trend: common-mode attribution, weighted by how much of the pulse
+    // this wire carried.
+    const float a = clampf(_cfg.trendAlpha * share, 0.0f, 1.0f);
+    w.trend += a * (ratio - w.trend);
+    if (w.pulses < UINT32_MAX) w.pulses++;
+
+    WireHealth next = w.health;
+    if (w.health != WireHealth::Open && w.health != WireHealth::Short) {
+      if (w.s.open >= _cfg.hFault) {
+        next = WireHealth::Open;
+      } else if (w.s.shorted >= _cfg.hFault) {
+        next = WireHealth::Short;
+      } else if (w.s.driftUp >= _cfg.hDrift || w.s.driftDown >= _cfg.hDrift) {
+        next = WireHealth::Drift;
+      } else {
+        next = WireHealth::Ok;
+      }
+    }
+    if (next != w.health) {
+      w.health = next;
+      changed |= static_cast<uint16_t>(1u << i);
+    }
+  }
+  return changed;
+}
+
+WireHealth WireHealthMonitor::health(uint8_t index) const {
+  if (index == 0 || index > kWireCount) return WireHealth::Ok;
+  return _w[index - 1].health;
+}
+
+WireHealthMonitor::Stats WireHealthMonitor::stats(uint8_t index) const {
+  if (index == 0 || index > kWireCount) return Stats{};
+  return _w[index - 1].s;
+}
+
+float WireHealthMonitor::trendRatio(uint8_t index) const {
+  if (index == 0 || index > kWireCount) return NAN;
+  return _w[index - 1].trend;
+}
+
+uint32_t WireHealthMonitor::trendPulses(uint8_t index) const {
+  if (index == 0 || index > kWireCount) return 0;
+  return _w[index - 1].pulses;
+}
+
+void WireHealthMonitor::setTrendRatio(uint8_t index, float ratio) {
+  if (index == 0 || index > kWireCount) return;
+  if (!isfinite(ratio) || ratio <= 0.0f) ratio = 1.0f;
+  _w[index - 1].trend = ratio;
+}
@@ -0,0 +1,108 @@
+#ifndef WIRE_HEALTH_MONITOR_HPP
+#define WIRE_HEALTH_MONITOR_HPP
+
+#include <cstdint>
+
+/**
+ * Per-wire change detection on pulse conductance residuals.
+ *
+ * Every pulse gives one mask-level residual e = Imeas / (V * sum(G)) - 1.
+ * For each member the hypotheses "this wire open", "this wire shorted" and
+ * "this wire drifted by +/-driftFrac" each shift e by a multiple of the
+ * member's share w = G_i / sum(G), so each runs its own CUSUM on the
+ * log-likelihood ratio of that shift vs. healthy:
+ *
+ *   S += clamp((d / s^2) * (+/-e - d / 2), +/-cap),  S = max(S, 0)
+ *
+ * s is the residual noise (relative + absolute current term). The
+ * per-pulse clamp (cap = h / minPulses) keeps one outlier pulse from
+ * declaring a fault on its own.
+ *
+ * Open/Short latch until resetWire(); Drift follows its statistic.
+ * A slow EWMA of the per-wire ratio gives the long-term resistance trend
+ * (persisted by the owner).
+ */
+
+#ifndef WIRE_CUSUM_SIGMA_REL
+#define WIRE_CUSUM_SIGMA_REL      0.05f   // relative residual noise per pulse
+#endif
+#ifndef WIRE_CUSUM_SIGMA_A
+#define WIRE_CUSUM_SIGMA_A        0.20f   // absolute current noise per pulse [A]
+#endif
+#ifndef WIRE_CUSUM_H_FAULT
+#define WIRE_CUSUM_H_FAULT        12.0f   // open/short decision threshold (LLR)
+#endif
+#ifndef WIRE_CUSUM_H_DRIFT
+#define WIRE_CUSUM_H_DRIFT        40.0f   // drift decision threshold (LLR)
+#endif
+#ifndef WIRE_CUSUM_SHORT_RATIO
+#define WIRE_CUSUM_SHORT_RATIO    1.50f   // per-wire ratio treated as shorted
+#endif
+#ifndef WIRE_CUSUM_DRIFT_FRAC
+#define WIRE_CUSUM_DRIFT_FRAC     0.08f   // per-wire ratio change treated as drift
+#endif
+#ifndef WIRE_TREND_ALPHA
+#define WIRE_TREND_ALPHA          0.002f  // EWMA weight per full-share pulse
+#endif
+
+enum class WireHealth : uint8_t {
+  Ok = 0,
+  Drift = 1,
+  Open = 2,
+  Short = 3,
+};
+
+class WireHealthMonitor {
+public:
+  static constexpr uint8_t kWireCount = 10;
+
+  struct Config {
+    float minRatio = 0.5f;        ///< presence ratio; open boundary
+    float shortRatio = WIRE_CUSUM_SHORT_RATIO;
+    float driftFrac = WIRE_CUSUM_DRIFT_FRAC;
+    float sigmaRel = WIRE_CUSUM_SIGMA_REL;
+    float sigmaA = WIRE_CUSUM_SIGMA_A;
+    float hFault = WIRE_CUSUM_H_FAULT;
+    float hDrift = WIRE_CUSUM_H_DRIFT;
+    uint8_t minPulses = 3;        ///< fewest pulses that can declare open/short
+    float trendAlpha = WIRE_TREND_ALPHA;
+  };
+
+  struct Stats {
+    float open = 0.0f;
+    float shorted = 0.0f;
+    float driftUp = 0.0f;
+    float driftDown = 0.0f;
+  };
+
+  void configure(const Config& cfg);
+
+  // Clear all CUSUM statistics and latched states (trend kept).
+  void reset();
+  void resetWire(uint8_t index);
+
+  // One pulse. g[i]: nominal conductance of wire i+1; iWireA: measured
+  // current net of leak. Returns the mask of wires whose health changed.
+  uint16_t update(uint16_t mask, const float g[kWireCount], float vBus, float iWireA);
+
+  WireHealth health(uint8_t index) const;
+  Stats stats(uint8_t index) const;
+
+  // Long-term trend as a ratio to nominal (1 = matches configured R).
+  float trendRatio(uint8_t index) const;
+  uint32_t trendPulses(uint8_t index) const;
+  void setTrendRatio(uint8_t index, float ratio);
+
+private:
+  struct Wire {
+    Stats s;
+    WireHealth health = WireHealth::Ok;
+    float trend = 1.0f;
+    uint32_t pulses = 0;
+  };
+
+  Config _cfg{};
+  Wire _w[kWireCount];
+};
+
+#endif // WIRE_HEALTH_MONITOR_HPP
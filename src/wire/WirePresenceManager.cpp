@@ -1,4 +1,5 @@
 #include <WirePresenceManager.hpp>
+#include <PresenceGroupTester.hpp>
 
 #include <HeaterManager.hpp>
 #include <WireSubsystem.hpp>
@@ -61,6 +62,25 @@ float resolveChargeResOhms() {
     return r;
 }
 
+const char* const kTrendKeys[10] = {
+    R01TRD_KEY, R02TRD_KEY, R03TRD_KEY, R04TRD_KEY, R05TRD_KEY,
+    R06TRD_KEY, R07TRD_KEY, R08TRD_KEY, R09TRD_KEY, R10TRD_KEY
+};
+
+float resolveWireOhms(const WireConfigStore& cfg, uint8_t index) {
+    float r = cfg.getWireResistance(index);
+    if (!isfinite(r) || r <= 0.01f) r = DEFAULT_WIRE_RES_OHMS;
+    return r;
+}
+
+// Health nominal: the calibrated resistance. The working value follows the
+// online estimator, which would track a slow drift out of the CUSUMs.
+float resolveNominalOhms(const WireConfigStore& cfg, uint8_t index) {
+    float r = cfg.getCalibratedResistance(index);
+    if (!isfinite(r) || r <= 0.01f) r = DEFAULT_WIRE_RES_OHMS;
+    return r;
+}
+
 float computeLeakCurrent(float busVoltage) {
     if (!isfinite(busVoltage) || busVoltage <= 0.0f) return 0.0f;
     const float rCharge = resolveChargeResOhms();
@@ -108,12 +128,42 @@ float sampleCurrentAverage(CurrentSensor* current, uint32_t windowMs) {
     if (count == 0) return NAN;
     return sum / static_cast<float>(count);
 }
+
+float resolveCurrentLimitA() {
+    float v = DEFAULT_CURR_LIMIT_A;
+    if (CONF) {
+        v = CONF->GetFloat(CURR_LIMIT_KEY, DEFAULT_CURR_LIMIT_A);
+    }
+    if (!isfinite(v) || v < 0.0f) v = DEFAULT_CURR_LIMIT_A;
+    return v;
+}
+
+// Probe adapter for PresenceGroupTester: energize a mask, settle, average.
+struct ProbeBus {
+    HeaterManager* heater;
+    CpDischg* discharger;
+    CurrentSensor* current;
+    uint32_t settleMs;
+    uint32_t windowMs;
+
+    static bool probe(void* ctx, uint16_t mask, float& vBus, float& iBus) {
+        ProbeBus* b = static_cast<ProbeBus*>(ctx);
+        for (uint8_t i = 1; i <= PresenceGroupTester::kWireCount; ++i) {
+            if (mask & (1u << (i - 1))) b->heater->setOutput(i, true);
+        }
+        if (b->settleMs > 0) {
+            vTaskDelay(pdMS_TO_TICKS(b->settleMs));
+        }
+        vBus = sampleVoltageAverage(b->discharger, b->windowMs);
+        iBus = sampleCurrentAverage(b->current, b->windowMs);
+        b->heater->disableAll();
+        return true;
+    }
+};
 } // namespace
 
 void WirePresenceManager::resetFailures() {
-    for (uint8_t i = 0; i < kWireCount; ++i) {
-        _failCount[i] = 0;
-    }
+    _health.reset();
 }
 
 void WirePresenceManager::setWirePresent_(HeaterManager& heater,
@@ -128,7 +178,8 @@ void WirePresenceManager::setWirePresent_(HeaterManager& heater,
     ws.lastUpdateMs = millis();
     heater.setWirePresence(index, present);
     if (present) {
-        _failCount[index - 1] = 0;
+        _health.resetWire(index);
+        ws.health = static_cast<uint8_t>(WireHealth::Ok);
     }
 }
 
@@ -146,46 +197,39 @@ bool WirePresenceManager::probeAll(HeaterManager& heater,
     const uint16_t prevMask = heater.getOutputMask();
     heater.disableAll();
 
-    const float minRatio = resolvePresenceMinRatio();
-    const uint32_t settleMs = kProbeSettleMs;
-    const uint32_t windowMs = resolvePresenceWindowMs();
+    ProbeBus bus{&heater, discharger, current, kProbeSettleMs, resolvePresenceWindowMs()};
 
+    float g[kWireCount] = {0};
+    float gCal[kWireCount] = {0};
+    uint16_t eligible = 0;
     for (uint8_t i = 1; i <= kWireCount; ++i) {
         if (!cfg.getAccessFlag(i)) {
             setWirePresent_(heater, state, i, false);
             continue;
         }
+        g[i - 1] = 1.0f / resolveWireOhms(cfg, i);
+        gCal[i - 1] = 1.0f / resolveNominalOhms(cfg, i);
+        eligible |= static_cast<uint16_t>(1u << (i - 1));
+    }
 
-        heater.setOutput(i, true);
-        if (settleMs > 0) {
-            vTaskDelay(pdMS_TO_TICKS(settleMs));
-        }
-
-        const float vBus = sampleVoltageAverage(discharger, windowMs);
-        const float iBus = sampleCurrentAverage(current, windowMs);
-
-        heater.setOutput(i, false);
-
-        if (!isfinite(vBus) || vBus <= kMinBusVoltage || !isfinite(iBus)) {
-            setWirePresent_(heater, state, i, false);
-            continue;
-        }
+    PresenceGroupTester::Config gcfg;
+    gcfg.minRatio = resolvePresenceMinRatio();
+    gcfg.minBusV = kMinBusVoltage;
+    gcfg.leakConductanceS = computeLeakCurrent(1.0f);
+    gcfg.maxGroupCurrentA = resolveCurrentLimitA() * PRESENCE_GROUP_LIMIT_FRAC;
 
-        float rWire = cfg.getWireResistance(i);
-        if (!isfinite(rWire) || rWire <= 0.01f) rWire = DEFAULT_WIRE_RES_OHMS;
-        const float iExpected = vBus / rWire;
-        if (!isfinite(iExpected) || iExpected <= 0.0f) {
-            setWirePresent_(heater, state, i, false);
-            continue;
-        }
+    const float vIdle = sampleVoltageAverage(discharger, kProbeSampleDelayMs * 2);
+    const PresenceGroupTester::Result res =
+        PresenceGroupTester().run(eligible, g, gCal, vIdle, gcfg, &ProbeBus::probe, &bus);
 
-        const float iLeak = computeLeakCurrent(vBus);
-        float iWire = fabsf(iBus) - iLeak;
-        if (iWire < 0.0f) iWire = 0.0f;
-        const float ratio = iWire / iExpected;
-        const bool present = isfinite(ratio) && (ratio >= minRatio);
-        setWirePresent_(heater, state, i, present);
+    for (uint8_t i = 1; i <= kWireCount; ++i) {
+        const uint16_t bit = static_cast<uint16_t>(1u << (i - 1));
+        if (!(eligible & bit)) continue;
+        setWirePresent_(heater, state, i, (res.presentMask & bit) != 0);
     }
+    DEBUG_PRINTF("[Presence] probe: %u probes (%u grouped) for %u wires, present=0x%03X\n",
+                 (unsigned)res.probes, (unsigned)res.groupProbes,
+                 (unsigned)__builtin_popcount(eligible), (unsigned)res.presentMask);
 
     if (prevMask != 0) {
         for (uint8_t i = 1; i <= kWireCount; ++i) {
@@ -199,6 +243,7 @@ bool WirePresenceManager::probeAll(HeaterManager& heater,
 
 bool WirePresenceManager::updatePresenceFromMask(HeaterManager& heater,
                                                  WireStateModel& state,
+                                                 const WireConfigStore& cfg,
                                                  uint16_t mask,
                                                  float busVoltage,
                                                  float currentA) {
@@ -206,10 +251,8 @@ bool WirePresenceManager::updatePresenceFromMask(HeaterManager& heater,
     if (!isfinite(busVoltage) || busVoltage <= kMinBusVoltage) return false;
     if (!isfinite(currentA)) return false;
 
-    const float minRatio = resolvePresenceMinRatio();
-    const uint8_t failLimit = resolvePresenceFailCount();
     uint16_t eligibleMask = 0;
-    double gTot = 0.0;
+    float g[kWireCount] = {0};
 
     for (uint8_t i = 0; i < kWireCount; ++i) {
         const uint16_t bit = static_cast<uint16_t>(1u << i);
@@ -219,47 +262,73 @@ bool WirePresenceManager::updatePresenceFromMask(HeaterManager& heater,
         if (!ws.present) continue;
         if (ws.overTemp) continue;
 
+        g[i] = 1.0f / resolveNominalOhms(cfg, i + 1);
         eligibleMask |= bit;
-        WireInfo wi = heater.getWireInfo(i + 1);
-        float r = wi.resistanceOhm;
-        if (!isfinite(r) || r <= 0.01f) r = DEFAULT_WIRE_RES_OHMS;
-        gTot += 1.0 / r;
     }
 
     if (eligibleMask == 0) return false;
-    if (!(gTot > 0.0)) return false;
 
-    const float iExpected = static_cast<float>(busVoltage * gTot);
-    if (!isfinite(iExpected) || iExpected <= 0.0f) return false;
+    WireHealthMonitor::Config hcfg;
+    hcfg.minRatio = resolvePresenceMinRatio();
+    hcfg.minPulses = resolvePresenceFailCount();
+    _health.configure(hcfg);
 
     const float iLeak = computeLeakCurrent(busVoltage);
     float iWire = fabsf(currentA) - iLeak;
     if (iWire < 0.0f) iWire = 0.0f;
-    const float ratio = iWire / iExpected;
-    const bool ratioFail = !isfinite(ratio) || ratio < minRatio;
-    bool changed = false;
 
-    for (uint8_t i = 0; i < kWireCount; ++i) {
-        const uint16_t bit = static_cast<uint16_t>(1u << i);
-        if (!(eligibleMask & bit)) continue;
+    const uint16_t healthChanged = _health.update(eligibleMask, g, busVoltage, iWire);
+    if (healthChanged == 0) return false;
 
-        WireRuntimeState& ws = state.wire(i + 1);
-        if (!ws.present) continue;
+    bool changed = false;
+    for (uint8_t i = 1; i <= kWireCount; ++i) {
+        if (!(healthChanged & (1u << (i - 1)))) continue;
 
-        if (ratioFail) {
-            if (_failCount[i] < 255) _failCount[i]++;
-            if (_failCount[i] >= failLimit) {
-                setWirePresent_(heater, state, i + 1, false);
-                changed = true;
-            }
-        } else {
-            _failCount[i] = 0;
+        const WireHealth h = _health.health(i);
+        WireRuntimeState& ws = state.wire(i);
+        ws.health = static_cast<uint8_t>(h);
+        DEBUG_PRINTF("[Presence] wire %u health -> %u (trend %.3f)\n",
+                     (unsigned)i, (unsigned)ws.health, _health.trendRatio(i));
+
+        if (h == WireHealth::Open || h == WireHealth::Short) {
+            setWirePresent_(heater, state, i, false);
+            changed = true;
         }
     }
 
     return changed;
 }
 
+float WirePresenceManager::trendOhms(uint8_t index, const WireConfigStore& cfg) const {
+    if (index == 0 || index > kWireCount) return NAN;
+    if (_health.trendPulses(index) == 0 && !_trendLoaded[index - 1]) return NAN;
+    const float ratio = _health.trendRatio(index);
+    if (!isfinite(ratio) || ratio <= 0.0f) return NAN;
+    return resolveNominalOhms(cfg, index) / ratio;
+}
+
+void WirePresenceManager::loadTrends(const WireConfigStore& cfg) {
+    if (!CONF) return;
+    for (uint8_t i = 1; i <= kWireCount; ++i) {
+        const float t = CONF->GetFloat(kTrendKeys[i - 1], DEFAULT_WIRE_TREND_OHMS);
+        _trendLoaded[i - 1] = isfinite(t) && t > 0.0f;
+        _health.setTrendRatio(i, _trendLoaded[i - 1] ? (resolveNominalOhms(cfg, i) / t) : 1.0f);
+    }
+}
+
+void WirePresenceManager::saveTrends(const WireConfigStore& cfg) const {
+    if (!CONF) return;
+    for (uint8_t i = 1; i <= kWireCount; ++i) {
+        if (_health.trendPulses(i) == 0) continue;
+        const float t = trendOhms(i, cfg);
+        if (!isfinite(t) || t <= 0.0f) continue;
+        const float prev = CONF->GetFloat(kTrendKeys[i - 1], DEFAULT_WIRE_TREND_OHMS);
+        // Skip sub-0.1 % moves to spare flash writes.
+        if (isfinite(prev) && prev > 0.0f && fabsf(t - prev) <= prev * 0.001f) continue;
+        CONF->PutFloat(kTrendKeys[i - 1], t);
+    }
+}
+
 bool WirePresenceManager::hasAnyConnected(const WireStateModel& state) const {
     for (uint8_t i = 1; i <= kWireCount; ++i) {
         if (state.wire(i).present) {
@@ -2,6 +2,7 @@
 #define WIRE_PRESENCE_MANAGER_HPP
 
 #include <cstdint>
+#include <WireHealthMonitor.hpp>
 
 class HeaterManager;
 class WireStateModel;
@@ -15,12 +16,20 @@ public:
   bool probeAll(HeaterManager& heater, WireStateModel& state, const WireConfigStore& cfg,
                 CpDischg* discharger, CurrentSensor* current);
   bool updatePresenceFromMask(HeaterManager& heater, WireStateModel& state,
-                              uint16_t mask, float busVoltage, float currentA);
+                              const WireConfigStore& cfg, uint16_t mask,
+                              float busVoltage, float currentA);
   bool hasAnyConnected(const WireStateModel& state) const;
 
+  WireHealth health(uint8_t index) const { return _health.health(index); }
+  // Long-term measured resistance (NAN until pulses or a stored trend exist).
+  float trendOhms(uint8_t index, const WireConfigStore& cfg) const;
+  void loadTrends(const WireConfigStore& cfg);
+  void saveTrends(const WireConfigStore& cfg) const;
+
 private:
   static constexpr uint8_t kWireCount = 10;
-  uint8_t _failCount[kWireCount] = {0};
+  WireHealthMonitor _health;
+  bool _trendLoaded[kWireCount] = {false};
 
   void setWirePresent_(HeaterManager& heater, WireStateModel& state,
                        uint8_t index, bool present);
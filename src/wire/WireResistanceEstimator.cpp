@@ -0,0 +1,112 @@
+#include <WireResistanceEstimator.hpp>
+
+#include <math.h>
+
+namespace {
+constexpr float kInitSigmaRel = 0.05f;   // trust in a fresh seed
+constexpr float kMaxDtS = 600.0f;        // cap process noise across idle gaps
+constexpr float kConfScaleRel = 0.01f;
+
+float clampf(float v, float lo, float hi) {
+  return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+} // namespace
+
+void WireResistanceEstimator::seed(uint8_t index, float r0Ohm) {
+  if (index == 0 || index > kWireCount) return;
+  if (!isfinite(r0Ohm) || r0Ohm <= 0.01f) return;
+  Wire& w = _w[index - 1];
+  w = Wire{};
+  w.base = r0Ohm;
+  w.x = r0Ohm;
+  w.applied = r0Ohm;
+  w.p = (kInitSigmaRel * r0Ohm) * (kInitSigmaRel * r0Ohm);
+}
+
+bool WireResistanceEstimator::update(uint8_t index, float vBus, float iWireA,
+                                     float wireTempC, float ambientC,
+                                     uint32_t nowMs) {
+  if (index == 0 || index > kWireCount) return false;
+  Wire& w = _w[index - 1];
+  if (!(w.base > 0.0f)) return false;
+  if (!isfinite(vBus) || vBus <= 0.0f) return false;
+  if (!isfinite(iWireA) || fabsf(iWireA) < _cfg.minCurrentA) return false;
+
+  // Predict.
+  if (w.haveLast) {
+    const float dtS = clampf((nowMs - w.lastMs) * 0.001f, 0.0f, kMaxDtS);
+    w.p += _cfg.qRelPerS * w.x * w.x * dtS;
+  }
+  w.lastMs = nowMs;
+  w.haveLast = true;
+
+  // Observation referred back to ambient.
+  const float i = fabsf(iWireA);
+  float scale = 1.0f;
+  if (isfinite(wireTempC) && isfinite(ambientC)) {
+    scale = clampf(1.0f + _cfg.tcrPerC * (wireTempC - ambientC), 0.2f, 3.0f);
+  }
+  const float z = (vBus / i) / scale;
+  if (!isfinite(z) || z <= 0.0f) return false;
+
+  const float rel = _cfg.sigmaRel * _cfg.sigmaRel +
+                    (_cfg.sigmaA / i) * (_cfg.sigmaA / i);
+  const float r = z * z * rel;
+  const float s = w.p + r;
+  const float y = z - w.x;
+
+  if (!(s > 0.0f) || (y * y) > (_cfg.gateSigma * _cfg.gateSigma * s)) {
+    // Widen (bounded by the seed variance) so a persistent shift re-enters
+    // the gate instead of being rejected forever.
+    const float pMax = (kInitSigmaRel * w.base) * (kInitSigmaRel * w.base);
+    w.p = (w.p * 2.0f < pMax) ? (w.p * 2.0f) : pMax;
+    w.rejected++;
+    return false;
+  }
+
+  const float k = w.p / s;
+  w.x += k * y;
+  w.p *= (1.0f - k);
+  w.accepted++;
+  return true;
+}
+
+bool WireResistanceEstimator::takePublish(uint8_t index, uint32_t nowMs, float& ohmsOut) {
+  if (index == 0 || index > kWireCount) return false;
+  Wire& w = _w[index - 1];
+  if (!(w.base > 0.0f)) return false;
+  if (w.published && (nowMs - w.lastPublishMs) < _cfg.publishIntervalMs) return false;
+
+  const Report rep = report(index);
+  if (rep.confidence < _cfg.minConfidence) return false;
+
+  const float diff = w.x - w.applied;
+  if (fabsf(diff) <= _cfg.deadbandFrac * w.applied) return false;
+
+  const float maxStep = _cfg.maxStepFrac * w.applied;
+  float next = w.applied + clampf(diff, -maxStep, maxStep);
+  next = clampf(next, w.base * (1.0f - _cfg.maxDriftFrac),
+                w.base * (1.0f + _cfg.maxDriftFrac));
+  if (next == w.applied) return false;
+
+  w.applied = next;
+  w.lastPublishMs = nowMs;
+  w.published = true;
+  ohmsOut = next;
+  return true;
+}
+
+WireResistanceEstimator::Report WireResistanceEstimator::report(uint8_t index) const {
+  Report rep;
+  if (index == 0 || index > kWireCount) return rep;
+  const Wire& w = _w[index - 1];
+  if (!(w.base > 0.0f)) return rep;
+  rep.estimateOhm = w.x;
+  rep.sigmaOhm = sqrtf(w.p > 0.0f ? w.p : 0.0f);
+  rep.confidence = 1.0f / (1.0f + (rep.sigmaOhm / w.x) / kConfScaleRel);
+  rep.driftFrac = (w.x - w.base) / w.base;
+  rep.appliedOhm = w.applied;
+  rep.accepted = w.accepted;
+  rep.rejected = w.rejected;
+  return rep;
+}
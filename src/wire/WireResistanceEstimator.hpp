@@ -0,0 +1,116 @@
+#ifndef WIRE_RESISTANCE_ESTIMATOR_HPP
+#define WIRE_RESISTANCE_ESTIMATOR_HPP
+
+#include <cstdint>
+
+/**
+ * Online cold-resistance refinement from ordinary single-wire pulses.
+ *
+ * Each pulse gives R = V / I_wire; the linear tempco model used by the
+ * thermal code, R(T) = R0 * (1 + alpha * (T - ambient)), maps it back to a
+ * cold-resistance observation. A scalar Kalman filter (random-walk process
+ * noise for aging) tracks R0; observations outside the innovation gate
+ * are rejected, and every rejection widens the variance so a persistent
+ * real shift is re-acquired within a few pulses.
+ *
+ * The value handed to HeaterManager moves toward the estimate only when
+ * confident, at most maxStepFrac per publish, no faster than
+ * publishIntervalMs, and never more than maxDriftFrac from the seeded
+ * (calibrated) value.
+ */
+
+#ifndef WIRE_REST_TCR_PER_C
+#define WIRE_REST_TCR_PER_C          0.00017f  // nichrome, matches Device::NICHROME_ALPHA
+#endif
+#ifndef WIRE_REST_SIGMA_REL
+#define WIRE_REST_SIGMA_REL          0.02f     // relative R noise per pulse
+#endif
+#ifndef WIRE_REST_SIGMA_A
+#define WIRE_REST_SIGMA_A            0.20f     // absolute current noise [A]
+#endif
+#ifndef WIRE_REST_Q_REL_PER_S
+#define WIRE_REST_Q_REL_PER_S        1e-8f     // aging random walk [(dR/R)^2 / s]
+#endif
+#ifndef WIRE_REST_GATE_SIGMA
+#define WIRE_REST_GATE_SIGMA         4.0f
+#endif
+#ifndef WIRE_REST_MAX_STEP_FRAC
+#define WIRE_REST_MAX_STEP_FRAC      0.005f    // per publish
+#endif
+#ifndef WIRE_REST_MAX_DRIFT_FRAC
+#define WIRE_REST_MAX_DRIFT_FRAC     0.20f     // vs. seeded value
+#endif
+#ifndef WIRE_REST_DEADBAND_FRAC
+#define WIRE_REST_DEADBAND_FRAC      0.002f
+#endif
+#ifndef WIRE_REST_PUBLISH_MS
+#define WIRE_REST_PUBLISH_MS         5000
+#endif
+#ifndef WIRE_REST_MIN_CONFIDENCE
+#define WIRE_REST_MIN_CONFIDENCE     0.5f
+#endif
+#ifndef WIRE_REST_MIN_CURRENT_A
+#define WIRE_REST_MIN_CURRENT_A      0.5f
+#endif
+
+class WireResistanceEstimator {
+public:
+  static constexpr uint8_t kWireCount = 10;
+
+  struct Config {
+    float tcrPerC = WIRE_REST_TCR_PER_C;
+    float sigmaRel = WIRE_REST_SIGMA_REL;
+    float sigmaA = WIRE_REST_SIGMA_A;
+    float qRelPerS = WIRE_REST_Q_REL_PER_S;
+    float gateSigma = WIRE_REST_GATE_SIGMA;
+    float maxStepFrac = WIRE_REST_MAX_STEP_FRAC;
+    float maxDriftFrac = WIRE_REST_MAX_DRIFT_FRAC;
+    float deadbandFrac = WIRE_REST_DEADBAND_FRAC;
+    uint32_t publishIntervalMs = WIRE_REST_PUBLISH_MS;
+    float minConfidence = WIRE_REST_MIN_CONFIDENCE;
+    float minCurrentA = WIRE_REST_MIN_CURRENT_A;
+  };
+
+  struct Report {
+    float estimateOhm = 0.0f;   ///< cold-resistance estimate
+    float sigmaOhm = 0.0f;
+    float confidence = 0.0f;    ///< 0..1 (0.5 at 1 % sigma)
+    float driftFrac = 0.0f;     ///< (estimate - seeded) / seeded
+    float appliedOhm = 0.0f;    ///< value last handed to HeaterManager
+    uint32_t accepted = 0;
+    uint32_t rejected = 0;
+  };
+
+  void configure(const Config& cfg) { _cfg = cfg; }
+
+  // (Re)start from a calibrated/configured cold resistance.
+  void seed(uint8_t index, float r0Ohm);
+
+  // One single-wire pulse. Returns true when the observation was used.
+  bool update(uint8_t index, float vBus, float iWireA,
+              float wireTempC, float ambientC, uint32_t nowMs);
+
+  // Rate-limited, bounded value for HeaterManager; true when it changed.
+  bool takePublish(uint8_t index, uint32_t nowMs, float& ohmsOut);
+
+  Report report(uint8_t index) const;
+
+private:
+  struct Wire {
+    float base = 0.0f;
+    float x = 0.0f;
+    float p = 0.0f;
+    float applied = 0.0f;
+    uint32_t lastMs = 0;
+    uint32_t lastPublishMs = 0;
+    bool haveLast = false;
+    bool published = false;
+    uint32_t accepted = 0;
+    uint32_t rejected = 0;
+  };
+
+  Config _cfg{};
+  Wire _w[kWireCount];
+};
+
+#endif // WIRE_RESISTANCE_ESTIMATOR_HPP
@@ -161,3 +161,150 @@ size_t WireScheduler::buildSchedule(const WireConfigStore& cfg,
 
   return outCount;
 }
+
+namespace {
+constexpr float kMaxStretch = 1.5f;       // cap on energy compensation
+constexpr float kRechargeCeilFrac = 0.98f; // recharge target ceiling vs source
+constexpr uint16_t kMaxGapMs = 2000;
+
+double packetLoadOhm(const WireConfigStore& cfg, uint16_t mask) {
+  double g = 0.0;
+  for (uint8_t i = 0; i < HeaterManager::kWireCount; ++i) {
+    if (!(mask & (1u << i))) continue;
+    float r = cfg.getWireResistance(i + 1);
+    if (!isfinite(r) || r <= 0.01f) r = DEFAULT_WIRE_RES_OHMS;
+    g += 1.0 / static_cast<double>(r);
+  }
+  return (g > 0.0) ? (1.0 / g) : INFINITY;
+}
+
+// Largest t in [0, tMax] ms with pred(t) true; pred must be monotone
+// (true up to some t, false after).
+template <typename Pred>
+uint16_t maxMsWhere(uint16_t tMax, Pred pred) {
+  if (pred(tMax)) return tMax;
+  uint16_t lo = 0;
+  uint16_t hi = tMax;
+  while (hi - lo > 1) {
+    const uint16_t mid = static_cast<uint16_t>(lo + (hi - lo) / 2);
+    if (pred(mid)) lo = mid;
+    else hi = mid;
+  }
+  return lo;
+}
+} // namespace
+
+float WireScheduler::planForDroop(const WireConfigStore& cfg,
+                                  const BusDroopModel& bus,
+                                  WirePacket* packets,
+                                  size_t count) const {
+  if (!packets || count == 0) return NAN;
+  if (!isfinite(bus.capF) || bus.capF <= 0.0f) return NAN;
+
+  const double capF = bus.capF;
+  const double vSrc = (isfinite(bus.vSrc) && bus.vSrc > 0.0f) ? bus.vSrc : 0.0;
+  const double rChg = (isfinite(bus.rChargeOhm) && bus.rChargeOhm > 0.0f)
+                          ? static_cast<double>(bus.rChargeOhm)
+                          : INFINITY;
+  double v = (isfinite(bus.vStart) && bus.vStart > 0.0f) ? bus.vStart : vSrc;
+  if (!(v > 0.0)) return NAN;
+  const double vNom = (isfinite(bus.vNominal) && bus.vNominal > 0.0f) ? bus.vNominal : v;
+  const double vFloor = (isfinite(bus.vFloor) && bus.vFloor > 0.0f) ? bus.vFloor : 0.0;
+  const bool canRecharge = isfinite(rChg) && vSrc > vFloor;
+  const double vCeil = canRecharge ? (vSrc * kRechargeCeilFrac) : v;
+
+  // Heaviest first: the fullest bus takes the deepest sag, light packets
+  // ride the partial recovery.
+  double rLoad[kMaxPlanPackets] = {0.0};
+  if (count > kMaxPlanPackets) count = kMaxPlanPackets;
+  for (size_t i = 0; i < count; ++i) {
+    rLoad[i] = packetLoadOhm(cfg, packets[i].mask);
+  }
+  for (size_t i = 1; bus.reorder && i < count; ++i) {
+    const WirePacket p = packets[i];
+    const double r = rLoad[i];
+    size_t j = i;
+    while (j > 0 && (p.onMs / r) > (packets[j - 1].onMs / rLoad[j - 1])) {
+      packets[j] = packets[j - 1];
+      rLoad[j] = rLoad[j - 1];
+      --j;
+    }
+    packets[j] = p;
+    rLoad[j] = r;
+  }
+
+  double vMin = v;
+  for (size_t i = 0; i < count; ++i) {
+    WirePacket& p = packets[i];
+    if (p.onMs == 0 || p.mask == 0 || !isfinite(rLoad[i])) {
+      p.gapMs = 0;
+      continue;
+    }
+    const double rL = rLoad[i];
+
+    // A gap already in the plan (interleaving) is idle time: the bank
+    // recovers over it before any extra recharge wait is added.
+    const uint16_t baseGapMs = p.gapMs;
+    if (baseGapMs > 0) {
+      v = CapModel::predictVoltage(v, baseGapMs * 0.001, capF, INFINITY, vSrc, rChg);
+    }
+
+    auto endV = [&](double v0, uint16_t ms) {
+      return CapModel::predictVoltage(v0, ms * 0.001, capF, rL, vSrc, rChg);
+    };
+
+    // On-time delivering the nominal-voltage energy from start voltage v0.
+    const double eTarget = (vNom * vNom / rL) * (p.onMs * 0.001);
+    uint16_t tCap = static_cast<uint16_t>(p.onMs * kMaxStretch);
+    if (bus.maxOnMs > 0 && tCap > bus.maxOnMs) tCap = bus.maxOnMs;
+    if (tCap < p.onMs) tCap = p.onMs;
+    auto compensated = [&](double v0) -> uint16_t {
+      if (!bus.compensate) return p.onMs;
+      const uint16_t under = maxMsWhere(tCap, [&](uint16_t ms) {
+        return CapModel::energyToLoadJ(v0, ms * 0.001, capF, rL, vSrc, rChg) < eTarget;
+      });
+      return (under < tCap) ? static_cast<uint16_t>(under + 1) : tCap;
+    };
+
+    uint16_t onMs = compensated(v);
+    if (vFloor > 0.0 && endV(v, onMs) < vFloor) {
+      // Lowest start voltage that keeps this pulse above the floor.
+      double lo = v;
+      double hi = vCeil;
+      if (hi > lo && endV(hi, compensated(hi)) >= vFloor) {
+        for (uint8_t it = 0; it < 24; ++it) {
+          const double mid = 0.5 * (lo + hi);
+          if (endV(mid, compensated(mid)) >= vFloor) hi = mid;
+          else lo = mid;
+        }
+      }
+      const double vReq = (hi > v) ? hi : v;
+
+      if (canRecharge && vReq > v) {
+        const double tau = rChg * capF;
+        const double t = tau * log((vSrc - v) / (vSrc - vReq));
+        double gap = ceil(t * 1000.0);
+        if (!isfinite(gap) || gap < 0.0) gap = 0.0;
+        if (gap > kMaxGapMs) gap = kMaxGapMs;
+        const uint16_t extraMs = static_cast<uint16_t>(gap);
+        p.gapMs = static_cast<uint16_t>(baseGapMs + extraMs);
+        v = CapModel::predictVoltage(v, extraMs * 0.001, capF, INFINITY, vSrc, rChg);
+        onMs = compensated(v);
+      }
+
+      // Recharge could not reach vReq: shorten to what the bus can carry,
+      // or skip the pulse when that is too short to be useful.
+      if (endV(v, onMs) < vFloor) {
+        onMs = maxMsWhere(onMs, [&](uint16_t ms) { return endV(v, ms) >= vFloor; });
+        if (onMs < bus.minOnMs) onMs = 0;
+      }
+    }
+
+    p.onMs = onMs;
+    if (onMs == 0) p.gapMs = baseGapMs;
+    v = endV(v, onMs);
+    if (v < vMin) vMin = v;
+  }
+
+  return static_cast<float>(vMin);
+}
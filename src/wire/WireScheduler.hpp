@@ -10,10 +10,28 @@ class WireStateModel;
 struct WirePacket {
   uint16_t mask = 0;
   uint16_t onMs = 0;
+  uint16_t gapMs = 0;  // recharge wait before this packet (droop planning)
+};
+
+// Bus state for droop planning (see CapModel in WireSubsystem.hpp).
+struct BusDroopModel {
+  float capF = 0.0f;            // bank capacitance [F]; <= 0 disables planning
+  float vSrc = 0.0f;            // charge source voltage [V]
+  float rChargeOhm = 0.0f;      // charge path [ohm]; <= 0 / INFINITY = no source
+  float vStart = 0.0f;          // measured bus voltage at frame start [V]
+  float vNominal = 0.0f;        // voltage the on-time budget assumes [V]
+  float vFloor = 0.0f;          // never plan the bus below this [V]
+  uint16_t maxOnMs = 0;         // cap for stretched on-times (0 = no cap)
+  uint16_t minOnMs = 0;         // shortest pulse worth firing (0 = any)
+  bool compensate = true;       // stretch on-times to the nominal energy
+  bool reorder = true;          // heaviest-first; false keeps an interleaved order
 };
 
 class WireScheduler {
 public:
+  // Largest plan planForDroop accepts (interleaved sub-pulses included).
+  static constexpr size_t kMaxPlanPackets = 40;
+
   size_t buildSchedule(const WireConfigStore& cfg,
                        const WireStateModel& state,
                        uint16_t frameMs,
@@ -23,6 +41,18 @@ public:
                        uint16_t maxOnMs,
                        WirePacket* out,
                        size_t maxPackets);
+
+  // Reorder packets heaviest-first (unless bus.reorder is false), stretch
+  // on-times so each delivers the energy it would at vNominal, and grow
+  // gapMs (an existing gap is kept as a minimum) so the predicted bus stays
+  // at or above vFloor (shortening a pulse only when even a recharged bus
+  // cannot carry it, and skipping it when that leaves less than
+  // bus.minOnMs). Returns the predicted minimum bus voltage, or NAN
+  // when the model is not usable (packets untouched).
+  float planForDroop(const WireConfigStore& cfg,
+                     const BusDroopModel& bus,
+                     WirePacket* packets,
+                     size_t count) const;
 };
 
 #endif // WIRE_SCHEDULER_HPP
@@ -82,6 +82,7 @@ void WireConfigStore::loadFromNvs() {
         float r = CONF->GetFloat(WIRE_RES_KEYS[i], DEFAULT_WIRE_RES_OHMS);
         if (!isfinite(r) || r <= 0.01f) r = DEFAULT_WIRE_RES_OHMS;
         _wireR[i] = r;
+        _calR[i]  = r;
 
         _access[i] = CONF->GetBool(ACCESS_KEYS[i], false);
     }
@@ -101,7 +102,7 @@ void WireConfigStore::saveToNvs() const {
     CONF->PutInt  (WIRE_GAUGE_KEY,     _wireGaugeAwg);
 
     for (uint8_t i = 0; i < HeaterManager::kWireCount; ++i) {
-        CONF->PutFloat(WIRE_RES_KEYS[i], _wireR[i]);
+        CONF->PutFloat(WIRE_RES_KEYS[i], _calR[i]);
         CONF->PutBool(ACCESS_KEYS[i],    _access[i]);
     }
 }
@@ -111,10 +112,22 @@ float WireConfigStore::getWireResistance(uint8_t index) const {
     return _wireR[index - 1];
 }
 
+float WireConfigStore::getCalibratedResistance(uint8_t index) const {
+    if (index == 0 || index > HeaterManager::kWireCount) return DEFAULT_WIRE_RES_OHMS;
+    return _calR[index - 1];
+}
+
 void WireConfigStore::setWireResistance(uint8_t index, float ohms) {
     if (index == 0 || index > HeaterManager::kWireCount) return;
     if (!isfinite(ohms) || ohms <= 0.01f) return;
     _wireR[index - 1] = ohms;
+    _calR[index - 1]  = ohms;
+}
+
+void WireConfigStore::applyResistanceEstimate(uint8_t index, float ohms) {
+    if (index == 0 || index > HeaterManager::kWireCount) return;
+    if (!isfinite(ohms) || ohms <= 0.01f) return;
+    _wireR[index - 1] = ohms;
 }
 
 bool WireConfigStore::getAccessFlag(uint8_t index) const {
@@ -621,6 +634,26 @@ double WireThermalModel::getWireTemp(uint8_t index) const {
     return _state[index - 1].T;
 }
 
+bool WireThermalModel::getWireThermalParams(uint8_t index,
+                                            double& tauSec,
+                                            double& kLoss,
+                                            double& thermalMassC) const {
+    if (index == 0 || index > HeaterManager::kWireCount) return false;
+    const WireThermalState& ws = _state[index - 1];
+    tauSec = ws.tauSec;
+    kLoss = (isfinite(ws.kLoss) && ws.kLoss >= 0.0) ? ws.kLoss : _heatLossK;
+    thermalMassC = (isfinite(ws.capC) && ws.capC > 0.0) ? ws.capC : _thermalMassC;
+    if (!isfinite(tauSec) || tauSec <= 0.0) {
+        tauSec = (kLoss > 0.0) ? (thermalMassC / kLoss) : _tauSec;
+    }
+    return true;
+}
+
+uint32_t WireThermalModel::getWireUpdateMs(uint8_t index) const {
+    if (index == 0 || index > HeaterManager::kWireCount) return 0;
+    return _state[index - 1].lastUpdateMs;
+}
+
 void WireThermalModel::setThermalParams(double tauSec, double kLoss, double thermalMassC) {
     if (!isfinite(tauSec) || tauSec <= 0.0) {
         tauSec = DEFAULT_WIRE_MODEL_TAU;
@@ -715,6 +748,7 @@ void WireTelemetryAdapter::fillSnapshot(StatusSnapshot& out,
         out.wireTemps[i] = allowed ? rt.tempC : NAN;
         out.outputs[i]   = ((state.getLastMask() & (1u << i)) != 0);
         out.wirePresent[i] = rt.present;
+        out.wireHealth[i]  = rt.health;
         totalP += rt.lastPowerW;
     }
     (void)totalP; // total power can be added to StatusSnapshot later if desired.
@@ -148,6 +148,7 @@ struct WireRuntimeState {
     bool      overTemp        = false;  // latched over-temperature
     bool      locked          = false;  // locked out by thermal/safety policy
     bool      allowedByAccess = true;   // from config access flags
+    uint8_t   health          = 0;      // WireHealth code (0 ok, 1 drift, 2 open, 3 short)
 
     double    tempC           = NAN;    // latest virtual temperature
     double    lastPowerW      = 0.0;    // last computed power
@@ -164,8 +165,14 @@ public:
     void loadFromNvs();
     void saveToNvs() const;
 
+    // Working resistance: the calibrated value, refined online by
+    // applyResistanceEstimate().
     float getWireResistance(uint8_t index) const;
+    // Calibrated resistance (NVS / setWireResistance()), never refined.
+    float getCalibratedResistance(uint8_t index) const;
     void  setWireResistance(uint8_t index, float ohms);
+    // Estimator update of the working value only (not persisted).
+    void  applyResistanceEstimate(uint8_t index, float ohms);
 
     bool  getAccessFlag(uint8_t index) const;
     void  setAccessFlag(uint8_t index, bool allowed);
@@ -178,6 +185,7 @@ public:
 
 private:
     float _wireR[HeaterManager::kWireCount]  = { DEFAULT_WIRE_RES_OHMS };
+    float _calR[HeaterManager::kWireCount]   = { DEFAULT_WIRE_RES_OHMS };
     bool  _access[HeaterManager::kWireCount] = { false };
     float _wireOhmPerM  = DEFAULT_WIRE_OHM_PER_M;
     int   _wireGaugeAwg = DEFAULT_WIRE_GAUGE;
@@ -236,6 +244,13 @@ public:
                          HeaterManager& heater);
 
     double getWireTemp(uint8_t index) const;
+    // Per-wire model parameters and last integration timestamp (warm start).
+    bool   getWireThermalParams(uint8_t index,
+                                double& tauSec,
+                                double& kLoss,
+                                double& thermalMassC) const;
+    uint32_t getWireUpdateMs(uint8_t index) const;
+    bool   isInitialized() const { return _initialized; }
     void   setThermalParams(double tauSec, double kLoss, double thermalMassC);
     void   setWireThermalParams(uint8_t index,
                                 double tauSec,
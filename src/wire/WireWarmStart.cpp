@@ -0,0 +1,52 @@
+#include <WireWarmStart.hpp>
+
+#include <math.h>
+
+WarmStartMode WireWarmStart::assess(const Evidence& ev, const Config& cfg) {
+  if (!ev.modelReady) return WarmStartMode::Unknown;
+  if (ev.maxModelAgeMs > cfg.staleMs) return WarmStartMode::Unknown;
+  if (ev.ranThisBoot) return WarmStartMode::Tracked;
+
+  if (isfinite(ev.maxTauS) && ev.maxTauS > 0.0f) {
+    const float coldMs = cfg.coldTaus * ev.maxTauS * 1000.0f;
+    if (static_cast<float>(ev.uptimeMs) >= coldMs) return WarmStartMode::ColdSinceBoot;
+    return WarmStartMode::Bounded;
+  }
+  return WarmStartMode::Unknown;
+}
+
+float WireWarmStart::boundedSeedC(float ambientC, float tMaxC, float tauS, uint32_t uptimeMs) {
+  if (!isfinite(ambientC) || !isfinite(tMaxC)) return tMaxC;
+  if (tMaxC <= ambientC) return ambientC;
+  if (!isfinite(tauS) || tauS <= 0.0f) return tMaxC;
+  const float decay = expf(-(uptimeMs * 0.001f) / tauS);
+  return ambientC + (tMaxC - ambientC) * decay;
+}
+
+uint16_t WireWarmStart::headroomOnMs(float tempC, float ambientC, float limitC,
+                                     float powerW, float capJPerK, float kWPerK,
+                                     uint16_t frameMs) {
+  if (!isfinite(powerW) || powerW <= 0.0f) return frameMs;
+  if (!isfinite(capJPerK) || capJPerK <= 0.0f) return frameMs;
+  if (!isfinite(tempC) || !isfinite(limitC)) return frameMs;
+  if (!isfinite(kWPerK) || kWPerK < 0.0f) kWPerK = 0.0f;
+  if (!isfinite(ambientC)) ambientC = tempC;
+
+  // C (limit - T) = P t - k (T - Tamb) F
+  const float lossJ = kWPerK * (tempC - ambientC) * (frameMs * 0.001f);
+  const float budgetJ = capJPerK * (limitC - tempC) + (lossJ > 0.0f ? lossJ : 0.0f);
+  if (budgetJ <= 0.0f) return 0;
+
+  const float tMs = (budgetJ / powerW) * 1000.0f;
+  if (tMs >= static_cast<float>(frameMs)) return frameMs;
+  return static_cast<uint16_t>(floorf(tMs));
+}
+
+const char* WireWarmStart::modeName(WarmStartMode m) {
+  switch (m) {
+    case WarmStartMode::Tracked:       return "tracked";
+    case WarmStartMode::ColdSinceBoot: return "cold";
+    case WarmStartMode::Bounded:       return "bounded";
+    default:                           return "unknown";
+  }
+}
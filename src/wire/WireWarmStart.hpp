@@ -0,0 +1,73 @@
+#ifndef WIRE_WARM_START_HPP
+#define WIRE_WARM_START_HPP
+
+#include <cstdint>
+
+/**
+ * Warm restart of the energy loop from the wire thermal model.
+ *
+ * Instead of forcing every wire estimate to the 150 C worst case and
+ * blocking until the model has cooled to ambient, StartLoop asks how far
+ * the current estimate can be trusted:
+ *
+ *  - Tracked        a run already happened this boot and the thermal task
+ *                   has integrated the cool-down since: use the estimate.
+ *  - ColdSinceBoot  no run this boot and the device has been up for
+ *                   coldTaus wire time constants: any pre-boot heat is gone.
+ *  - Bounded        no run this boot, short uptime: seed each wire with the
+ *                   worst case (tMax at boot) decayed over the uptime.
+ *  - Unknown        model not initialised or stale: caller keeps the old
+ *                   worst-case wait.
+ *
+ * Residual heat is then charged against the frame energy budget:
+ * headroomOnMs() is the longest on-time that keeps the lumped model
+ *   C dT/dt = P - k (T - Tamb)
+ * at or below the limit by the end of the frame (loss taken at the start
+ * temperature, so the bound is conservative).
+ */
+
+#ifndef WIRE_WARM_STALE_MS
+#define WIRE_WARM_STALE_MS      5000    // estimate older than this is not trusted
+#endif
+#ifndef WIRE_WARM_COLD_TAUS
+#define WIRE_WARM_COLD_TAUS     5.0f    // uptime (in wire taus) after which boot heat is gone
+#endif
+
+enum class WarmStartMode : uint8_t {
+  Tracked = 0,
+  ColdSinceBoot = 1,
+  Bounded = 2,
+  Unknown = 3
+};
+
+class WireWarmStart {
+public:
+  struct Evidence {
+    bool modelReady = false;      // thermal model initialised
+    bool ranThisBoot = false;     // a RUN ended earlier in this boot
+    uint32_t uptimeMs = 0;
+    uint32_t maxModelAgeMs = 0;   // oldest per-wire estimate age
+    float maxTauS = 0.0f;         // slowest wire time constant
+  };
+
+  struct Config {
+    uint32_t staleMs = WIRE_WARM_STALE_MS;
+    float coldTaus = WIRE_WARM_COLD_TAUS;
+  };
+
+  static WarmStartMode assess(const Evidence& ev, const Config& cfg);
+
+  // Worst case for Bounded: the wire was at tMaxC at boot and has only
+  // been cooling since.
+  static float boundedSeedC(float ambientC, float tMaxC, float tauS, uint32_t uptimeMs);
+
+  // Longest on-time [ms] in a frame that keeps the model at or below
+  // limitC. Returns frameMs when the wire cannot reach the limit.
+  static uint16_t headroomOnMs(float tempC, float ambientC, float limitC,
+                               float powerW, float capJPerK, float kWPerK,
+                               uint16_t frameMs);
+
+  static const char* modeName(WarmStartMode m);
+};
+
+#endif // WIRE_WARM_START_HPP
@@ -0,0 +1,238 @@
+// Host benchmark: CborStream writes straight into a file vs through
+// BlockWriter (CborStream::BufferedPrint).
+//
+// The payload is PowerTracker::saveHistoryToFile for a full 800-entry
+// history, written with the same call pattern CborStream uses: one call
+// per header byte, per big-endian integer byte and per text body. The
+// sink is a mock file that counts write calls and bytes and charges a
+// fixed cost per call (vfs lock + SPIFFS bookkeeping), so the call count
+// dominates like it does on the device.
+// Paths:
+//   direct    every CborStream call reaches the file
+//   blockN    BlockWriter with an N-byte block, flushed at the end
+// Output bytes must be identical. Error cases: a full disk (the file takes
+// only part of a block), a partial write and a memory sink overflow must
+// latch, make flush() fail and report the bytes actually delivered.
+//
+// Build & run from the repo root:
+//   g++ -std=c++17 -O2 -Isrc/utils -o /tmp/block_writer_bench
+//       tools/block_writer_bench.cpp src/utils/BlockWriter.cpp
+//       src/utils/CborNumber.cpp
+//   /tmp/block_writer_bench
+
+#include <BlockWriter.hpp>
+#include <CborNumber.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+// --- Mock file ---
+struct MockFile {
+  std::vector<uint8_t> bytes;
+  size_t capacity = SIZE_MAX;   // "disk" size
+  size_t maxPerCall = SIZE_MAX; // partial-write limit
+  uint32_t calls = 0;
+  volatile uint32_t work = 0;
+
+  size_t write(const uint8_t* data, size_t len) {
+    ++calls;
+    for (int k = 0; k < 40; ++k) work = work + k;  // per-call overhead
+    size_t n = len;
+    if (n > maxPerCall) n = maxPerCall;
+    if (bytes.size() + n > capacity) n = capacity - bytes.size();
+    bytes.insert(bytes.end(), data, data + n);
+    return n;
+  }
+
+  static size_t sink(void* ctx, const uint8_t* data, size_t len) {
+    return static_cast<MockFile*>(ctx)->write(data, len);
+  }
+};
+
+// Byte-oriented target, like Arduino's Print.
+struct Out {
+  virtual size_t write(const uint8_t* data, size_t len) = 0;
+  virtual ~Out() = default;
+};
+
+struct DirectOut : Out {
+  MockFile& f;
+  explicit DirectOut(MockFile& file) : f(file) {}
+  size_t write(const uint8_t* data, size_t len) override { return f.write(data, len); }
+};
+
+struct BufferedOut : Out {
+  BlockWriter w;
+  BufferedOut(MockFile& file, uint8_t* block, size_t size) : w(block, size, &MockFile::sink, &file) {}
+  BufferedOut(uint8_t* mem, size_t cap) : w(mem, cap) {}
+  size_t write(const uint8_t* data, size_t len) override { return w.write(data, len); }
+};
+
+// --- CborStream's call pattern ---
+bool writeByte(Out& o, uint8_t v) { return o.write(&v, 1) == 1; }
+bool writeUintBE(Out& o, uint64_t v, int bytes) {
+  for (int i = 0; i < bytes; ++i) {
+    if (!writeByte(o, static_cast<uint8_t>(v >> (8 * (bytes - 1 - i))))) return false;
+  }
+  return true;
+}
+bool writeMajorAndLen(Out& o, uint8_t major, uint64_t len) {
+  if (len < 24) return writeByte(o, static_cast<uint8_t>((major << 5) | len));
+  if (len <= 0xFF) return writeByte(o, static_cast<uint8_t>((major << 5) | 24)) && writeByte(o, static_cast<uint8_t>(len));
+  if (len <= 0xFFFF) return writeByte(o, static_cast<uint8_t>((major << 5) | 25)) && writeUintBE(o, len, 2);
+  return writeByte(o, static_cast<uint8_t>((major << 5) | 26)) && writeUintBE(o, len, 4);
+}
+bool writeText(Out& o, const char* s) {
+  const size_t l = std::strlen(s);
+  return writeMajorAndLen(o, 3, l) && o.write(reinterpret_cast<const uint8_t*>(s), l) == l;
+}
+bool writeNumber(Out& o, double v, CborNumber::Resolution res) {
+  uint8_t buf[CborNumber::kMaxBytes];
+  const size_t len = CborNumber::encode(v, res, buf);
+  return o.write(buf, len) == len;
+}
+
+struct Entry {
+  uint32_t startMs, durationS;
+  float energyWh, peakPowerW, peakCurrentA;
+};
+
+std::vector<Entry> history() {
+  std::mt19937 rng(1);
+  std::normal_distribution<float> noise(0.0f, 1.0f);
+  std::vector<Entry> v(800);
+  for (size_t k = 0; k < v.size(); ++k) {
+    v[k] = {1000000u + 3600000u * static_cast<uint32_t>(k), 600u + static_cast<uint32_t>(k % 1200),
+            40.0f + 5.0f * noise(rng), 2300.0f + 40.0f * noise(rng), 7.2f + 0.1f * noise(rng)};
+  }
+  return v;
+}
+
+// Mirrors PowerTracker::saveHistoryToFile.
+bool saveHistory(Out& o, const std::vector<Entry>& h) {
+  bool ok = true;
+  ok = ok && writeMajorAndLen(o, 5, 1);
+  ok = ok && writeText(o, "history");
+  ok = ok && writeMajorAndLen(o, 4, h.size());
+  for (size_t k = 0; k < h.size() && ok; ++k) {
+    ok = ok && writeMajorAndLen(o, 5, 5);
+    ok = ok && writeText(o, "start_ms") && writeMajorAndLen(o, 0, h[k].startMs);
+    ok = ok && writeText(o, "duration_s") && writeMajorAndLen(o, 0, h[k].durationS);
+    ok = ok && writeText(o, "energy_Wh") && writeNumber(o, h[k].energyWh, CborNumber::kEnergy);
+    ok = ok && writeText(o, "peakPower_W") && writeNumber(o, h[k].peakPowerW, CborNumber::kPower);
+    ok = ok && writeText(o, "peakCurrent_A") && writeNumber(o, h[k].peakCurrentA, CborNumber::kCurrent);
+  }
+  return ok;
+}
+
+double timeIt(const std::vector<Entry>& h, size_t blockSize, MockFile& file) {
+  const int rounds = 50;
+  std::vector<uint8_t> block(blockSize ? blockSize : 1);
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    file = MockFile{};
+    if (blockSize == 0) {
+      DirectOut o(file);
+      saveHistory(o, h);
+    } else {
+      BufferedOut o(file, block.data(), block.size());
+      saveHistory(o, h);
+      o.w.flush();
+    }
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() / rounds;
+}
+
+bool errors(const std::vector<Entry>& h, size_t fileBytes) {
+  bool ok = true;
+  uint8_t block[512];
+
+  // Full disk: the file stops halfway through a block.
+  {
+    MockFile file;
+    file.capacity = fileBytes / 2 + 100;
+    BufferedOut o(file, block, sizeof(block));
+    const bool wrote = saveHistory(o, h);
+    const bool flushed = o.w.flush();
+    const bool pass = !flushed && o.w.error() == BlockWriter::Error::ShortWrite &&
+                      o.w.delivered() == file.capacity && file.bytes.size() == file.capacity;
+    std::printf("  full disk:        writes %s, flush %s, delivered %zu of %zu  %s\n",
+                wrote ? "ok" : "stopped", flushed ? "ok" : "failed", o.w.delivered(), fileBytes,
+                pass ? "ok" : "FAILED");
+    ok = ok && pass;
+  }
+
+  // Partial write: the sink takes 100 bytes of each call.
+  {
+    MockFile file;
+    file.maxPerCall = 100;
+    BufferedOut o(file, block, sizeof(block));
+    saveHistory(o, h);
+    const bool flushed = o.w.flush();
+    const bool pass = !flushed && o.w.error() == BlockWriter::Error::ShortWrite &&
+                      o.w.delivered() == 100 && o.w.sinkCalls() == 1;
+    std::printf("  partial write:    flush %s after %u sink call(s), delivered %zu  %s\n",
+                flushed ? "ok" : "failed", o.w.sinkCalls(), o.w.delivered(), pass ? "ok" : "FAILED");
+    ok = ok && pass;
+  }
+
+  // Memory sink too small, then large enough.
+  {
+    std::vector<uint8_t> mem(fileBytes - 1);
+    BufferedOut small(mem.data(), mem.size());
+    const bool wrote = saveHistory(small, h);
+    const bool pass = !wrote && small.w.error() == BlockWriter::Error::Overflow &&
+                      small.w.size() == mem.size();
+    std::printf("  memory overflow:  %s at %zu bytes  %s\n",
+                wrote ? "no error" : "stopped", small.w.size(), pass ? "ok" : "FAILED");
+    ok = ok && pass;
+
+    std::vector<uint8_t> big(fileBytes);
+    BufferedOut fit(big.data(), big.size());
+    MockFile ref;
+    DirectOut direct(ref);
+    saveHistory(direct, h);
+    const bool fitOk = saveHistory(fit, h) && fit.w.flush() && fit.w.size() == fileBytes &&
+                       std::memcmp(big.data(), ref.bytes.data(), fileBytes) == 0;
+    std::printf("  memory sink:      %zu bytes, identical  %s\n", fit.w.size(), fitOk ? "ok" : "FAILED");
+    ok = ok && fitOk;
+  }
+  return ok;
+}
+
+} // namespace
+
+int main() {
+  const std::vector<Entry> h = history();
+
+  MockFile ref;
+  DirectOut direct(ref);
+  if (!saveHistory(direct, h)) return 1;
+  const size_t fileBytes = ref.bytes.size();
+
+  std::printf("history save, %zu entries, %zu bytes:\n", h.size(), fileBytes);
+  bool ok = true;
+  const size_t sizes[] = {0, 64, 256, 512, 1024};
+  for (size_t bs : sizes) {
+    MockFile file;
+    const double us = timeIt(h, bs, file);
+    const bool same = file.bytes == ref.bytes;
+    ok = ok && same;
+    char name[32];
+    if (bs == 0) std::snprintf(name, sizeof(name), "direct");
+    else std::snprintf(name, sizeof(name), "block%zu", bs);
+    std::printf("  %-9s %6u file writes  %8.1f us  %s\n", name, file.calls, us,
+                same ? "identical" : "BYTES DIFFER");
+  }
+
+  std::printf("errors:\n");
+  ok = errors(h, fileBytes) && ok;
+  std::printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
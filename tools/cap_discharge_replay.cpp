@@ -0,0 +1,245 @@
+// Host replay: capacitor bank bleed through the heater wires.
+//
+// discharge() mirrors CpDischg::discharge() and the round loop of
+// Device::dischargeCapBank(): relay open, per-wire conductance from the
+// 44 ohm cache, CapDischargeController in CAP_DISCHARGE_STEP_MS steps,
+// open wires dropped between rounds. The masks go through Outputs, which
+// copies HeaterManager's gates: setOutputMask() writes 0 outside Running,
+// setDischargeMask() does not, and the emergency cut wins over both.
+// The bank decays through the wires actually switched on
+// (V *= exp(-G dt / C) per step). Each ADC read gets Gaussian noise and
+// a step sample is the mean of CAP_DISCHARGE_ADC_AVG reads.
+//
+// Checked:
+//   - the calibration path (device not Running) through setOutputMask()
+//     never switches a wire and stalls every round; setDischargeMask()
+//     reaches the threshold close to the model prediction
+//   - a latched emergency cut keeps every wire off
+//   - an open wire is flagged and the rest still finish the discharge,
+//     also with a wrong calibrated capacitance; with ADC noise in at
+//     least 90 % of the seeds (a miss only costs discharge time). On a
+//     small bank the discharge is over before the wires can be told apart
+//   - no wire is flagged on a healthy bank across noise (also without
+//     averaging), capacitance error and seeds
+//
+// Build & run from the repo root:
+//   g++ -std=c++17 -O2 -Isrc/control -o /tmp/cap_discharge_replay
+//       tools/cap_discharge_replay.cpp src/control/CapDischargeController.cpp
+//   /tmp/cap_discharge_replay
+
+#include <CapDischargeController.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool cond, const char* what) {
+  std::printf("  %-62s %s\n", what, cond ? "ok" : "FAILED");
+  if (!cond) ++failures;
+}
+
+constexpr int kWires = 10;              // HeaterManager::kWireCount
+constexpr double kWireOhm = 44.0;       // DEFAULT_WIRE_RES_OHMS
+constexpr double kV0 = 325.0;           // DEFAULT_DC_VOLTAGE
+constexpr float kVSafe = 5.0f;          // dischargeCapBank(5.0f, 3)
+constexpr int kRounds = 3;
+constexpr float kMaxCurrentA = 36.0f * 0.9f;  // DEFAULT_CURR_LIMIT_A * 0.9
+constexpr uint32_t kStepUs = 5000;      // CAP_DISCHARGE_STEP_MS
+constexpr int kAdcAvg = 32;             // CAP_DISCHARGE_ADC_AVG
+constexpr uint16_t kAllMask = (1u << kWires) - 1u;
+
+// HeaterManager output gates.
+struct Outputs {
+  bool running = false;
+  bool cut = false;
+  uint16_t mask = 0;
+
+  void setOutputMask(uint16_t m) { applyMask(running ? m : 0); }
+  void setDischargeMask(uint16_t m) { applyMask(m); }
+  void applyMask(uint16_t m) { mask = cut ? 0 : (m & kAllMask); }
+  void disableAll() { mask = 0; }
+};
+
+enum class Path { OutputMask, DischargeMask };
+
+struct Bank {
+  double capF = 0.002;
+  uint16_t openMask = 0;   // wires that carry no current
+  double v = kV0;
+
+  double conductance(uint16_t m) const {
+    double g = 0.0;
+    for (int i = 0; i < kWires; ++i) {
+      if ((m & (1u << i)) && !(openMask & (1u << i))) g += 1.0 / kWireOhm;
+    }
+    return g;
+  }
+};
+
+struct Result {
+  CapDischargeController::Report last;
+  int rounds = 0;
+  uint32_t totalMs = 0;
+  uint16_t flagged = 0;    // open masks reported over all rounds
+  bool ok = false;
+};
+
+// readNoiseV: sigma of one ADC read in bus volts; avg: reads per sample.
+Result discharge(Path path, Bank bank, double capErr, double readNoiseV, uint32_t seed,
+                 bool cut = false, int avg = kAdcAvg) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  const double sigma = readNoiseV / std::sqrt(static_cast<double>(avg));
+  auto sample = [&]() { return static_cast<float>(bank.v + sigma * noise(rng)); };
+
+  Outputs out;            // calibration runs outside Running
+  out.cut = cut;
+
+  CapDischargeController::Config cfg;
+  cfg.capF = static_cast<float>(bank.capF * (1.0 + capErr));
+  cfg.vSafe = kVSafe;
+  cfg.maxCurrentA = kMaxCurrentA;
+
+  Result res;
+  uint16_t allowed = kAllMask;
+  uint32_t tUs = 1000;
+  for (int round = 0; round < kRounds && allowed != 0; ++round) {
+    CapDischargeController::Wire wires[kWires];
+    for (int i = 0; i < kWires; ++i) {
+      if (allowed & (1u << i)) wires[i].gS = static_cast<float>(1.0 / kWireOhm);
+    }
+    out.disableAll();
+    CapDischargeController ctl;
+    float v = sample();
+    ctl.begin(cfg, wires, kWires, v, tUs);
+    while (ctl.report().status == CapDischargeController::Status::Running) {
+      const uint16_t mask = ctl.nextMask(v);
+      if (mask == 0) break;
+      if (path == Path::OutputMask) out.setOutputMask(mask);
+      else out.setDischargeMask(mask);
+      bank.v *= std::exp(-bank.conductance(out.mask) * (kStepUs * 1e-6) / bank.capF);
+      tUs += kStepUs;
+      v = sample();
+      ctl.update(mask, v, tUs);
+    }
+    out.disableAll();
+
+    res.last = ctl.report();
+    res.rounds = round + 1;
+    res.totalMs += res.last.elapsedMs;
+    res.flagged |= res.last.openMask;
+    allowed &= static_cast<uint16_t>(~res.last.openMask);
+    res.ok = res.last.status == CapDischargeController::Status::Done;
+    if (res.ok || res.last.status == CapDischargeController::Status::NoLoad) break;
+  }
+  return res;
+}
+
+void gate() {
+  std::printf("output gate (2 mF, 10 x 44 ohm, %.0f V -> %.0f V, %.1f A cap)\n",
+              kV0, kVSafe, kMaxCurrentA);
+  Bank bank;
+
+  const Result old = discharge(Path::OutputMask, bank, 0.0, 0.0, 1);
+  std::printf("  setOutputMask:    %s after %d rounds, %.1f V left, %.2f J\n",
+              CapDischargeController::statusName(old.last.status), old.rounds,
+              old.last.vEnd, old.last.totalJ);
+  expect(!old.ok && old.last.status == CapDischargeController::Status::Stalled &&
+         old.rounds == kRounds && old.last.vEnd > kV0 - 1.0,
+         "setOutputMask outside Running: nothing switches, stalls");
+
+  const Result now = discharge(Path::DischargeMask, bank, 0.0, 0.0, 1);
+  std::printf("  setDischargeMask: %s in %u ms (model %u ms), %.1f J, %u steps\n",
+              CapDischargeController::statusName(now.last.status), now.totalMs,
+              now.last.modelMs, now.last.totalJ, now.last.steps);
+  expect(now.ok && now.rounds == 1 && now.flagged == 0, "setDischargeMask: done in one round");
+  expect(now.totalMs <= now.last.modelMs + 2 * kStepUs / 1000,
+         "within two steps of the model time");
+  const double bankJ = 0.5 * bank.capF * (kV0 * kV0 - kVSafe * kVSafe);
+  expect(std::fabs(now.last.totalJ - bankJ) < 0.02 * bankJ, "energy accounted to the wires");
+
+  float eMin = 1e9f, eMax = 0.0f;
+  for (int i = 0; i < kWires; ++i) {
+    eMin = std::fmin(eMin, now.last.energyJ[i]);
+    eMax = std::fmax(eMax, now.last.energyJ[i]);
+  }
+  std::printf("  per-wire energy %.2f .. %.2f J\n", eMin, eMax);
+  expect(now.last.usedMask == kAllMask && eMax < 1.5f * now.last.totalJ / kWires,
+         "every wire used, none above 1.5x its share");
+
+  const Result cut = discharge(Path::DischargeMask, bank, 0.0, 0.0, 1, true);
+  expect(!cut.ok && cut.last.totalJ < 0.01f && cut.flagged == 0,
+         "latched emergency cut keeps every wire off");
+}
+
+void openWire() {
+  std::printf("open wire (wire 4 open, %d reads per sample)\n", kAdcAvg);
+  struct Case { double capF; double capErr; double noiseV; bool flags; };
+  const Case cases[] = {
+      {0.010, 0.0, 0.0, true},  {0.010, -0.3, 0.0, true}, {0.010, 0.3, 0.0, true},
+      {0.010, 0.0, 2.0, true},  {0.010, -0.3, 2.0, true}, {0.010, 0.3, 2.0, true},
+      {0.002, 0.0, 0.0, false}, {0.002, 0.0, 2.0, false},
+  };
+  for (const Case& c : cases) {
+    Bank bank;
+    bank.capF = c.capF;
+    bank.openMask = 1u << 3;
+    int hit = 0, done = 0, wrong = 0;
+    uint32_t worstMs = 0;
+    const int seeds = (c.noiseV > 0.0) ? 50 : 1;
+    for (int s = 0; s < seeds; ++s) {
+      const Result r = discharge(Path::DischargeMask, bank, c.capErr, c.noiseV, 100 + s);
+      if (r.flagged == bank.openMask) ++hit;
+      if (r.flagged & ~bank.openMask) ++wrong;
+      if (r.ok) ++done;
+      if (r.totalMs > worstMs) worstMs = r.totalMs;
+    }
+    char what[96];
+    std::snprintf(what, sizeof(what),
+                  "%2.0f mF, C %+3.0f %%, %.0f V/read: flagged %d/%d, done %d/%d, %u ms",
+                  c.capF * 1000.0, c.capErr * 100.0, c.noiseV, hit, seeds, done, seeds,
+                  worstMs);
+    const bool found = c.flags ? (hit * 10 >= seeds * 9) : (hit == 0);
+    expect(found && wrong == 0 && done == seeds, what);
+  }
+}
+
+void healthy() {
+  std::printf("healthy bank (no false flags)\n");
+  struct Case { double noiseV; int avg; };
+  const Case cases[] = {{0.0, kAdcAvg}, {2.0, kAdcAvg}, {4.0, kAdcAvg}, {2.0, 1}};
+  for (double capF : {0.002, 0.010}) {
+    for (const Case& c : cases) {
+      int flagged = 0, done = 0, runs = 0;
+      for (double capErr : {-0.3, -0.15, 0.0, 0.15, 0.3}) {
+        for (int s = 0; s < 40; ++s, ++runs) {
+          Bank bank;
+          bank.capF = capF;
+          const Result r = discharge(Path::DischargeMask, bank, capErr, c.noiseV, 200 + s,
+                                     false, c.avg);
+          if (r.flagged) ++flagged;
+          if (r.ok) ++done;
+        }
+      }
+      char what[96];
+      std::snprintf(what, sizeof(what),
+                    "%2.0f mF, C +/-30 %%, %.0f V/read x %2d: %d/%d flagged, %d/%d done",
+                    capF * 1000.0, c.noiseV, c.avg, flagged, runs, done, runs);
+      expect(flagged == 0 && done == runs, what);
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  gate();
+  openWire();
+  healthy();
+  std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
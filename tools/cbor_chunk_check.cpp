@@ -0,0 +1,284 @@
+// Host check: chunked CBOR bodies (CborChunkStream) against the buffered
+// encode the /session_history and /calib_data routes used before.
+//
+// For a full history (800 rows) and a calibration page (200 samples) the
+// body is encoded twice:
+//   buffered  one nested encode into a vector of the old guessed capacity
+//             (256 + n * 80, 4096 + n * 160)
+//   chunked   head / one row per piece / breaks, drained by fill() with a
+//             range of chunk sizes (1 byte, sizes around kScratch, typical
+//             AsyncTCP windows, random)
+// and the bytes must match exactly. Peak heap for each path is reported
+// from a global operator new shim.
+// tinycbor is not available on host: the minimal writer below emits the
+// same bytes (indefinite map/array, text, uint, nint, bool, double).
+//
+// Build & run from the repo root:
+//   g++ -std=c++17 -O2 -Isrc/comms -o /tmp/cbor_chunk_check
+//       tools/cbor_chunk_check.cpp src/comms/CborChunkStream.cpp
+//   /tmp/cbor_chunk_check
+
+#include <CborChunkStream.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace {
+
+size_t gLive = 0;
+size_t gPeak = 0;
+
+void* countedAlloc(size_t n) {
+  size_t* p = static_cast<size_t*>(std::malloc(sizeof(size_t) + (n ? n : 1)));
+  if (!p) throw std::bad_alloc();
+  *p = n;
+  gLive += n;
+  if (gLive > gPeak) gPeak = gLive;
+  return p + 1;
+}
+
+void countedFree(void* q) {
+  if (!q) return;
+  size_t* p = static_cast<size_t*>(q) - 1;
+  gLive -= *p;
+  std::free(p);
+}
+
+// --- Minimal CBOR writer (tinycbor-compatible output) ---
+struct Cbor {
+  uint8_t* p;
+  size_t cap;
+  size_t n = 0;
+  bool ok = true;
+  void put(uint8_t b) {
+    if (n < cap) p[n] = b;
+    else ok = false;
+    ++n;
+  }
+  void head(uint8_t major, uint64_t v) {
+    if (v < 24) { put(static_cast<uint8_t>((major << 5) | v)); return; }
+    int bytes = v <= 0xFF ? 1 : v <= 0xFFFF ? 2 : v <= 0xFFFFFFFFull ? 4 : 8;
+    put(static_cast<uint8_t>((major << 5) | (bytes == 1 ? 24 : bytes == 2 ? 25 : bytes == 4 ? 26 : 27)));
+    for (int s = (bytes - 1) * 8; s >= 0; s -= 8) put(static_cast<uint8_t>(v >> s));
+  }
+  void text(const char* s) {
+    const size_t l = std::strlen(s);
+    head(3, l);
+    for (size_t i = 0; i < l; ++i) put(static_cast<uint8_t>(s[i]));
+  }
+  void uint(uint64_t v) { head(0, v); }
+  void sint(int64_t v) { if (v >= 0) head(0, v); else head(1, static_cast<uint64_t>(-1 - v)); }
+  void boolean(bool b) { put(b ? 0xF5 : 0xF4); }
+  void dbl(double d) {
+    uint64_t u;
+    std::memcpy(&u, &d, sizeof(u));
+    put(0xFB);
+    for (int s = 56; s >= 0; s -= 8) put(static_cast<uint8_t>(u >> s));
+  }
+  void openMap() { put(0xBF); }
+  void openArray() { put(0x9F); }
+  void close() { put(0xFF); }
+};
+
+struct HistoryRow {
+  uint32_t startMs, durationS;
+  double energyWh, peakW, peakA;
+};
+
+struct CalSample {
+  uint32_t tMs;
+  double v, i, tempC, roomC, ntcV, ntcOhm;
+  int32_t ntcAdc;
+  bool ntcOk, pressed;
+};
+
+void writeHistoryRow(Cbor& c, const HistoryRow& h) {
+  c.openMap();
+  c.text("start_ms"); c.uint(h.startMs);
+  c.text("duration_s"); c.uint(h.durationS);
+  c.text("energy_Wh"); c.dbl(h.energyWh);
+  c.text("peakPower_W"); c.dbl(h.peakW);
+  c.text("peakCurrent_A"); c.dbl(h.peakA);
+  c.close();
+}
+
+void writeCalRow(Cbor& c, const CalSample& s) {
+  c.openMap();
+  c.text("t_ms"); c.uint(s.tMs);
+  c.text("v"); c.dbl(s.v);
+  c.text("i"); c.dbl(s.i);
+  c.text("temp_c"); c.dbl(s.tempC);
+  c.text("room_c"); c.dbl(s.roomC);
+  c.text("ntc_v"); c.dbl(s.ntcV);
+  c.text("ntc_ohm"); c.dbl(s.ntcOhm);
+  c.text("ntc_adc"); c.sint(s.ntcAdc);
+  c.text("ntc_ok"); c.boolean(s.ntcOk);
+  c.text("pressed"); c.boolean(s.pressed);
+  c.close();
+}
+
+void writeCalMeta(Cbor& c, uint16_t total) {
+  c.text("meta");
+  c.openMap();
+  c.text("mode"); c.text("model");
+  c.text("running"); c.boolean(false);
+  c.text("count"); c.uint(total);
+  c.text("capacity"); c.uint(2048);
+  c.text("interval_ms"); c.uint(500);
+  c.text("start_ms"); c.uint(123456);
+  c.text("start_epoch"); c.uint(1760000000);
+  c.text("saved"); c.boolean(true);
+  c.text("saved_ms"); c.uint(654321);
+  c.text("saved_epoch"); c.uint(1760000600);
+  c.text("target_c"); c.dbl(150.0);
+  c.text("wire_index"); c.uint(3);
+  c.text("offset"); c.uint(0);
+  c.text("limit"); c.uint(200);
+  c.close();
+  c.text("samples");
+}
+
+// Mirrors WiFiCbor::makeArrayStream: head, one row per piece, two breaks.
+template <typename Head, typename Row>
+std::shared_ptr<CborChunkStream> makeStream(Head head, Row row, size_t rows) {
+  size_t i = 0;
+  uint8_t stage = 0;
+  return std::make_shared<CborChunkStream>(
+      [head, row, rows, i, stage](uint8_t* buf, size_t cap, size_t& len) mutable {
+        using Step = CborChunkStream::Step;
+        Cbor c{buf, cap};
+        if (stage == 0) {
+          c.openMap();
+          head(c);
+          c.openArray();
+          stage = 1;
+        } else if (stage == 1 && i < rows) {
+          row(c, i++);
+        } else if (stage != 3) {
+          len = CborChunkStream::writeBreaks(buf, cap, 2);
+          stage = 3;
+          return Step::Piece;
+        } else {
+          return Step::Done;
+        }
+        len = c.n;
+        return c.ok ? Step::Piece : Step::Error;
+      });
+}
+
+template <typename Head, typename Row>
+std::vector<uint8_t> buffered(Head head, Row row, size_t rows, size_t capacity, size_t& peak) {
+  gLive = gPeak = 0;
+  std::vector<uint8_t> out(capacity, 0);
+  Cbor c{out.data(), out.size()};
+  c.openMap();
+  head(c);
+  c.openArray();
+  for (size_t i = 0; i < rows; ++i) row(c, i);
+  c.close();
+  c.close();
+  out.resize(c.ok ? c.n : 0);
+  peak = gPeak;
+  return out;
+}
+
+// Drains the stream like AsyncWebServer's chunked response: a fresh
+// window each call, sized by sizeFn.
+template <typename SizeFn>
+std::vector<uint8_t> chunked(std::shared_ptr<CborChunkStream> s, SizeFn sizeFn,
+                             size_t& calls) {
+  std::vector<uint8_t> out;
+  std::vector<uint8_t> window;
+  calls = 0;
+  for (;;) {
+    window.assign(sizeFn(), 0);
+    const size_t n = s->fill(window.data(), window.size());
+    ++calls;
+    if (n == 0) break;
+    out.insert(out.end(), window.begin(), window.begin() + n);
+  }
+  return out;
+}
+
+template <typename Head, typename Row>
+bool check(const char* name, Head head, Row row, size_t rows, size_t legacyCap) {
+  size_t bufPeak = 0;
+  std::vector<uint8_t> ref = buffered(head, row, rows, legacyCap, bufPeak);
+  const bool legacyFit = !ref.empty();
+  if (!legacyFit) {
+    // The guess was too small (the route answered 500); compare against
+    // a buffer that fits.
+    size_t fitPeak = 0;
+    ref = buffered(head, row, rows, legacyCap * 4, fitPeak);
+  }
+
+  gLive = gPeak = 0;
+  auto stream = makeStream(head, row, rows);
+  const size_t streamPeak = gPeak;
+
+  std::printf("%s: %zu rows, %zu B body\n", name, rows, ref.size());
+  std::printf("  buffered peak heap %6zu B%s\n", bufPeak,
+              legacyFit ? "" : "  (old capacity guess overflowed)");
+  std::printf("  chunked  peak heap %6zu B (stream + producer state)\n", streamPeak);
+  stream.reset();
+
+  std::mt19937 rng(42);
+  const size_t fixed[] = {1, 7, 64, CborChunkStream::kScratch - 1, CborChunkStream::kScratch,
+                          CborChunkStream::kScratch + 1, 1436, 5744};
+  bool ok = true;
+  for (size_t w : fixed) {
+    size_t calls = 0;
+    const std::vector<uint8_t> got =
+        chunked(makeStream(head, row, rows), [w] { return w; }, calls);
+    const bool same = got == ref;
+    ok = ok && same;
+    std::printf("  window %5zu B: %5zu calls  %s\n", w, calls, same ? "identical" : "MISMATCH");
+  }
+  size_t calls = 0;
+  const std::vector<uint8_t> got = chunked(
+      makeStream(head, row, rows), [&rng] { return 1 + rng() % 2048; }, calls);
+  ok = ok && got == ref;
+  std::printf("  window random : %5zu calls  %s\n", calls, got == ref ? "identical" : "MISMATCH");
+  return ok;
+}
+
+} // namespace
+
+void* operator new(size_t n) { return countedAlloc(n); }
+void* operator new[](size_t n) { return countedAlloc(n); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t) noexcept { countedFree(p); }
+
+int main() {
+  std::vector<HistoryRow> hist(800);
+  for (size_t i = 0; i < hist.size(); ++i) {
+    hist[i] = {static_cast<uint32_t>(1000 + i * 3600000u), static_cast<uint32_t>(600 + i),
+               12.5 + i * 0.01, 1800.0 + i, 7.5 + i * 0.001};
+  }
+  std::vector<CalSample> cal(200);
+  for (size_t i = 0; i < cal.size(); ++i) {
+    cal[i] = {static_cast<uint32_t>(i * 500), 310.0 - i * 0.1, 5.2, 20.0 + i * 0.6, 21.5,
+              1.65, 10000.0 - i * 20.0, static_cast<int32_t>(2048 - i * 3), true, (i % 17) == 0};
+  }
+
+  const bool h = check(
+      "session_history",
+      [](Cbor& c) { c.text("history"); },
+      [&hist](Cbor& c, size_t i) { writeHistoryRow(c, hist[i]); },
+      hist.size(), 256 + hist.size() * 80);
+  const bool k = check(
+      "calib_data",
+      [](Cbor& c) { writeCalMeta(c, 200); },
+      [&cal](Cbor& c, size_t i) { writeCalRow(c, cal[i]); },
+      cal.size(), 4096 + cal.size() * 160);
+
+  std::printf("%s\n", (h && k) ? "PASS" : "FAIL");
+  return (h && k) ? 0 : 1;
+}
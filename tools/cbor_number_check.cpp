@@ -0,0 +1,276 @@
+// Host check: CborNumber precision policy (shortest exact-enough number).
+//
+// Round trip:
+//   half      every float16 bit pattern survives half -> float -> half;
+//             random floats round to the nearest float16 (ties to even)
+//   fields    random values over each field's range are encoded with the
+//             field's Resolution, decoded with the reference decoder and
+//             must stay within that resolution
+//   edges     0, -0, NaN, +-Inf, float16 limits, 2^53, int64 extremes
+// Size:
+//   the rows of a full session history (800), a calibration capture (200
+//   samples) and a 16-sample live batch, written with every float as
+//   float64 (before) and through the policy (after), keys included.
+// Time: ns per encode() over a mixed value set.
+//
+// Build & run from the repo root:
+//   g++ -std=c++17 -O2 -Isrc/utils -o /tmp/cbor_number_check
+//       tools/cbor_number_check.cpp src/utils/CborNumber.cpp
+//   /tmp/cbor_number_check
+
+#include <CborNumber.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+using CborNumber::Resolution;
+
+bool checkHalf() {
+  for (uint32_t h = 0; h <= 0xFFFF; ++h) {
+    const uint16_t bits = static_cast<uint16_t>(h);
+    if ((bits & 0x7C00u) == 0x7C00u && (bits & 0x3FFu)) continue;  // NaN payloads
+    if (CborNumber::floatToHalf(CborNumber::halfToFloat(bits)) != bits) {
+      std::printf("  half 0x%04X does not survive\n", h);
+      return false;
+    }
+  }
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> mag(-30.0f, 16.0f);
+  for (int k = 0; k < 200000; ++k) {
+    const float f = std::ldexp(1.0f + (rng() & 0xFFFFFF) / 16777216.0f, static_cast<int>(mag(rng)));
+    const uint16_t h = CborNumber::floatToHalf(f);
+    if ((h & 0x7C00u) == 0x7C00u) {
+      if (f < 65520.0f) return false;
+      continue;
+    }
+    // Nearest: neither neighbour is strictly closer.
+    const double e = std::fabs(CborNumber::halfToFloat(h) - static_cast<double>(f));
+    const double lo = std::fabs(CborNumber::halfToFloat(static_cast<uint16_t>(h - 1)) - static_cast<double>(f));
+    const double hi = std::fabs(CborNumber::halfToFloat(static_cast<uint16_t>(h + 1)) - static_cast<double>(f));
+    if ((h != 0 && lo < e) || ((h + 1) < 0x7C00 && hi < e)) {
+      std::printf("  %.9g rounded to 0x%04X, not nearest\n", f, h);
+      return false;
+    }
+  }
+  return true;
+}
+
+struct Field {
+  const char* name;
+  Resolution res;
+  double lo, hi;
+};
+
+const Field kFields[] = {
+    {"capV",          CborNumber::kVoltage,      0.0,   340.0},
+    {"ntc_v",         CborNumber::kSenseVoltage, 0.0,   3.3},
+    {"i",             CborNumber::kCurrent,      0.0,   12.0},
+    {"temp_c",        CborNumber::kTemperature,  -40.0, 400.0},
+    {"peakPower_W",   CborNumber::kPower,        0.0,   4000.0},
+    {"energy_Wh",     CborNumber::kEnergy,       0.0,   500.0},
+    {"ntc_ohm",       CborNumber::kResistance,   50.0,  500000.0},
+    {"progress_pct",  CborNumber::kPercent,      0.0,   100.0},
+};
+
+bool checkFields() {
+  std::mt19937 rng(5);
+  bool ok = true;
+  uint8_t buf[CborNumber::kMaxBytes];
+  for (const Field& f : kFields) {
+    std::uniform_real_distribution<double> d(f.lo, f.hi);
+    double worst = 0.0;
+    size_t bytes = 0;
+    int forms[4] = {0, 0, 0, 0};
+    const int n = 100000;
+    for (int k = 0; k < n; ++k) {
+      // Sources are float fields promoted to double, like the firmware's.
+      const double v = static_cast<float>(d(rng));
+      const size_t len = CborNumber::encode(v, f.res, buf);
+      double back = 0.0;
+      if (CborNumber::decode(buf, len, back) != len) {
+        ok = false;
+        break;
+      }
+      const double tol = std::fmax(f.res.abs, f.res.rel * std::fabs(v));
+      const double err = std::fabs(back - v);
+      if (err > tol) {
+        std::printf("  %s: %.9g -> %.9g (err %.3g > %.3g)\n", f.name, v, back, err, tol);
+        ok = false;
+        break;
+      }
+      if (tol > 0.0 && err / tol > worst) worst = err / tol;
+      bytes += len;
+      ++forms[static_cast<int>(CborNumber::choose(v, f.res).form)];
+    }
+    std::printf("  %-13s %.2f B/value  worst err %.2f of allowed  int %d%% f16 %d%% f32 %d%% f64 %d%%\n",
+                f.name, static_cast<double>(bytes) / n, worst,
+                forms[0] * 100 / n, forms[1] * 100 / n, forms[2] * 100 / n, forms[3] * 100 / n);
+  }
+  return ok;
+}
+
+bool checkEdges() {
+  struct Edge {
+    double v;
+    Resolution res;
+    size_t len;
+  };
+  const Edge edges[] = {
+      {0.0, CborNumber::kExact, 1},
+      {-0.0, CborNumber::kExact, 1},
+      {23.0, CborNumber::kExact, 1},
+      {-24.0, CborNumber::kExact, 1},
+      {0.5, CborNumber::kExact, 3},
+      {65504.0, CborNumber::kExact, 3},         // float16 max; the int is as short
+      {65504.5, CborNumber::kExact, 5},
+      {0.1, CborNumber::kExact, 9},
+      {static_cast<float>(0.1), CborNumber::kExact, 5},
+      {5.960464477539063e-08, CborNumber::kExact, 3},  // smallest float16 subnormal
+      {9007199254740992.0, CborNumber::kExact, 5},     // 2^53 is a float32
+      {9007199254740994.0, CborNumber::kExact, 9},
+      {-9223372036854775808.0, CborNumber::kExact, 5}, // past 2^53: float32
+      {NAN, CborNumber::kExact, 3},
+      {INFINITY, CborNumber::kExact, 3},
+      {-INFINITY, CborNumber::kExact, 3},
+      {317.994, CborNumber::kVoltage, 5},
+      {317.5, CborNumber::kVoltage, 3},
+      {0.004, CborNumber::kVoltage, 1},
+  };
+  bool ok = true;
+  uint8_t buf[CborNumber::kMaxBytes];
+  for (const Edge& e : edges) {
+    const size_t len = CborNumber::encode(e.v, e.res, buf);
+    double back = 0.0;
+    const bool decoded = CborNumber::decode(buf, len, back) == len;
+    const bool same = std::isnan(e.v) ? std::isnan(back)
+                    : back == e.v ||
+                      std::fabs(back - e.v) <= std::fmax(e.res.abs, e.res.rel * std::fabs(e.v));
+    if (!decoded || !same || len != e.len) {
+      std::printf("  edge %.17g: %zu B (want %zu), back %.17g\n", e.v, len, e.len, back);
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+// --- Payload sizes: key text + value, as the writers emit them ---
+struct Sizer {
+  size_t before = 0, after = 0;
+  static size_t textLen(const char* s) {
+    const size_t l = std::strlen(s);
+    return l + (l < 24 ? 1 : 2);
+  }
+  static size_t uintLen(uint64_t v) { return v < 24 ? 1 : v <= 0xFF ? 2 : v <= 0xFFFF ? 3 : v <= 0xFFFFFFFFu ? 5 : 9; }
+  void num(const char* key, double v, Resolution res) {
+    uint8_t buf[CborNumber::kMaxBytes];
+    before += textLen(key) + 9;
+    after += textLen(key) + CborNumber::encode(v, res, buf);
+  }
+  void uint(const char* key, uint64_t v) {
+    before += textLen(key) + uintLen(v);
+    after += textLen(key) + uintLen(v);
+  }
+  void other(const char* key, size_t valueBytes) {
+    before += textLen(key) + valueBytes;
+    after += textLen(key) + valueBytes;
+  }
+  void container() { ++before; ++after; }
+  void report(const char* name) const {
+    std::printf("  %-22s %7zu B -> %7zu B  (%.0f%% smaller)\n", name, before, after,
+                100.0 * (1.0 - static_cast<double>(after) / before));
+  }
+};
+
+void sizes() {
+  std::mt19937 rng(3);
+  std::normal_distribution<float> noise(0.0f, 1.0f);
+
+  Sizer hist;
+  for (int k = 0; k < 800; ++k) {
+    hist.container();
+    hist.uint("start_ms", 1000000u + 3600000u * k);
+    hist.uint("duration_s", 600 + k % 1200);
+    hist.num("energy_Wh", static_cast<float>(40.0 + 5.0 * noise(rng)), CborNumber::kEnergy);
+    hist.num("peakPower_W", static_cast<float>(2300.0 + 40.0 * noise(rng)), CborNumber::kPower);
+    hist.num("peakCurrent_A", static_cast<float>(7.2 + 0.1 * noise(rng)), CborNumber::kCurrent);
+  }
+
+  Sizer calib;
+  for (int k = 0; k < 200; ++k) {
+    const float temp = 22.0f + 0.9f * k + 0.2f * noise(rng);
+    calib.container();
+    calib.uint("t_ms", 500u * k);
+    calib.num("v", static_cast<float>(318.0 + 2.0 * noise(rng)), CborNumber::kVoltage);
+    calib.num("i", static_cast<float>(7.1 + 0.05 * noise(rng)), CborNumber::kCurrent);
+    calib.num("temp_c", temp, CborNumber::kTemperature);
+    calib.num("room_c", static_cast<float>(23.5 + 0.1 * noise(rng)), CborNumber::kTemperature);
+    calib.num("ntc_v", static_cast<float>(1.2 + 0.004 * k), CborNumber::kSenseVoltage);
+    calib.num("ntc_ohm", static_cast<float>(10000.0 * std::exp(-0.02 * k)), CborNumber::kResistance);
+    calib.uint("ntc_adc", 1500 + 5 * k);
+    calib.other("ntc_ok", 1);
+    calib.other("pressed", 1);
+  }
+
+  Sizer live;
+  for (int k = 0; k < 16; ++k) {
+    live.container();
+    live.uint("seq", 4000 + k);
+    live.uint("ts", 812345u + 250u * k);
+    live.num("capV", static_cast<float>(318.0 + 2.0 * noise(rng)), CborNumber::kVoltage);
+    live.num("i", static_cast<float>(7.1 + 0.05 * noise(rng)), CborNumber::kCurrent);
+    live.uint("mask", 1u << (k % 10));
+    live.other("relay", 1);
+    live.other("ac", 1);
+    live.uint("fan", 40);
+    live.other("wireTemps", 2 + 10 * 2);
+  }
+
+  std::printf("payload size (float64 -> policy):\n");
+  hist.report("history, 800 rows");
+  calib.report("calibration, 200 rows");
+  live.report("live batch, 16 rows");
+}
+
+void timing() {
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<double> d(0.0, 400.0);
+  std::vector<double> values(4096);
+  for (double& v : values) v = static_cast<float>(d(rng));
+  uint8_t buf[CborNumber::kMaxBytes];
+  size_t sink = 0;
+  const int rounds = 200;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (size_t k = 0; k < values.size(); ++k) {
+      sink += CborNumber::encode(values[k], kFields[k & 7].res, buf);
+    }
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (rounds * values.size());
+  std::printf("encode: %.1f ns/value (host; %zu bytes total)\n", ns, sink);
+}
+
+} // namespace
+
+int main() {
+  bool ok = true;
+  const bool half = checkHalf();
+  std::printf("float16 conversion: %s\n", half ? "ok" : "FAILED");
+  ok = ok && half;
+  std::printf("per-field round trip:\n");
+  const bool fields = checkFields();
+  ok = ok && fields;
+  const bool edges = checkEdges();
+  std::printf("edge values: %s\n", edges ? "ok" : "FAILED");
+  ok = ok && edges;
+  sizes();
+  timing();
+  std::printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,752 @@
+// Host check: EP_CONTROL "set" dispatch through the ControlTargets table
+// against the if / else-if chain it replaced.
+//
+// legacyDispatch() is the old WiFiRoutes_Control.cpp chain transcribed
+// onto std::string (String::toInt() -> atol, float targets checked in
+// float); tableDispatch() is what the route does now: resolve(), read the
+// value as Target::type, normalize(). Both reduce a request to an Action
+// (queued command + args, NVS put, NTC setter, per-wire write, custom
+// handler + value, 400, unknown target) and must agree for:
+//   - every table name and family prefix with indices -1..11 and junk
+//   - missing / bool / integer / float / NaN / inf / text / map values
+//   - near-miss names (case, prefix, suffix) and random strings
+// Also: the perfect-hash index is collision free and every name resolves
+// to itself; the queued ops line up with the CtrlType enum below (copied
+// from WiFiManager.hpp); lookup cost, chain vs table.
+//
+// Build & run from the repo root (ConfigNVS.hpp only needs an empty
+// Arduino.h for its macros):
+//   mkdir -p /tmp/host_arduino && touch /tmp/host_arduino/Arduino.h
+//   g++ -std=c++17 -O2 -I/tmp/host_arduino -Isrc/system -Isrc/comms
+//       -o /tmp/control_dispatch_check tools/control_dispatch_check.cpp
+//       src/comms/ControlTargets.cpp
+//   /tmp/control_dispatch_check
+// After adding a target that collides, rebuild with
+// -DCONTROL_TARGETS_SEED_SEARCH and run with --seed for a new seed.
+
+#include <ControlTargets.hpp>
+#include <ConfigNVS.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool cond, const char* what) {
+  std::printf("  %-62s %s\n", what, cond ? "ok" : "FAILED");
+  if (!cond) ++failures;
+}
+
+using ControlTargets::Op;
+using ControlTargets::Rule;
+using ControlTargets::Target;
+using ControlTargets::Type;
+
+constexpr int kWireCount = 10;  // HeaterManager::kWireCount
+
+// WiFiManager::CtrlType, in declaration order.
+const char* const kCtrlNames[] = {
+    "CTRL_REBOOT",          "CTRL_SYS_RESET",          "CTRL_LED_FEEDBACK_BOOL",
+    "CTRL_RELAY_BOOL",      "CTRL_OUTPUT_BOOL",        "CTRL_AC_FREQ",
+    "CTRL_CHARGE_RES",      "CTRL_ACCESS_BOOL",        "CTRL_SYSTEM_START",
+    "CTRL_SYSTEM_WAKE",     "CTRL_SYSTEM_SHUTDOWN",    "CTRL_FAN_SPEED",
+    "CTRL_BUZZER_MUTE",     "CTRL_WIRE_RES",           "CTRL_WIRE_OHM_PER_M",
+    "CTRL_WIRE_GAUGE",      "CTRL_CURR_LIMIT",         "CTRL_CONFIRM_WIRES_COOL",
+    "CTRL_CALIBRATE",
+};
+
+// ------------------------------------------------------------ request value
+
+struct Value {
+  enum Kind { Missing, Bool, Int, Real, Text, Map } kind = Missing;
+  bool b = false;
+  int64_t i = 0;
+  double d = 0.0;
+  std::string s;
+};
+
+Value missing() { return Value(); }
+Value boolean(bool b) { Value v; v.kind = Value::Bool; v.b = b; return v; }
+Value integer(int64_t i) { Value v; v.kind = Value::Int; v.i = i; return v; }
+Value real(double d) { Value v; v.kind = Value::Real; v.d = d; return v; }
+Value text(const char* s) { Value v; v.kind = Value::Text; v.s = s; return v; }
+Value map() { Value v; v.kind = Value::Map; return v; }
+
+// The route's readValue* lambdas.
+bool readBool(const Value& v, bool& out) {
+  if (v.kind == Value::Missing) { out = false; return true; }
+  if (v.kind == Value::Bool) { out = v.b; return true; }
+  if (v.kind == Value::Int) { out = (v.i != 0); return true; }
+  return false;
+}
+
+bool readInt(const Value& v, int& out) {
+  if (v.kind == Value::Missing) { out = 0; return true; }
+  if (v.kind == Value::Int) { out = static_cast<int>(v.i); return true; }
+  if (v.kind == Value::Real) { out = static_cast<int>(std::lround(v.d)); return true; }
+  return false;
+}
+
+bool readDouble(const Value& v, double& out) {
+  if (v.kind == Value::Missing) { out = 0.0; return true; }
+  if (v.kind == Value::Real) { out = v.d; return true; }
+  if (v.kind == Value::Int) { out = static_cast<double>(v.i); return true; }
+  return false;
+}
+
+bool readFloat(const Value& v, float& out) {
+  double d = 0.0;
+  if (!readDouble(v, d)) return false;
+  out = static_cast<float>(d);
+  return true;
+}
+
+bool readText(const Value& v, std::string& out) {
+  if (v.kind == Value::Missing) { out.clear(); return true; }
+  if (v.kind == Value::Text) { out = v.s; return true; }
+  return false;
+}
+
+// ------------------------------------------------------------------ action
+
+struct Action {
+  std::string what;  // "400", "unknown", "queue:CTRL_X", "put", "ntc:beta",
+                     // "wire:tau", "custom:name/arg"
+  std::string key;
+  char kind = '-';   // b i f d t: type of the value below
+  int32_t i1 = 0;
+  bool b1 = false;
+  double num = 0.0;
+  std::string str;
+
+  bool operator==(const Action& o) const {
+    if (what != o.what || key != o.key || kind != o.kind || i1 != o.i1 ||
+        b1 != o.b1 || str != o.str) {
+      return false;
+    }
+    return num == o.num || (std::isnan(num) && std::isnan(o.num));
+  }
+};
+
+Action bad() { Action a; a.what = "400"; return a; }
+Action unknown() { Action a; a.what = "unknown"; return a; }
+
+Action queue(const char* ctrl) { Action a; a.what = std::string("queue:") + ctrl; return a; }
+
+Action putBool(const char* key, bool v) {
+  Action a; a.what = "put"; a.key = key; a.kind = 'b'; a.b1 = v; return a;
+}
+Action putInt(const char* key, int v) {
+  Action a; a.what = "put"; a.key = key; a.kind = 'i'; a.i1 = v; return a;
+}
+Action putFloat(const char* key, float v) {
+  Action a; a.what = "put"; a.key = key; a.kind = 'f'; a.num = v; return a;
+}
+Action putDouble(const char* key, double v) {
+  Action a; a.what = "put"; a.key = key; a.kind = 'd'; a.num = v; return a;
+}
+
+// ------------------------------------------------------- old if-else chain
+
+bool startsWith(const std::string& s, const char* p) {
+  return s.compare(0, std::strlen(p), p) == 0;
+}
+
+long toInt(const std::string& s, size_t from) {
+  return std::atol(from <= s.size() ? s.c_str() + from : "");
+}
+
+size_t chainCompares = 0;
+
+bool is(const std::string& target, const char* name) {
+  ++chainCompares;
+  return target == name;
+}
+
+bool prefixed(const std::string& target, const char* p) {
+  ++chainCompares;
+  return startsWith(target, p);
+}
+
+Action legacyDispatch(const std::string& target, const Value& value) {
+  auto parseWireIndex = [&](const char* prefix) -> int {
+    if (!prefixed(target, prefix)) return 0;
+    const long idx = toInt(target, std::strlen(prefix));
+    if (idx < 1 || idx > kWireCount) return 0;
+    return static_cast<int>(idx);
+  };
+  auto wireDouble = [&](const char* what, int idx, double fallback) -> Action {
+    double v = 0.0;
+    if (!readDouble(value, v)) return bad();
+    if (!std::isfinite(v) || v <= 0.0) v = fallback;
+    Action a; a.what = what; a.kind = 'd'; a.i1 = idx; a.num = v; return a;
+  };
+
+  int wireIdx = parseWireIndex("wireTau");
+  if (wireIdx > 0) return wireDouble("wire:tau", wireIdx, DEFAULT_WIRE_MODEL_TAU);
+  wireIdx = parseWireIndex("wireK");
+  if (wireIdx > 0) return wireDouble("wire:k", wireIdx, DEFAULT_WIRE_MODEL_K);
+  wireIdx = parseWireIndex("wireC");
+  if (wireIdx > 0) return wireDouble("wire:c", wireIdx, DEFAULT_WIRE_MODEL_C);
+  wireIdx = parseWireIndex("wireCalibrated");
+  if (wireIdx > 0) {
+    bool v = false;
+    if (!readBool(value, v)) return bad();
+    Action a; a.what = "wire:calibrated"; a.kind = 'b'; a.i1 = wireIdx; a.b1 = v;
+    return a;
+  }
+
+  auto qBool = [&](const char* ctrl, int32_t i1) -> Action {
+    Action a = queue(ctrl);
+    a.i1 = i1;
+    if (!readBool(value, a.b1)) return bad();
+    return a;
+  };
+  auto qInt = [&](const char* ctrl) -> Action {
+    Action a = queue(ctrl);
+    int v = 0;
+    if (!readInt(value, v)) return bad();
+    a.i1 = v;
+    return a;
+  };
+  auto qFloat = [&](const char* ctrl, int32_t i1) -> Action {
+    Action a = queue(ctrl);
+    a.i1 = i1;
+    float f = 0.0f;
+    if (!readFloat(value, f)) return bad();
+    a.num = f;
+    return a;
+  };
+  auto customFloat = [&](const char* what) -> Action {
+    float v = 0.0f;
+    if (!readFloat(value, v)) return bad();
+    Action a; a.what = what; a.kind = 'f'; a.num = v; return a;
+  };
+  auto customText = [&](const char* what) -> Action {
+    std::string s;
+    if (!readText(value, s)) return bad();
+    Action a; a.what = what; a.kind = 't'; a.str = s; return a;
+  };
+  auto ntcFloat = [&](const char* what, float v) -> Action {
+    Action a; a.what = what; a.kind = 'f'; a.num = v; return a;
+  };
+
+  if (is(target, "reboot"))                 return queue("CTRL_REBOOT");
+  else if (is(target, "systemReset"))       return queue("CTRL_SYS_RESET");
+  else if (is(target, "ledFeedback"))       return qBool("CTRL_LED_FEEDBACK_BOOL", 0);
+  else if (is(target, "relay"))             return qBool("CTRL_RELAY_BOOL", 0);
+  else if (prefixed(target, "output"))      return qBool("CTRL_OUTPUT_BOOL", toInt(target, 6));
+  else if (is(target, "acFrequency"))       return qInt("CTRL_AC_FREQ");
+  else if (is(target, "chargeResistor"))    return qFloat("CTRL_CHARGE_RES", 0);
+  else if (prefixed(target, "Access"))      return qBool("CTRL_ACCESS_BOOL", toInt(target, 6));
+  else if (is(target, "systemStart"))       return queue("CTRL_SYSTEM_START");
+  else if (is(target, "systemWake"))        return queue("CTRL_SYSTEM_WAKE");
+  else if (is(target, "systemShutdown"))    return queue("CTRL_SYSTEM_SHUTDOWN");
+  else if (is(target, "fanSpeed")) {
+    Action a = qInt("CTRL_FAN_SPEED");
+    if (a.what == "400") return a;
+    a.i1 = a.i1 < 0 ? 0 : (a.i1 > 100 ? 100 : a.i1);
+    return a;
+  }
+  else if (is(target, "buzzerMute"))        return qBool("CTRL_BUZZER_MUTE", 0);
+  else if (prefixed(target, "wireRes"))     return qFloat("CTRL_WIRE_RES", toInt(target, 7));
+  else if (is(target, "wireOhmPerM"))       return qFloat("CTRL_WIRE_OHM_PER_M", 0);
+  else if (is(target, "wireGauge"))         return qInt("CTRL_WIRE_GAUGE");
+  else if (is(target, "currLimit"))         return qFloat("CTRL_CURR_LIMIT", 0);
+  else if (is(target, "confirmWiresCool"))  return queue("CTRL_CONFIRM_WIRES_COOL");
+  else if (is(target, "adminCredentials"))  { Action a; a.what = "custom:admin"; return a; }
+  else if (is(target, "userCredentials"))   { Action a; a.what = "custom:user"; return a; }
+  else if (is(target, "wifiSSID"))          { Action a = customText("custom:ssid"); a.key = a.what == "400" ? "" : STA_SSID_KEY; return a; }
+  else if (is(target, "wifiPassword"))      { Action a = customText("custom:wifipass"); a.key = a.what == "400" ? "" : STA_PASS_KEY; return a; }
+  else if (is(target, "uiLanguage") || is(target, "language")) {
+    Action a = customText("custom:language");
+    if (a.what != "400") a.key = UI_LANGUAGE_KEY;
+    return a;
+  }
+  else if (is(target, "tempWarnC")) {
+    float v = 0.0f;
+    if (!readFloat(value, v)) return bad();
+    if (!std::isfinite(v) || v < 0.0f) v = 0.0f;
+    return putFloat(TEMP_WARN_KEY, v);
+  }
+  else if (is(target, "tempTripC")) {
+    float v = 0.0f;
+    if (!readFloat(value, v)) return bad();
+    if (!std::isfinite(v) || v < 0.0f) v = DEFAULT_TEMP_THRESHOLD;
+    return putFloat(TEMP_THRESHOLD_KEY, v);
+  }
+  else if (is(target, "floorThicknessMm")) {
+    float v = 0.0f;
+    if (!readFloat(value, v)) return bad();
+    if (!std::isfinite(v) || v < 0.0f) {
+      v = DEFAULT_FLOOR_THICKNESS_MM;
+    } else if (v > 0.0f) {
+      if (v < FLOOR_THICKNESS_MIN_MM) v = FLOOR_THICKNESS_MIN_MM;
+      if (v > FLOOR_THICKNESS_MAX_MM) v = FLOOR_THICKNESS_MAX_MM;
+    }
+    return putFloat(FLOOR_THICKNESS_MM_KEY, v);
+  }
+  else if (is(target, "floorMaterial"))     { Action a; a.what = "custom:floorMaterial"; a.key = FLOOR_MATERIAL_KEY; return a; }
+  else if (is(target, "floorMaxC")) {
+    float v = 0.0f;
+    if (!readFloat(value, v)) return bad();
+    if (!std::isfinite(v) || v < 0.0f) v = DEFAULT_FLOOR_MAX_C;
+    if (v > DEFAULT_FLOOR_MAX_C) v = DEFAULT_FLOOR_MAX_C;
+    return putFloat(FLOOR_MAX_C_KEY, v);
+  }
+  else if (is(target, "floorSwitchMarginC")) {
+    float v = 0.0f;
+    if (!readFloat(value, v)) return bad();
+    if (!std::isfinite(v) || v <= 0.0f) v = DEFAULT_FLOOR_SWITCH_MARGIN_C;
+    return putFloat(FLOOR_SWITCH_MARGIN_C_KEY, v);
+  }
+  else if (is(target, "floorTau")) {
+    double v = 0.0;
+    if (!readDouble(value, v)) return bad();
+    if (!std::isfinite(v) || v <= 0.0) v = DEFAULT_FLOOR_MODEL_TAU;
+    return putDouble(FLOOR_MODEL_TAU_KEY, v);
+  }
+  else if (is(target, "floorK")) {
+    double v = 0.0;
+    if (!readDouble(value, v)) return bad();
+    if (!std::isfinite(v) || v <= 0.0) v = DEFAULT_FLOOR_MODEL_K;
+    return putDouble(FLOOR_MODEL_K_KEY, v);
+  }
+  else if (is(target, "floorC")) {
+    double v = 0.0;
+    if (!readDouble(value, v)) return bad();
+    if (!std::isfinite(v) || v <= 0.0) v = DEFAULT_FLOOR_MODEL_C;
+    return putDouble(FLOOR_MODEL_C_KEY, v);
+  }
+  else if (is(target, "nichromeFinalTempC")) {
+    float v = 0.0f;
+    if (!readFloat(value, v)) return bad();
+    if (!std::isfinite(v) || v < 0.0f) v = DEFAULT_NICHROME_FINAL_TEMP_C;
+    return putFloat(NICHROME_FINAL_TEMP_C_KEY, v);
+  }
+  else if (is(target, "currentSource"))     { Action a; a.what = "custom:currentSource"; a.key = CURRENT_SOURCE_KEY; return a; }
+  else if (is(target, "presenceCalibrated")) {
+    bool v = false;
+    if (!readBool(value, v)) return bad();
+    return putBool(CALIB_PRESENCE_DONE_KEY, v);
+  }
+  else if (is(target, "presenceMinRatio") || is(target, "presenceMinRatioPct")) {
+    Action a = customFloat(target == "presenceMinRatioPct" ? "custom:presenceRatio/1"
+                                                           : "custom:presenceRatio/0");
+    if (a.what != "400") a.key = PRESENCE_MIN_RATIO_KEY;
+    return a;
+  }
+  else if (is(target, "floorCalibrated")) {
+    bool v = false;
+    if (!readBool(value, v)) return bad();
+    return putBool(CALIB_FLOOR_DONE_KEY, v);
+  }
+  else if (is(target, "ntcModel"))          { Action a; a.what = "custom:ntcModel"; a.key = NTC_MODEL_KEY; return a; }
+  else if (is(target, "ntcBeta")) {
+    float v = 0.0f;
+    if (!readFloat(value, v)) return bad();
+    if (!std::isfinite(v) || v <= 0.0f) v = DEFAULT_NTC_BETA;
+    Action a = ntcFloat("ntc:beta", v); a.key = NTC_BETA_KEY; return a;
+  }
+  else if (is(target, "ntcT0C")) {
+    float v = 0.0f;
+    if (!readFloat(value, v)) return bad();
+    if (!std::isfinite(v)) v = DEFAULT_NTC_T0_C;
+    Action a = ntcFloat("ntc:t0", v); a.key = NTC_T0_C_KEY; return a;
+  }
+  else if (is(target, "ntcR0")) {
+    float v = 0.0f;
+    if (!readFloat(value, v)) return bad();
+    if (!std::isfinite(v) || v <= 0.0f) v = DEFAULT_NTC_R0_OHMS;
+    Action a = ntcFloat("ntc:r0", v); a.key = NTC_R0_KEY; return a;
+  }
+  else if (is(target, "ntcShA") || is(target, "ntcShB") || is(target, "ntcShC")) {
+    return customFloat(target == "ntcShA" ? "custom:steinhart/0"
+                       : target == "ntcShB" ? "custom:steinhart/1"
+                                            : "custom:steinhart/2");
+  }
+  else if (is(target, "ntcFixedRes")) {
+    float v = 0.0f;
+    if (!readFloat(value, v)) return bad();
+    if (!std::isfinite(v) || v <= 0.0f) v = DEFAULT_NTC_FIXED_RES_OHMS;
+    Action a = ntcFloat("ntc:fixedRes", v); a.key = NTC_FIXED_RES_KEY; return a;
+  }
+  else if (is(target, "ntcMinC") || is(target, "ntcMaxC")) {
+    return customFloat(target == "ntcMinC" ? "custom:limits/0" : "custom:limits/1");
+  }
+  else if (is(target, "ntcSamples")) {
+    int v = 0;
+    if (!readInt(value, v)) return bad();
+    if (v < 1) v = 1;
+    if (v > 64) v = 64;
+    Action a; a.what = "ntc:samples"; a.key = NTC_SAMPLES_KEY; a.kind = 'i'; a.i1 = v;
+    return a;
+  }
+  else if (is(target, "ntcPressMv") || is(target, "ntcReleaseMv") ||
+           is(target, "ntcDebounceMs")) {
+    if (target == "ntcPressMv") return customFloat("custom:button/0");
+    if (target == "ntcReleaseMv") return customFloat("custom:button/1");
+    int v = 0;
+    if (!readInt(value, v)) return bad();
+    Action a; a.what = "custom:button/2"; a.kind = 'i'; a.i1 = v; return a;
+  }
+  else if (is(target, "ntcCalTargetC")) {
+    float v = 0.0f;
+    if (!readFloat(value, v)) return bad();
+    if (!std::isfinite(v) || v <= 0.0f) v = DEFAULT_NTC_CAL_TARGET_C;
+    return putFloat(NTC_CAL_TARGET_C_KEY, v);
+  }
+  else if (is(target, "ntcCalSampleMs")) {
+    int v = 0;
+    if (!readInt(value, v)) return bad();
+    if (v < 50) v = 50;
+    if (v > 5000) v = 5000;
+    return putInt(NTC_CAL_SAMPLE_MS_KEY, v);
+  }
+  else if (is(target, "ntcCalTimeoutMs")) {
+    int v = 0;
+    if (!readInt(value, v)) return bad();
+    if (v < 1000) v = 1000;
+    if (v > 3600000) v = 3600000;
+    return putInt(NTC_CAL_TIMEOUT_MS_KEY, v);
+  }
+  else if (is(target, "ntcCalibrated")) {
+    bool v = false;
+    if (!readBool(value, v)) return bad();
+    return putBool(CALIB_NTC_DONE_KEY, v);
+  }
+  else if (is(target, "ntcGateIndex")) {
+    int v = 0;
+    if (!readInt(value, v)) return bad();
+    if (v < 1) v = 1;
+    if (v > kWireCount) v = kWireCount;
+    return putInt(NTC_GATE_INDEX_KEY, v);
+  }
+  else if (is(target, "calibrate"))         return queue("CTRL_CALIBRATE");
+  return unknown();
+}
+
+// ------------------------------------------------------------ table route
+
+// Reads the value as t.type and applies the rule; false on a type the
+// target does not accept (the route answers 400).
+bool readNormalized(const Target& t, const Value& value, Action& a) {
+  switch (t.type) {
+    case Type::None:
+    case Type::Custom:
+      return true;
+    case Type::Bool:
+      a.kind = 'b';
+      return readBool(value, a.b1);
+    case Type::Int: {
+      int v = 0;
+      if (!readInt(value, v)) return false;
+      a.kind = 'i';
+      a.i1 = static_cast<int32_t>(ControlTargets::normalize(t, v));
+      return true;
+    }
+    case Type::Float: {
+      float v = 0.0f;
+      if (!readFloat(value, v)) return false;
+      a.kind = 'f';
+      a.num = static_cast<float>(ControlTargets::normalize(t, v));
+      return true;
+    }
+    case Type::Double: {
+      double v = 0.0;
+      if (!readDouble(value, v)) return false;
+      a.kind = 'd';
+      a.num = ControlTargets::normalize(t, v);
+      return true;
+    }
+    case Type::Text:
+      a.kind = 't';
+      return readText(value, a.str);
+  }
+  return false;
+}
+
+std::string customName(const Target& t) {
+  switch (t.op) {
+    case Op::AdminCredentials: return "custom:admin";
+    case Op::UserCredentials:  return "custom:user";
+    case Op::WifiSsid:         return "custom:ssid";
+    case Op::WifiPassword:     return "custom:wifipass";
+    case Op::Language:         return "custom:language";
+    case Op::FloorMaterial:    return "custom:floorMaterial";
+    case Op::CurrentSource:    return "custom:currentSource";
+    case Op::NtcModel:         return "custom:ntcModel";
+    case Op::PresenceMinRatio: return "custom:presenceRatio/" + std::to_string(t.arg);
+    case Op::NtcSteinhart:     return "custom:steinhart/" + std::to_string(t.arg);
+    case Op::NtcLimits:        return "custom:limits/" + std::to_string(t.arg);
+    case Op::NtcButton:        return "custom:button/" + std::to_string(t.arg);
+    default:                   return "custom:?";
+  }
+}
+
+Action tableDispatch(const char* target, const Value& value) {
+  int32_t index = 0;
+  const Target* t = ControlTargets::resolve(target, index);
+  if (!t) return unknown();
+
+  Action a;
+  if (!readNormalized(*t, value, a)) return bad();
+
+  if (ControlTargets::isQueued(t->op)) {
+    // ControlCmd carries the value in i1 / f1 / b1; families add the index.
+    Action q = queue(kCtrlNames[static_cast<int>(t->op)]);
+    q.b1 = a.b1;
+    q.i1 = (t->type == Type::Int) ? a.i1 : index;
+    q.num = a.num;
+    return q;
+  }
+  switch (t->op) {
+    case Op::Store:
+      a.what = "put";
+      a.key = t->key;
+      return a;
+    case Op::NtcBeta:     a.what = "ntc:beta"; break;
+    case Op::NtcT0C:      a.what = "ntc:t0"; break;
+    case Op::NtcR0:       a.what = "ntc:r0"; break;
+    case Op::NtcFixedRes: a.what = "ntc:fixedRes"; break;
+    case Op::NtcSamples:  a.what = "ntc:samples"; break;
+    case Op::WireTau:        a.what = "wire:tau"; a.i1 = index; return a;
+    case Op::WireK:          a.what = "wire:k"; a.i1 = index; return a;
+    case Op::WireC:          a.what = "wire:c"; a.i1 = index; return a;
+    case Op::WireCalibrated: a.what = "wire:calibrated"; a.i1 = index; return a;
+    default:
+      a.what = customName(*t);
+      if (t->key) a.key = t->key;
+      if (t->type == Type::None || t->type == Type::Custom) a.kind = '-';
+      return a;
+  }
+  a.key = t->key;
+  return a;
+}
+
+// ------------------------------------------------------------------ checks
+
+std::vector<Value> sampleValues() {
+  const double inf = INFINITY;
+  return {
+      missing(),   boolean(true), boolean(false), integer(0),    integer(1),
+      integer(-5), integer(7),    integer(49),    integer(64),   integer(65),
+      integer(150), integer(4000000), integer(-4000000000LL),
+      real(0.0),   real(-0.0),    real(0.5),      real(-1.0),    real(1.5),
+      real(12.345), real(19.99),  real(20.0),     real(35.0),    real(35.0001),
+      real(50.5),  real(1e9),     real(1e-30),    real(NAN),     real(inf),
+      real(-inf),  text(""),      text("abc"),    text("steinhart"), map(),
+  };
+}
+
+std::string describe(const Value& v) {
+  char buf[64];
+  switch (v.kind) {
+    case Value::Missing: return "missing";
+    case Value::Bool:    return v.b ? "true" : "false";
+    case Value::Int:     std::snprintf(buf, sizeof(buf), "%lld", (long long)v.i); return buf;
+    case Value::Real:    std::snprintf(buf, sizeof(buf), "%g", v.d); return buf;
+    case Value::Text:    return "\"" + v.s + "\"";
+    case Value::Map:     return "{map}";
+  }
+  return "?";
+}
+
+size_t compareAll(const std::vector<std::string>& names, size_t& mismatches) {
+  const std::vector<Value> values = sampleValues();
+  size_t cases = 0;
+  for (const std::string& name : names) {
+    for (const Value& v : values) {
+      const Action oldA = legacyDispatch(name, v);
+      const Action newA = tableDispatch(name.c_str(), v);
+      ++cases;
+      if (!(oldA == newA)) {
+        if (mismatches < 10) {
+          std::printf("    %s = %s: old %s key=%s %c i=%d b=%d n=%g | new %s key=%s %c i=%d b=%d n=%g\n",
+                      name.c_str(), describe(v).c_str(),
+                      oldA.what.c_str(), oldA.key.c_str(), oldA.kind, oldA.i1, oldA.b1, oldA.num,
+                      newA.what.c_str(), newA.key.c_str(), newA.kind, newA.i1, newA.b1, newA.num);
+        }
+        ++mismatches;
+      }
+    }
+  }
+  return cases;
+}
+
+void tableShape() {
+  std::printf("table:\n");
+  size_t n = 0;
+  const Target* t = ControlTargets::targets(n);
+  const ControlTargets::Index& idx = ControlTargets::index();
+
+  expect(ControlTargets::perfect(idx, t, n), "perfect hash: one name per slot");
+  bool self = true;
+  for (size_t i = 0; i < n; ++i) {
+    int32_t index = -1;
+    self = self && ControlTargets::resolve(t[i].name, index) == &t[i] && index == 0;
+  }
+  expect(self, "every exact name resolves to its own entry");
+
+  size_t fn = 0;
+  const Target* f = ControlTargets::families(fn);
+  bool noShadow = true;
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < fn; ++j) {
+      if (std::strncmp(t[i].name, f[j].name, std::strlen(f[j].name)) == 0) noShadow = false;
+    }
+  }
+  expect(noShadow, "no exact name starts with a family prefix");
+
+  bool ctrl = sizeof(kCtrlNames) / sizeof(kCtrlNames[0]) ==
+              static_cast<size_t>(Op::Calibrate) + 1;
+  expect(ctrl, "queued ops cover CtrlType one to one");
+
+  bool keyed = true;
+  for (size_t i = 0; i < n; ++i) {
+    if ((t[i].op == Op::Store || (t[i].op >= Op::NtcBeta && t[i].op <= Op::NtcSamples)) &&
+        (!t[i].key || std::strlen(t[i].key) > 6)) {
+      keyed = false;
+    }
+  }
+  expect(keyed, "stored targets carry an NVS key of <= 6 chars");
+  std::printf("  %zu exact names, %zu families, %zu / %zu slots used\n", n, fn, n,
+              ControlTargets::kSlots);
+}
+
+void compareWithChain() {
+  std::printf("table vs old chain:\n");
+  size_t n = 0;
+  const Target* t = ControlTargets::targets(n);
+  size_t fn = 0;
+  const Target* f = ControlTargets::families(fn);
+
+  std::vector<std::string> exact;
+  for (size_t i = 0; i < n; ++i) exact.push_back(t[i].name);
+  size_t bad = 0;
+  size_t cases = compareAll(exact, bad);
+  char line[96];
+  std::snprintf(line, sizeof(line), "exact names (%zu cases)", cases);
+  expect(bad == 0, line);
+
+  std::vector<std::string> fam;
+  const char* suffixes[] = {"", "0", "1", "5", "10", "11", "-1", "x", "3x", " 2", "007",
+                            "99999999999"};
+  for (size_t j = 0; j < fn; ++j) {
+    for (const char* s : suffixes) fam.push_back(std::string(f[j].name) + s);
+  }
+  fam.push_back("wireCalibrated");
+  fam.push_back("wireCx");
+  fam.push_back("wireCalibrate3");
+  fam.push_back("wireResistance");
+  fam.push_back("outputs");
+  fam.push_back("Accessory");
+  bad = 0;
+  cases = compareAll(fam, bad);
+  std::snprintf(line, sizeof(line), "families and indices (%zu cases)", cases);
+  expect(bad == 0, line);
+
+  std::vector<std::string> near;
+  for (size_t i = 0; i < n; ++i) {
+    std::string s = t[i].name;
+    near.push_back(s + "x");
+    near.push_back(s.substr(0, s.size() - 1));
+    near.push_back(" " + s);
+    std::string up = s;
+    up[0] = static_cast<char>(up[0] >= 'a' && up[0] <= 'z' ? up[0] - 32 : up[0] + 32);
+    near.push_back(up);
+  }
+  near.push_back("");
+  near.push_back("status");
+  bad = 0;
+  cases = compareAll(near, bad);
+  std::snprintf(line, sizeof(line), "near-miss names (%zu cases)", cases);
+  expect(bad == 0, line);
+
+  std::mt19937 rng(11);
+  const char alphabet[] = "abcdefghijklmnopqrstuvwxyzACDRSTW0123456789";
+  size_t randomBad = 0;
+  const Value v = real(1.5);
+  for (int k = 0; k < 200000; ++k) {
+    std::string s;
+    const int len = 1 + static_cast<int>(rng() % 20);
+    for (int c = 0; c < len; ++c) s += alphabet[rng() % (sizeof(alphabet) - 1)];
+    if (!(legacyDispatch(s, v) == tableDispatch(s.c_str(), v))) ++randomBad;
+  }
+  expect(randomBad == 0, "200k random names");
+}
+
+void lookupCost() {
+  std::printf("lookup cost:\n");
+  size_t n = 0;
+  const Target* t = ControlTargets::targets(n);
+  std::vector<std::string> names;
+  for (size_t i = 0; i < n; ++i) names.push_back(t[i].name);
+  names.push_back("output3");
+  names.push_back("wireTau4");
+  names.push_back("bogus");
+
+  chainCompares = 0;
+  for (const std::string& s : names) legacyDispatch(s, missing());
+  const double avgCompares = static_cast<double>(chainCompares) / names.size();
+
+  const int rounds = 20000;
+  volatile size_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (const std::string& s : names) sink += legacyDispatch(s, missing()).what.size();
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (const std::string& s : names) sink += tableDispatch(s.c_str(), missing()).what.size();
+  }
+  auto t2 = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (const std::string& s : names) {
+      int32_t index = 0;
+      sink += ControlTargets::resolve(s.c_str(), index) != nullptr;
+    }
+  }
+  auto t3 = std::chrono::steady_clock::now();
+  const double per = static_cast<double>(rounds) * names.size();
+  auto ns = [&](std::chrono::steady_clock::time_point a,
+                std::chrono::steady_clock::time_point b) {
+    return std::chrono::duration<double, std::nano>(b - a).count() / per;
+  };
+  std::printf("  old chain: %.1f string compares per target on average\n", avgCompares);
+  std::printf("  old chain dispatch %.0f ns, table dispatch %.0f ns, resolve() alone %.0f ns\n",
+              ns(t0, t1), ns(t1, t2), ns(t2, t3));
+}
+
+int seedSearch() {
+  size_t n = 0;
+  const Target* t = ControlTargets::targets(n);
+  for (uint32_t seed = 2166136261u, k = 0; k < 1000000; ++k, seed += 0x9E3779B9u) {
+    const ControlTargets::Index idx = ControlTargets::makeIndex(t, n, seed);
+    if (ControlTargets::perfect(idx, t, n)) {
+      std::printf("CONTROL_TARGETS_SEED %uu (%u tries)\n", seed, k + 1);
+      return 0;
+    }
+  }
+  std::printf("no seed found; raise kSlots\n");
+  return 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc > 1 && std::strcmp(argv[1], "--seed") == 0) return seedSearch();
+  tableShape();
+  compareWithChain();
+  lookupCost();
+  std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+// Host check: conditional GET (HttpConditional) through a mocked
+// AsyncWebServerRequest.
+//
+// MockRequest has the header API the template uses (hasHeader /
+// getHeader()->value().c_str()). MockRoute mirrors a history handler:
+// build the validator from a generation counter, answer 304 on a match,
+// otherwise "encode" a 200 with ETag / Last-Modified. It counts encodes
+// so the check can assert that a 304 never reaches the body path.
+// Covered: first fetch, revalidation hit, change -> miss, reboot (same
+// generation, new boot tag) -> miss, If-None-Match lists / weak / "*" /
+// unquoted, If-Modified-Since with and without If-None-Match, and
+// HTTP-date formatting / parsing round trips.
+//
+// Build & run from the repo root:
+//   g++ -std=c++17 -O2 -Isrc/comms -o /tmp/http_conditional_check
+//       tools/http_conditional_check.cpp src/comms/HttpConditional.cpp
+//   /tmp/http_conditional_check
+
+#include <HttpConditional.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+
+namespace {
+
+// --- Mock of the AsyncWebServer request header API ---
+struct MockString {
+  std::string s;
+  const char* c_str() const { return s.c_str(); }
+};
+
+struct MockHeader {
+  MockString v;
+  const MockString& value() const { return v; }
+};
+
+struct MockRequest {
+  std::map<std::string, MockHeader> headers;
+  MockRequest& with(const char* name, const char* value) {
+    headers[name].v.s = value;
+    return *this;
+  }
+  bool hasHeader(const char* name) const { return headers.count(name) != 0; }
+  const MockHeader* getHeader(const char* name) const {
+    auto it = headers.find(name);
+    return it == headers.end() ? nullptr : &it->second;
+  }
+};
+
+struct Response {
+  int status = 0;
+  std::string etag;
+  std::string lastModified;
+};
+
+// Mirrors the /session_history handler: validator first, body only on a miss.
+struct MockRoute {
+  uint32_t bootTag;
+  uint32_t generation = 0;
+  uint32_t modifiedEpoch = 0;
+  int encodes = 0;
+
+  Response handle(MockRequest& req) {
+    const HttpConditional::Validator v =
+        HttpConditional::make("h", bootTag, generation, modifiedEpoch);
+    Response r;
+    r.etag = v.etag;
+    if (v.modifiedEpoch) {
+      char date[HttpConditional::kDateMax];
+      if (HttpConditional::formatHttpDate(v.modifiedEpoch, date, sizeof(date))) r.lastModified = date;
+    }
+    if (HttpConditional::notModified(&req, v)) {
+      r.status = 304;
+      return r;
+    }
+    ++encodes;
+    r.status = 200;
+    return r;
+  }
+};
+
+int failures = 0;
+
+void expect(bool cond, const char* what) {
+  std::printf("  %-58s %s\n", what, cond ? "ok" : "FAILED");
+  if (!cond) ++failures;
+}
+
+void routeFlow() {
+  std::printf("route flow:\n");
+  MockRoute route{0x1234abcdu};
+  route.generation = 7;
+  route.modifiedEpoch = 1760000000u;
+
+  MockRequest first;
+  const Response r1 = route.handle(first);
+  expect(r1.status == 200 && route.encodes == 1, "first fetch -> 200, encoded");
+  expect(r1.etag == "\"h-1234abcd-7\"", "ETag carries scope, boot tag, generation");
+
+  MockRequest again;
+  again.with("If-None-Match", r1.etag.c_str());
+  const Response r2 = route.handle(again);
+  expect(r2.status == 304 && route.encodes == 1, "revalidate same tag -> 304, no encode");
+  expect(r2.etag == r1.etag, "304 repeats the ETag");
+
+  route.generation = 8;
+  const Response r3 = route.handle(again);
+  expect(r3.status == 200 && route.encodes == 2, "history changed -> 200");
+
+  MockRoute rebooted{0x0badf00du};
+  rebooted.generation = 7;
+  const Response r4 = rebooted.handle(again);
+  expect(r4.status == 200, "reboot, same generation -> new boot tag -> 200");
+
+  MockRequest ims;
+  ims.with("If-Modified-Since", r1.lastModified.c_str());
+  route.generation = 7;
+  expect(route.handle(ims).status == 304, "If-Modified-Since == Last-Modified -> 304");
+
+  MockRequest both;
+  both.with("If-None-Match", "\"h-1234abcd-6\"").with("If-Modified-Since", r1.lastModified.c_str());
+  expect(route.handle(both).status == 200, "If-None-Match miss wins over If-Modified-Since");
+
+  MockRoute noClock{1u};
+  MockRequest imsOnly;
+  imsOnly.with("If-Modified-Since", "Sun, 06 Nov 1994 08:49:37 GMT");
+  expect(noClock.handle(imsOnly).status == 200, "no RTC time -> If-Modified-Since ignored");
+}
+
+void matching() {
+  std::printf("If-None-Match parsing:\n");
+  const char* tag = "\"h-1234abcd-7\"";
+  expect(HttpConditional::etagListMatches("\"a\", \"h-1234abcd-7\"", tag), "list, second entry");
+  expect(HttpConditional::etagListMatches("W/\"h-1234abcd-7\"", tag), "weak form matches (weak comparison)");
+  expect(HttpConditional::etagListMatches("*", tag), "* matches");
+  expect(HttpConditional::etagListMatches("h-1234abcd-7", tag), "unquoted value matches");
+  expect(!HttpConditional::etagListMatches("\"h-1234abcd-70\"", tag), "longer tag does not match");
+  expect(!HttpConditional::etagListMatches("\"h-1234abcd-\"", tag), "prefix does not match");
+  expect(!HttpConditional::etagListMatches("", tag), "empty header does not match");
+  expect(!HttpConditional::etagListMatches("\"unterminated", tag), "unterminated quote does not match");
+}
+
+void dates() {
+  std::printf("HTTP dates:\n");
+  char buf[HttpConditional::kDateMax];
+  expect(HttpConditional::formatHttpDate(784111777u, buf, sizeof(buf)) &&
+             std::strcmp(buf, "Sun, 06 Nov 1994 08:49:37 GMT") == 0,
+         "784111777 -> Sun, 06 Nov 1994 08:49:37 GMT");
+  uint32_t e = 0;
+  expect(HttpConditional::parseHttpDate("Sun, 06 Nov 1994 08:49:37 GMT", e) && e == 784111777u,
+         "parse RFC example");
+  expect(HttpConditional::formatHttpDate(951782400u, buf, sizeof(buf)) &&
+             std::strcmp(buf, "Tue, 29 Feb 2000 00:00:00 GMT") == 0,
+         "leap day 2000");
+  bool roundTrip = true;
+  for (uint32_t t = 0; t < 0xFFFF0000u; t += 86400u * 37u + 12345u) {
+    uint32_t back = 0;
+    if (!HttpConditional::formatHttpDate(t, buf, sizeof(buf)) ||
+        !HttpConditional::parseHttpDate(buf, back) || back != t) {
+      std::printf("    %u -> %s -> %u\n", t, buf, back);
+      roundTrip = false;
+      break;
+    }
+  }
+  expect(roundTrip, "format/parse round trip 1970..2106");
+  expect(!HttpConditional::parseHttpDate("Sunday, 06-Nov-94 08:49:37 GMT", e), "obsolete RFC 850 form rejected");
+  expect(!HttpConditional::parseHttpDate("Sun, 06 Foo 1994 08:49:37 GMT", e), "bad month rejected");
+}
+
+} // namespace
+
+int main() {
+  routeFlow();
+  matching();
+  dates();
+  std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,246 @@
+// Host check: columnar live batches (LiveColumnar) vs the row format.
+//
+// Two traces of 64 samples (one full live ring) at the 250 ms snapshot
+// period with scheduler jitter:
+//   heating   RUN with outputs cycling, bus sagging under load, wires
+//             warming 20 -> 150 C
+//   idle      relay off, bus discharged, temperatures flat
+// Each trace is encoded as
+//   rows      what buildLiveBatch emits: one map per sample, every key
+//             repeated, capV / i as float64
+//   columns   the "fmt":"col" map: header + one varint byte string per
+//             column
+// then the columns are decoded with the reference decoder and checked
+// against the samples (ts, flags, temps exact; capV within 5 mV, i within
+// 0.5 mA). Full-ring and 16-sample (one paced WebSocket batch) sizes are
+// reported.
+// tinycbor is not available on host: the writer below emits the same bytes.
+//
+// Build & run from the repo root:
+//   g++ -std=c++17 -O2 -Isrc/comms -o /tmp/live_columnar_check
+//       tools/live_columnar_check.cpp src/comms/LiveColumnar.cpp
+//   /tmp/live_columnar_check
+
+#include <LiveColumnar.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int kWires = 10;       // HeaterManager::kWireCount
+constexpr int kRing = 64;        // WiFiManager::kLiveBufSize
+
+struct LiveSample {
+  uint32_t seq, tsMs;
+  float capV, currentA;
+  int16_t wireTemps[kWires];
+  uint16_t outputsMask;
+  bool relay, ac;
+  uint8_t fanPct;
+};
+
+std::vector<LiveSample> heatingTrace() {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> jitter(-3, 3);
+  std::normal_distribution<float> noise(0.0f, 0.4f);
+  std::vector<LiveSample> v;
+  uint32_t ts = 812345;
+  for (int k = 0; k < kRing; ++k) {
+    LiveSample s{};
+    s.seq = 4000 + k;
+    ts += 250 + jitter(rng);
+    s.tsMs = ts;
+    const int active = k % kWires;
+    s.outputsMask = static_cast<uint16_t>(1u << active);
+    s.capV = 318.0f - 6.5f * (k % 3) + noise(rng);
+    s.currentA = s.capV / 44.0f + noise(rng) * 0.01f;
+    for (int w = 0; w < kWires; ++w) {
+      s.wireTemps[w] = static_cast<int16_t>(std::lround(20.0 + (130.0 * k) / kRing + w * 0.7));
+    }
+    s.relay = true;
+    s.ac = true;
+    s.fanPct = static_cast<uint8_t>(40 + k / 8);
+    v.push_back(s);
+  }
+  return v;
+}
+
+std::vector<LiveSample> idleTrace() {
+  std::vector<LiveSample> v;
+  uint32_t ts = 5000;
+  for (int k = 0; k < kRing; ++k) {
+    LiveSample s{};
+    s.seq = 100 + k;
+    ts += 250 + (k % 4 == 3 ? 1 : 0);
+    s.tsMs = ts;
+    s.capV = 0.42f;
+    s.currentA = 0.0f;
+    for (int w = 0; w < kWires; ++w) s.wireTemps[w] = static_cast<int16_t>(w == 3 ? -127 : 22);
+    s.ac = true;
+    v.push_back(s);
+  }
+  return v;
+}
+
+// --- Minimal CBOR writer (tinycbor-compatible output) ---
+struct Cbor {
+  std::vector<uint8_t> b;
+  void head(uint8_t major, uint64_t v) {
+    if (v < 24) { b.push_back(static_cast<uint8_t>((major << 5) | v)); return; }
+    const int bytes = v <= 0xFF ? 1 : v <= 0xFFFF ? 2 : 4;
+    b.push_back(static_cast<uint8_t>((major << 5) | (bytes == 1 ? 24 : bytes == 2 ? 25 : 26)));
+    for (int s = (bytes - 1) * 8; s >= 0; s -= 8) b.push_back(static_cast<uint8_t>(v >> s));
+  }
+  void text(const char* s) { const size_t l = std::strlen(s); head(3, l); b.insert(b.end(), s, s + l); }
+  void bytes(const uint8_t* p, size_t l) { head(2, l); b.insert(b.end(), p, p + l); }
+  void uint(uint64_t v) { head(0, v); }
+  void sint(int64_t v) { if (v >= 0) head(0, v); else head(1, static_cast<uint64_t>(-1 - v)); }
+  void boolean(bool v) { b.push_back(v ? 0xF5 : 0xF4); }
+  void dbl(double d) {
+    uint64_t u; std::memcpy(&u, &d, 8);
+    b.push_back(0xFB);
+    for (int s = 56; s >= 0; s -= 8) b.push_back(static_cast<uint8_t>(u >> s));
+  }
+  void open(uint8_t t) { b.push_back(t); }
+  void close() { b.push_back(0xFF); }
+};
+
+size_t encodeRows(const LiveSample* s, int n) {
+  Cbor c;
+  c.open(0xBF);
+  c.text("items");
+  c.open(0x9F);
+  for (int k = 0; k < n; ++k) {
+    c.open(0xBF);
+    c.text("seq"); c.uint(s[k].seq);
+    c.text("ts"); c.uint(s[k].tsMs);
+    c.text("capV"); c.dbl(s[k].capV);
+    c.text("i"); c.dbl(s[k].currentA);
+    c.text("mask"); c.uint(s[k].outputsMask);
+    c.text("relay"); c.boolean(s[k].relay);
+    c.text("ac"); c.boolean(s[k].ac);
+    c.text("fan"); c.uint(s[k].fanPct);
+    c.text("wireTemps"); c.open(0x9F);
+    for (int w = 0; w < kWires; ++w) c.sint(s[k].wireTemps[w]);
+    c.close();
+    c.close();
+  }
+  c.close();
+  c.text("seqStart"); c.uint(s[0].seq);
+  c.text("seqEnd"); c.uint(s[n - 1].seq);
+  c.close();
+  return c.b.size();
+}
+
+const char* const kNames[] = {"ts", "capV", "i", "mask", "relay", "ac", "fan"};
+const int32_t kScales[] = {1, 100, 1000, 1, 1, 1, 1};
+constexpr int kFixed = 7;
+constexpr int kCols = kFixed + kWires;
+
+int32_t columnValue(const LiveSample& s, int c, uint32_t t0, uint32_t dt, int k) {
+  switch (c) {
+    case 0: return LiveColumnar::tsResidual(s.tsMs, t0, dt, k);
+    case 1: return LiveColumnar::quantize(s.capV, kScales[1]);
+    case 2: return LiveColumnar::quantize(s.currentA, kScales[2]);
+    case 3: return s.outputsMask;
+    case 4: return s.relay;
+    case 5: return s.ac;
+    case 6: return s.fanPct;
+    default: return s.wireTemps[c - kFixed];
+  }
+}
+
+// Mirrors WiFiManager::buildLiveColumns_; returns the per-column bytes too.
+size_t encodeColumns(const LiveSample* s, int n, std::vector<std::vector<uint8_t>>& cols) {
+  const uint32_t t0 = s[0].tsMs;
+  const uint32_t dt = LiveColumnar::meanPeriod(t0, s[n - 1].tsMs, n);
+  Cbor c;
+  c.open(0xBF);
+  c.text("fmt"); c.text(LiveColumnar::kFormat);
+  c.text("n"); c.uint(n);
+  c.text("t0"); c.uint(t0);
+  c.text("dt"); c.uint(dt);
+  c.text("cols"); c.head(4, kCols);
+  for (int k = 0; k < kCols; ++k) {
+    char name[8];
+    if (k >= kFixed) std::snprintf(name, sizeof(name), "wt%d", k - kFixed + 1);
+    c.text(k < kFixed ? kNames[k] : name);
+  }
+  c.text("scale"); c.head(4, kCols);
+  for (int k = 0; k < kCols; ++k) c.sint(k < kFixed ? kScales[k] : 1);
+  c.text("data"); c.head(4, kCols);
+  cols.assign(kCols, {});
+  uint8_t buf[kRing * LiveColumnar::kMaxVarint];
+  for (int k = 0; k < kCols; ++k) {
+    LiveColumnar::ColumnEncoder enc(buf, sizeof(buf));
+    for (int i = 0; i < n; ++i) enc.add(columnValue(s[i], k, t0, dt, i));
+    cols[k].assign(buf, buf + enc.size());
+    c.bytes(buf, enc.size());
+  }
+  c.text("seqStart"); c.uint(s[0].seq);
+  c.text("seqEnd"); c.uint(s[n - 1].seq);
+  c.close();
+  return c.b.size();
+}
+
+bool roundTrip(const LiveSample* s, int n, const std::vector<std::vector<uint8_t>>& cols) {
+  const uint32_t t0 = s[0].tsMs;
+  const uint32_t dt = LiveColumnar::meanPeriod(t0, s[n - 1].tsMs, n);
+  int32_t out[kRing];
+  for (int k = 0; k < kCols; ++k) {
+    if (LiveColumnar::decodeColumn(cols[k].data(), cols[k].size(), 0, out, kRing) != n) return false;
+    for (int i = 0; i < n; ++i) {
+      const double v = static_cast<double>(out[i]) / (k < kFixed ? kScales[k] : 1);
+      switch (k) {
+        case 0: if (LiveColumnar::tsFromResidual(out[i], t0, dt, i) != s[i].tsMs) return false; break;
+        case 1: if (std::fabs(v - s[i].capV) > 0.005 + 1e-6) return false; break;
+        case 2: if (std::fabs(v - s[i].currentA) > 0.0005 + 1e-7) return false; break;
+        default: if (out[i] != columnValue(s[i], k, t0, dt, i)) return false; break;
+      }
+    }
+  }
+  return true;
+}
+
+bool run(const char* name, const std::vector<LiveSample>& trace) {
+  std::vector<std::vector<uint8_t>> cols;
+  bool ok = true;
+  std::printf("%s\n", name);
+  const int sizes[2] = {kRing, 16};
+  for (int n : sizes) {
+    const LiveSample* s = trace.data() + (kRing - n);
+    const size_t rows = encodeRows(s, n);
+    const size_t colsBytes = encodeColumns(s, n, cols);
+    const bool rt = roundTrip(s, n, cols);
+    ok = ok && rt;
+    size_t tsBytes = cols[0].size();
+    std::printf("  %2d samples: rows %5zu B  columns %4zu B  (%.1fx smaller, ts column %zu B)  %s\n",
+                n, rows, colsBytes, static_cast<double>(rows) / colsBytes, tsBytes,
+                rt ? "round-trip ok" : "ROUND-TRIP FAILED");
+  }
+  return ok;
+}
+
+} // namespace
+
+int main() {
+  // Codec edge cases: extremes and wrap-around deltas.
+  const int32_t edge[] = {0, -1, 1, 2147483647, -2147483647 - 1, 63, -64, 64, -65, 0};
+  uint8_t buf[64];
+  LiveColumnar::ColumnEncoder enc(buf, sizeof(buf));
+  for (int32_t v : edge) enc.add(v);
+  int32_t back[16];
+  const int n = LiveColumnar::decodeColumn(buf, enc.size(), 0, back, 16);
+  bool ok = enc.ok() && n == static_cast<int>(sizeof(edge) / sizeof(edge[0]));
+  for (int i = 0; ok && i < n; ++i) ok = back[i] == edge[i];
+  std::printf("edge values: %s\n", ok ? "ok" : "FAILED");
+
+  ok = run("heating trace", heatingTrace()) && ok;
+  ok = run("idle trace", idleTrace()) && ok;
+  std::printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,358 @@
+// Host benchmark: /monitor fixed fields re-encoded every snapshot vs the
+// CborTemplate patched in place.
+//
+// Paths, per snapshot period:
+//   encode    what snapshotTask did: zero-fill the 4 KB buffer, then encode
+//             every key and value (doubles, shortest ints, "outputN" keys
+//             built with snprintf)
+//   template  set each slot (fixed-width float32 / uint32 / bool), then
+//             copy the pairs into the frame buffer
+// Both encode the same fields (the part of /monitor whose shape never
+// changes); decoded values must match. Reports ns per update, heap
+// allocations per update and the bytes of the fixed part.
+// tinycbor is not available on host: the encode path uses a minimal writer
+// with the same output, which is faster than tinycbor, so the measured gap
+// is a lower bound.
+//
+// Build & run from the repo root:
+//   g++ -std=c++17 -O2 -Isrc/comms -o /tmp/monitor_template_bench
+//       tools/monitor_template_bench.cpp src/comms/CborTemplate.cpp
+//   /tmp/monitor_template_bench
+
+#include <CborTemplate.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace {
+
+constexpr int kSensors = 12;   // MAX_TEMP_SENSORS
+constexpr int kWires = 10;     // HeaterManager::kWireCount
+constexpr size_t kMonitorCborMax = 4096;
+constexpr int kIters = 200000;
+
+size_t gAllocs = 0;
+
+struct Sample {
+  float capV, capAdc, current, currentAcs, capF;
+  float temps[kSensors];
+  float board, heatsink;
+  double wireTemps[kWires];
+  bool present[kWires];
+  uint8_t health[kWires];
+  float ohm[kWires], conf[kWires], drift[kWires];
+  bool outputs[kWires];
+  bool ready, off, ac, relay;
+  uint32_t fan;
+  bool sta, connected;
+  float totalWh;
+  uint32_t sessions, sessionsOk;
+};
+
+Sample makeSample(int k) {
+  Sample s{};
+  s.capV = 300.0f + (k % 50) * 0.37f;
+  s.capAdc = 38.5f + (k % 7) * 0.01f;
+  s.current = 4.2f + (k % 13) * 0.05f;
+  s.currentAcs = s.current * 1.01f;
+  s.capF = 0.0021f;
+  for (int i = 0; i < kSensors; ++i) s.temps[i] = i < 3 ? 24.0f + i + (k % 5) * 0.0625f : -127.0f;
+  s.board = 41.5f;
+  s.heatsink = 38.25f;
+  for (int i = 0; i < kWires; ++i) {
+    s.wireTemps[i] = 20.0 + i * 12.3 + (k % 30);
+    s.present[i] = i != 7;
+    s.health[i] = static_cast<uint8_t>(i == 7 ? 2 : 0);
+    s.ohm[i] = 44.0f + i * 0.1f;
+    s.conf[i] = 80.0f + i;
+    s.drift[i] = -0.5f + i * 0.1f;
+    s.outputs[i] = ((k + i) % 3) == 0;
+  }
+  s.ready = false;
+  s.off = false;
+  s.ac = true;
+  s.relay = true;
+  s.fan = 40 + k % 20;
+  s.sta = true;
+  s.connected = true;
+  s.totalWh = 1234.5f;
+  s.sessions = 321;
+  s.sessionsOk = 300;
+  return s;
+}
+
+// --- Minimal CBOR writer (tinycbor-compatible output) ---
+struct Cbor {
+  uint8_t* p;
+  size_t n = 0;
+  void head(uint8_t major, uint64_t v) {
+    if (v < 24) { p[n++] = static_cast<uint8_t>((major << 5) | v); return; }
+    const int bytes = v <= 0xFF ? 1 : v <= 0xFFFF ? 2 : 4;
+    p[n++] = static_cast<uint8_t>((major << 5) | (bytes == 1 ? 24 : bytes == 2 ? 25 : 26));
+    for (int s = (bytes - 1) * 8; s >= 0; s -= 8) p[n++] = static_cast<uint8_t>(v >> s);
+  }
+  void text(const char* s) { const size_t l = std::strlen(s); head(3, l); std::memcpy(p + n, s, l); n += l; }
+  void uint(uint64_t v) { head(0, v); }
+  void sint(int64_t v) { if (v >= 0) head(0, v); else head(1, static_cast<uint64_t>(-1 - v)); }
+  void boolean(bool b) { p[n++] = b ? 0xF5 : 0xF4; }
+  void dbl(double d) {
+    uint64_t u; std::memcpy(&u, &d, 8);
+    p[n++] = 0xFB;
+    for (int s = 56; s >= 0; s -= 8) p[n++] = static_cast<uint8_t>(u >> s);
+  }
+  void flt(float f) {
+    uint32_t u; std::memcpy(&u, &f, 4);
+    p[n++] = 0xFA;
+    for (int s = 24; s >= 0; s -= 8) p[n++] = static_cast<uint8_t>(u >> s);
+  }
+  void open(uint8_t b) { p[n++] = b; }
+  void close() { p[n++] = 0xFF; }
+};
+
+size_t encodeFixed(std::vector<uint8_t>& buf, const Sample& s) {
+  buf.assign(kMonitorCborMax, 0);
+  Cbor c{buf.data()};
+  c.open(0xBF);
+  c.text("capVoltage"); c.dbl(s.capV);
+  c.text("capAdcRaw"); c.dbl(s.capAdc);
+  c.text("current"); c.dbl(s.current);
+  c.text("currentAcs"); c.dbl(s.currentAcs);
+  c.text("capacitanceF"); c.dbl(s.capF);
+  c.text("temperatures"); c.open(0x9F);
+  for (int i = 0; i < kSensors; ++i) c.dbl(s.temps[i]);
+  c.close();
+  c.text("boardTemp"); c.dbl(s.board);
+  c.text("heatsinkTemp"); c.dbl(s.heatsink);
+  c.text("wireTemps"); c.open(0x9F);
+  for (int i = 0; i < kWires; ++i) c.sint(std::lround(s.wireTemps[i]));
+  c.close();
+  c.text("wirePresent"); c.open(0x9F);
+  for (int i = 0; i < kWires; ++i) c.boolean(s.present[i]);
+  c.close();
+  c.text("wireHealth"); c.open(0x9F);
+  for (int i = 0; i < kWires; ++i) c.uint(s.health[i]);
+  c.close();
+  c.text("wireRes"); c.open(0xBF);
+  const char* const keys[3] = {"ohm", "conf", "drift"};
+  const float* const vals[3] = {s.ohm, s.conf, s.drift};
+  for (int k = 0; k < 3; ++k) {
+    c.text(keys[k]); c.head(4, kWires);
+    for (int i = 0; i < kWires; ++i) c.flt(vals[k][i]);
+  }
+  c.close();
+  c.text("outputs"); c.open(0xBF);
+  for (int i = 0; i < kWires; ++i) {
+    char key[12];
+    std::snprintf(key, sizeof(key), "output%u", static_cast<unsigned>(i + 1));
+    c.text(key); c.boolean(s.outputs[i]);
+  }
+  c.close();
+  c.text("ready"); c.boolean(s.ready);
+  c.text("off"); c.boolean(s.off);
+  c.text("ac"); c.boolean(s.ac);
+  c.text("relay"); c.boolean(s.relay);
+  c.text("fanSpeed"); c.uint(s.fan);
+  c.text("wifiSta"); c.boolean(s.sta);
+  c.text("wifiConnected"); c.boolean(s.connected);
+  c.text("sessionTotals"); c.open(0xBF);
+  c.text("totalEnergy_Wh"); c.dbl(s.totalWh);
+  c.text("totalSessions"); c.uint(s.sessions);
+  c.text("totalSessionsOk"); c.uint(s.sessionsOk);
+  c.close();
+  c.close();
+  buf.resize(c.n);
+  return c.n;
+}
+
+// Same field order and slot layout as WiFiStreams.cpp buildMonitorTemplate.
+struct Slots {
+  using Id = CborTemplate::SlotId;
+  Id capV, capAdc, current, currentAcs, capF, temps[kSensors], board, heatsink;
+  Id wireTemps[kWires], present[kWires], health[kWires];
+  Id ohm[kWires], conf[kWires], drift[kWires], outputs[kWires];
+  Id ready, off, ac, relay, fan, sta, connected, totalWh, sessions, sessionsOk;
+};
+
+bool buildTemplate(CborTemplate& t, Slots& m) {
+  t.reset((kSensors << 8) | kWires);
+  m.capV = t.addF32("capVoltage");
+  m.capAdc = t.addF32("capAdcRaw");
+  m.current = t.addF32("current");
+  m.currentAcs = t.addF32("currentAcs");
+  m.capF = t.addF32("capacitanceF");
+  t.beginArray("temperatures");
+  for (int i = 0; i < kSensors; ++i) m.temps[i] = t.f32();
+  t.end();
+  m.board = t.addF32("boardTemp");
+  m.heatsink = t.addF32("heatsinkTemp");
+  t.beginArray("wireTemps");
+  for (int i = 0; i < kWires; ++i) m.wireTemps[i] = t.i32();
+  t.end();
+  t.beginArray("wirePresent");
+  for (int i = 0; i < kWires; ++i) m.present[i] = t.boolean();
+  t.end();
+  t.beginArray("wireHealth");
+  for (int i = 0; i < kWires; ++i) m.health[i] = t.u32();
+  t.end();
+  t.beginMap("wireRes");
+  t.beginArray("ohm");
+  for (int i = 0; i < kWires; ++i) m.ohm[i] = t.f32();
+  t.end();
+  t.beginArray("conf");
+  for (int i = 0; i < kWires; ++i) m.conf[i] = t.f32();
+  t.end();
+  t.beginArray("drift");
+  for (int i = 0; i < kWires; ++i) m.drift[i] = t.f32();
+  t.end();
+  t.end();
+  t.beginMap("outputs");
+  for (int i = 0; i < kWires; ++i) {
+    char key[12];
+    std::snprintf(key, sizeof(key), "output%u", static_cast<unsigned>(i + 1));
+    m.outputs[i] = t.addBool(key);
+  }
+  t.end();
+  m.ready = t.addBool("ready");
+  m.off = t.addBool("off");
+  m.ac = t.addBool("ac");
+  m.relay = t.addBool("relay");
+  m.fan = t.addU32("fanSpeed");
+  m.sta = t.addBool("wifiSta");
+  m.connected = t.addBool("wifiConnected");
+  t.beginMap("sessionTotals");
+  m.totalWh = t.addF32("totalEnergy_Wh");
+  m.sessions = t.addU32("totalSessions");
+  m.sessionsOk = t.addU32("totalSessionsOk");
+  t.end();
+  return t.finish();
+}
+
+size_t patchTemplate(CborTemplate& t, const Slots& m, std::vector<uint8_t>& buf, const Sample& s) {
+  t.setF32(m.capV, s.capV);
+  t.setF32(m.capAdc, s.capAdc);
+  t.setF32(m.current, s.current);
+  t.setF32(m.currentAcs, s.currentAcs);
+  t.setF32(m.capF, s.capF);
+  for (int i = 0; i < kSensors; ++i) t.setF32(m.temps[i], s.temps[i]);
+  t.setF32(m.board, s.board);
+  t.setF32(m.heatsink, s.heatsink);
+  for (int i = 0; i < kWires; ++i) {
+    t.setI32(m.wireTemps[i], static_cast<int32_t>(std::lround(s.wireTemps[i])));
+    t.setBool(m.present[i], s.present[i]);
+    t.setU32(m.health[i], s.health[i]);
+    t.setF32(m.ohm[i], s.ohm[i]);
+    t.setF32(m.conf[i], s.conf[i]);
+    t.setF32(m.drift[i], s.drift[i]);
+    t.setBool(m.outputs[i], s.outputs[i]);
+  }
+  t.setBool(m.ready, s.ready);
+  t.setBool(m.off, s.off);
+  t.setBool(m.ac, s.ac);
+  t.setBool(m.relay, s.relay);
+  t.setU32(m.fan, s.fan);
+  t.setBool(m.sta, s.sta);
+  t.setBool(m.connected, s.connected);
+  t.setF32(m.totalWh, s.totalWh);
+  t.setU32(m.sessions, s.sessions);
+  t.setU32(m.sessionsOk, s.sessionsOk);
+
+  buf.resize(kMonitorCborMax);
+  size_t n = 0;
+  buf[n++] = 0xBF;
+  std::memcpy(buf.data() + n, t.data(), t.size());
+  n += t.size();
+  buf[n++] = 0xFF;
+  buf.resize(n);
+  return n;
+}
+
+// --- Minimal decoder: flattens every scalar to a double, in order ---
+bool flatten(const uint8_t* p, size_t len, std::vector<double>& out) {
+  size_t i = 0;
+  auto arg = [&](uint8_t ai, uint64_t& v) {
+    if (ai < 24) { v = ai; return true; }
+    const int bytes = ai == 24 ? 1 : ai == 25 ? 2 : ai == 26 ? 4 : ai == 27 ? 8 : 0;
+    if (!bytes || i + bytes > len) return false;
+    v = 0;
+    for (int b = 0; b < bytes; ++b) v = (v << 8) | p[i++];
+    return true;
+  };
+  while (i < len) {
+    const uint8_t ib = p[i++];
+    const uint8_t major = ib >> 5, ai = ib & 31;
+    uint64_t v = 0;
+    if (ib == 0xBF || ib == 0x9F || ib == 0xFF) continue;
+    if (major == 4) { if (!arg(ai, v)) return false; continue; }
+    if (major == 3) { if (!arg(ai, v)) return false; i += v; continue; }
+    if (major == 0) { if (!arg(ai, v)) return false; out.push_back(static_cast<double>(v)); continue; }
+    if (major == 1) { if (!arg(ai, v)) return false; out.push_back(-1.0 - static_cast<double>(v)); continue; }
+    if (ib == 0xF4 || ib == 0xF5) { out.push_back(ib == 0xF5); continue; }
+    if (ib == 0xFA) { uint64_t u; if (!arg(26, u)) return false; uint32_t w = static_cast<uint32_t>(u); float f; std::memcpy(&f, &w, 4); out.push_back(f); continue; }
+    if (ib == 0xFB) { uint64_t u; if (!arg(27, u)) return false; double d; std::memcpy(&d, &u, 8); out.push_back(d); continue; }
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+void* operator new(size_t n) { ++gAllocs; void* p = std::malloc(n ? n : 1); if (!p) throw std::bad_alloc(); return p; }
+void* operator new[](size_t n) { ++gAllocs; void* p = std::malloc(n ? n : 1); if (!p) throw std::bad_alloc(); return p; }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+int main() {
+  static CborTemplate tpl;
+  Slots slots{};
+  if (!buildTemplate(tpl, slots)) {
+    std::printf("template overflow\n");
+    return 1;
+  }
+
+  // Same values out of both paths?
+  std::vector<uint8_t> a, b;
+  a.reserve(kMonitorCborMax);
+  b.reserve(kMonitorCborMax);
+  bool same = true;
+  for (int k = 0; k < 100 && same; ++k) {
+    const Sample s = makeSample(k);
+    encodeFixed(a, s);
+    patchTemplate(tpl, slots, b, s);
+    std::vector<double> va, vb;
+    same = flatten(a.data(), a.size(), va) && flatten(b.data(), b.size(), vb) && va == vb;
+  }
+
+  const Sample samples[4] = {makeSample(1), makeSample(2), makeSample(3), makeSample(4)};
+  volatile size_t sink = 0;
+
+  gAllocs = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int k = 0; k < kIters; ++k) sink += encodeFixed(a, samples[k & 3]);
+  auto t1 = std::chrono::steady_clock::now();
+  const size_t encAllocs = gAllocs;
+  const size_t encBytes = a.size();
+
+  gAllocs = 0;
+  auto t2 = std::chrono::steady_clock::now();
+  for (int k = 0; k < kIters; ++k) sink += patchTemplate(tpl, slots, b, samples[k & 3]);
+  auto t3 = std::chrono::steady_clock::now();
+  const size_t tplAllocs = gAllocs;
+  const size_t tplBytes = b.size();
+
+  const double encNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / kIters;
+  const double tplNs = std::chrono::duration<double, std::nano>(t3 - t2).count() / kIters;
+  std::printf("Fixed /monitor fields (%d sensors, %d wires, %zu slots)\n",
+              kSensors, kWires, tpl.slotCount());
+  std::printf("  encode    %7.1f ns/update  allocs %zu  %4zu B\n", encNs, encAllocs, encBytes);
+  std::printf("  template  %7.1f ns/update  allocs %zu  %4zu B\n", tplNs, tplAllocs, tplBytes);
+  std::printf("  speedup   %.1fx\n", encNs / tplNs);
+  std::printf("  decoded values %s\n", same ? "identical" : "DIFFER");
+  return same ? 0 : 1;
+}
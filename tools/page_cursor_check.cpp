@@ -0,0 +1,539 @@
+// Host check: cursor paging (PageCursor) and plot decimation (Decimator)
+// for /session_history and /calib_data.
+//
+// Cursor text: round trip, every single-digit edit and truncation is
+// rejected, a cursor from the other route is Invalid, a reboot or a new
+// data set is Expired.
+// History paging: MockHistory mirrors the PowerTracker ring (800 slots,
+// append sequence, getHistoryEntryBySeq) and historyPage() mirrors
+// makeHistoryPageStream (limit, scan cap, start_ms filter, next / gap).
+// A client pages through while sessions keep ending between pages:
+//   - every row comes at most once, newest first
+//   - rows that were stored when paging began come back unless the ring
+//     overwrote them first, and then the page says gap
+//   - offset paging over the same appends is shown for comparison
+// Calib paging: MockRecorder + CalibSampleReader mirror the route; a
+// client polls "next" while the run records and gets every sample once;
+// a restarted run makes the page stale.
+// Decimation: buckets against a brute-force min / max / mean per pixel
+// column, NaN skipping, spike survival, cost per sample.
+//
+// Build & run from the repo root:
+//   g++ -std=c++17 -O2 -Isrc/comms -Isrc/utils -o /tmp/page_cursor_check
+//       tools/page_cursor_check.cpp src/comms/PageCursor.cpp
+//       src/utils/Decimator.cpp
+//   /tmp/page_cursor_check
+
+#include <PageCursor.hpp>
+#include <Decimator.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool cond, const char* what) {
+  std::printf("  %-62s %s\n", what, cond ? "ok" : "FAILED");
+  if (!cond) ++failures;
+}
+
+// ---------------------------------------------------------------- cursor
+
+void cursorText() {
+  std::printf("cursor text:\n");
+  std::mt19937 rng(7);
+  bool roundTrip = true;
+  for (int k = 0; k < 10000 && roundTrip; ++k) {
+    PageCursor::Token t;
+    t.source = (k & 1) ? PageCursor::Source::Calib : PageCursor::Source::History;
+    t.boot = rng();
+    t.dataset = rng();
+    t.pos = rng();
+    t.floor = rng();
+    char text[PageCursor::kTextMax];
+    PageCursor::Token back;
+    roundTrip = PageCursor::format(t, text, sizeof(text)) && std::strlen(text) == PageCursor::kTextLen &&
+                PageCursor::parse(text, back) && back.source == t.source && back.boot == t.boot &&
+                back.dataset == t.dataset && back.pos == t.pos && back.floor == t.floor;
+  }
+  expect(roundTrip, "format / parse round trip (10000 random tokens)");
+
+  PageCursor::Token t;
+  t.boot = 0x1234abcdu;
+  t.dataset = 3;
+  t.pos = 812;
+  t.floor = 12;
+  char text[PageCursor::kTextMax];
+  PageCursor::format(t, text, sizeof(text));
+
+  size_t edits = 0, caught = 0;
+  for (size_t i = 0; i < PageCursor::kTextLen; ++i) {
+    for (const char* d = "0123456789abcdef"; *d; ++d) {
+      if (*d == text[i]) continue;
+      std::string e(text);
+      e[i] = *d;
+      PageCursor::Token out;
+      ++edits;
+      if (!PageCursor::parse(e.c_str(), out)) ++caught;
+    }
+  }
+  char line[96];
+  std::snprintf(line, sizeof(line), "single-digit edits rejected (%zu of %zu)", caught, edits);
+  expect(caught == edits, line);
+
+  PageCursor::Token out;
+  std::string s(text);
+  expect(!PageCursor::parse(s.substr(0, s.size() - 1).c_str(), out), "truncated cursor rejected");
+  expect(!PageCursor::parse((s + "0").c_str(), out), "extended cursor rejected");
+  std::string upper(s);
+  std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+  expect(upper == s || !PageCursor::parse(upper.c_str(), out), "uppercase hex rejected");
+  expect(!PageCursor::parse("", out) && !PageCursor::parse(nullptr, out), "empty / null rejected");
+
+  using PageCursor::Check;
+  using PageCursor::Source;
+  expect(PageCursor::check(text, Source::History, 0x1234abcdu, 3, out) == Check::Ok, "same boot and dataset -> Ok");
+  expect(PageCursor::check(text, Source::Calib, 0x1234abcdu, 3, out) == Check::Invalid, "history cursor on calib route -> Invalid");
+  expect(PageCursor::check(text, Source::History, 0x0badf00du, 3, out) == Check::Expired, "after reboot -> Expired");
+  expect(PageCursor::check(text, Source::History, 0x1234abcdu, 4, out) == Check::Expired, "history cleared / reloaded -> Expired");
+}
+
+// ------------------------------------------------------------ history
+
+constexpr uint32_t kRing = 800;      // POWERTRACKER_HISTORY_MAX
+constexpr uint16_t kScanMax = 400;   // kHistoryScanMax
+
+struct Entry {
+  bool valid = false;
+  uint32_t startMs = 0;
+  uint32_t id = 0;   // = append sequence, to check what came back
+};
+
+// Mirrors PowerTracker's ring and getHistoryEntryBySeq.
+struct MockHistory {
+  Entry ring[kRing];
+  uint16_t head = 0, count = 0;
+  uint32_t endSeq = 0;
+  uint32_t clock = 1000;
+
+  void append() {
+    Entry e;
+    e.valid = true;
+    e.startMs = clock;
+    e.id = endSeq;
+    clock += 60000;
+    ring[head] = e;
+    head = static_cast<uint16_t>((head + 1) % kRing);
+    ++endSeq;
+    if (count < kRing) ++count;
+  }
+  uint32_t oldest() const { return endSeq > count ? endSeq - count : 0; }
+  bool bySeq(uint32_t seq, Entry& out) const {
+    if (seq >= endSeq || endSeq - seq > count) return false;
+    out = ring[seq % kRing];
+    return out.valid;
+  }
+  // getHistoryEntry(indexFromNewest), for the offset baseline.
+  bool byIndex(uint32_t i, Entry& out) const {
+    if (i >= count) return false;
+    out = ring[(head + kRing - 1 - i) % kRing];
+    return out.valid;
+  }
+};
+
+struct HistoryPage {
+  std::vector<Entry> rows;
+  bool hasNext = false;
+  PageCursor::Token next;
+  bool gap = false;
+};
+
+// Mirrors makeHistoryPageStream (rows, then tail).
+HistoryPage historyPage(const MockHistory& h, PageCursor::DescendingWalk walk, uint16_t limit,
+                        uint32_t fromMs, uint32_t toMs) {
+  HistoryPage p;
+  uint16_t scanned = 0;
+  while (p.rows.size() < limit && scanned < kScanMax) {
+    uint32_t seq = 0;
+    if (!walk.next(h.oldest(), seq)) break;
+    ++scanned;
+    Entry e;
+    if (!h.bySeq(seq, e)) continue;
+    if (e.startMs < fromMs || e.startMs > toMs) continue;
+    p.rows.push_back(e);
+  }
+  if (walk.more(h.oldest())) {
+    p.hasNext = true;
+    p.next.pos = walk.pos;
+    p.next.floor = walk.floor;
+  }
+  p.gap = walk.gap;
+  return p;
+}
+
+struct PagingResult {
+  std::vector<uint32_t> ids;
+  int pages = 0;
+  bool gap = false;
+  bool ordered = true;
+  bool viaText = true;
+};
+
+// Client loop: first page, then follow "next" (through the text form)
+// with `appendsPerPage` sessions ending before each request.
+PagingResult pageAll(MockHistory& h, uint16_t limit, uint32_t appendsPerPage, uint32_t fromMs = 0,
+                     uint32_t toMs = UINT32_MAX) {
+  PagingResult r;
+  const uint32_t boot = 0xfeedbeefu, dataset = 1;
+  PageCursor::DescendingWalk walk;
+  walk.pos = h.endSeq;
+  walk.floor = h.oldest();
+  while (true) {
+    const HistoryPage p = historyPage(h, walk, limit, fromMs, toMs);
+    ++r.pages;
+    r.gap = r.gap || p.gap;
+    for (const Entry& e : p.rows) {
+      if (!r.ids.empty() && e.id >= r.ids.back()) r.ordered = false;
+      r.ids.push_back(e.id);
+    }
+    if (!p.hasNext || r.pages > 10000) break;
+    PageCursor::Token t = p.next;
+    t.source = PageCursor::Source::History;
+    t.boot = boot;
+    t.dataset = dataset;
+    char text[PageCursor::kTextMax];
+    PageCursor::format(t, text, sizeof(text));
+    for (uint32_t k = 0; k < appendsPerPage; ++k) h.append();
+    PageCursor::Token back;
+    if (PageCursor::check(text, PageCursor::Source::History, boot, dataset, back) != PageCursor::Check::Ok) {
+      r.viaText = false;
+      break;
+    }
+    walk = PageCursor::DescendingWalk{};
+    walk.pos = back.pos;
+    walk.floor = back.floor;
+  }
+  return r;
+}
+
+// Offset paging (?offset=N&count=M over getHistoryEntry) for comparison.
+void offsetBaseline(MockHistory& h, uint16_t limit, uint32_t appendsPerPage, size_t& dupes, size_t& missed) {
+  std::set<uint32_t> seen;
+  std::vector<uint32_t> want;
+  for (uint32_t s = h.oldest(); s < h.endSeq; ++s) want.push_back(s);
+  dupes = 0;
+  for (uint32_t offset = 0;; offset += limit) {
+    bool any = false;
+    for (uint32_t i = offset; i < offset + limit; ++i) {
+      Entry e;
+      if (!h.byIndex(i, e)) break;
+      any = true;
+      if (!seen.insert(e.id).second) ++dupes;
+    }
+    if (!any) break;
+    for (uint32_t k = 0; k < appendsPerPage; ++k) h.append();
+  }
+  missed = 0;
+  for (uint32_t id : want) missed += seen.count(id) ? 0 : 1;
+}
+
+void historyPaging() {
+  std::printf("history paging (ring %u, limit 100):\n", kRing);
+  char line[128];
+
+  {
+    MockHistory h;
+    for (int k = 0; k < 500; ++k) h.append();
+    const PagingResult r = pageAll(h, 100, 0);
+    bool all = r.ids.size() == 500;
+    for (size_t k = 0; all && k < r.ids.size(); ++k) all = r.ids[k] == 499 - k;
+    std::snprintf(line, sizeof(line), "static, 500 entries -> %zu rows in %d pages, newest first", r.ids.size(), r.pages);
+    expect(all && r.ordered && !r.gap && r.viaText, line);
+  }
+
+  {
+    MockHistory h;
+    for (int k = 0; k < 300; ++k) h.append();
+    const PagingResult r = pageAll(h, 100, 37);
+    bool all = r.ids.size() == 300;
+    for (size_t k = 0; all && k < r.ids.size(); ++k) all = r.ids[k] == 299 - k;
+    std::snprintf(line, sizeof(line), "37 appends per page, ring not full -> %zu rows, exactly the snapshot", r.ids.size());
+    expect(all && r.ordered && !r.gap, line);
+  }
+
+  {
+    MockHistory h;
+    for (int k = 0; k < 1000; ++k) h.append();
+    const uint32_t oldest0 = h.oldest(), end0 = h.endSeq;
+    const PagingResult r = pageAll(h, 100, 90);
+    std::set<uint32_t> got(r.ids.begin(), r.ids.end());
+    bool subset = got.size() == r.ids.size();
+    for (uint32_t id : r.ids) subset = subset && id >= oldest0 && id < end0;
+    bool lostOnlyOverwritten = true;
+    size_t lost = 0;
+    for (uint32_t s = oldest0; s < end0; ++s) {
+      if (got.count(s)) continue;
+      ++lost;
+      if (s >= h.oldest()) lostOnlyOverwritten = false;
+    }
+    std::snprintf(line, sizeof(line), "ring full, 90 appends per page -> %zu rows, %zu overwritten, gap=%s",
+                  r.ids.size(), lost, r.gap ? "true" : "false");
+    expect(subset && r.ordered && lostOnlyOverwritten && (lost > 0) == r.gap, line);
+
+    MockHistory b;
+    for (int k = 0; k < 1000; ++k) b.append();
+    size_t dupes = 0, missed = 0;
+    offsetBaseline(b, 100, 90, dupes, missed);
+    std::printf("    offset paging, same appends: %zu duplicated rows, %zu missed, no gap signal\n", dupes, missed);
+  }
+
+  {
+    MockHistory h;
+    for (int k = 0; k < 800; ++k) h.append();
+    const uint32_t fromMs = h.ring[(h.head + 100) % kRing].startMs;
+    const uint32_t toMs = fromMs + 59 * 60000;   // 60 entries, near the oldest end
+    const PagingResult r = pageAll(h, 100, 0, fromMs, toMs);
+    bool inRange = r.ids.size() == 60;
+    std::snprintf(line, sizeof(line), "time filter, 60 of 800 entries -> %zu rows in %d pages (scan cap %u)",
+                  r.ids.size(), r.pages, kScanMax);
+    expect(inRange && r.ordered && r.pages >= 2, line);
+  }
+
+  {
+    MockHistory h;
+    const PagingResult r = pageAll(h, 100, 0);
+    expect(r.ids.empty() && r.pages == 1, "empty history -> one empty page, no next");
+  }
+}
+
+// -------------------------------------------------------------- calib
+
+struct Sample {
+  uint32_t tMs = 0;
+  float v = 0;
+};
+
+// Mirrors the CalibrationRecorder calls the route makes.
+struct MockRecorder {
+  std::vector<Sample> buf;
+  uint32_t runId = 1;
+  bool running = true;
+  int locks = 0;
+
+  size_t copySamples(uint32_t run, uint16_t offset, Sample* out, size_t maxOut) {
+    ++locks;
+    if (run != runId || offset >= buf.size()) return 0;
+    const size_t n = std::min(maxOut, buf.size() - offset);
+    std::copy(buf.begin() + offset, buf.begin() + offset + n, out);
+    return n;
+  }
+  void record(size_t n) {
+    for (size_t k = 0; k < n; ++k) buf.push_back({static_cast<uint32_t>(buf.size() * 500), static_cast<float>(buf.size())});
+  }
+};
+
+constexpr size_t kBatch = 16;   // kCalibCopyBatch
+
+// Mirrors CalibSampleReader.
+struct Reader {
+  MockRecorder* rec = nullptr;
+  uint32_t runId = 0;
+  uint32_t pos = 0;
+  bool runChanged = false;
+  Sample batch[kBatch];
+  size_t n = 0, at = 0;
+
+  bool next(Sample& out) {
+    if (at >= n) {
+      at = 0;
+      n = pos <= UINT16_MAX ? rec->copySamples(runId, static_cast<uint16_t>(pos), batch, kBatch) : 0;
+      if (n == 0) {
+        runChanged = rec->runId != runId;
+        return false;
+      }
+    }
+    out = batch[at++];
+    ++pos;
+    return true;
+  }
+};
+
+struct CalibPage {
+  std::vector<Sample> rows;
+  bool hasNext = false;
+  uint32_t nextPos = 0;
+  bool stale = false;
+};
+
+// Mirrors makeCalibPageStream.
+CalibPage calibPage(MockRecorder& rec, uint32_t runId, uint32_t offset, uint16_t limit, uint32_t toMs) {
+  CalibPage p;
+  Reader r;
+  r.rec = &rec;
+  r.runId = runId;
+  r.pos = offset;
+  bool pastTo = false;
+  while (p.rows.size() < limit) {
+    Sample s;
+    if (!r.next(s)) break;
+    if (s.tMs > toMs) {
+      pastTo = true;
+      break;
+    }
+    p.rows.push_back(s);
+  }
+  if (r.runChanged || rec.runId != runId) {
+    p.stale = true;
+  } else if (!pastTo && (rec.running || r.pos < rec.buf.size())) {
+    p.hasNext = true;
+    p.nextPos = r.pos;
+  }
+  return p;
+}
+
+void calibPaging() {
+  std::printf("calib paging (limit 50, copy batch %zu):\n", kBatch);
+  char line[128];
+
+  MockRecorder rec;
+  rec.record(30);
+  std::vector<uint32_t> got;
+  uint32_t pos = 0;
+  int polls = 0;
+  while (true) {
+    const CalibPage p = calibPage(rec, rec.runId, pos, 50, UINT32_MAX);
+    for (const Sample& s : p.rows) got.push_back(s.tMs / 500);
+    ++polls;
+    if (!p.hasNext) break;
+    pos = p.nextPos;
+    if (rec.buf.size() < 2000) rec.record(23);
+    else rec.running = false;
+  }
+  bool once = got.size() == rec.buf.size();
+  for (size_t k = 0; once && k < got.size(); ++k) once = got[k] == k;
+  std::snprintf(line, sizeof(line), "polling next while recording -> %zu of %zu samples once, %d polls",
+                got.size(), rec.buf.size(), polls);
+  expect(once, line);
+  std::snprintf(line, sizeof(line), "recorder locks per page: %.1f (one per %zu samples)",
+                static_cast<double>(rec.locks) / polls, kBatch);
+  expect(rec.locks <= polls * (50 / static_cast<int>(kBatch) + 2), line);
+
+  const CalibPage ranged = calibPage(rec, rec.runId, 100, 50, 100 * 500 + 9 * 500);
+  expect(ranged.rows.size() == 10 && !ranged.hasNext, "to= ends the walk without next");
+
+  const uint32_t oldRun = rec.runId;
+  ++rec.runId;
+  rec.buf.clear();
+  rec.record(10);
+  const CalibPage stale = calibPage(rec, oldRun, 5, 50, UINT32_MAX);
+  expect(stale.stale && stale.rows.empty() && !stale.hasNext, "run restarted under the cursor -> stale, no rows");
+}
+
+// --------------------------------------------------------- decimation
+
+void decimation() {
+  std::printf("decimation:\n");
+  std::mt19937 rng(3);
+  std::normal_distribution<float> noise(0.0f, 0.2f);
+  const size_t n = 2048;
+  std::vector<uint32_t> xs(n);
+  std::vector<float> a(n), b(n);
+  uint32_t t = 0;
+  for (size_t k = 0; k < n; ++k) {
+    t += 480 + rng() % 41;   // 500 ms +- jitter
+    xs[k] = t;
+    a[k] = 20.0f + 0.03f * k + noise(rng);
+    b[k] = (k % 97 == 0) ? NAN : 7.0f + noise(rng);
+  }
+  a[1234] = 500.0f;   // one-sample spike
+
+  for (uint16_t width : {1, 37, 300, 1024, 4000}) {
+    Decimator dec(xs.front(), xs.back(), width, 2);
+    std::vector<Decimator::Bucket> out;
+    for (size_t k = 0; k < n; ++k) {
+      const float v[2] = {a[k], b[k]};
+      if (dec.add(xs[k], v)) out.push_back(dec.ready());
+    }
+    if (dec.finish()) out.push_back(dec.ready());
+
+    // Brute force per pixel column.
+    bool match = true;
+    size_t total = 0;
+    bool spike = false;
+    for (const Decimator::Bucket& bk : out) {
+      float mn[2] = {INFINITY, INFINITY}, mx[2] = {-INFINITY, -INFINITY};
+      double sum[2] = {0, 0};
+      uint32_t cnt[2] = {0, 0}, m = 0;
+      for (size_t k = 0; k < n; ++k) {
+        if (dec.bucketOf(xs[k]) != bk.index) continue;
+        ++m;
+        const float v[2] = {a[k], b[k]};
+        for (int f = 0; f < 2; ++f) {
+          if (!std::isfinite(v[f])) continue;
+          mn[f] = std::min(mn[f], v[f]);
+          mx[f] = std::max(mx[f], v[f]);
+          sum[f] += v[f];
+          ++cnt[f];
+        }
+      }
+      total += bk.n;
+      match = match && m == bk.n;
+      for (int f = 0; f < 2; ++f) {
+        match = match && cnt[f] == bk.count[f] && mn[f] == bk.min[f] && mx[f] == bk.max[f] &&
+                std::fabs(sum[f] / cnt[f] - bk.mean(static_cast<uint8_t>(f))) < 1e-4;
+      }
+      spike = spike || bk.max[0] == 500.0f;
+    }
+    char line[128];
+    std::snprintf(line, sizeof(line), "width %4u -> %4zu buckets, all %zu samples, brute force match, spike kept",
+                  width, out.size(), total);
+    expect(match && total == n && spike && out.size() <= std::min<size_t>(width, Decimator::kMaxWidth), line);
+  }
+
+  {
+    Decimator dec(0, 9999, 10, 1);
+    const float v = 1.0f;
+    dec.add(5000, &v);
+    const bool behind = !dec.add(100, &v);
+    const bool outside = !dec.add(20000, &v);
+    dec.finish();
+    expect(behind && outside && dec.ready().n == 1, "samples behind the open bucket / outside the range ignored");
+  }
+
+  {
+    const int rounds = 200;
+    volatile size_t sink = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+      Decimator dec(xs.front(), xs.back(), 300, 2);
+      for (size_t k = 0; k < n; ++k) {
+        const float v[2] = {a[k], b[k]};
+        if (dec.add(xs[k], v)) sink = sink + dec.ready().n;
+      }
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (rounds * n);
+    std::printf("  %.1f ns per sample, Decimator state %zu bytes, walk state %zu bytes\n", ns,
+                sizeof(Decimator), sizeof(PageCursor::DescendingWalk));
+  }
+}
+
+} // namespace
+
+int main() {
+  cursorText();
+  historyPaging();
+  calibPaging();
+  decimation();
+  std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
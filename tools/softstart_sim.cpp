@@ -0,0 +1,278 @@
+// Host simulation: first seconds of a RUN with and without the soft start.
+//
+// Heater bus (source -> charge resistor -> capacitor bank -> one wire at a
+// time) right after precharge, cold wires (R(T) = R0 (1 + a (T - Tamb)),
+// lumped C dT/dt = P - k (T - Tamb)), full boost demand from the first
+// frame. Each frame: the scheduler's packets, SoftStartRamp::scale() when
+// the ramp is active, OutputInterleaver, then a droop pass that mirrors
+// WireScheduler::planForDroop (recharge gap so the pulse ends at or above
+// the floor, shortened when even a recharged bank cannot carry it; no
+// energy stretching). The floor is the bus floor, raised during the ramp
+// to SoftStartRamp::floorForPeakV(). Reported per run: charge-path
+// (inrush) and load current peaks per time window from the first frame,
+// energy delivered and the mean wire temperature.
+//
+// Checked, on minimum-length packets (60 ms, and 30 ms under a 30 ms
+// minOn): no packet leaves the ramp shorter than max(minOn,
+// OUTPUT_INTERLEAVE_MIN_SUB_MS), and no pulse leaves the interleaver and
+// the droop pass shorter than OUTPUT_INTERLEAVE_MIN_SUB_MS.
+//
+// Build & run from the repo root:
+//   g++ -std=c++17 -O2 -Isrc/wire -o /tmp/softstart_sim
+//       tools/softstart_sim.cpp src/wire/SoftStartRamp.cpp src/wire/OutputInterleaver.cpp
+//   /tmp/softstart_sim
+
+#include <OutputInterleaver.hpp>
+#include <SoftStartRamp.hpp>
+
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool cond, const char* what) {
+  std::printf("  %-62s %s\n", what, cond ? "ok" : "FAILED");
+  if (!cond) ++failures;
+}
+
+constexpr double kVSrc = 325.0;      // DEFAULT_DC_VOLTAGE
+constexpr double kRCharge = 35.0;    // DEFAULT_CHARGE_RESISTOR_OHMS
+constexpr double kWireOhm = 44.0;    // DEFAULT_WIRE_RES_OHMS (at ambient)
+constexpr double kTcr = 0.00017;     // NICHROME_ALPHA
+constexpr double kAmbC = 22.0;
+constexpr double kWireCapJK = 43.0;
+constexpr double kWireTauS = 35.0;
+constexpr double kBusFloorV = kVSrc * 0.70;   // DEFAULT_BUS_FLOOR_V
+constexpr double kCeilFrac = 0.98;            // planner recharge ceiling
+constexpr int kWires = 4;
+constexpr uint16_t kFrameMs = 120;
+constexpr uint16_t kMinOnMs = 60;             // minOnI default: two wires per frame
+constexpr double kRunS = 4.0;
+constexpr double kStepS = 20e-6;
+
+// Bus voltage after t seconds with load rL (INFINITY = idle).
+double busAfter(double v0, double tS, double capF, double rL) {
+  const double vInf = std::isfinite(rL) ? kVSrc * rL / (rL + kRCharge) : kVSrc;
+  const double rEq = std::isfinite(rL) ? rL * kRCharge / (rL + kRCharge) : kRCharge;
+  return vInf + (v0 - vInf) * std::exp(-tS / (rEq * capF));
+}
+
+// planForDroop without stretching: gap so the pulse ends >= floor, or
+// shorten it when even a recharged bank cannot carry it (skip it below
+// the interleaver's sub-pulse minimum).
+void planDroop(WirePacket* plan, size_t n, double v, double capF, double floorV) {
+  const double rL = kWireOhm;
+  const double vCeil = kVSrc * kCeilFrac;
+  for (size_t i = 0; i < n; ++i) {
+    WirePacket& p = plan[i];
+    if (p.onMs == 0) continue;
+    if (p.gapMs > 0) v = busAfter(v, p.gapMs * 0.001, capF, INFINITY);
+    const double t = p.onMs * 0.001;
+    if (busAfter(v, t, capF, rL) < floorV) {
+      // Start voltage that just reaches the floor: linear in v0.
+      const double vInf = kVSrc * rL / (rL + kRCharge);
+      const double d = std::exp(-t / ((rL * kRCharge / (rL + kRCharge)) * capF));
+      double vReq = vInf + (floorV - vInf) / d;
+      if (vReq > vCeil) vReq = vCeil;
+      if (vReq > v) {
+        const double gapS = kRCharge * capF * std::log((kVSrc - v) / (kVSrc - vReq));
+        const uint16_t g = static_cast<uint16_t>(std::ceil(gapS * 1000.0));
+        p.gapMs = static_cast<uint16_t>(p.gapMs + g);
+        v = busAfter(v, g * 0.001, capF, INFINITY);
+      }
+      while (p.onMs > 0 && busAfter(v, p.onMs * 0.001, capF, rL) < floorV) --p.onMs;
+      if (p.onMs < OUTPUT_INTERLEAVE_MIN_SUB_MS) p.onMs = 0;
+    }
+    v = busAfter(v, p.onMs * 0.001, capF, rL);
+  }
+}
+
+struct Window {
+  double supPeakA = 0.0;
+  double loadPeakA = 0.0;
+  double vMin = 1e9;
+  void add(double iSup, double iLoad, double v) {
+    if (iSup > supPeakA) supPeakA = iSup;
+    if (iLoad > loadPeakA) loadPeakA = iLoad;
+    if (v < vMin) vMin = v;
+  }
+};
+
+// Frame-start buckets [s] for the per-window report.
+constexpr double kBucketS[] = {0.0, 0.12, 0.5, 1.0, 1.5, 2.0, 3.0};
+constexpr int kBuckets = sizeof(kBucketS) / sizeof(kBucketS[0]);
+
+struct Outcome {
+  Window win[kBuckets];
+  double rampEndS = 0.0;
+  double energyJ = 0.0;
+  double tempC = kAmbC;
+  uint16_t shortestScaledMs = UINT16_MAX;  // shortest packet out of scale()
+  uint16_t shortestMs = UINT16_MAX;        // shortest pulse fired during the ramp
+  int rampPulses = 0;
+};
+
+// packetMs: scheduler on-time per wire (the minimum on-time when the
+// budget is tight).
+Outcome run(double capF, const SoftStartRamp::Config* soft, uint16_t packetMs = kMinOnMs) {
+  Outcome o;
+  double v = kVSrc * kCeilFrac;  // precharge done
+  double temp[kWires];
+  for (double& t : temp) t = kAmbC;
+  SoftStartRamp ramp;
+  if (soft) ramp.begin(*soft, 0);
+  bool rampSeen = soft && ramp.active();
+
+  double tS = 0.0;
+  int frame = 0;
+  while (tS < kRunS) {
+    // Scheduler: two wires per frame, rotating.
+    WirePacket packets[2];
+    for (int k = 0; k < 2; ++k) {
+      packets[k].mask = static_cast<uint16_t>(1u << ((frame * 2 + k) % kWires));
+      packets[k].onMs = packetMs;
+    }
+    SoftStartRamp::Step st{};
+    if (soft && ramp.active()) {
+      double coldest = 1e9;
+      for (const WirePacket& p : packets) {
+        for (int w = 0; w < kWires; ++w) {
+          if ((p.mask & (1u << w)) && temp[w] - kAmbC < coldest) coldest = temp[w] - kAmbC;
+        }
+      }
+      st = ramp.step(static_cast<uint32_t>(tS * 1000.0), static_cast<float>(coldest));
+      if (st.active) {
+        ramp.scale(packets, 2, st.frac);
+        for (const WirePacket& p : packets) {
+          if (p.onMs > 0 && p.onMs < o.shortestScaledMs) o.shortestScaledMs = p.onMs;
+        }
+      }
+      else if (rampSeen && o.rampEndS == 0.0) o.rampEndS = tS;
+    }
+
+    OutputInterleaver::Limits lim;
+    lim.frameMs = kFrameMs;
+    WirePacket plan[WireScheduler::kMaxPlanPackets];
+    const size_t n = OutputInterleaver::interleave(packets, 2, lim, plan,
+                                                   WireScheduler::kMaxPlanPackets);
+    double floorV = kBusFloorV;
+    if (st.active) {
+      const double f = SoftStartRamp::floorForPeakV(static_cast<float>(kVSrc),
+                                                    static_cast<float>(kRCharge),
+                                                    st.peakAllowA);
+      if (f > floorV) floorV = f;
+    }
+    planDroop(plan, n, v, capF, floorV);
+    if (st.active) {
+      for (size_t i = 0; i < n; ++i) {
+        if (plan[i].onMs == 0) continue;
+        ++o.rampPulses;
+        if (plan[i].onMs < o.shortestMs) o.shortestMs = plan[i].onMs;
+      }
+    }
+
+    // Play the frame: gap -> pulse per packet, idle to the frame end.
+    int b = 0;
+    while (b + 1 < kBuckets && tS >= kBucketS[b + 1]) ++b;
+    Window& win = o.win[b];
+    double frameT = 0.0;
+    auto advance = [&](double seconds, int wire) {
+      for (double s = 0.0; s < seconds; s += kStepS) {
+        const double iSup = (kVSrc - v) / kRCharge;
+        double iLoad = 0.0;
+        if (wire >= 0) {
+          const double r = kWireOhm * (1.0 + kTcr * (temp[wire] - kAmbC));
+          iLoad = v / r;
+          const double p = v * iLoad;
+          o.energyJ += p * kStepS;
+          temp[wire] += p / kWireCapJK * kStepS;
+        }
+        for (double& t : temp) t -= (t - kAmbC) / kWireTauS * kStepS;
+        v += (iSup - iLoad) / capF * kStepS;
+        win.add(iSup, iLoad, v);
+      }
+      frameT += seconds;
+    };
+    for (size_t i = 0; i < n; ++i) {
+      int wire = -1;
+      for (int w = 0; w < kWires; ++w) {
+        if (plan[i].mask & (1u << w)) wire = w;
+      }
+      advance(plan[i].gapMs * 0.001, -1);
+      advance(plan[i].onMs * 0.001, wire);
+    }
+    if (frameT < kFrameMs * 0.001) advance(kFrameMs * 0.001 - frameT, -1);
+    tS += frameT;
+    ++frame;
+  }
+  double sum = 0.0;
+  for (double t : temp) sum += t;
+  o.tempC = sum / kWires;
+  return o;
+}
+
+void print(int b, const Window& w) {
+  const double end = (b + 1 < kBuckets) ? kBucketS[b + 1] : kRunS;
+  std::printf("    %4.2f-%4.2f s  inrush peak %5.2f A  load peak %5.2f A  Vmin %6.1f V\n",
+              kBucketS[b], end, w.supPeakA, w.loadPeakA, w.vMin);
+}
+
+void report(const char* label, const Outcome& o) {
+  std::printf("  %s: %.1f kJ in %.1f s, mean wire %.1f C", label, o.energyJ * 1e-3,
+              kRunS, o.tempC);
+  if (o.rampEndS > 0.0) std::printf(", ramp ended at %.2f s", o.rampEndS);
+  std::printf("\n");
+  for (int b = 0; b < kBuckets; ++b) print(b, o.win[b]);
+}
+
+// The ramp on minimum-length packets: nothing shorter than the minimum
+// goes out.
+void minimumPulse() {
+  std::printf("minimum pulse during the ramp\n");
+  const double caps[] = {0.002, 0.010};
+  const uint16_t minOns[] = {kMinOnMs, 30};
+  for (double capF : caps) {
+    for (uint16_t minOn : minOns) {
+      SoftStartRamp::Config cfg;
+      cfg.rampMs = 2000;
+      cfg.peakLimitA = 3.0f;
+      cfg.minPulseMs = (minOn > OUTPUT_INTERLEAVE_MIN_SUB_MS) ? minOn
+                                                            : OUTPUT_INTERLEAVE_MIN_SUB_MS;
+      const Outcome soft = run(capF, &cfg, minOn);
+      char what[96];
+      std::snprintf(what, sizeof(what), "%2.0f mF, minOn %2u ms: shortest packet %u ms (>= %u)",
+                    capF * 1e3, (unsigned)minOn, (unsigned)soft.shortestScaledMs,
+                    (unsigned)cfg.minPulseMs);
+      expect(soft.shortestScaledMs != UINT16_MAX && soft.shortestScaledMs >= cfg.minPulseMs,
+             what);
+      std::snprintf(what, sizeof(what), "%2.0f mF, minOn %2u ms: %d pulses, shortest %u ms (>= %u)",
+                    capF * 1e3, (unsigned)minOn, soft.rampPulses, (unsigned)soft.shortestMs,
+                    (unsigned)OUTPUT_INTERLEAVE_MIN_SUB_MS);
+      expect(soft.rampPulses > 0 && soft.shortestMs >= OUTPUT_INTERLEAVE_MIN_SUB_MS, what);
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  std::printf("Bus %.0f V, charge path %.0f ohm, %d wires of %.0f ohm,"
+              " frame %u ms, floor %.0f V\n\n",
+              kVSrc, kRCharge, kWires, kWireOhm, (unsigned)kFrameMs, kBusFloorV);
+  const double caps[] = {0.002, 0.010};
+  for (double capF : caps) {
+    std::printf("C = %.0f mF\n", capF * 1e3);
+    report("legacy", run(capF, nullptr));
+    SoftStartRamp::Config cfg;
+    cfg.rampMs = 2000;     // DEFAULT_SOFTSTART_MS
+    cfg.peakLimitA = 3.0f; // DEFAULT_SOFTSTART_PEAK_A
+    cfg.minPulseMs = kMinOnMs;
+    report("soft", run(capF, &cfg));
+    std::printf("\n");
+  }
+  minimumPulse();
+  std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
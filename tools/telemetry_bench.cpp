@@ -0,0 +1,239 @@
+// Host benchmark: bytes and heap allocations per telemetry message, SSE
+// (base64 CBOR) vs the binary WebSocket channel.
+//
+// Paths modelled per message, for 1 and 3 connected clients:
+//   sse/legacy  buildCborBase64_ as it was: std::vector(capacity) for the
+//               CBOR, Arduino String reserve + base64, then the library's
+//               event text ("id: ..\r\nevent: ..\r\ndata: ..\r\n\r\n",
+//               String += grows to the exact length each time) and one
+//               message object + copy per client
+//   sse/now     CBOR on the stack, the rest as above
+//   ws          CBOR on the stack behind the TelemetryFrame header, one
+//               message object + copy per client (AsyncWebSocket::binary)
+// Allocations are counted with a global operator new / malloc shim; the
+// String model reallocates exactly like WString (reserve to the new length).
+// tinycbor is not available on host: the maps are written with a minimal
+// encoder that emits the same bytes (indefinite map, text, uint).
+//
+// Build & run from the repo root:
+//   g++ -std=c++17 -O2 -Isrc/comms -o /tmp/telemetry_bench
+//       tools/telemetry_bench.cpp src/comms/TelemetryChannel.cpp
+//   /tmp/telemetry_bench
+
+#include <TelemetryChannel.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+size_t gAllocs = 0;
+
+void* countedAlloc(size_t n) {
+  ++gAllocs;
+  void* p = std::malloc(n ? n : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+// WString model: exact-size realloc whenever the length outgrows capacity.
+class MiniString {
+public:
+  ~MiniString() { std::free(_buf); }
+  void reserve(size_t n) {
+    if (n <= _cap) return;
+    ++gAllocs;
+    _buf = static_cast<char*>(std::realloc(_buf, n + 1));
+    _cap = n;
+  }
+  void append(const char* s, size_t n) {
+    reserve(_len + n);
+    std::memcpy(_buf + _len, s, n);
+    _len += n;
+    _buf[_len] = '\0';
+  }
+  void append(const char* s) { append(s, std::strlen(s)); }
+  void append(char c) { append(&c, 1); }
+  size_t size() const { return _len; }
+  const char* c_str() const { return _buf ? _buf : ""; }
+
+private:
+  char* _buf = nullptr;
+  size_t _len = 0;
+  size_t _cap = 0;
+};
+
+// --- Minimal CBOR writer (tinycbor-compatible output for these maps) ---
+struct Cbor {
+  uint8_t* p;
+  size_t n = 0;
+  void head(uint8_t major, uint64_t v) {
+    if (v < 24) { p[n++] = static_cast<uint8_t>((major << 5) | v); return; }
+    if (v <= 0xFF) { p[n++] = static_cast<uint8_t>((major << 5) | 24); p[n++] = static_cast<uint8_t>(v); return; }
+    if (v <= 0xFFFF) {
+      p[n++] = static_cast<uint8_t>((major << 5) | 25);
+      p[n++] = static_cast<uint8_t>(v >> 8); p[n++] = static_cast<uint8_t>(v);
+      return;
+    }
+    p[n++] = static_cast<uint8_t>((major << 5) | 26);
+    for (int s = 24; s >= 0; s -= 8) p[n++] = static_cast<uint8_t>(v >> s);
+  }
+  void text(const char* s) { const size_t l = std::strlen(s); head(3, l); std::memcpy(p + n, s, l); n += l; }
+  void kvText(const char* k, const char* v) { text(k); text(v); }
+  void kvUInt(const char* k, uint64_t v) { text(k); head(0, v); }
+  void openMap() { p[n++] = 0xBF; }
+  void close() { p[n++] = 0xFF; }
+};
+
+size_t encodeState(uint8_t* out) {
+  Cbor c{out};
+  c.openMap();
+  c.kvText("state", "Running");
+  c.kvUInt("seq", 1234);
+  c.kvUInt("sinceMs", 3600000);
+  c.close();
+  return c.n;
+}
+
+size_t encodeEvent(uint8_t* out) {
+  Cbor c{out};
+  c.openMap();
+  c.kvText("kind", "warning");
+  c.kvText("reason", "Capacitor bank discharge stalled");
+  c.kvUInt("ms", 7200000);
+  c.kvUInt("epoch", 1760000000);
+  c.text("unread");
+  c.openMap();
+  c.kvUInt("warn", 2);
+  c.kvUInt("error", 0);
+  c.close();
+  c.close();
+  return c.n;
+}
+
+void base64(MiniString& out, const uint8_t* d, size_t len) {
+  static const char t[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  size_t i = 0;
+  for (; i + 2 < len; i += 3) {
+    const uint32_t v = (d[i] << 16) | (d[i + 1] << 8) | d[i + 2];
+    out.append(t[(v >> 18) & 63]); out.append(t[(v >> 12) & 63]);
+    out.append(t[(v >> 6) & 63]); out.append(t[v & 63]);
+  }
+  if (i < len) {
+    uint32_t v = d[i] << 16;
+    if (i + 1 < len) v |= d[i + 1] << 8;
+    out.append(t[(v >> 18) & 63]); out.append(t[(v >> 12) & 63]);
+    out.append(i + 1 < len ? t[(v >> 6) & 63] : '=');
+    out.append('=');
+  }
+}
+
+// Library side of AsyncEventSource::send(): event text + one copy per client.
+size_t sseSend(const char* data, const char* event, uint32_t id, int clients) {
+  MiniString ev;
+  char num[12];
+  std::snprintf(num, sizeof(num), "%u", static_cast<unsigned>(id));
+  ev.append("id: "); ev.append(num); ev.append("\r\n");
+  ev.append("event: "); ev.append(event); ev.append("\r\n");
+  ev.append("data: "); ev.append(data); ev.append("\r\n");
+  ev.append("\r\n");
+  for (int c = 0; c < clients; ++c) {
+    std::vector<char>* msg = new std::vector<char>(ev.c_str(), ev.c_str() + ev.size());
+    delete msg;
+  }
+  return ev.size();
+}
+
+struct Result {
+  size_t wireBytes = 0;  // per client
+  size_t allocs = 0;     // per message, all clients
+};
+
+template <typename Encode>
+Result sseLegacy(Encode enc, size_t capacity, const char* event, int clients) {
+  gAllocs = 0;
+  std::vector<uint8_t> payload(capacity, 0);
+  const size_t len = enc(payload.data());
+  payload.resize(len);
+  MiniString s;
+  s.reserve(((len + 2) / 3) * 4);
+  base64(s, payload.data(), len);
+  Result r;
+  r.wireBytes = sseSend(s.c_str(), event, 1234, clients);
+  r.allocs = gAllocs;
+  return r;
+}
+
+template <typename Encode>
+Result sseNow(Encode enc, const char* event, int clients) {
+  gAllocs = 0;
+  uint8_t frame[TelemetryFrame::kHeaderLen + 512];
+  const size_t len = enc(frame + TelemetryFrame::kHeaderLen);
+  MiniString s;
+  s.reserve(((len + 2) / 3) * 4);
+  base64(s, frame + TelemetryFrame::kHeaderLen, len);
+  Result r;
+  r.wireBytes = sseSend(s.c_str(), event, 1234, clients);
+  r.allocs = gAllocs;
+  return r;
+}
+
+template <typename Encode>
+Result ws(Encode enc, TelemetryChannel ch, int clients) {
+  gAllocs = 0;
+  uint8_t frame[TelemetryFrame::kHeaderLen + 512];
+  const size_t len = enc(frame + TelemetryFrame::kHeaderLen);
+  TelemetryFrame::writeHeader(frame, ch, 1234);
+  const size_t frameLen = TelemetryFrame::kHeaderLen + len;
+  TelemetrySubscribers subs;
+  for (int c = 0; c < clients; ++c) subs.add(static_cast<uint32_t>(c + 1), 0xFF);
+  gAllocs = 0;
+  uint32_t ids[TelemetrySubscribers::kMaxClients];
+  const size_t n = subs.subscribers(ch, ids, TelemetrySubscribers::kMaxClients);
+  for (size_t i = 0; i < n; ++i) {
+    // AsyncWebSocket::binary(id, data, len): message object + payload copy.
+    std::vector<uint8_t>* msg = new std::vector<uint8_t>(frame, frame + frameLen);
+    delete msg;
+    subs.delivered(ids[i], ch, 1234);
+  }
+  Result r;
+  // Unmasked server frame: 2-byte header below 126 bytes, 4 below 64 KiB.
+  r.wireBytes = frameLen + (frameLen < 126 ? 2 : 4);
+  r.allocs = gAllocs;
+  return r;
+}
+
+void row(const char* msg, const char* path, size_t cbor, const Result& r1, const Result& r3) {
+  std::printf("  %-6s %-11s cbor %4zu B  wire %4zu B/client  allocs %2zu (1 client) %2zu (3)\n",
+              msg, path, cbor, r1.wireBytes, r1.allocs, r3.allocs);
+}
+
+template <typename Encode>
+void bench(const char* name, Encode enc, size_t legacyCap, const char* event,
+           TelemetryChannel ch) {
+  uint8_t tmp[512];
+  const size_t cbor = enc(tmp);
+  row(name, "sse/legacy", cbor, sseLegacy(enc, legacyCap, event, 1), sseLegacy(enc, legacyCap, event, 3));
+  row(name, "sse/now", cbor, sseNow(enc, event, 1), sseNow(enc, event, 3));
+  row(name, "ws", cbor, ws(enc, ch, 1), ws(enc, ch, 3));
+}
+
+} // namespace
+
+void* operator new(size_t n) { return countedAlloc(n); }
+void* operator new[](size_t n) { return countedAlloc(n); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+int main() {
+  std::printf("Per message (frame header %zu B)\n", TelemetryFrame::kHeaderLen);
+  bench("state", encodeState, 96, "state", TelemetryChannel::State);
+  bench("event", encodeEvent, 256, "event", TelemetryChannel::Event);
+  return 0;
+}
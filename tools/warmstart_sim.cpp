@@ -0,0 +1,176 @@
+// Host simulation: RUN stop/restart with and without the warm start.
+//
+// One lumped wire (C dT/dt = P - k (T - Tamb)) driven by the loop's demand
+// law (boost below target - margin, proportional hold above it, wires at
+// wireMax - 10 skipped). The loop runs to the target, stops, and a new RUN
+// is requested after a short pause. Compared:
+//   legacy      model forced to 150 C, wait until within 5 C of ambient
+//   warm/nocap  resume from the model, no energy budget
+//   warm/cap    resume from the model, WireWarmStart::headroomOnMs() cap
+// A second scenario reboots the device with the wire hot and restarts
+// shortly after boot (WarmStartMode::Bounded: model seeded with the
+// decayed worst case; "naive" trusts the ambient model from init).
+//
+// Build & run from the repo root:
+//   g++ -std=c++17 -O2 -Isrc/wire -o /tmp/warmstart_sim
+//       tools/warmstart_sim.cpp src/wire/WireWarmStart.cpp
+//   /tmp/warmstart_sim
+
+#include <WireWarmStart.hpp>
+
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr double kAmbC = 22.0;
+constexpr double kLimitC = 150.0;    // WIRE_T_MAX_C / NICHROME_FINAL_TEMP_C
+constexpr double kTargetC = 130.0;
+constexpr double kMarginC = 5.0;     // DEFAULT_FLOOR_SWITCH_MARGIN_C
+constexpr double kHoldGain = 0.6;
+constexpr double kPowerW = 325.0 * 325.0 / 44.0;
+constexpr double kTauS = 35.0;
+constexpr int kFrameMs = 120;
+constexpr double kStepS = 0.001;
+
+struct Wire {
+  double capC;
+  double k;
+  double t = kAmbC;      // physical
+  double model = kAmbC;  // firmware estimate
+};
+
+void cool(Wire& w, double seconds, bool modelToo) {
+  const double d = std::exp(-seconds / kTauS);
+  w.t = kAmbC + (w.t - kAmbC) * d;
+  if (modelToo) w.model = kAmbC + (w.model - kAmbC) * d;
+}
+
+// One frame of the loop; returns the on-time applied.
+int frame(Wire& w, bool cap) {
+  const double err = kTargetC - w.t;
+  double demand = 0.0;
+  if (err > kMarginC) demand = kFrameMs;
+  else if (err > 0.0) demand = kFrameMs * (err / kMarginC) * kHoldGain;
+  int onMs = static_cast<int>(std::lround(demand));
+  if (w.model >= kLimitC - 10.0) onMs = 0;  // scheduler exclusion
+  if (cap && onMs > 0) {
+    const uint16_t c = WireWarmStart::headroomOnMs(
+        static_cast<float>(w.model), static_cast<float>(kAmbC), static_cast<float>(kLimitC),
+        static_cast<float>(kPowerW), static_cast<float>(w.capC), static_cast<float>(w.k),
+        kFrameMs);
+    if (onMs > c) onMs = c;
+  }
+  for (int ms = 0; ms < kFrameMs; ++ms) {
+    const double p = (ms < onMs) ? kPowerW : 0.0;
+    w.t += (p - w.k * (w.t - kAmbC)) / w.capC * kStepS;
+    w.model += (p - w.k * (w.model - kAmbC)) / w.capC * kStepS;
+  }
+  return onMs;
+}
+
+struct Outcome {
+  double waitS = 0.0;
+  double toTargetS = -1.0;  // from the RUN request
+  double peakC = 0.0;
+};
+
+Outcome runFrom(Wire w, bool cap, double waitS) {
+  Outcome o;
+  o.waitS = waitS;
+  o.peakC = w.t;
+  double t = waitS;
+  for (int f = 0; f < 600 * 1000 / kFrameMs; ++f) {
+    frame(w, cap);
+    t += kFrameMs * 0.001;
+    if (w.t > o.peakC) o.peakC = w.t;
+    if (o.toTargetS < 0.0 && w.t >= kTargetC - 2.0) o.toTargetS = t;
+    if (o.toTargetS >= 0.0 && t > o.toTargetS + 30.0) break;
+  }
+  return o;
+}
+
+double legacyWaitS(Wire& w) {
+  // Model forced to the limit, then cooled until within 5 C of ambient.
+  const double waitS = kTauS * std::log((kLimitC - kAmbC) / 5.0);
+  cool(w, waitS, false);
+  w.model = kAmbC + 5.0;
+  return waitS;
+}
+
+void print(const char* label, const Outcome& o) {
+  std::printf("  %-12s wait %6.1f s  back to target %6.1f s  peak %6.1f C%s\n",
+              label, o.waitS, o.toTargetS, o.peakC,
+              o.peakC > kLimitC + 0.05 ? "  OVER LIMIT" : "");
+}
+
+void stopRestart(double capC, double offS) {
+  Wire w{capC, capC / kTauS};
+  for (int f = 0; f < 60 * 1000 / kFrameMs; ++f) frame(w, true);
+  cool(w, offS, true);
+  std::printf("C=%.1f J/K, stop %.0f s at %.1f C (model %.1f C)\n",
+              capC, offS, w.t, w.model);
+
+  Wire legacy = w;
+  const double waitS = legacyWaitS(legacy);
+  print("legacy", runFrom(legacy, false, waitS));
+
+  WireWarmStart::Evidence ev;
+  ev.modelReady = true;
+  ev.ranThisBoot = true;
+  ev.uptimeMs = 600000;
+  ev.maxTauS = kTauS;
+  const WarmStartMode mode = WireWarmStart::assess(ev, WireWarmStart::Config{});
+  std::printf("  mode: %s\n", WireWarmStart::modeName(mode));
+  print("warm/nocap", runFrom(w, false, 0.0));
+  print("warm/cap", runFrom(w, true, 0.0));
+}
+
+void rebootRestart(double capC, double uptimeS) {
+  Wire w{capC, capC / kTauS};
+  for (int f = 0; f < 60 * 1000 / kFrameMs; ++f) frame(w, true);
+  // Reboot: the model restarts at ambient, the wire keeps its heat.
+  w.model = kAmbC;
+  cool(w, uptimeS, true);
+  std::printf("C=%.1f J/K, reboot hot, RUN at uptime %.0f s, wire %.1f C\n",
+              capC, uptimeS, w.t);
+
+  Wire legacy = w;
+  const double waitS = legacyWaitS(legacy);
+  print("legacy", runFrom(legacy, false, waitS));
+  print("naive", runFrom(w, false, 0.0));
+
+  WireWarmStart::Evidence ev;
+  ev.modelReady = true;
+  ev.ranThisBoot = false;
+  ev.uptimeMs = static_cast<uint32_t>(uptimeS * 1000.0);
+  ev.maxTauS = kTauS;
+  const WarmStartMode mode = WireWarmStart::assess(ev, WireWarmStart::Config{});
+  Wire warm = w;
+  if (mode == WarmStartMode::Bounded) {
+    warm.model = WireWarmStart::boundedSeedC(kAmbC, kLimitC, kTauS, ev.uptimeMs);
+  }
+  std::printf("  mode: %s, seed %.1f C\n", WireWarmStart::modeName(mode), warm.model);
+  print("warm/cap", runFrom(warm, true, 0.0));
+}
+
+} // namespace
+
+int main() {
+  std::printf("Wire: %.0f W, tau %.0f s, ambient %.0f C, target %.0f C, limit %.0f C,"
+              " frame %d ms\n\n",
+              kPowerW, kTauS, kAmbC, kTargetC, kLimitC, kFrameMs);
+  // 43 J/K ~ 22 m of AWG20 (44 ohm at 2 ohm/m); 4.3 J/K a thin/short wire
+  // where one frame can add tens of kelvin.
+  const double caps[] = {43.0, 4.3};
+  const double offs[] = {5.0, 30.0};
+  for (double capC : caps) {
+    for (double offS : offs) {
+      stopRestart(capC, offS);
+      std::printf("\n");
+    }
+    rebootRestart(capC, 15.0);
+    std::printf("\n");
+  }
+  return 0;
+}
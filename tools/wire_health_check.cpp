@@ -0,0 +1,285 @@
+// Host check: WireHealthMonitor on synthetic pulse streams.
+//
+// The monitor is configured the way WirePresenceManager does it (PMINR
+// 0.5, PFAIL 3) and fed one update() per heating pulse: 325 V bus, 44 ohm
+// wires, the scheduler's one-wire-per-pulse rotation (and a rotating pair
+// mask), nominal conductance from the calibrated resistance. The measured
+// current is V * sum(actual G) with Gaussian relative and absolute noise.
+// A wire that latches Open or Short leaves the masks, as it does when
+// WirePresenceManager marks it not present.
+// For each stream the check asserts the final state and the detection
+// delay, counted in pulses of the faulty wire after the fault:
+//   - step open (wire gone): Open after PFAIL pulses, noisy or not
+//   - step short (G x2, and x1.6 just past the short boundary): Short
+//     after PFAIL pulses, never reported as Drift on the way
+//   - slow ramp (R +/-0.05 % per pulse): Drift (not Open / Short) within a
+//     bounded number of pulses after the 8 % boundary, never before it
+//   - one-pulse dropout: no latch
+//   - noisy healthy wires at the configured noise level: stays Ok
+//   - rotating pairs: only the faulty wire latches
+//
+// Build & run from the repo root:
+//   g++ -std=c++17 -O2 -Isrc/wire -o /tmp/wire_health_check
+//       tools/wire_health_check.cpp src/wire/WireHealthMonitor.cpp
+//   /tmp/wire_health_check
+
+#include <WireHealthMonitor.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool cond, const char* what) {
+  std::printf("  %-62s %s\n", what, cond ? "ok" : "FAILED");
+  if (!cond) ++failures;
+}
+
+constexpr int kWires = WireHealthMonitor::kWireCount;
+constexpr double kBusV = 325.0;         // DEFAULT_DC_VOLTAGE
+constexpr double kWireOhm = 44.0;       // DEFAULT_WIRE_RES_OHMS
+constexpr uint8_t kFailPulses = 3;      // DEFAULT_PRESENCE_FAIL_COUNT
+constexpr float kMinRatio = 0.5f;       // DEFAULT_PRESENCE_MIN_RATIO
+constexpr uint8_t kWire = 4;            // faulty wire (1-based)
+
+// Actual / nominal conductance of wire `index` (1-based) at its n-th pulse.
+using Ratio = std::function<double(uint8_t index, uint32_t n)>;
+
+struct Noise {
+  double rel;
+  double amps;
+};
+
+constexpr Noise kQuiet{0.0, 0.0};
+constexpr Noise kTypical{0.02, 0.10};
+constexpr Noise kConfigured{WIRE_CUSUM_SIGMA_REL, WIRE_CUSUM_SIGMA_A};
+
+struct Run {
+  WireHealth state[kWires + 1];
+  int changedAt[kWires + 1];     // pulse count of that wire at its first change, -1 none
+  WireHealth firstState[kWires + 1];
+};
+
+WireHealthMonitor makeMonitor() {
+  WireHealthMonitor m;
+  WireHealthMonitor::Config cfg;
+  cfg.minRatio = kMinRatio;
+  cfg.minPulses = kFailPulses;
+  m.configure(cfg);
+  return m;
+}
+
+// pair: masks rotate over (1,2), (2,3), ... (10,1) instead of single wires.
+Run stream(const Ratio& ratio, uint32_t rounds, Noise noise, uint32_t seed, bool pair = false) {
+  WireHealthMonitor m = makeMonitor();
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> gauss(0.0, 1.0);
+  float g[kWires];
+  for (int i = 0; i < kWires; ++i) g[i] = static_cast<float>(1.0 / kWireOhm);
+
+  Run r;
+  uint32_t pulses[kWires + 1] = {0};
+  uint16_t present = (1u << kWires) - 1u;
+  for (int i = 0; i <= kWires; ++i) {
+    r.state[i] = WireHealth::Ok;
+    r.firstState[i] = WireHealth::Ok;
+    r.changedAt[i] = -1;
+  }
+  for (uint32_t k = 0; k < rounds; ++k) {
+    for (int w = 0; w < kWires; ++w) {
+      uint16_t mask = static_cast<uint16_t>(1u << w);
+      if (pair) mask |= static_cast<uint16_t>(1u << ((w + 1) % kWires));
+      mask &= present;
+      if (mask == 0) continue;
+      double gAct = 0.0;
+      for (int i = 0; i < kWires; ++i) {
+        if (!(mask & (1u << i))) continue;
+        gAct += ratio(static_cast<uint8_t>(i + 1), pulses[i + 1]) / kWireOhm;
+        ++pulses[i + 1];
+      }
+      const double v = kBusV;
+      double a = v * gAct;
+      a += a * noise.rel * gauss(rng) + noise.amps * gauss(rng);
+      const uint16_t changed = m.update(mask, g, static_cast<float>(v), static_cast<float>(a));
+      for (uint8_t i = 1; i <= kWires; ++i) {
+        if (!(changed & (1u << (i - 1)))) continue;
+        if (r.changedAt[i] < 0) {
+          r.changedAt[i] = static_cast<int>(pulses[i]);
+          r.firstState[i] = m.health(i);
+        }
+        if (m.health(i) == WireHealth::Open || m.health(i) == WireHealth::Short) {
+          present &= static_cast<uint16_t>(~(1u << (i - 1)));
+        }
+      }
+    }
+  }
+  for (uint8_t i = 1; i <= kWires; ++i) r.state[i] = m.health(i);
+  return r;
+}
+
+bool othersOk(const Run& r) {
+  for (uint8_t i = 1; i <= kWires; ++i) {
+    if (i != kWire && (r.state[i] != WireHealth::Ok || r.changedAt[i] >= 0)) return false;
+  }
+  return true;
+}
+
+const char* name(WireHealth h) {
+  switch (h) {
+    case WireHealth::Ok:    return "Ok";
+    case WireHealth::Drift: return "Drift";
+    case WireHealth::Open:  return "Open";
+    case WireHealth::Short: return "Short";
+  }
+  return "?";
+}
+
+// Fault from the wire's 50th pulse on.
+constexpr uint32_t kFaultPulse = 50;
+
+Ratio step(double after) {
+  return [after](uint8_t i, uint32_t n) {
+    return (i == kWire && n >= kFaultPulse) ? after : 1.0;
+  };
+}
+
+void steps() {
+  std::printf("step open / short (wire %u from pulse %u, PFAIL %u)\n",
+              kWire, kFaultPulse, kFailPulses);
+  struct Case { const char* what; double ratio; WireHealth want; };
+  const Case cases[] = {
+      {"open (G 0)", 0.0, WireHealth::Open},
+      {"open (G 0.2)", 0.2, WireHealth::Open},
+      {"short (G x2)", 2.0, WireHealth::Short},
+      {"short (G x1.6)", 1.6, WireHealth::Short},
+  };
+  for (const Case& c : cases) {
+    for (const Noise& n : {kQuiet, kTypical}) {
+      int worst = 0;
+      bool ok = true;
+      const int seeds = (n.rel > 0.0) ? 50 : 1;
+      for (int s = 0; s < seeds; ++s) {
+        const Run r = stream(step(c.ratio), 100, n, 300 + s);
+        const int delay = r.changedAt[kWire] - static_cast<int>(kFaultPulse);
+        if (delay > worst) worst = delay;
+        ok = ok && r.state[kWire] == c.want && r.firstState[kWire] == c.want &&
+             delay >= kFailPulses && othersOk(r);
+      }
+      char what[96];
+      std::snprintf(what, sizeof(what), "%-15s noise %2.0f %%: %s after <= %d pulses",
+                    c.what, n.rel * 100.0, name(c.want), worst);
+      // Quiet: exactly PFAIL pulses; noisy: one more at most.
+      expect(ok && worst <= kFailPulses + (n.rel > 0.0 ? 1 : 0), what);
+    }
+  }
+
+  // A single dropped pulse must not latch.
+  const Run r = stream([](uint8_t i, uint32_t n) {
+    return (i == kWire && n == kFaultPulse) ? 0.0 : 1.0;
+  }, 100, kTypical, 7);
+  expect(r.state[kWire] == WireHealth::Ok && othersOk(r), "one-pulse dropout: stays Ok");
+}
+
+void ramps() {
+  std::printf("slow ramp (R +/-0.05 %% per pulse of wire %u)\n", kWire);
+  const double perPulse = 0.0005;
+  for (int dir : {+1, -1}) {
+    // dir +1: resistance rises, conductance ratio falls.
+    const Ratio ramp = [dir, perPulse](uint8_t i, uint32_t n) {
+      if (i != kWire || n < kFaultPulse) return 1.0;
+      return 1.0 / (1.0 + dir * perPulse * (n - kFaultPulse));
+    };
+    // Pulse at which the ratio leaves the 1 +/- driftFrac band.
+    const double edgeR = (dir > 0) ? 1.0 / (1.0 - WIRE_CUSUM_DRIFT_FRAC)
+                                   : 1.0 / (1.0 + WIRE_CUSUM_DRIFT_FRAC);
+    const int edge = kFaultPulse + static_cast<int>((edgeR - 1.0) / (dir * perPulse));
+    // Past the edge the drift LLR grows by (d / s^2) * perPulse each pulse,
+    // so the sum reaches hDrift after about sqrt(2 h s^2 / (d perPulse)).
+    const double iExp = kBusV / kWireOhm;
+    const double var = WIRE_CUSUM_SIGMA_REL * WIRE_CUSUM_SIGMA_REL +
+                       std::pow(WIRE_CUSUM_SIGMA_A / iExp, 2.0);
+    const double d = 2.0 * WIRE_CUSUM_DRIFT_FRAC;
+    const int predicted = static_cast<int>(std::sqrt(2.0 * WIRE_CUSUM_H_DRIFT * var / (d * perPulse)));
+    int early = 0, worst = 0, latched = 0, seeds = 50;
+    for (int s = 0; s < seeds; ++s) {
+      const Run r = stream(ramp, kFaultPulse + 260, kTypical, 400 + s);
+      if (r.firstState[kWire] != WireHealth::Drift || !othersOk(r)) ++latched;
+      if (r.changedAt[kWire] < edge) ++early;
+      const int delay = r.changedAt[kWire] - edge;
+      if (delay > worst) worst = delay;
+    }
+    char what[96];
+    std::snprintf(what, sizeof(what), "R %s: Drift in %d/%d, %d early, <= %d pulses past %d (~%d)",
+                  dir > 0 ? "up  " : "down", seeds - latched, seeds, early, worst, edge,
+                  predicted);
+    expect(latched == 0 && early == 0 && worst <= predicted * 3 / 2, what);
+  }
+
+  // A ramp that stays inside the band is not reported.
+  const Run r = stream([](uint8_t i, uint32_t n) {
+    return (i == kWire) ? 1.0 / (1.0 + std::fmin(0.0005 * n, 0.04)) : 1.0;
+  }, 500, kTypical, 9);
+  expect(r.state[kWire] == WireHealth::Ok && othersOk(r), "4 % rise (inside the band): stays Ok");
+}
+
+void healthy() {
+  std::printf("no fault\n");
+  const uint32_t rounds = 20000;
+  for (const Noise& n : {kTypical, kConfigured}) {
+    int flagged = 0;
+    for (uint32_t seed = 0; seed < 5; ++seed) {
+      const Run r = stream([](uint8_t, uint32_t) { return 1.0; }, rounds, n, 500 + seed);
+      for (uint8_t i = 1; i <= kWires; ++i) {
+        if (r.changedAt[i] >= 0) ++flagged;
+      }
+    }
+    char what[96];
+    std::snprintf(what, sizeof(what), "%u pulses/wire x 5, noise %.0f %% + %.2f A: %d changes",
+                  rounds, n.rel * 100.0, n.amps, flagged);
+    expect(flagged == 0, what);
+  }
+}
+
+void pairs() {
+  std::printf("rotating pair masks\n");
+  struct Case { const char* what; double ratio; WireHealth want; };
+  const Case cases[] = {
+      {"open", 0.0, WireHealth::Open},
+      {"short (G x2)", 2.0, WireHealth::Short},
+  };
+  for (const Case& c : cases) {
+    int ok = 0, worst = 0;
+    const int seeds = 50;
+    for (int s = 0; s < seeds; ++s) {
+      const Run r = stream(step(c.ratio), 100, kTypical, 600 + s, true);
+      if (r.state[kWire] == c.want && othersOk(r)) ++ok;
+      const int delay = r.changedAt[kWire] - static_cast<int>(kFaultPulse);
+      if (delay > worst) worst = delay;
+    }
+    char what[96];
+    std::snprintf(what, sizeof(what), "%-12s: only wire %u latched in %d/%d, <= %d pulses",
+                  c.what, kWire, ok, seeds, worst);
+    expect(ok == seeds && worst <= 2 * kFailPulses, what);
+  }
+  int flagged = 0;
+  const Run r = stream([](uint8_t, uint32_t) { return 1.0; }, 20000, kConfigured, 700, true);
+  for (uint8_t i = 1; i <= kWires; ++i) {
+    if (r.changedAt[i] >= 0) ++flagged;
+  }
+  expect(flagged == 0, "healthy pairs, configured noise: no change");
+}
+
+} // namespace
+
+int main() {
+  steps();
+  ramps();
+  healthy();
+  pairs();
+  std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}